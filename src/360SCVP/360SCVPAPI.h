@@ -193,6 +193,31 @@ typedef struct TILE_DEF
     int32_t downRightYOffset;
 } TileDef;
 
+/*!
+ *
+ *  The structure for selecting tiles of several poses in one call
+ *  pPoses: The poses to select tiles for, only yaw and pitch are used
+ *  posesNum: The number of poses
+ *  bitsetWords: The uint64_t words number of each bitset, it can't be less than (tilesNum + 63) / 64,
+ *      tilesNum is the one returned by I360SCVP_GetTilesLayout
+ *  pTilesBitsets: The tiles bitsets of all poses, the bitset of pose i starts from word i * bitsetWords,
+ *      and bit n of one bitset is set when the tile whose idx is n is selected
+ *  pUnionBitset: Optional, the tiles selected by any of the poses
+ *  pIntersectionBitset: Optional, the tiles selected by all of the poses
+ *  pSelectedTilesNum: Optional, the selected tiles number of each pose
+ *
+ */
+typedef struct TILES_SELECTION_BATCH
+{
+    HeadPose *pPoses;
+    int32_t   posesNum;
+    int32_t   bitsetWords;
+    uint64_t *pTilesBitsets;
+    uint64_t *pUnionBitset;
+    uint64_t *pIntersectionBitset;
+    int32_t  *pSelectedTilesNum;
+} TilesSelectionBatch;
+
 typedef struct CC_DEF
 {
     int32_t centreAzimuth;
@@ -576,6 +601,19 @@ typedef struct PARAM_STREAMSTITCHINFO
     uint32_t               pts;
 }param_streamStitchInfo;
 
+//!
+//! \brief  This structure is for one span of the merged frame in the scatter/gather output mode,
+//!         it points either to the rewritten headers in pOutputBitstream or to the slice data
+//!         inside the input tile bitstream, so the slice data isn't copied during the merge
+//!
+//! \param    pData,              output,   the start address of the span
+//! \param    dataLen,            output,   the length of the span
+typedef struct OUTPUT_SPAN
+{
+    const uint8_t *pData;
+    uint32_t       dataLen;
+}Output_Span;
+
 //!
 //! \brief  This structure is for the stitch parameters
 //!
@@ -602,6 +640,12 @@ typedef struct PARAM_STREAMSTITCHINFO
 //! \param    pOutputSEI,         output,   the buffer for the output SEI bistream, mainly RWPK, just used in the usedType=E_MERGE_AND_VIEWPORT
 //! \param    outputSEILen,       output,   the length of the output SEI bistream, just used in the usedType=E_MERGE_AND_VIEWPORT
 //! \param    timeStamp,          input,    using timestamp to track frame, especially used in the E_MERGE_AND_VIEWPORT use case
+//! \param    pOutputSpans,       input,    the span array for the scatter/gather output mode, which is enabled when it isn't NULL,
+//!                                         just used in the usedType=E_STREAM_STITCH_ONLY and E_MERGE_AND_VIEWPORT. Only the
+//!                                         rewritten headers are written into pOutputBitstream then, and the merged frame is
+//!                                         the concatenation of the spans, whose length is still outputBitstreamLen
+//! \param    maxOutputSpansNum,  input,    the size of pOutputSpans array, at least 2 * (merged tiles number + 1)
+//! \param    outputSpansNum,     output,   the number of the spans describing the merged frame
 //!
 typedef struct PARAM_360SCVP
 {
@@ -630,6 +674,9 @@ typedef struct PARAM_360SCVP
     uint32_t               timeStamp;
     void                  *logFunction;       //external log callback function pointer, NULL if external log is not used
     NovelViewSEI          novelViewSEI;
+    Output_Span           *pOutputSpans;
+    uint32_t               maxOutputSpansNum;
+    uint32_t               outputSpansNum;
 }param_360SCVP;
 
 //!
@@ -664,6 +711,22 @@ void * I360SCVP_New(void* p360SCVPHandle);
 //!
 int32_t I360SCVP_process(param_360SCVP* pParam360SCVP, void * p360SCVPHandle);
 
+//!
+//! \brief      This function assembles the spans got from the scatter/gather output mode of I360SCVP_process
+//!             into one continuous buffer, which is the only copy of the slice data when the decoder
+//!             can't consume the spans directly
+//! \param      Output_Span*     pOutputSpans,      input,  the spans describing the merged frame
+//! \param      uint32_t         outputSpansNum,    input,  the number of the spans
+//! \param      uint8_t*         pDstBuffer,        output, the buffer for the assembled frame
+//! \param      uint32_t         dstBufferLen,      input,  the size of pDstBuffer
+//! \param      uint32_t*        pAssembledLen,     output, the length of the assembled frame
+//!
+//! \return     int32_t, the status of the function.
+//!     0,      if succeed
+//!     not 0,  if fail
+//!
+int32_t I360SCVP_AssembleSpans(Output_Span* pOutputSpans, uint32_t outputSpansNum, uint8_t* pDstBuffer, uint32_t dstBufferLen, uint32_t* pAssembledLen);
+
 //!
 //! \brief      This function sets the parameter of the viewPort.
 //!
@@ -963,6 +1026,71 @@ int32_t I360SCVP_SetParameter(void* p360SCVPHandle, int32_t paramID, void* pValu
 //!
 int32_t I360SCVP_GetTilesByLegacyWay(TileDef* pOutTile, void* p360SCVPHandle);
 
+//!
+//! \brief    This function enables the pose quantized tile selection look up table, the tiles of one pose are
+//!           the tiles selected at the center of its quantization cell afterwards, and repeated poses in one
+//!           cell only cost one table lookup. The table is bound to the tile grid, projection and FOV of the handle
+//!
+//! \param    void*     p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
+//! \param    float     yawStep,         input,     the quantization step of yaw in degree, 1 keeps integer yaw exact
+//! \param    float     pitchStep,       input,     the quantization step of pitch in degree, 1 keeps integer pitch exact
+//! \param    bool      bBuildAll,       input,     fill all entries of the table now, or fill each at its first use
+//!
+//! \return   int32_t, the status of the function.
+//!           ERROR_NONE if success, else failed reason
+//!
+int32_t I360SCVP_EnableTileSelectionLUT(void* p360SCVPHandle, float yawStep, float pitchStep, bool bBuildAll);
+
+//!
+//! \brief    This function writes the filled entries of the tile selection look up table into the file
+//!
+//! \param    void*        p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
+//! \param    const char*  fileName,        input,     the file to write
+//!
+//! \return   int32_t, the status of the function.
+//!           ERROR_NONE if success, else failed reason
+//!
+int32_t I360SCVP_SaveTileSelectionLUT(void* p360SCVPHandle, const char* fileName);
+
+//!
+//! \brief    This function reads the tile selection look up table from the file, the table must be built for the
+//!           same tile grid, projection and FOV, and I360SCVP_EnableTileSelectionLUT must be called before
+//!
+//! \param    void*        p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
+//! \param    const char*  fileName,        input,     the file to read
+//!
+//! \return   int32_t, the status of the function.
+//!           ERROR_NONE if success, else failed reason
+//!
+int32_t I360SCVP_LoadTileSelectionLUT(void* p360SCVPHandle, const char* fileName);
+
+//!
+//! \brief    This function gets all tiles of the handle, the tile with idx n is the one of bit n in the tiles bitsets
+//!           of I360SCVP_SelectTilesForPoses
+//!
+//! \param    void*     p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
+//! \param    TileDef*  pOutTile,        output,    the tiles, it can be NULL to only get the tiles number
+//! \param    int32_t   maxTileNum,      input,     the size of pOutTile
+//!
+//! \return   int32_t, the tiles number.
+//!           >0, if succeed
+//!           <0, if fail
+//!
+int32_t I360SCVP_GetTilesLayout(void* p360SCVPHandle, TileDef* pOutTile, int32_t maxTileNum);
+
+//!
+//! \brief    This function selects the tiles of several poses in one call, the current viewport of the handle is
+//!           not changed. It can be called from several threads on the same handle at the same time, each call
+//!           uses its own viewport instance which is kept by the handle for later calls
+//!
+//! \param    void*                 p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
+//! \param    TilesSelectionBatch*  pBatch,          input/output, the poses and the selected tiles bitsets
+//!
+//! \return   int32_t, the status of the function.
+//!           ERROR_NONE if success, else failed reason
+//!
+int32_t I360SCVP_SelectTilesForPoses(void* p360SCVPHandle, TilesSelectionBatch* pBatch);
+
 //! \brief    This function can set the logcallback funciton.
 //!
 //! \param    void*     p360SCVPHandle,  input,     which is created by the I360SVCP_Init function
@@ -93,6 +93,23 @@ int32_t   I360SCVP_process(param_360SCVP* pParam360SCVP, void* p360SCVPHandle)
     return ret;
 }
 
+int32_t I360SCVP_AssembleSpans(Output_Span* pOutputSpans, uint32_t outputSpansNum, uint8_t* pDstBuffer, uint32_t dstBufferLen, uint32_t* pAssembledLen)
+{
+    if (!pOutputSpans || !pDstBuffer || !pAssembledLen)
+        return -1;
+
+    uint32_t assembledLen = 0;
+    for (uint32_t i = 0; i < outputSpansNum; i++)
+    {
+        if (!pOutputSpans[i].pData || pOutputSpans[i].dataLen > dstBufferLen - assembledLen)
+            return -1;
+        memcpy_s(pDstBuffer + assembledLen, pOutputSpans[i].dataLen, pOutputSpans[i].pData, pOutputSpans[i].dataLen);
+        assembledLen += pOutputSpans[i].dataLen;
+    }
+    *pAssembledLen = assembledLen;
+    return 0;
+}
+
 int32_t I360SCVP_setViewPort(void* p360SCVPHandle, float yaw, float pitch)
 {
     int32_t ret = 0;
@@ -424,6 +441,46 @@ int32_t I360SCVP_GetTilesByLegacyWay(TileDef* pOutTile, void* p360SCVPHandle)
     return ret;
 }
 
+int32_t I360SCVP_EnableTileSelectionLUT(void* p360SCVPHandle, float yawStep, float pitchStep, bool bBuildAll)
+{
+    TstitchStream* pStitch = (TstitchStream*)(p360SCVPHandle);
+    if (!pStitch)
+        return OMAF_ERROR_NULL_PTR;
+    return pStitch->enableTileSelectionLUT(yawStep, pitchStep, bBuildAll);
+}
+
+int32_t I360SCVP_SaveTileSelectionLUT(void* p360SCVPHandle, const char* fileName)
+{
+    TstitchStream* pStitch = (TstitchStream*)(p360SCVPHandle);
+    if (!pStitch || !fileName)
+        return OMAF_ERROR_NULL_PTR;
+    return pStitch->saveTileSelectionLUT(fileName);
+}
+
+int32_t I360SCVP_LoadTileSelectionLUT(void* p360SCVPHandle, const char* fileName)
+{
+    TstitchStream* pStitch = (TstitchStream*)(p360SCVPHandle);
+    if (!pStitch || !fileName)
+        return OMAF_ERROR_NULL_PTR;
+    return pStitch->loadTileSelectionLUT(fileName);
+}
+
+int32_t I360SCVP_GetTilesLayout(void* p360SCVPHandle, TileDef* pOutTile, int32_t maxTileNum)
+{
+    TstitchStream* pStitch = (TstitchStream*)(p360SCVPHandle);
+    if (!pStitch)
+        return OMAF_ERROR_NULL_PTR;
+    return pStitch->getTilesLayout(pOutTile, maxTileNum);
+}
+
+int32_t I360SCVP_SelectTilesForPoses(void* p360SCVPHandle, TilesSelectionBatch* pBatch)
+{
+    TstitchStream* pStitch = (TstitchStream*)(p360SCVPHandle);
+    if (!pStitch || !pBatch)
+        return OMAF_ERROR_NULL_PTR;
+    return pStitch->selectTilesForPoses(pBatch);
+}
+
 int32_t I360SCVPSetLogCallBack(void* p360SCVPHandle, void* externalLog)
 {
     TstitchStream* pStitch = (TstitchStream*)p360SCVPHandle;
@@ -232,9 +232,117 @@ uint8_t gf_bs_read_bit(GTS_BitStream *bs)
 }
 
 
+/*count leading zero bits of a non-zero 32 bits value*/
+static inline uint32_t BS_CountLeadingZeros(uint32_t val)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clz(val);
+#else
+    uint32_t n = 0;
+    while (!(val & 0x80000000)) {
+        val <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*load 8 bytes from the memory as one big endian word*/
+static inline uint64_t BS_LoadWord(const uint8_t *data)
+{
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+#if (defined(__GNUC__) || defined(__clang__)) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    return __builtin_bswap64(word);
+#elif (defined(__GNUC__) || defined(__clang__)) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return word;
+#else
+    word = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        word = (word << 8) | data[i];
+    }
+    return word;
+#endif
+}
+
+/*load the 32 bits starting from the bit offset in memory read mode, bits out of
+  the buffer are zero. returns false if the bit offset is out of the buffer*/
+static inline bool BS_LoadBits(GTS_BitStream *bs, uint64_t bitOffset, uint32_t *value)
+{
+    uint64_t byteOffset = bitOffset >> 3;
+    const uint8_t *data = (const uint8_t *)bs->original + byteOffset;
+    uint64_t word = 0;
+    uint32_t i;
+
+    if (byteOffset + 8 <= bs->size) {
+        word = BS_LoadWord(data);
+    } else {
+        if (byteOffset >= bs->size)
+            return false;
+        for (i = 0; i < bs->size - byteOffset; i++)
+            word |= (uint64_t)data[i] << (56 - 8 * i);
+    }
+    *value = (uint32_t)((word << (bitOffset & 7)) >> 32);
+    return true;
+}
+
+/*move the memory read mode state to the bit offset, the state (position, current
+  and nbBits) is the same as the one after reading bit by bit*/
+static inline void BS_SetReadBitOffset(GTS_BitStream *bs, uint64_t bitOffset)
+{
+    uint32_t bits = (uint32_t)(bitOffset & 7);
+    if (bits) {
+        bs->position = (bitOffset >> 3) + 1;
+        bs->current = (uint32_t)(uint8_t)bs->original[bs->position - 1] << bits;
+        bs->nbBits = bits;
+    } else {
+        bs->position = bitOffset >> 3;
+        bs->current = bs->position ? (uint32_t)(uint8_t)bs->original[bs->position - 1] << 8 : 0;
+        bs->nbBits = 8;
+    }
+}
+
+/*get the bit offset of the next bit to read in memory read mode, the byte at
+  position - 1 is the current one and nbBits of it have been read.
+  returns false if the state is not a reading one*/
+static inline bool BS_GetReadBitOffset(GTS_BitStream *bs, uint64_t *bitOffset)
+{
+    if ((bs->nbBits > 8) || (!bs->position && (bs->nbBits != 8)))
+        return false;
+    *bitOffset = bs->position * 8 + bs->nbBits - 8;
+    return true;
+}
+
+/*read at most 32 bits in memory read mode with one word load instead of bit by bit.
+  returns false if the bits are not all in the buffer, nothing is read then*/
+static inline bool BS_ReadBitsFromWord(GTS_BitStream *bs, uint32_t nBits, uint32_t *value)
+{
+    uint64_t bitOffset = 0;
+    uint32_t window = 0;
+
+    if (!nBits) {
+        *value = 0;
+        return true;
+    }
+    if (!BS_GetReadBitOffset(bs, &bitOffset))
+        return false;
+    if (bitOffset + nBits > bs->size * 8)
+        return false;
+    if (!BS_LoadBits(bs, bitOffset, &window))
+        return false;
+
+    *value = window >> (32 - nBits);
+    BS_SetReadBitOffset(bs, bitOffset + nBits);
+    return true;
+}
+
 uint32_t gts_bs_read_int(GTS_BitStream *bs, uint32_t nBits)
 {
     uint32_t ret = 0;
+    if ((bs->bsmode == GTS_BITSTREAM_READ) && (nBits <= 32)) {
+        if (BS_ReadBitsFromWord(bs, nBits, &ret))
+            return ret;
+    }
     while (nBits-- > 0) {
         ret <<= 1;
         ret |= gf_bs_read_bit(bs);
@@ -242,6 +350,49 @@ uint32_t gts_bs_read_int(GTS_BitStream *bs, uint32_t nBits)
     return ret;
 }
 
+uint32_t gts_bs_read_ue(GTS_BitStream *bs)
+{
+    uint32_t window = 0;
+    uint32_t leadingZeros = 0;
+    uint32_t flag = 0;
+    uint64_t bitOffset = 0;
+
+    /*count the leading zeros of the next 32 bits at once*/
+    if ((bs->bsmode == GTS_BITSTREAM_READ) && BS_GetReadBitOffset(bs, &bitOffset)) {
+        if (BS_LoadBits(bs, bitOffset, &window) && window) {
+            leadingZeros = BS_CountLeadingZeros(window);
+            if ((leadingZeros < 16) && (bitOffset + 2 * leadingZeros + 1 <= bs->size * 8)) {
+                BS_SetReadBitOffset(bs, bitOffset + 2 * leadingZeros + 1);
+                return (window >> (31 - 2 * leadingZeros)) - 1;
+            }
+            leadingZeros = 0;
+        }
+    }
+
+    /*skip the leading zeros byte by byte*/
+    while (1) {
+        flag = gts_bs_peek_bits(bs, 8, 0);
+        if (flag) break;
+        //check whether we still have data once the peek is done since we may have less than 8 data available
+        if (!gts_bs_available(bs)) {
+            return 0;
+        }
+        gts_bs_read_int(bs, 8);
+        leadingZeros += 8;
+    }
+    flag = BS_CountLeadingZeros(flag) - 24;
+    gts_bs_read_int(bs, flag);
+    leadingZeros += flag;
+    return gts_bs_read_int(bs, leadingZeros + 1) - 1;
+}
+
+int32_t gts_bs_read_se(GTS_BitStream *bs)
+{
+    uint32_t v = gts_bs_read_ue(bs);
+    if ((v & 0x1) == 0) return (int32_t)(0 - (v >> 1));
+    return (v + 1) >> 1;
+}
+
 uint32_t gts_bs_read_U32(GTS_BitStream *bs)
 {
     uint32_t ret;
@@ -263,11 +414,12 @@ uint64_t gts_bs_read_long_int(GTS_BitStream *bs, uint32_t nBits)
     if (nBits>64) {
         gts_bs_read_long_int(bs, nBits-64);
         ret = gts_bs_read_long_int(bs, 64);
+    } else if (nBits > 32) {
+        ret = gts_bs_read_int(bs, nBits - 32);
+        ret <<= 32;
+        ret |= gts_bs_read_int(bs, 32);
     } else {
-        while (nBits-- > 0) {
-            ret <<= 1;
-            ret |= gf_bs_read_bit(bs);
-        }
+        ret = gts_bs_read_int(bs, nBits);
     }
     return ret;
 }
@@ -376,43 +528,43 @@ static void BS_WriteByte(GTS_BitStream *bs, uint8_t val)
     bs->position += 1;
 }
 
-static void BS_WriteBit(GTS_BitStream *bs, uint32_t bit)
+/*write one byte of the rbsp, insert emulation_prevention_three_byte if needed*/
+static inline void BS_WriteRbspByte(GTS_BitStream *bs, uint8_t val)
 {
     const uint8_t emulation_prevention_three_byte = 0x03;
 
-    bs->current <<= 1;
-    bs->current |= bit;
-    if (++ bs->nbBits == 8) {
-        bs->nbBits = 0;
-
-        if((bs->zeroCount == 2) && ((uint8_t) bs->current < 4))
-        {
-            BS_WriteByte(bs, emulation_prevention_three_byte);
-            bs->zeroCount = 0;
-        }
-        bs->zeroCount = ((uint8_t) bs->current) == 0 ? bs->zeroCount+1 : 0;
-
-        BS_WriteByte(bs, (uint8_t) bs->current);
-        bs->current = 0;
+    if ((bs->zeroCount == 2) && (val < 4))
+    {
+        BS_WriteByte(bs, emulation_prevention_three_byte);
+        bs->zeroCount = 0;
     }
-}
+    bs->zeroCount = (val == 0) ? bs->zeroCount + 1 : 0;
 
+    BS_WriteByte(bs, val);
+}
 
 void gts_bs_write_int(GTS_BitStream *bs, int32_t _value, int32_t nBits)
 {
     if (!bs) return;
-    uint32_t value, nb_shift;
-    if (!nBits) return;
-    value = (uint32_t) _value;
-    nb_shift = sizeof (int32_t) * 8 - nBits;
-    if (nb_shift)
-        value <<= nb_shift;
+    uint64_t acc;
+    uint32_t total;
+    if (nBits <= 0) return;
+    /*the value is 32 bits, the extra high bits are zero*/
+    if (nBits > 32) {
+        gts_bs_write_int(bs, 0, nBits - 32);
+        nBits = 32;
+    }
 
-    while (--nBits >= 0) {
-        //but check value as signed
-        BS_WriteBit (bs, ((int32_t)value) < 0);
-        value <<= 1;
+    /*append the bits to the pending ones and output all complete bytes at once*/
+    acc = (uint64_t)(bs->current & ((1u << bs->nbBits) - 1));
+    acc = (acc << nBits) | ((uint64_t)(uint32_t)_value & ((1ULL << nBits) - 1));
+    total = bs->nbBits + (uint32_t)nBits;
+    while (total >= 8) {
+        total -= 8;
+        BS_WriteRbspByte(bs, (uint8_t)(acc >> total));
     }
+    bs->current = (uint32_t)(acc & ((1u << total) - 1));
+    bs->nbBits = total;
 }
 
 
@@ -710,7 +862,12 @@ uint32_t gts_bs_peek_bits(GTS_BitStream *bs, uint32_t numBits, uint64_t byte_off
     if (byte_offset) gts_bs_seek(bs, bs->position + byte_offset);
     ret = gts_bs_read_int(bs, numBits);
 
-    gts_bs_seek(bs, curPos);
+    /*memory mode only needs the state back, no seek is required*/
+    if (bs->bsmode == GTS_BITSTREAM_READ) {
+        bs->position = curPos;
+    } else {
+        gts_bs_seek(bs, curPos);
+    }
     bs->nbBits = curBits;
     bs->current = current;
     return ret;
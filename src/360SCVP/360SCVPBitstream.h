@@ -187,6 +187,24 @@ uint64_t gts_bs_available(GTS_BitStream *bs);
  */
 uint32_t gts_bs_read_int(GTS_BitStream *bs, uint32_t nBits);
 
+/*!
+ *    \brief Reads an unsigned Exp-Golomb coded integer, ue(v).
+ *
+ *    \param GTS_BitStream *bs   input  the target bitstream
+ *
+ *    \return uint32_t the integer value read.
+ */
+uint32_t gts_bs_read_ue(GTS_BitStream *bs);
+
+/*!
+ *    \brief Reads a signed Exp-Golomb coded integer, se(v).
+ *
+ *    \param GTS_BitStream *bs   input  the target bitstream
+ *
+ *    \return int32_t the integer value read.
+ */
+int32_t gts_bs_read_se(GTS_BitStream *bs);
+
 /*!
  *    \brief Reads a large integer coded on a number of bit bigger than 32.
  *
@@ -92,46 +92,14 @@ uint32_t gts_media_nalu_remove_emulation_bytes(const int8_t *src_buffer, int8_t
 }
 
 
-static uint8_t digits_of_agm[128] = {
-    8, 7, 6, 6, 5, 5, 5, 5,  4, 4, 4, 4, 4, 4, 4, 4,
-    3, 3, 3, 3, 3, 3, 3, 3,  3, 3, 3, 3, 3, 3, 3, 3,
-    2, 2, 2, 2, 2, 2, 2, 2,  2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2,  2, 2, 2, 2, 2, 2, 2, 2,
-    1, 1, 1, 1, 1, 1, 1, 1,  1, 1, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1,  1, 1, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1,  1, 1, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1,  1, 1, 1, 1, 1, 1, 1, 1
-};
-
 static uint32_t bs_get_ue(GTS_BitStream *gts_bitstream)
 {
-    uint8_t flag_c;
-    uint32_t data = 0, flag_r = 0;
-    while (1) {
-        flag_r = gts_bs_peek_bits(gts_bitstream, 8, 0);
-        if (flag_r) break;
-        //check whether we still have data once the peek is done since we may have less than 8 data available
-        if (!gts_bs_available(gts_bitstream)) {
-            //GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[AVC/HEVC] Not enough data in bitstream !!\n"));
-            return 0;
-        }
-        gts_bs_read_int(gts_bitstream, 8);
-        data += 8;
-    }
-    if (flag_r < 128)
-        flag_c = digits_of_agm[flag_r];
-    else
-        flag_c = 0;
-    gts_bs_read_int(gts_bitstream, flag_c);
-    data += flag_c;
-    return gts_bs_read_int(gts_bitstream, data + 1) - 1;
+    return gts_bs_read_ue(gts_bitstream);
 }
 
 static int32_t bs_get_se(GTS_BitStream *bs)
 {
-    uint32_t v = bs_get_ue(bs);
-    if ((v & 0x1) == 0) return (int32_t)(0 - (v >> 1));
-    return (v + 1) >> 1;
+    return gts_bs_read_se(bs);
 }
 
 uint32_t gts_media_nalu_is_start_code(GTS_BitStream *bs)
@@ -196,12 +196,23 @@ int32_t merge_header(GTS_BitStream *bs, oneStream_info* pSlice, uint8_t **pBitst
     //move to current address
     pBitstreamCur += bs->position - bs_position;
     pSlice->outputBufferLen += (uint32_t)(bs->position - bs_position);
-    bs_position = bs->position;
 
-    //copy slice data
-    memcpy_s(pBitstreamCur, nalsize[SLICE_DATA], pBufferSliceCur + specialLen, nalsize[SLICE_DATA]);
-    pBitstreamCur += nalsize[SLICE_DATA];
-    bs->position += nalsize[SLICE_DATA];
+    if (mergeStream->pOutputSpans)
+    {
+        // refer to the rewritten headers and the slice data in input bitstream
+        if (add_output_span(mergeStream->pOutputSpans, mergeStream->maxOutputSpansNum, &mergeStream->outputSpansNum,
+                (uint8_t*)bs->original + bs_position, (uint32_t)(bs->position - bs_position))
+            || add_output_span(mergeStream->pOutputSpans, mergeStream->maxOutputSpansNum, &mergeStream->outputSpansNum,
+                pBufferSliceCur + specialLen, nalsize[SLICE_DATA]))
+            return -1;
+    }
+    else
+    {
+        //copy slice data
+        memcpy_s(pBitstreamCur, nalsize[SLICE_DATA], pBufferSliceCur + specialLen, nalsize[SLICE_DATA]);
+        pBitstreamCur += nalsize[SLICE_DATA];
+        bs->position += nalsize[SLICE_DATA];
+    }
     pSlice->outputBufferLen += nalsize[SLICE_DATA];
     pBufferSliceCur += specialLen + nalsize[SLICE_DATA];
 
@@ -519,6 +530,14 @@ int32_t tile_merge_Process(param_mergeStream *mergeStreamParams, void* handle)
     }
 
     mergeStream->pOutputBitstream = mergeStreamParams->pOutputBitstream;
+    mergeStream->pOutputSpans = mergeStreamParams->pOutputSpans;
+    mergeStream->maxOutputSpansNum = mergeStreamParams->maxOutputSpansNum;
+    mergeStream->outputSpansNum = 0;
+    mergeStreamParams->outputSpansNum = 0;
+
+    // one span for the headers and one for the slice data of each tile and the stream header
+    if (mergeStream->pOutputSpans && mergeStream->maxOutputSpansNum < (uint32_t)(2 * (HR_ntile + LR_ntile + 1)))
+        return -1;
 
     // Get tiles merge solution
     int32_t err = get_merge_solution(mergeStream);
@@ -577,6 +596,7 @@ int32_t tile_merge_Process(param_mergeStream *mergeStreamParams, void* handle)
     }
     mergeStream->outputiledbistreamlen = outputBufferLen;
     mergeStreamParams->outputiledbistreamlen = mergeStream->outputiledbistreamlen;
+    mergeStreamParams->outputSpansNum = mergeStream->outputSpansNum;
 
     if (bs) gts_bs_del(bs);
 
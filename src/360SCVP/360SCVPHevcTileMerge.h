@@ -55,6 +55,9 @@ typedef struct HEVC_MERGEBITSTREAM
     int32_t        pic_height;
     int32_t       *slice_segment_address;
     bool           bWroteHeader;
+    Output_Span   *pOutputSpans;
+    uint32_t       maxOutputSpansNum;
+    uint32_t       outputSpansNum;
 }hevc_mergeStream;
 
 //modify resolution and tile segmentation
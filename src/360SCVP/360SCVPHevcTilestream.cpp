@@ -403,6 +403,28 @@ int32_t set_genHandle_params(oneStream_info* cur, param_oneStream_info* in)
     return 0;
 }
 
+int32_t add_output_span(Output_Span* pSpans, uint32_t maxSpansNum, uint32_t* pSpansNum, const uint8_t* pData, uint32_t dataLen)
+{
+    if (!pSpans || !pSpansNum || !pData)
+        return GTS_BAD_PARAM;
+    if (!dataLen)
+        return 0;
+
+    uint32_t spansNum = *pSpansNum;
+    if (spansNum && (pSpans[spansNum - 1].pData + pSpans[spansNum - 1].dataLen == pData))
+    {
+        pSpans[spansNum - 1].dataLen += dataLen;
+        return 0;
+    }
+    if (spansNum >= maxSpansNum)
+        return GTS_BAD_PARAM;
+
+    pSpans[spansNum].pData = pData;
+    pSpans[spansNum].dataLen = dataLen;
+    *pSpansNum = spansNum + 1;
+    return 0;
+}
+
 void*   genTiledStream_Init(param_gen_tiledStream* pParamGenTiledStream)
 {
     if (!pParamGenTiledStream)
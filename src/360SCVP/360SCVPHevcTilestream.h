@@ -84,6 +84,9 @@ typedef struct HEVC_GEN_TILEDSTREAM
 
     oneStream_info      **pTiledBitstreams;
     uint8_t              *pOutputTiledBitstream;
+    Output_Span          *pOutputSpans;          // scatter/gather output mode if not NULL
+    uint32_t              maxOutputSpansNum;
+    uint32_t              outputSpansNum;
     nal_info             *pNalInfo;
     int32_t               parseType;
     hevc_specialInfo      specialInfo;
@@ -98,4 +101,6 @@ int32_t set_genHandle_params(oneStream_info* cur, param_oneStream_info* in);
 int32_t parse_tiles_info(hevc_gen_tiledstream* pGenTilesStream);
 int32_t hevc_import_ffextradata(hevc_specialInfo* pSpecialInfo, HEVCState* hevc, uint32_t *pSize, int32_t *spsCnt, int32_t *audCnt, int32_t bParse);
 int32_t parse_hevc_specialinfo(hevc_specialInfo* pSpecialInfo, HEVCState* hevc, uint32_t* nalsize, uint32_t* specialLen, int32_t* spsCnt, int32_t bParse);
+// append one span to the span array, the span is combined with the last one if they are continuous
+int32_t add_output_span(Output_Span* pSpans, uint32_t maxSpansNum, uint32_t* pSpansNum, const uint8_t* pData, uint32_t dataLen);
 #endif
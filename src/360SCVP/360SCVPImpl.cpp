@@ -970,6 +970,15 @@ int32_t TstitchStream::uninit()
     }
     if(m_pViewport)
         ret |= genViewport_unInit(m_pViewport);
+    {
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        for (uint32_t i = 0; i < m_batchViewports.size(); i++)
+        {
+            ret |= genViewport_unInit(m_batchViewports[i]->pViewport);
+            SAFE_DELETE(m_batchViewports[i]);
+        }
+        m_batchViewports.clear();
+    }
     if (m_pSteamStitch)
         ret |= genTiledStream_unInit(m_pSteamStitch);
     SAFE_DELETE_ARRAY(m_pOutTile);
@@ -1285,6 +1294,132 @@ int32_t TstitchStream::getTilesByLegacyWay(TileDef* pOutTile)
     return ret;
 }
 
+int32_t TstitchStream::enableTileSelectionLUT(float yawStep, float pitchStep, bool bBuildAll)
+{
+    if (m_pTileSelection || !m_pViewport) {
+        SCVP_LOG(LOG_WARNING, "Tile selection LUT is only supported by the built-in viewport tile selection\n");
+        return ERROR_INVALID;
+    }
+    return genViewport_enableTileSelectionLUT(m_pViewport, yawStep, pitchStep, bBuildAll);
+}
+
+int32_t TstitchStream::saveTileSelectionLUT(const char* fileName)
+{
+    if (!m_pViewport)
+        return ERROR_INVALID;
+    return genViewport_saveTileSelectionLUT(m_pViewport, fileName);
+}
+
+int32_t TstitchStream::loadTileSelectionLUT(const char* fileName)
+{
+    if (!m_pViewport)
+        return ERROR_INVALID;
+    return genViewport_loadTileSelectionLUT(m_pViewport, fileName);
+}
+
+int32_t TstitchStream::getTilesLayout(TileDef* pOutTile, int32_t maxTileNum)
+{
+    if (m_pTileSelection || !m_pViewport)
+        return -1;
+    return genViewport_getTilesLayout(m_pViewport, pOutTile, maxTileNum);
+}
+
+BatchViewport* TstitchStream::acquireBatchViewport()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        if (!m_batchViewports.empty())
+        {
+            BatchViewport *pBatchViewport = m_batchViewports.back();
+            m_batchViewports.pop_back();
+            return pBatchViewport;
+        }
+    }
+
+    // the instance is initialized with the same parameters as m_pViewport,
+    // so it gets the same viewport size and selects the same tiles
+    BatchViewport *pBatchViewport = new BatchViewport;
+    if (!pBatchViewport)
+        return NULL;
+    memcpy_s(&pBatchViewport->viewportParam, sizeof(generateViewPortParam), &m_pViewportParam, sizeof(generateViewPortParam));
+    pBatchViewport->viewportParam.m_pUpLeft = pBatchViewport->upLeft;
+    pBatchViewport->viewportParam.m_pDownRight = pBatchViewport->downRight;
+    pBatchViewport->pViewport = genViewport_Init(&pBatchViewport->viewportParam);
+    if (!pBatchViewport->pViewport)
+    {
+        SAFE_DELETE(pBatchViewport);
+        return NULL;
+    }
+    return pBatchViewport;
+}
+
+void TstitchStream::releaseBatchViewport(BatchViewport* pBatchViewport)
+{
+    if (!pBatchViewport)
+        return;
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    m_batchViewports.push_back(pBatchViewport);
+}
+
+int32_t TstitchStream::selectTilesForPoses(TilesSelectionBatch* pBatch)
+{
+    if (!pBatch || !pBatch->pPoses || !pBatch->pTilesBitsets)
+        return OMAF_ERROR_NULL_PTR;
+    if (m_pTileSelection || !m_pViewport) {
+        SCVP_LOG(LOG_WARNING, "Batched tile selection is only supported by the built-in viewport tile selection\n");
+        return ERROR_INVALID;
+    }
+
+    int32_t tileNum = genViewport_getTilesLayout(m_pViewport, NULL, 0);
+    if (pBatch->posesNum <= 0 || tileNum <= 0 || pBatch->bitsetWords < (tileNum + 63) / 64)
+        return ERROR_BAD_PARAM;
+
+    BatchViewport *pBatchViewport = acquireBatchViewport();
+    if (!pBatchViewport)
+        return ERROR_MEMORY;
+
+    int32_t ret = ERROR_NONE;
+    int32_t bitsetWords = pBatch->bitsetWords;
+    for (int32_t i = 0; i < pBatch->posesNum; i++)
+    {
+        uint64_t *pBitset = pBatch->pTilesBitsets + i * bitsetWords;
+        genViewport_setViewPort(pBatchViewport->pViewport, pBatch->pPoses[i].yaw, pBatch->pPoses[i].pitch);
+        if (genViewport_postprocess(&pBatchViewport->viewportParam, pBatchViewport->pViewport))
+        {
+            ret = ERROR_INVALID;
+            break;
+        }
+        int32_t selectedNum = genViewport_getTilesBitset(pBatchViewport->pViewport, pBitset, bitsetWords);
+        if (selectedNum < 0)
+        {
+            ret = ERROR_INVALID;
+            break;
+        }
+        if (pBatch->pSelectedTilesNum)
+            pBatch->pSelectedTilesNum[i] = selectedNum;
+    }
+    releaseBatchViewport(pBatchViewport);
+    if (ret != ERROR_NONE)
+        return ret;
+
+    for (int32_t word = 0; word < bitsetWords; word++)
+    {
+        uint64_t unionBits = 0;
+        uint64_t intersectionBits = ~0ULL;
+        for (int32_t i = 0; i < pBatch->posesNum; i++)
+        {
+            uint64_t bits = pBatch->pTilesBitsets[i * bitsetWords + word];
+            unionBits |= bits;
+            intersectionBits &= bits;
+        }
+        if (pBatch->pUnionBitset)
+            pBatch->pUnionBitset[word] = unionBits;
+        if (pBatch->pIntersectionBitset)
+            pBatch->pIntersectionBitset[word] = intersectionBits;
+    }
+    return ERROR_NONE;
+}
+
 int32_t TstitchStream::setViewPort(HeadPose *pose)
 {
     int32_t ret = 0;
@@ -1303,8 +1438,20 @@ int32_t TstitchStream::doMerge(param_360SCVP* pParamStitchStream)
     int32_t ret = 0;
     if (pParamStitchStream == NULL)
         return -1;
+
+    // in scatter/gather output mode the rewritten headers are written into
+    // the output buffer of this call directly, and there is no frame copy
+    uint8_t *pMergeOutput = m_mergeStreamParam.pOutputBitstream;
+    m_mergeStreamParam.pOutputSpans = pParamStitchStream->pOutputSpans;
+    m_mergeStreamParam.maxOutputSpansNum = pParamStitchStream->maxOutputSpansNum;
+    m_mergeStreamParam.outputSpansNum = 0;
+    if (pParamStitchStream->pOutputSpans)
+        m_mergeStreamParam.pOutputBitstream = pParamStitchStream->pOutputBitstream;
+
     ret = tile_merge_Process(&m_mergeStreamParam, m_pMergeStream);
 
+    m_mergeStreamParam.pOutputBitstream = pMergeOutput;
+    pParamStitchStream->outputSpansNum = m_mergeStreamParam.outputSpansNum;
     if (ret < 0)
         return -1;
     hevc_mergeStream *mergeStream = (hevc_mergeStream *)m_pMergeStream;
@@ -1330,7 +1477,8 @@ int32_t TstitchStream::doMerge(param_360SCVP* pParamStitchStream)
     if(GenerateRwpkInfo(&m_dstRwpk) == 0)
         ret = EncRWPKSEI(&m_dstRwpk, pParamStitchStream->pOutputSEI, &pParamStitchStream->outputSEILen);
     pParamStitchStream->outputBitstreamLen = m_mergeStreamParam.outputiledbistreamlen;
-    memcpy_s(pParamStitchStream->pOutputBitstream, m_mergeStreamParam.outputiledbistreamlen, m_mergeStreamParam.pOutputBitstream, m_mergeStreamParam.outputiledbistreamlen);
+    if (!pParamStitchStream->pOutputSpans)
+        memcpy_s(pParamStitchStream->pOutputBitstream, m_mergeStreamParam.outputiledbistreamlen, m_mergeStreamParam.pOutputBitstream, m_mergeStreamParam.outputiledbistreamlen);
 
     return ret;
 }
@@ -1834,8 +1982,12 @@ int32_t  TstitchStream::doStreamStitch(param_360SCVP* pParamStitchStream)
     }
 
     pGenTilesStream->pOutputTiledBitstream = pParamStitchStream->pOutputBitstream;
+    pGenTilesStream->pOutputSpans = pParamStitchStream->pOutputSpans;
+    pGenTilesStream->maxOutputSpansNum = pParamStitchStream->maxOutputSpansNum;
+    pGenTilesStream->outputSpansNum = 0;
 
     ret = merge_partstream_into1bitstream(pParamStitchStream->inputBitstreamLen);
+    pParamStitchStream->outputSpansNum = pGenTilesStream->outputSpansNum;
 
   //  int32_t tiled_idx = 0;
     input_count = 0;
@@ -1895,6 +2047,7 @@ int32_t TstitchStream::merge_one_tile(uint8_t **pBitstream, oneStream_info* pSli
 
     memset_s(nalsize, sizeof(nalsize), 0);
     uint64_t bs_position = bs->position;
+    uint64_t bs_entry = bs->position;
     int32_t spsCnt;
     parse_hevc_specialinfo(&specialInfo, hevc, nalsize, &specialLen, &spsCnt, 0);
 
@@ -1967,10 +2120,25 @@ int32_t TstitchStream::merge_one_tile(uint8_t **pBitstream, oneStream_info* pSli
     pBitstreamCur += bs->position - bs_position;
     bs_position = bs->position;
 
-    //copy slice data
-    memcpy_s(pBitstreamCur, nalsize[SLICE_DATA], pBufferSliceCur + specialLen, nalsize[SLICE_DATA]);
-    pBitstreamCur += nalsize[SLICE_DATA];
-    bs->position += nalsize[SLICE_DATA];
+    if (pGenTilesStream->pOutputSpans)
+    {
+        // refer to the rewritten headers and the slice data in input
+        // bitstream, the slice data isn't written into the output
+        uint8_t *pHeaderStart = (uint8_t*)bs->original + bs_entry;
+        if (add_output_span(pGenTilesStream->pOutputSpans, pGenTilesStream->maxOutputSpansNum,
+                &pGenTilesStream->outputSpansNum, pHeaderStart, (uint32_t)(bs->position - bs_entry))
+            || add_output_span(pGenTilesStream->pOutputSpans, pGenTilesStream->maxOutputSpansNum,
+                &pGenTilesStream->outputSpansNum, pBufferSliceCur + specialLen, nalsize[SLICE_DATA]))
+            return GTS_BAD_PARAM;
+        pSlice->outputBufferLen += nalsize[SLICE_DATA];
+    }
+    else
+    {
+        //copy slice data
+        memcpy_s(pBitstreamCur, nalsize[SLICE_DATA], pBufferSliceCur + specialLen, nalsize[SLICE_DATA]);
+        pBitstreamCur += nalsize[SLICE_DATA];
+        bs->position += nalsize[SLICE_DATA];
+    }
     pBufferSliceCur += specialLen + nalsize[SLICE_DATA];
 
     pSlice->currentTileIdx++;
@@ -2003,6 +2171,14 @@ int32_t TstitchStream::merge_partstream_into1bitstream(int32_t totalInputLen)
 
     parse_tiles_info(pGenTilesStream);
 
+    // one span for the headers and one for the slice data of each tile
+    if (pGenTilesStream->pOutputSpans && pGenTilesStream->maxOutputSpansNum
+        < (uint32_t)(2 * pGenTilesStream->outTilesHeightCount * pGenTilesStream->outTilesWidthCount))
+    {
+        gts_bs_del(bs);
+        return GTS_BAD_PARAM;
+    }
+
     for (int32_t i = 0; i < pGenTilesStream->outTilesHeightCount; i++)
     {
         for (int32_t j = 0; j < pGenTilesStream->outTilesWidthCount; j++)
@@ -2027,6 +2203,11 @@ int32_t TstitchStream::merge_partstream_into1bitstream(int32_t totalInputLen)
             if (bs) bspos = bs->position;
             bool bFirstTile = (bool)((i == 0 && j == 0) == 1 ? 1 : 0);
             int32_t curframesize = merge_one_tile(&pBitstreamCur, pSliceCur, bs, bFirstTile);
+            if (curframesize < 0)
+            {
+                gts_bs_del(bs);
+                return curframesize;
+            }
             pSliceCur->curBufferLen += curframesize;
             pSliceCur->outputBufferLen += (uint32_t)(bs->position - bspos);
         }
@@ -29,6 +29,8 @@
 #include "../utils/data_type.h"
 #include "TileSelectionPlugins_API.h"
 #include "360SCVPViewportImpl.h"
+#include <mutex>
+#include <vector>
 
 #define MAX_TILE_NUM 1000
 //!
@@ -45,6 +47,20 @@ typedef struct MapFaceInfo
     E_TransformType transformType; //face transform type
 }MapFaceInfo;
 
+//!
+//! \struct: BatchViewport
+//! \brief:  one viewport instance for the batched tile selection, it
+//!          has its own selection state, so several batched selections
+//!          on the same handle don't touch each other
+//!
+typedef struct BatchViewport
+{
+    void                  *pViewport;
+    generateViewPortParam  viewportParam;
+    point                  upLeft[6];
+    point                  downRight[6];
+}BatchViewport;
+
 class TstitchStream
 {
 protected:
@@ -157,6 +173,11 @@ public:
     int32_t  getContentCoverage(CCDef* pOutCC);
     TileDef* getSelectedTile();
     int32_t  getTilesByLegacyWay(TileDef* pOutTile);
+    int32_t  enableTileSelectionLUT(float yawStep, float pitchStep, bool bBuildAll);
+    int32_t  saveTileSelectionLUT(const char* fileName);
+    int32_t  loadTileSelectionLUT(const char* fileName);
+    int32_t  getTilesLayout(TileDef* pOutTile, int32_t maxTileNum);
+    int32_t  selectTilesForPoses(TilesSelectionBatch* pBatch);
     int32_t  SetLogCallBack(LogFunction logFunction);
 
 protected:
@@ -165,6 +186,8 @@ protected:
     int32_t merge_partstream_into1bitstream(int32_t totalInputLen);
     int32_t ConvertTilesIdx(uint16_t tilesNum);
     int32_t initTileInfo(param_360SCVP* pParamStitchStream);
+    BatchViewport* acquireBatchViewport();
+    void releaseBatchViewport(BatchViewport* pBatchViewport);
 
 private:
     void* m_pluginLibHdl;
@@ -173,6 +196,8 @@ private:
     bool  m_bNeedPlugin;
     ITileInfo* m_tilesInfo;
     MapFaceInfo* m_mapFaceInfo;
+    std::mutex   m_batchMutex;
+    std::vector<BatchViewport*> m_batchViewports; //idle viewport instances for the batched tile selection
 };// END CLASS DEFINITION
 
 #endif // _360SCVP_IMPL_H_
@@ -57,6 +57,9 @@ typedef struct PARAM_MERGEBITSTREAM
     uint8_t               *pOutputBitstream;       //!< pointer to output bitstream
     uint32_t               outputiledbistreamlen;  //!< length of output bitstream
     bool                   bWroteHeader;           //!< flag for whether Headers need to be wrote
+    Output_Span           *pOutputSpans;           //!< span array for scatter/gather output, slice data isn't copied if not NULL
+    uint32_t               maxOutputSpansNum;      //!< size of span array
+    uint32_t               outputSpansNum;         //!< number of spans describing the merged stream
 }param_mergeStream;
 
 //!
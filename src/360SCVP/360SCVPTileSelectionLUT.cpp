@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     360SCVPTileSelectionLUT.cpp
+    \brief    pose quantized look up table of the tile selection
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include "360SCVPTileSelectionLUT.h"
+#include "360SCVPViewPort.h"
+#include "360SCVPViewportImpl.h"
+#include "360SCVPLog.h"
+#include "../utils/error.h"
+
+TileSelectionLUT::TileSelectionLUT()
+{
+    memset(&m_config, 0, sizeof(TileSelectionLUTConfig));
+    m_yawNum = 0;
+    m_pitchNum = 0;
+    m_entriesNum = 0;
+    m_tilesNum = 0;
+    m_wordsPerEntry = 0;
+}
+
+TileSelectionLUT::~TileSelectionLUT()
+{
+}
+
+int32_t TileSelectionLUT::init(TileSelectionLUTConfig& config)
+{
+    if (config.yawStep <= 0 || config.yawStep > ERP_HORZ_ANGLE ||
+        config.pitchStep <= 0 || config.pitchStep > ERP_VERT_ANGLE ||
+        config.faceNum <= 0 || config.faceNum > FACE_NUMBER ||
+        !config.tileNumRow || !config.tileNumCol)
+        return ERROR_BAD_PARAM;
+
+    m_config = config;
+    // the cells are spread evenly, so the steps are adjusted to divide the ranges.
+    // Both ends of the yaw range have their cells, since the region selection
+    // isn't the same at yaw -180 and 180
+    m_yawNum = (uint32_t)(ERP_HORZ_ANGLE / config.yawStep + 0.5) + 1;
+    m_pitchNum = (uint32_t)(ERP_VERT_ANGLE / config.pitchStep + 0.5) + 1;
+    m_entriesNum = m_yawNum * m_pitchNum;
+    m_tilesNum = config.faceNum * config.tileNumRow * config.tileNumCol;
+    m_wordsPerEntry = (m_tilesNum + 63) >> 6;
+
+    m_valid.assign(m_entriesNum, 0);
+    m_tileBits.assign((size_t)m_entriesNum * m_wordsPerEntry, 0);
+    m_boxes.assign((size_t)m_entriesNum * FACE_NUMBER * 2, TileSelectionBox());
+    SCVP_LOG(LOG_INFO, "Tile selection LUT with %d x %d entries is created\n", m_yawNum, m_pitchNum);
+    return ERROR_NONE;
+}
+
+uint32_t TileSelectionLUT::getEntryIdx(float yaw, float pitch, float *pQuantYaw, float *pQuantPitch)
+{
+    double yawStep = (double)ERP_HORZ_ANGLE / (m_yawNum - 1);
+    double pitchStep = (double)ERP_VERT_ANGLE / (m_pitchNum - 1);
+
+    // wrap the yaw out of [-180, 180] into the range
+    double yawOffset = yaw - ERP_HORZ_START;
+    if (yawOffset < 0 || yawOffset > ERP_HORZ_ANGLE)
+    {
+        yawOffset = fmod(yawOffset, (double)ERP_HORZ_ANGLE);
+        if (yawOffset < 0)
+            yawOffset += ERP_HORZ_ANGLE;
+    }
+    int32_t yawIdx = (int32_t)floor(yawOffset / yawStep + 0.5);
+    if (yawIdx >= (int32_t)m_yawNum)
+        yawIdx = m_yawNum - 1;
+    int32_t pitchIdx = (int32_t)floor((pitch + ERP_VERT_ANGLE / 2) / pitchStep + 0.5);
+    if (pitchIdx < 0)
+        pitchIdx = 0;
+    if (pitchIdx >= (int32_t)m_pitchNum)
+        pitchIdx = m_pitchNum - 1;
+
+    uint32_t entryIdx = pitchIdx * m_yawNum + yawIdx;
+    getEntryPose(entryIdx, pQuantYaw, pQuantPitch);
+    return entryIdx;
+}
+
+void TileSelectionLUT::getEntryPose(uint32_t entryIdx, float *pYaw, float *pPitch)
+{
+    double yawStep = (double)ERP_HORZ_ANGLE / (m_yawNum - 1);
+    double pitchStep = (double)ERP_VERT_ANGLE / (m_pitchNum - 1);
+    if (pYaw)
+        *pYaw = (float)((entryIdx % m_yawNum) * yawStep + ERP_HORZ_START);
+    if (pPitch)
+        *pPitch = (float)((entryIdx / m_yawNum) * pitchStep - ERP_VERT_ANGLE / 2);
+}
+
+void TileSelectionLUT::store(uint32_t entryIdx, const ITileInfo *pTileInfo, const SPos *pUpLeft, const SPos *pDownRight)
+{
+    if (entryIdx >= m_entriesNum || !pTileInfo || !pUpLeft || !pDownRight)
+        return;
+
+    uint64_t *pBits = &m_tileBits[(size_t)entryIdx * m_wordsPerEntry];
+    for (uint32_t i = 0; i < m_wordsPerEntry; i++)
+        pBits[i] = 0;
+    for (uint32_t i = 0; i < m_tilesNum; i++)
+    {
+        if (pTileInfo[i].isOccupy)
+            pBits[i >> 6] |= (1ULL << (i & 63));
+    }
+
+    TileSelectionBox *pBox = &m_boxes[(size_t)entryIdx * FACE_NUMBER * 2];
+    for (int32_t i = 0; i < FACE_NUMBER; i++)
+    {
+        pBox[2 * i].faceIdx = pUpLeft[i].faceIdx;
+        pBox[2 * i].x = pUpLeft[i].x;
+        pBox[2 * i].y = pUpLeft[i].y;
+        pBox[2 * i + 1].faceIdx = pDownRight[i].faceIdx;
+        pBox[2 * i + 1].x = pDownRight[i].x;
+        pBox[2 * i + 1].y = pDownRight[i].y;
+    }
+    m_valid[entryIdx] = 1;
+}
+
+void TileSelectionLUT::restore(uint32_t entryIdx, ITileInfo *pTileInfo, SPos *pUpLeft, SPos *pDownRight)
+{
+    if (!isValid(entryIdx) || !pTileInfo || !pUpLeft || !pDownRight)
+        return;
+
+    uint32_t tilesPerFace = m_config.tileNumRow * m_config.tileNumCol;
+    for (uint32_t i = 0; i < m_tilesNum; i++)
+    {
+        pTileInfo[i].isOccupy = isOccupied(entryIdx, i) ? 1 : 0;
+        // cube map region selection marks the face only on the occupied tiles
+        if (m_config.geoType == SVIDEO_CUBEMAP)
+            pTileInfo[i].faceId = pTileInfo[i].isOccupy ? (int32_t)(i / tilesPerFace) : -1;
+    }
+
+    TileSelectionBox *pBox = &m_boxes[(size_t)entryIdx * FACE_NUMBER * 2];
+    for (int32_t i = 0; i < FACE_NUMBER; i++)
+    {
+        pUpLeft[i].faceIdx = pBox[2 * i].faceIdx;
+        pUpLeft[i].x = pBox[2 * i].x;
+        pUpLeft[i].y = pBox[2 * i].y;
+        pDownRight[i].faceIdx = pBox[2 * i + 1].faceIdx;
+        pDownRight[i].x = pBox[2 * i + 1].x;
+        pDownRight[i].y = pBox[2 * i + 1].y;
+    }
+}
+
+int32_t TileSelectionLUT::save(const char *fileName)
+{
+    if (!fileName || !m_entriesNum)
+        return ERROR_BAD_PARAM;
+
+    FILE *fp = fopen(fileName, "wb");
+    if (!fp)
+    {
+        SCVP_LOG(LOG_ERROR, "Failed to open %s to save tile selection LUT\n", fileName);
+        return ERROR_INVALID;
+    }
+
+    uint64_t magic = TILE_SELECTION_LUT_MAGIC;
+    uint32_t version = TILE_SELECTION_LUT_VERSION;
+    uint32_t validNum = 0;
+    for (uint32_t i = 0; i < m_entriesNum; i++)
+        validNum += m_valid[i];
+
+    bool bOk = fwrite(&magic, sizeof(magic), 1, fp) == 1 &&
+               fwrite(&version, sizeof(version), 1, fp) == 1 &&
+               fwrite(&m_config, sizeof(TileSelectionLUTConfig), 1, fp) == 1 &&
+               fwrite(&validNum, sizeof(validNum), 1, fp) == 1;
+    for (uint32_t i = 0; bOk && i < m_entriesNum; i++)
+    {
+        if (!m_valid[i])
+            continue;
+        bOk = fwrite(&i, sizeof(i), 1, fp) == 1 &&
+              fwrite(&m_tileBits[(size_t)i * m_wordsPerEntry], sizeof(uint64_t), m_wordsPerEntry, fp) == m_wordsPerEntry;
+        TileSelectionBox *pBox = &m_boxes[(size_t)i * FACE_NUMBER * 2];
+        for (int32_t j = 0; bOk && j < FACE_NUMBER * 2; j++)
+        {
+            bOk = fwrite(&pBox[j].faceIdx, sizeof(int32_t), 1, fp) == 1 &&
+                  fwrite(&pBox[j].x, sizeof(POSType), 1, fp) == 1 &&
+                  fwrite(&pBox[j].y, sizeof(POSType), 1, fp) == 1;
+        }
+    }
+    fclose(fp);
+
+    if (!bOk)
+    {
+        SCVP_LOG(LOG_ERROR, "Failed to write tile selection LUT into %s\n", fileName);
+        return ERROR_INVALID;
+    }
+    return ERROR_NONE;
+}
+
+int32_t TileSelectionLUT::load(const char *fileName)
+{
+    if (!fileName || !m_entriesNum)
+        return ERROR_BAD_PARAM;
+
+    FILE *fp = fopen(fileName, "rb");
+    if (!fp)
+    {
+        SCVP_LOG(LOG_ERROR, "Failed to open %s to load tile selection LUT\n", fileName);
+        return ERROR_INVALID;
+    }
+
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint32_t validNum = 0;
+    TileSelectionLUTConfig config;
+    memset(&config, 0, sizeof(TileSelectionLUTConfig));
+    bool bOk = fread(&magic, sizeof(magic), 1, fp) == 1 &&
+               fread(&version, sizeof(version), 1, fp) == 1 &&
+               fread(&config, sizeof(TileSelectionLUTConfig), 1, fp) == 1 &&
+               fread(&validNum, sizeof(validNum), 1, fp) == 1;
+    if (!bOk || magic != TILE_SELECTION_LUT_MAGIC || version != TILE_SELECTION_LUT_VERSION)
+    {
+        SCVP_LOG(LOG_ERROR, "%s isn't one tile selection LUT file\n", fileName);
+        fclose(fp);
+        return ERROR_PARSE;
+    }
+    if (config.geoType != m_config.geoType || config.faceNum != m_config.faceNum ||
+        config.tileNumRow != m_config.tileNumRow || config.tileNumCol != m_config.tileNumCol ||
+        config.inputWidth != m_config.inputWidth || config.inputHeight != m_config.inputHeight ||
+        config.hFOV != m_config.hFOV || config.vFOV != m_config.vFOV)
+    {
+        SCVP_LOG(LOG_ERROR, "The tile selection LUT in %s is built for another projection, tile grid or FOV\n", fileName);
+        fclose(fp);
+        return ERROR_BAD_PARAM;
+    }
+
+    TileSelectionLUTConfig curConfig = m_config;
+    if (init(config) != ERROR_NONE || validNum > m_entriesNum)
+    {
+        fclose(fp);
+        init(curConfig);
+        return ERROR_PARSE;
+    }
+    for (uint32_t i = 0; bOk && i < validNum; i++)
+    {
+        uint32_t entryIdx = 0;
+        bOk = fread(&entryIdx, sizeof(entryIdx), 1, fp) == 1 && entryIdx < m_entriesNum &&
+              fread(&m_tileBits[(size_t)entryIdx * m_wordsPerEntry], sizeof(uint64_t), m_wordsPerEntry, fp) == m_wordsPerEntry;
+        if (!bOk)
+            break;
+        TileSelectionBox *pBox = &m_boxes[(size_t)entryIdx * FACE_NUMBER * 2];
+        for (int32_t j = 0; bOk && j < FACE_NUMBER * 2; j++)
+        {
+            bOk = fread(&pBox[j].faceIdx, sizeof(int32_t), 1, fp) == 1 &&
+                  fread(&pBox[j].x, sizeof(POSType), 1, fp) == 1 &&
+                  fread(&pBox[j].y, sizeof(POSType), 1, fp) == 1;
+        }
+        m_valid[entryIdx] = bOk ? 1 : 0;
+    }
+    fclose(fp);
+
+    if (!bOk)
+    {
+        SCVP_LOG(LOG_ERROR, "The tile selection LUT in %s is truncated\n", fileName);
+        init(curConfig);
+        return ERROR_PARSE;
+    }
+    return ERROR_NONE;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     360SCVPTileSelectionLUT.h
+    \brief    pose quantized look up table of the tile selection (header)
+*/
+
+#ifndef __360SCVP_TILESELECTIONLUT__
+#define __360SCVP_TILESELECTIONLUT__
+
+#include <stdint.h>
+#include <vector>
+#include "360SCVPGeometry.h"
+
+struct ITileInfo;
+
+//! the magic number at the beginning of the serialized table, "SCVPTLUT"
+#define TILE_SELECTION_LUT_MAGIC   0x54554C5450564353ULL
+#define TILE_SELECTION_LUT_VERSION 1
+
+//!
+//! \brief  the configuration the table is built for, a serialized table
+//!         is only accepted when it matches the configuration of the handle
+//!
+struct TileSelectionLUTConfig
+{
+    int32_t  geoType;
+    int32_t  faceNum;
+    uint32_t tileNumRow;
+    uint32_t tileNumCol;
+    int32_t  inputWidth;
+    int32_t  inputHeight;
+    float    hFOV;
+    float    vFOV;
+    float    yawStep;
+    float    pitchStep;
+};
+
+//!
+//! \brief  the bounding box of the viewport on one face, same as SPos
+//!         without the unused z
+//!
+struct TileSelectionBox
+{
+    int32_t faceIdx;
+    POSType x;
+    POSType y;
+};
+
+//!
+//! \class  TileSelectionLUT
+//! \brief  maps the quantized (yaw, pitch) to the occupied tiles and the
+//!         viewport bounding boxes got from the region selection at the
+//!         center of the quantization cell. The FOV and the tile grid are
+//!         fixed for one table. Entries are filled lazily on the first
+//!         lookup of the cell, or all together by the offline build
+//!
+class TileSelectionLUT
+{
+public:
+    TileSelectionLUT();
+    ~TileSelectionLUT();
+
+    //!
+    //! \brief  allocate the table for the configuration, all entries are empty
+    //!
+    int32_t init(TileSelectionLUTConfig& config);
+
+    //!
+    //! \brief  get the entry index of the pose and the pose at the center
+    //!         of its quantization cell
+    //!
+    uint32_t getEntryIdx(float yaw, float pitch, float *pQuantYaw, float *pQuantPitch);
+
+    //!
+    //! \brief  get the pose at the center of the quantization cell of the entry
+    //!
+    void getEntryPose(uint32_t entryIdx, float *pYaw, float *pPitch);
+
+    uint32_t getEntriesNum() { return m_entriesNum; }
+    bool isValid(uint32_t entryIdx) { return entryIdx < m_entriesNum && m_valid[entryIdx]; }
+    TileSelectionLUTConfig& getConfig() { return m_config; }
+
+    //!
+    //! \brief  store the occupied flags of all tiles and the bounding boxes
+    //!         of the FACE_NUMBER faces into the entry
+    //!
+    void store(uint32_t entryIdx, const ITileInfo *pTileInfo, const SPos *pUpLeft, const SPos *pDownRight);
+
+    //!
+    //! \brief  restore the entry into the tiles and the bounding boxes, which
+    //!         are the same as the region selection sets for the pose
+    //!
+    void restore(uint32_t entryIdx, ITileInfo *pTileInfo, SPos *pUpLeft, SPos *pDownRight);
+
+    //!
+    //! \brief  get whether the tile is occupied in the entry
+    //!
+    bool isOccupied(uint32_t entryIdx, uint32_t tileIdx)
+    {
+        return (m_tileBits[entryIdx * m_wordsPerEntry + (tileIdx >> 6)] >> (tileIdx & 63)) & 1;
+    }
+
+    //!
+    //! \brief  write the filled entries into the file
+    //!
+    int32_t save(const char *fileName);
+
+    //!
+    //! \brief  read the table from the file, the grid, FOV and projection in
+    //!         the file must match the configuration the table is inited with,
+    //!         while the quantization steps are taken from the file
+    //!
+    int32_t load(const char *fileName);
+
+private:
+    TileSelectionLUTConfig        m_config;
+    uint32_t                      m_yawNum;
+    uint32_t                      m_pitchNum;
+    uint32_t                      m_entriesNum;
+    uint32_t                      m_tilesNum;
+    uint32_t                      m_wordsPerEntry;
+    std::vector<uint8_t>          m_valid;
+    std::vector<uint64_t>         m_tileBits;
+    std::vector<TileSelectionBox> m_boxes;
+};
+
+#endif // __360SCVP_TILESELECTIONLUT__
@@ -115,3 +115,222 @@ void ViewPort::map3DTo2D(SPos *,SPos *)
     assert(0 && "Viewport 3D to 2D is not supported ");
 }
 
+
+void ViewPort::initMappingTables()
+{
+    int32_t iWidth = m_sVideoInfo.iFaceWidth;
+    int32_t iHeight = m_sVideoInfo.iFaceHeight;
+    int32_t *pRot = m_sVideoInfo.sVideoRotation.degree;
+
+    // K has no skew, so x2 only depends on the column and y2 only on the row
+    m_colX.resize(iWidth);
+    m_rowY.resize(iHeight);
+    for (int32_t i = 0; i < iWidth; i++)
+        m_colX[i] = m_matInvK[0][0]*(i+(POSType)(0.5)) + m_matInvK[0][2];
+    for (int32_t j = 0; j < iHeight; j++)
+        m_rowY[j] = m_matInvK[1][1]*(j+(POSType)(0.5)) + m_matInvK[1][2];
+
+    for (int32_t k = 0; k < 3; k++)
+    {
+        m_bRotAxis[k] = (pRot[k] != 0);
+        m_rotCos[k] = scos((POSType)(pRot[k]*S_PI/180.0));
+        m_rotSin[k] = ssin((POSType)(pRot[k]*S_PI/180.0));
+    }
+
+    m_rowPosX.resize(iWidth);
+    m_rowPosY.resize(iWidth);
+    m_rowPosZ.resize(iWidth);
+}
+
+void ViewPort::mapRowTo3D(int32_t j, int32_t iStart, int32_t iEnd)
+{
+    const POSType (*R)[3] = m_matRotMatx;
+    const POSType *pColX = m_colX.data();
+    POSType *pOutX = m_rowPosX.data();
+    POSType *pOutY = m_rowPosY.data();
+    POSType *pOutZ = m_rowPosZ.data();
+    POSType y2 = m_rowY[j];
+
+    // same arithmetic as map2DTo3D and rotate3D, written without branches
+    // and virtual calls in the inner loop so that it can be vectorized
+    for (int32_t i = iStart; i < iEnd; i++)
+    {
+        POSType x2 = pColX[i];
+        POSType z1 = 1/ssqrt(x2*x2+y2*y2+1);
+        POSType x1 = z1*x2;
+        POSType y1 = z1*y2;
+        pOutX[i] = R[0][0]*x1 + R[0][1]*y1 + R[0][2]*z1;
+        pOutY[i] = R[1][0]*x1 + R[1][1]*y1 + R[1][2]*z1;
+        pOutZ[i] = R[2][0]*x1 + R[2][1]*y1 + R[2][2]*z1;
+    }
+
+    if (m_bRotAxis[0])
+    {
+        for (int32_t i = iStart; i < iEnd; i++)
+        {
+            POSType t1 = m_rotCos[0]*pOutY[i] - m_rotSin[0]*pOutZ[i];
+            POSType t2 = m_rotSin[0]*pOutY[i] + m_rotCos[0]*pOutZ[i];
+            pOutY[i] = t1;
+            pOutZ[i] = t2;
+        }
+    }
+    if (m_bRotAxis[1])
+    {
+        for (int32_t i = iStart; i < iEnd; i++)
+        {
+            POSType t1 = m_rotCos[1]*pOutX[i] + m_rotSin[1]*pOutZ[i];
+            POSType t2 = -m_rotSin[1]*pOutX[i] + m_rotCos[1]*pOutZ[i];
+            pOutX[i] = t1;
+            pOutZ[i] = t2;
+        }
+    }
+    if (m_bRotAxis[2])
+    {
+        for (int32_t i = iStart; i < iEnd; i++)
+        {
+            POSType t1 = m_rotCos[2]*pOutX[i] - m_rotSin[2]*pOutY[i];
+            POSType t2 = m_rotSin[2]*pOutX[i] + m_rotCos[2]*pOutY[i];
+            pOutX[i] = t1;
+            pOutY[i] = t2;
+        }
+    }
+}
+
+void ViewPort::mapPixelToSrc(int32_t i, int32_t j, Geometry *pGeoSrc, SPos *pPos)
+{
+    mapRowTo3D(j, i, i + 1);
+    SPos pos3D(0, m_rowPosX[i], m_rowPosY[i], m_rowPosZ[i]);
+    pGeoSrc->map3DTo2D(&pos3D, pPos);
+}
+
+void ViewPort::updateBoundingBox(int32_t faceSlot, SPos& sPos)
+{
+    SPos *pUpLeftTmp = m_upLeft + faceSlot;
+    SPos *pDownRightTmp = m_downRight + faceSlot;
+    int32_t yTmp = (int32_t)sPos.y;
+    int32_t xTmp = (int32_t)sPos.x;
+    if (pUpLeftTmp->x > xTmp)
+        pUpLeftTmp->x = xTmp;
+    if (pUpLeftTmp->y > yTmp)
+        pUpLeftTmp->y = yTmp;
+    if (pDownRightTmp->x < xTmp)
+        pDownRightTmp->x = xTmp;
+    if (pDownRightTmp->y < yTmp)
+        pDownRightTmp->y = yTmp;
+    pUpLeftTmp->faceIdx = sPos.faceIdx;
+    pDownRightTmp->faceIdx = sPos.faceIdx;
+}
+
+void ViewPort::cubeMapMapping(Geometry *pGeoSrc)
+{
+    int32_t iWidth = m_sVideoInfo.iFaceWidth;
+    int32_t iHeight = m_sVideoInfo.iFaceHeight;
+
+    // the viewport plane to one cube face is a homography and the part of the
+    // plane which goes to one face is convex, so when the four corners of one
+    // block go to the same face, the whole block does, and its extreme x/y on
+    // that face are reached at the corners
+    for (int32_t y0 = 0; y0 < iHeight; y0 += VIEWPORT_MAPPING_BLOCK)
+    {
+        int32_t y1 = (y0 + VIEWPORT_MAPPING_BLOCK < iHeight) ? (y0 + VIEWPORT_MAPPING_BLOCK - 1) : (iHeight - 1);
+        for (int32_t x0 = 0; x0 < iWidth; x0 += VIEWPORT_MAPPING_BLOCK)
+        {
+            int32_t x1 = (x0 + VIEWPORT_MAPPING_BLOCK < iWidth) ? (x0 + VIEWPORT_MAPPING_BLOCK - 1) : (iWidth - 1);
+            SPos corner[4];
+            mapPixelToSrc(x0, y0, pGeoSrc, &corner[0]);
+            mapPixelToSrc(x1, y0, pGeoSrc, &corner[1]);
+            mapPixelToSrc(x0, y1, pGeoSrc, &corner[2]);
+            mapPixelToSrc(x1, y1, pGeoSrc, &corner[3]);
+            if (corner[0].faceIdx == corner[1].faceIdx &&
+                corner[0].faceIdx == corner[2].faceIdx &&
+                corner[0].faceIdx == corner[3].faceIdx)
+            {
+                for (int32_t k = 0; k < 4; k++)
+                    updateBoundingBox(corner[k].faceIdx, corner[k]);
+                continue;
+            }
+
+            // the block crosses a face edge, map all of its pixels
+            for (int32_t j = y0; j <= y1; j++)
+            {
+                mapRowTo3D(j, x0, x1 + 1);
+                for (int32_t i = x0; i <= x1; i++)
+                {
+                    SPos pos3D(0, m_rowPosX[i], m_rowPosY[i], m_rowPosZ[i]);
+                    pGeoSrc->map3DTo2D(&pos3D, &pos3D);
+                    updateBoundingBox(pos3D.faceIdx, pos3D);
+                }
+            }
+        }
+    }
+}
+
+void ViewPort::equiRectMapping(Geometry *pGeoSrc)
+{
+    int32_t iWidth = m_sVideoInfo.iFaceWidth;
+    int32_t iHeight = m_sVideoInfo.iFaceHeight;
+    int32_t nNextAreaX = iWidth + m_iMarginX;
+
+    // the erp boundary handling depends on the scan order, so all pixels are
+    // mapped in the same order as Geometry::geometryMapping
+    for (int32_t j = 0; j < iHeight; j++)
+    {
+        mapRowTo3D(j, 0, iWidth);
+        for (int32_t i = 0; i < iWidth; i++)
+        {
+            SPos pos3D(0, m_rowPosX[i], m_rowPosY[i], m_rowPosZ[i]);
+            pGeoSrc->map3DTo2D(&pos3D, &pos3D);
+            if ((int32_t)pos3D.x == 0 && i != 0)
+            {
+                nNextAreaX = i;
+                break;
+            }
+            updateBoundingBox(pos3D.faceIdx, pos3D);
+        }
+    }
+
+    // the viewport crosses the erp boundary, the right part goes to the second box
+    if (nNextAreaX != (iWidth + m_iMarginX))
+    {
+        for (int32_t j = 0; j < iHeight; j++)
+        {
+            mapRowTo3D(j, nNextAreaX, iWidth);
+            for (int32_t i = nNextAreaX; i < iWidth; i++)
+            {
+                SPos pos3D(0, m_rowPosX[i], m_rowPosY[i], m_rowPosZ[i]);
+                pGeoSrc->map3DTo2D(&pos3D, &pos3D);
+                updateBoundingBox(1, pos3D);
+            }
+        }
+    }
+}
+
+void ViewPort::geometryMapping(Geometry *pGeoSrc)
+{
+    GeometryType srcType = pGeoSrc->getType();
+    if (m_bConvOutputPaddingNeeded || m_sVideoInfo.iNumFaces != 1 ||
+        (srcType != SVIDEO_CUBEMAP && srcType != SVIDEO_EQUIRECT))
+    {
+        Geometry::geometryMapping(pGeoSrc);
+        return;
+    }
+
+    assert(!m_bGeometryMapping);
+    setRotMat();
+    setInvK();
+    initMappingTables();
+
+    if (srcType == SVIDEO_CUBEMAP)
+        cubeMapMapping(pGeoSrc);
+    else
+        equiRectMapping(pGeoSrc);
+
+    SPos *pUpLeftTmp = m_upLeft;
+    for (int32_t i = 0; i < FACE_NUMBER; i++)
+    {
+        if (pUpLeftTmp->faceIdx >= 0)
+            m_numFaces++;
+        pUpLeftTmp++;
+    }
+    m_bGeometryMapping = true;
+}
@@ -27,6 +27,7 @@
 #ifndef __360SCVP_VIEWPORT__
 #define __360SCVP_VIEWPORT__
 #include "360SCVPGeometry.h"
+#include <vector>
 
 #define FACE_NUMBER 6
 #define ERP_HORZ_ANGLE 360
@@ -39,6 +40,8 @@
 #define RAD2DEG_FACTOR (PI_IN_DEGREE/S_PI)
 #define HORZ_BOUNDING_STEP 5
 #define VERT_BOUNDING_STEP 5
+//! block size in pixels of the sampled viewport mapping for the cube map source
+#define VIEWPORT_MAPPING_BLOCK 16
 
 // ====================================================================================================================
 // Class definition
@@ -50,6 +53,25 @@ private:
     POSType m_matRotMatx[3][3];
     POSType m_matInvK[3][3];
 
+    //! the per column and per row terms of the inverse K matrix product
+    std::vector<POSType> m_colX;
+    std::vector<POSType> m_rowY;
+    //! cos and sin of the video rotation around x/y/z axis, computed once per mapping
+    bool    m_bRotAxis[3];
+    POSType m_rotCos[3];
+    POSType m_rotSin[3];
+    //! the 3D positions of one row, laid out per component for vectorizing
+    std::vector<POSType> m_rowPosX;
+    std::vector<POSType> m_rowPosY;
+    std::vector<POSType> m_rowPosZ;
+
+    void initMappingTables();
+    void mapRowTo3D(int32_t j, int32_t iStart, int32_t iEnd);
+    void mapPixelToSrc(int32_t i, int32_t j, Geometry *pGeoSrc, SPos *pPos);
+    void updateBoundingBox(int32_t faceSlot, SPos& sPos);
+    void cubeMapMapping(Geometry *pGeoSrc);
+    void equiRectMapping(Geometry *pGeoSrc);
+
 public:
     ViewPort(SVideoInfo& sVideoInfo);
     virtual ~ViewPort();
@@ -60,6 +82,15 @@ public:
     void setRotMat();
     void setInvK();
     void matInv(POSType[3][3]);
+
+    //!
+    //! \brief  compute the bounding box of the viewport on each source face.
+    //!         The same boxes as Geometry::geometryMapping are generated, while
+    //!         the rotation is computed once, the inverse K product is split
+    //!         into per column and per row terms, and for the cube map source
+    //!         only the corners of the blocks which lie in one face are mapped
+    //!
+    virtual void geometryMapping(Geometry *pGeoSrc);
 };
 
 #endif // __T360SCVP_GEOMETRY__
@@ -133,6 +133,38 @@ int32_t   genViewport_postprocess(generateViewPortParam* pParamGenViewport, void
 //!
 int32_t genViewport_setViewPort(void* pGenHandle, float yaw, float pitch);
 
+//!
+//! \brief    This function enables the pose quantized tile selection look up table.
+//!
+//! \param    void*  pGenHandle,        input, which is created by the genTiledStream_Init function
+//! \param    float  yawStep,           input, the quantization step of yaw in degree
+//! \param    float  pitchStep,         input, the quantization step of pitch in degree
+//! \param    bool   bBuildAll,         input, fill all entries now, or fill each at its first use
+//!
+//! \return   s32, the status of the function.
+//!           0,     if succeed
+//!           not 0, if fail
+//!
+int32_t genViewport_enableTileSelectionLUT(void* pGenHandle, float yawStep, float pitchStep, bool bBuildAll);
+
+//!
+//! \brief    This function writes the tile selection look up table into the file.
+//!
+//! \return   s32, the status of the function.
+//!           0,     if succeed
+//!           not 0, if fail
+//!
+int32_t genViewport_saveTileSelectionLUT(void* pGenHandle, const char* fileName);
+
+//!
+//! \brief    This function reads the tile selection look up table from the file.
+//!
+//! \return   s32, the status of the function.
+//!           0,     if succeed
+//!           not 0, if fail
+//!
+int32_t genViewport_loadTileSelectionLUT(void* pGenHandle, const char* fileName);
+
 //!
 //! \brief    This function sets the maxmimum selected tile number for the viewPort.
 //!
@@ -185,6 +217,29 @@ int32_t genViewport_getFixedNumTiles(void* pGenHandle, TileDef* pOutTile);
 //!
 int32_t genViewport_getTilesInViewport(void* pGenHandle, TileDef* pOutTile);
 
+//!
+//! \brief    This function outputs all tiles of the source, the tile idx is its index in the tile bitset
+//!
+//! \param    void*      pGenHandle,     input,  which is created by the genTiledStream_Init function
+//! \param    TileDef*   pOutTile,       output, the list for all the tiles, it can be NULL
+//! \param    int32_t    maxTileNum,     input,  the size of pOutTile
+//!
+//! \return   int32_t, the number of all the tiles.
+//!
+int32_t genViewport_getTilesLayout(void* pGenHandle, TileDef* pOutTile, int32_t maxTileNum);
+
+//!
+//! \brief    This function outputs the selected tiles of the current viewport as bitset, bit n is set
+//!           when the tile whose idx is n is selected
+//!
+//! \param    void*      pGenHandle,     input,  which is created by the genTiledStream_Init function
+//! \param    uint64_t*  pBitset,        output, the tiles bitset
+//! \param    int32_t    bitsetWords,    input,  the uint64_t words number of pBitset
+//!
+//! \return   int32_t, the number of the tiles inside the viewport.
+//!
+int32_t genViewport_getTilesBitset(void* pGenHandle, uint64_t* pBitset, int32_t bitsetWords);
+
 //!
 //! \brief    This function output the fixed number tiles according to the viewPort information in the initialization phase,
 //!           especially these tiles are put in the original picture order.
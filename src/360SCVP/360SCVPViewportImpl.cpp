@@ -264,13 +264,7 @@ int32_t   genViewport_postprocess(generateViewPortParam* pParamGenViewport, void
     TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
     if (!cTAppConvCfg || !pParamGenViewport)
         return -1;
-    cTAppConvCfg->CalculateViewportBoundaryPoints();
-    if (cTAppConvCfg->m_sourceSVideoInfo.geoType == E_SVIDEO_EQUIRECT)
-        cTAppConvCfg->ERPSelectRegion(pParamGenViewport->m_iInputWidth, pParamGenViewport->m_iInputHeight, pParamGenViewport->m_viewportDestWidth, pParamGenViewport->m_viewportDestHeight);
-    else if (cTAppConvCfg->m_sourceSVideoInfo.geoType == E_SVIDEO_CUBEMAP)
-        cTAppConvCfg->cubemapSelectRegion();
-    else
-        SCVP_LOG(LOG_WARNING, "Not support projection mode %d\n", cTAppConvCfg->m_sourceSVideoInfo.geoType);
+    cTAppConvCfg->selectRegion(pParamGenViewport->m_iInputWidth, pParamGenViewport->m_iInputHeight, pParamGenViewport->m_viewportDestWidth, pParamGenViewport->m_viewportDestHeight);
 
     pParamGenViewport->m_numFaces = cTAppConvCfg->m_numFaces;
     point* pTmpUpleftDst = pParamGenViewport->m_pUpLeft;
@@ -308,6 +302,30 @@ int32_t genViewport_setMaxSelTiles(void* pGenHandle, int32_t maxSelTiles)
     return 0;
 
 }
+int32_t genViewport_enableTileSelectionLUT(void* pGenHandle, float yawStep, float pitchStep, bool bBuildAll)
+{
+    TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
+    if (!cTAppConvCfg)
+        return -1;
+    return cTAppConvCfg->enableTileSelectionLUT(yawStep, pitchStep, bBuildAll);
+}
+
+int32_t genViewport_saveTileSelectionLUT(void* pGenHandle, const char* fileName)
+{
+    TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
+    if (!cTAppConvCfg)
+        return -1;
+    return cTAppConvCfg->saveTileSelectionLUT(fileName);
+}
+
+int32_t genViewport_loadTileSelectionLUT(void* pGenHandle, const char* fileName)
+{
+    TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
+    if (!cTAppConvCfg)
+        return -1;
+    return cTAppConvCfg->loadTileSelectionLUT(fileName);
+}
+
 int32_t genViewport_setViewPort(void* pGenHandle, float yaw, float pitch)
 {
     TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
@@ -540,6 +558,56 @@ int32_t genViewport_getTilesInViewport(void* pGenHandle, TileDef* pOutTile)
     return tileNum;
 }
 
+int32_t genViewport_getTilesLayout(void* pGenHandle, TileDef* pOutTile, int32_t maxTileNum)
+{
+    TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
+    if (!cTAppConvCfg)
+        return -1;
+
+    int32_t faceNum = (cTAppConvCfg->m_sourceSVideoInfo.geoType == SVIDEO_CUBEMAP) ? 6 : 1;
+    int32_t tileNum = faceNum * cTAppConvCfg->m_tileNumCol * cTAppConvCfg->m_tileNumRow;
+    if (!pOutTile)
+        return tileNum;
+    if (maxTileNum < tileNum)
+        return -1;
+
+    int32_t tilesPerFace = cTAppConvCfg->m_tileNumCol * cTAppConvCfg->m_tileNumRow;
+    for (int32_t idx = 0; idx < tileNum; idx++)
+    {
+        memset_s(&pOutTile[idx], sizeof(TileDef), 0);
+        // same face id as the one output by genViewport_getTilesInViewport
+        pOutTile[idx].faceId = cubeMapFaceMap[idx / tilesPerFace];
+        pOutTile[idx].x = cTAppConvCfg->m_srd[idx].x;
+        pOutTile[idx].y = cTAppConvCfg->m_srd[idx].y;
+        pOutTile[idx].idx = idx;
+    }
+    return tileNum;
+}
+
+int32_t genViewport_getTilesBitset(void* pGenHandle, uint64_t* pBitset, int32_t bitsetWords)
+{
+    TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
+    if (!cTAppConvCfg || !pBitset)
+        return -1;
+
+    int32_t faceNum = (cTAppConvCfg->m_sourceSVideoInfo.geoType == SVIDEO_CUBEMAP) ? 6 : 1;
+    int32_t tileNum = faceNum * cTAppConvCfg->m_tileNumCol * cTAppConvCfg->m_tileNumRow;
+    if (bitsetWords < (tileNum + 63) / 64)
+        return -1;
+
+    memset_s(pBitset, bitsetWords * sizeof(uint64_t), 0);
+    int32_t selectedNum = 0;
+    for (int32_t idx = 0; idx < tileNum; idx++)
+    {
+        if (cTAppConvCfg->m_srd[idx].isOccupy == 1)
+        {
+            pBitset[idx >> 6] |= (1ULL << (idx & 63));
+            selectedNum++;
+        }
+    }
+    return selectedNum;
+}
+
 int32_t genViewport_getViewportTiles(void* pGenHandle, TileDef* pOutTile)
 {
     TgenViewport* cTAppConvCfg = (TgenViewport*)(pGenHandle);
@@ -729,6 +797,7 @@ TgenViewport::TgenViewport()
     m_srd = NULL;
     m_pViewportHorizontalBoundaryPoints = NULL;
     m_pViewportVerticalBoundaryPoints = NULL;
+    m_pTileSelLUT = NULL;
     m_paramVideoFP.cols = 0;
     m_paramVideoFP.rows = 0;
 }
@@ -757,6 +826,7 @@ TgenViewport::TgenViewport(TgenViewport& src)
     m_srd = NULL;
     m_pViewportHorizontalBoundaryPoints = NULL;
     m_pViewportVerticalBoundaryPoints = NULL;
+    m_pTileSelLUT = NULL;
     m_paramVideoFP.cols = src.m_paramVideoFP.cols;
     m_paramVideoFP.rows = src.m_paramVideoFP.rows;
 }
@@ -768,6 +838,7 @@ TgenViewport::~TgenViewport()
     SAFE_DELETE_ARRAY(m_srd);
     SAFE_DELETE_ARRAY(m_pViewportHorizontalBoundaryPoints);
     SAFE_DELETE_ARRAY(m_pViewportVerticalBoundaryPoints);
+    SAFE_DELETE(m_pTileSelLUT);
 }
 
 TgenViewport& TgenViewport::operator=(const TgenViewport& src)
@@ -831,6 +902,7 @@ void TgenViewport::destroy()
     SAFE_DELETE_ARRAY(m_srd);
     SAFE_DELETE_ARRAY(m_pViewportHorizontalBoundaryPoints);
     SAFE_DELETE_ARRAY(m_pViewportVerticalBoundaryPoints);
+    SAFE_DELETE(m_pTileSelLUT);
 }
 
 
@@ -2264,6 +2336,117 @@ int32_t TgenViewport::cubemapSelectRegion()
     return selectedTilesNum;
 }
 
+int32_t TgenViewport::selectRegionAtPose(short inputWidth, short inputHeight, short dstWidth, short dstHeight)
+{
+    CalculateViewportBoundaryPoints();
+    if (m_sourceSVideoInfo.geoType == E_SVIDEO_EQUIRECT)
+        ERPSelectRegion(inputWidth, inputHeight, dstWidth, dstHeight);
+    else if (m_sourceSVideoInfo.geoType == E_SVIDEO_CUBEMAP)
+        cubemapSelectRegion();
+    else
+    {
+        SCVP_LOG(LOG_WARNING, "Not support projection mode %d\n", m_sourceSVideoInfo.geoType);
+        return ERROR_BAD_PARAM;
+    }
+    return ERROR_NONE;
+}
+
+int32_t TgenViewport::selectRegion(short inputWidth, short inputHeight, short dstWidth, short dstHeight)
+{
+    if (!m_pTileSelLUT)
+        return selectRegionAtPose(inputWidth, inputHeight, dstWidth, dstHeight);
+
+    float fYaw = m_codingSVideoInfo.viewPort.fYaw;
+    float fPitch = m_codingSVideoInfo.viewPort.fPitch;
+    float quantYaw = 0;
+    float quantPitch = 0;
+    uint32_t entryIdx = m_pTileSelLUT->getEntryIdx(fYaw, fPitch, &quantYaw, &quantPitch);
+    if (m_pTileSelLUT->isValid(entryIdx))
+    {
+        m_pTileSelLUT->restore(entryIdx, m_srd, m_pUpLeft, m_pDownRight);
+        return ERROR_NONE;
+    }
+
+    // the entry is filled with the selection at the center of the cell,
+    // so all poses inside the cell get the same tiles
+    m_codingSVideoInfo.viewPort.fYaw = quantYaw;
+    m_codingSVideoInfo.viewPort.fPitch = quantPitch;
+    int32_t ret = selectRegionAtPose(inputWidth, inputHeight, dstWidth, dstHeight);
+    m_codingSVideoInfo.viewPort.fYaw = fYaw;
+    m_codingSVideoInfo.viewPort.fPitch = fPitch;
+    if (ret != ERROR_NONE)
+        return ret;
+
+    m_pTileSelLUT->store(entryIdx, m_srd, m_pUpLeft, m_pDownRight);
+    return ERROR_NONE;
+}
+
+int32_t TgenViewport::enableTileSelectionLUT(float yawStep, float pitchStep, bool bBuildAll)
+{
+    if (m_sourceSVideoInfo.geoType != SVIDEO_EQUIRECT && m_sourceSVideoInfo.geoType != SVIDEO_CUBEMAP)
+    {
+        SCVP_LOG(LOG_WARNING, "Tile selection LUT only supports ERP and Cubemap, projection mode is %d\n", m_sourceSVideoInfo.geoType);
+        return ERROR_BAD_PARAM;
+    }
+
+    TileSelectionLUTConfig config;
+    config.geoType = m_sourceSVideoInfo.geoType;
+    config.faceNum = (m_sourceSVideoInfo.geoType == SVIDEO_CUBEMAP) ? 6 : 1;
+    config.tileNumRow = m_tileNumRow;
+    config.tileNumCol = m_tileNumCol;
+    config.inputWidth = m_iInputWidth;
+    config.inputHeight = m_iInputHeight;
+    config.hFOV = m_codingSVideoInfo.viewPort.hFOV;
+    config.vFOV = m_codingSVideoInfo.viewPort.vFOV;
+    config.yawStep = yawStep;
+    config.pitchStep = pitchStep;
+
+    TileSelectionLUT *pLUT = new TileSelectionLUT;
+    int32_t ret = pLUT->init(config);
+    if (ret != ERROR_NONE)
+    {
+        SAFE_DELETE(pLUT);
+        return ret;
+    }
+    SAFE_DELETE(m_pTileSelLUT);
+    m_pTileSelLUT = pLUT;
+
+    if (!bBuildAll)
+        return ERROR_NONE;
+
+    float fYaw = m_codingSVideoInfo.viewPort.fYaw;
+    float fPitch = m_codingSVideoInfo.viewPort.fPitch;
+    for (uint32_t entryIdx = 0; entryIdx < m_pTileSelLUT->getEntriesNum(); entryIdx++)
+    {
+        m_pTileSelLUT->getEntryPose(entryIdx, &m_codingSVideoInfo.viewPort.fYaw, &m_codingSVideoInfo.viewPort.fPitch);
+        ret = selectRegionAtPose(m_iInputWidth, m_iInputHeight, m_iCodingFaceWidth, m_iCodingFaceHeight);
+        if (ret != ERROR_NONE)
+            break;
+        m_pTileSelLUT->store(entryIdx, m_srd, m_pUpLeft, m_pDownRight);
+    }
+    m_codingSVideoInfo.viewPort.fYaw = fYaw;
+    m_codingSVideoInfo.viewPort.fPitch = fPitch;
+    if (ret != ERROR_NONE)
+        return ret;
+
+    // leave the selection of the current pose, same as before building
+    return selectRegion(m_iInputWidth, m_iInputHeight, m_iCodingFaceWidth, m_iCodingFaceHeight);
+}
+
+int32_t TgenViewport::saveTileSelectionLUT(const char* fileName)
+{
+    if (!m_pTileSelLUT)
+        return ERROR_INVALID;
+    return m_pTileSelLUT->save(fileName);
+}
+
+int32_t TgenViewport::loadTileSelectionLUT(const char* fileName)
+{
+    if (!m_pTileSelLUT)
+        return ERROR_INVALID;
+    return m_pTileSelLUT->load(fileName);
+}
+
 int32_t TgenViewport::calcTilesInViewport(ITileInfo* pTileInfo, int32_t tileCol, int32_t tileRow)
 {
     if (!pTileInfo)
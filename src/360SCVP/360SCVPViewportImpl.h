@@ -28,6 +28,7 @@
 
 #include "360SCVPAPI.h"
 #include "360SCVPGeometry.h"
+#include "360SCVPTileSelectionLUT.h"
 
 #include <sstream>
 #include <vector>
@@ -125,6 +126,7 @@ public:
     Param_VideoFPStruct m_paramVideoFP;
     SpherePoint   *m_pViewportHorizontalBoundaryPoints;
     SpherePoint   *m_pViewportVerticalBoundaryPoints;
+    TileSelectionLUT *m_pTileSelLUT;                                ///< pose quantized tile selection table, NULL if disabled
     inline int32_t round(POSType t) { return (int32_t)(t+ (t>=0? 0.5 :-0.5)); }
 
 public:
@@ -147,8 +149,29 @@ public:
     int32_t  CalculateViewportBoundaryPoints();
     int32_t  CubemapCalcTilesGrid();
     int32_t  getContentCoverage(CCDef* pOutCC, int32_t coverageShapeType);
+    /* selectRegion: select the tiles for the current pose, which is    *
+     *               looked up in the tile selection LUT when enabled   *
+     *    Return:                                                       *
+     *        Error code                                                */
+    int32_t  selectRegion(short inputWidth, short inputHeight, short dstWidth, short dstHeight);
+    /* enableTileSelectionLUT: select tiles through the pose quantized  *
+     *                         look up table from now on                *
+     *    Param:                                                        *
+     *        yawStep:   The quantization step of yaw in degree         *
+     *        pitchStep: The quantization step of pitch in degree       *
+     *        bBuildAll: Fill all entries now, or lazily at first use   *
+     *    Return:                                                       *
+     *        Error code                                                */
+    int32_t  enableTileSelectionLUT(float yawStep, float pitchStep, bool bBuildAll);
+    int32_t  saveTileSelectionLUT(const char* fileName);
+    int32_t  loadTileSelectionLUT(const char* fileName);
 
 private:
+    /* selectRegionAtPose: calculate the boundary and select the tiles  *
+     *                     for the current pose without the LUT         *
+     *    Return:                                                       *
+     *        Error code                                                */
+    int32_t  selectRegionAtPose(short inputWidth, short inputHeight, short dstWidth, short dstHeight);
     /* calculateLongitudeFromThita:                              *
      *    Param:                                                 *
      *        Latti: Point spherial lattitude                    *
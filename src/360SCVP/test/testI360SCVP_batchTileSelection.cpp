@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <thread>
+#include <vector>
+#include "../360SCVPAPI.h"
+#include "testI360SCVP_tileSelectionCommon.h"
+
+#include "../../utils/safe_mem.h"
+#include "../../utils/error.h"
+
+namespace{
+class I360SCVPTest_batchTileSelection : public I360SCVPTest_tileSelection {
+public:
+    void initPoses()
+    {
+        poses.clear();
+        for (float yaw = -170; yaw <= 180; yaw += 50)
+        {
+            for (float pitch = -60; pitch <= 60; pitch += 30)
+            {
+                HeadPose pose;
+                memset_s(&pose, sizeof(HeadPose), 0);
+                pose.yaw = yaw;
+                pose.pitch = pitch;
+                poses.push_back(pose);
+            }
+        }
+    }
+
+    // the bitset of each pose is expected to be the tiles selected by the single pose functions
+    void checkBitsets(void* pRef, const std::vector<uint64_t>& bitsets, int32_t bitsetWords, const std::vector<TileDef>& layout)
+    {
+        int32_t tilesNum = layout.size();
+        for (uint32_t i = 0; i < poses.size(); i++)
+        {
+            TileDef refTiles[1024];
+            Param_ViewportOutput refOutput;
+            std::vector<uint64_t> refBitset(bitsetWords, 0);
+            I360SCVP_setViewPort(pRef, poses[i].yaw, poses[i].pitch);
+            int32_t refNum = I360SCVP_getTilesInViewport(refTiles, &refOutput, pRef);
+            ASSERT_TRUE(refNum > 0);
+            for (int32_t j = 0; j < refNum; j++)
+            {
+                ASSERT_TRUE(refTiles[j].idx >= 0 && refTiles[j].idx < tilesNum);
+                EXPECT_EQ(refTiles[j].x, layout[refTiles[j].idx].x);
+                EXPECT_EQ(refTiles[j].y, layout[refTiles[j].idx].y);
+                EXPECT_EQ(refTiles[j].faceId, layout[refTiles[j].idx].faceId);
+                refBitset[refTiles[j].idx >> 6] |= (1ULL << (refTiles[j].idx & 63));
+            }
+            for (int32_t word = 0; word < bitsetWords; word++)
+            {
+                EXPECT_EQ(refBitset[word], bitsets[i * bitsetWords + word]) << "yaw " << poses[i].yaw << " pitch " << poses[i].pitch;
+            }
+        }
+    }
+
+    void checkBatch()
+    {
+        void* pRef = I360SCVP_Init(&param);
+        void* pBatch = I360SCVP_Init(&param);
+        ASSERT_TRUE(pRef != NULL);
+        ASSERT_TRUE(pBatch != NULL);
+
+        int32_t tilesNum = I360SCVP_GetTilesLayout(pBatch, NULL, 0);
+        ASSERT_TRUE(tilesNum > 0);
+        std::vector<TileDef> layout(tilesNum);
+        EXPECT_EQ(I360SCVP_GetTilesLayout(pBatch, layout.data(), tilesNum), tilesNum);
+        for (int32_t i = 0; i < tilesNum; i++)
+            EXPECT_EQ(layout[i].idx, i);
+
+        // the current viewport of the handle is kept by the batched selection
+        TileDef beforeTiles[1024];
+        TileDef afterTiles[1024];
+        Param_ViewportOutput output;
+        I360SCVP_setViewPort(pBatch, 30, 10);
+        int32_t beforeNum = I360SCVP_getTilesInViewport(beforeTiles, &output, pBatch);
+
+        initPoses();
+        int32_t bitsetWords = (tilesNum + 63) / 64;
+        std::vector<uint64_t> bitsets(poses.size() * bitsetWords, 0);
+        std::vector<uint64_t> unionBitset(bitsetWords, 0);
+        std::vector<uint64_t> intersectionBitset(bitsetWords, 0);
+        std::vector<int32_t> selectedNum(poses.size(), 0);
+        TilesSelectionBatch batch;
+        batch.pPoses = poses.data();
+        batch.posesNum = poses.size();
+        batch.bitsetWords = bitsetWords;
+        batch.pTilesBitsets = bitsets.data();
+        batch.pUnionBitset = unionBitset.data();
+        batch.pIntersectionBitset = intersectionBitset.data();
+        batch.pSelectedTilesNum = selectedNum.data();
+        EXPECT_EQ(I360SCVP_SelectTilesForPoses(pBatch, &batch), ERROR_NONE);
+
+        checkBitsets(pRef, bitsets, bitsetWords, layout);
+        for (int32_t word = 0; word < bitsetWords; word++)
+        {
+            uint64_t unionBits = 0;
+            uint64_t intersectionBits = ~0ULL;
+            for (uint32_t i = 0; i < poses.size(); i++)
+            {
+                unionBits |= bitsets[i * bitsetWords + word];
+                intersectionBits &= bitsets[i * bitsetWords + word];
+            }
+            EXPECT_EQ(unionBits, unionBitset[word]);
+            EXPECT_EQ(intersectionBits, intersectionBitset[word]);
+        }
+        for (uint32_t i = 0; i < poses.size(); i++)
+        {
+            int32_t bitsNum = 0;
+            for (int32_t word = 0; word < bitsetWords; word++)
+                bitsNum += __builtin_popcountll(bitsets[i * bitsetWords + word]);
+            EXPECT_EQ(bitsNum, selectedNum[i]);
+        }
+
+        int32_t afterNum = I360SCVP_getTilesInViewport(afterTiles, &output, pBatch);
+        ASSERT_EQ(beforeNum, afterNum);
+        for (int32_t i = 0; i < beforeNum; i++)
+            EXPECT_EQ(beforeTiles[i].idx, afterTiles[i].idx);
+
+        // bitsets with less words than the tiles number are rejected
+        batch.bitsetWords = 0;
+        EXPECT_EQ(I360SCVP_SelectTilesForPoses(pBatch, &batch), ERROR_BAD_PARAM);
+
+        I360SCVP_unInit(pRef);
+        I360SCVP_unInit(pBatch);
+    }
+
+    std::vector<HeadPose> poses;
+};
+
+TEST_F(I360SCVPTest_batchTileSelection, ERPBatch)
+{
+    setERP();
+    checkBatch();
+}
+
+TEST_F(I360SCVPTest_batchTileSelection, CubemapBatch)
+{
+    setCubemap();
+    checkBatch();
+}
+
+TEST_F(I360SCVPTest_batchTileSelection, ConcurrentBatches)
+{
+    setCubemap();
+    void* pRef = I360SCVP_Init(&param);
+    void* pBatch = I360SCVP_Init(&param);
+    ASSERT_TRUE(pRef != NULL);
+    ASSERT_TRUE(pBatch != NULL);
+
+    initPoses();
+    int32_t tilesNum = I360SCVP_GetTilesLayout(pBatch, NULL, 0);
+    ASSERT_TRUE(tilesNum > 0);
+    std::vector<TileDef> layout(tilesNum);
+    EXPECT_EQ(I360SCVP_GetTilesLayout(pBatch, layout.data(), tilesNum), tilesNum);
+    int32_t bitsetWords = (tilesNum + 63) / 64;
+    const int32_t threadsNum = 4;
+    std::vector<std::vector<uint64_t>> bitsets(threadsNum);
+    std::vector<int32_t> results(threadsNum, ERROR_INVALID);
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < threadsNum; t++)
+    {
+        bitsets[t].resize(poses.size() * bitsetWords, 0);
+        threads.push_back(std::thread([&, t]() {
+            TilesSelectionBatch batch;
+            memset_s(&batch, sizeof(TilesSelectionBatch), 0);
+            batch.pPoses = poses.data();
+            batch.posesNum = poses.size();
+            batch.bitsetWords = bitsetWords;
+            batch.pTilesBitsets = bitsets[t].data();
+            // repeated rounds reuse the viewport instances kept by the handle
+            for (int32_t round = 0; round < 3; round++)
+            {
+                results[t] = I360SCVP_SelectTilesForPoses(pBatch, &batch);
+                if (results[t] != ERROR_NONE)
+                    break;
+            }
+        }));
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int32_t t = 0; t < threadsNum; t++)
+    {
+        EXPECT_EQ(results[t], ERROR_NONE);
+        checkBitsets(pRef, bitsets[t], bitsetWords, layout);
+    }
+
+    I360SCVP_unInit(pRef);
+    I360SCVP_unInit(pBatch);
+}
+}
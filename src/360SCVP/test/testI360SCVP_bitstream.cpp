@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include "../360SCVPAPI.h"
+#include "../360SCVPBitstream.h"
+
+namespace{
+
+// bit by bit reader and writer, which are the former GTS_BitStream
+// implementation, used as reference for the word based one
+static uint32_t ref_read_bit(GTS_BitStream *bs)
+{
+    if (bs->nbBits == 8) {
+        bs->current = (bs->position < bs->size) ? (uint8_t)bs->original[bs->position++] : 0;
+        bs->nbBits = 0;
+    }
+    bs->current <<= 1;
+    bs->nbBits++;
+    return (bs->current & 0x100) >> 8;
+}
+
+static uint32_t ref_read_int(GTS_BitStream *bs, uint32_t nBits)
+{
+    uint32_t ret = 0;
+    while (nBits-- > 0) {
+        ret <<= 1;
+        ret |= ref_read_bit(bs);
+    }
+    return ret;
+}
+
+static uint32_t ref_peek_int(GTS_BitStream *bs, uint32_t nBits)
+{
+    uint64_t position = bs->position;
+    uint32_t current = bs->current;
+    uint32_t nbBits = bs->nbBits;
+    uint32_t ret = ref_read_int(bs, nBits);
+    bs->position = position;
+    bs->current = current;
+    bs->nbBits = nbBits;
+    return ret;
+}
+
+// the former Exp-Golomb parsing which skips the leading zeros byte by byte
+static uint32_t ref_read_ue(GTS_BitStream *bs)
+{
+    uint32_t leadingZeros = 0, flag = 0;
+    while (1) {
+        flag = ref_peek_int(bs, 8);
+        if (flag) break;
+        if (bs->size <= bs->position)
+            return 0;
+        ref_read_int(bs, 8);
+        leadingZeros += 8;
+    }
+    uint32_t digits = 0;
+    while (!(flag & 0x80)) {
+        flag <<= 1;
+        digits++;
+    }
+    ref_read_int(bs, digits);
+    leadingZeros += digits;
+    return ref_read_int(bs, leadingZeros + 1) - 1;
+}
+
+static void ref_write_int(std::vector<uint8_t> &out, uint32_t &current, uint32_t &nbBits, uint8_t &zeroCount,
+                          int32_t value, int32_t nBits)
+{
+    uint32_t val = (uint32_t)value << (32 - nBits);
+    while (--nBits >= 0) {
+        current = (current << 1) | (((int32_t)val) < 0);
+        val <<= 1;
+        if (++nbBits == 8) {
+            nbBits = 0;
+            if ((zeroCount == 2) && ((uint8_t)current < 4)) {
+                out.push_back(0x03);
+                zeroCount = 0;
+            }
+            zeroCount = ((uint8_t)current) == 0 ? zeroCount + 1 : 0;
+            out.push_back((uint8_t)current);
+            current = 0;
+        }
+    }
+}
+
+// read pattern looks like a slice header: flags, Exp-Golomb ids and fixed length fields
+enum ReadType { READ_FLAG, READ_UE, READ_SE, READ_BITS };
+struct ReadOp { ReadType type; uint32_t nBits; };
+static const ReadOp g_sliceHdrOps[] = {
+    {READ_FLAG, 1}, {READ_UE, 0}, {READ_FLAG, 1}, {READ_BITS, 12}, {READ_UE, 0}, {READ_BITS, 8},
+    {READ_FLAG, 1}, {READ_SE, 0}, {READ_BITS, 4}, {READ_UE, 0}, {READ_BITS, 2}, {READ_SE, 0},
+    {READ_BITS, 16}, {READ_FLAG, 1}, {READ_UE, 0}, {READ_BITS, 5}, {READ_SE, 0}, {READ_BITS, 32},
+};
+
+class I360SCVPTest_bitstream : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        std::ifstream input("./test.265", std::ios::binary);
+        std::vector<uint8_t> stream((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        // split the stream into NAL payloads and keep the slice ones
+        std::vector<size_t> starts;
+        for (size_t i = 0; i + 3 < stream.size(); i++) {
+            if (stream[i] == 0 && stream[i + 1] == 0 && stream[i + 2] == 1) {
+                starts.push_back(i + 3);
+                i += 2;
+            }
+        }
+        for (size_t i = 0; i < starts.size(); i++) {
+            size_t end = (i + 1 < starts.size()) ? starts[i + 1] - 3 : stream.size();
+            uint8_t nalType = (stream[starts[i]] >> 1) & 0x3f;
+            if (nalType <= 21 && end > starts[i] + 2) {
+                size_t len = end - (starts[i] + 2);
+                if (len > 64) len = 64;
+                sliceHeaders.push_back(std::vector<uint8_t>(stream.begin() + starts[i] + 2,
+                                                            stream.begin() + starts[i] + 2 + len));
+            }
+        }
+    }
+
+    virtual void TearDown()
+    {
+        sliceHeaders.clear();
+    }
+
+    std::vector<std::vector<uint8_t>> sliceHeaders;
+};
+
+TEST_F(I360SCVPTest_bitstream, ReadSliceHeaders)
+{
+    ASSERT_FALSE(sliceHeaders.empty());
+
+    for (auto &hdr : sliceHeaders) {
+        GTS_BitStream *bs = gts_bs_new((const int8_t *)hdr.data(), hdr.size(), GTS_BITSTREAM_READ);
+        GTS_BitStream *ref = gts_bs_new((const int8_t *)hdr.data(), hdr.size(), GTS_BITSTREAM_READ);
+        ASSERT_TRUE(bs != NULL && ref != NULL);
+
+        for (auto &op : g_sliceHdrOps) {
+            switch (op.type) {
+            case READ_UE:
+                EXPECT_EQ(ref_read_ue(ref), gts_bs_read_ue(bs));
+                break;
+            case READ_SE:
+            {
+                uint32_t v = ref_read_ue(ref);
+                int32_t se = (v & 0x1) ? (int32_t)((v + 1) >> 1) : (int32_t)(0 - (v >> 1));
+                EXPECT_EQ(se, gts_bs_read_se(bs));
+                break;
+            }
+            default:
+                EXPECT_EQ(ref_read_int(ref, op.nBits), gts_bs_read_int(bs, op.nBits));
+                break;
+            }
+            EXPECT_EQ(ref->position, bs->position);
+            EXPECT_EQ(ref->nbBits, bs->nbBits);
+            EXPECT_EQ(gts_bs_get_bit_offset(ref), gts_bs_get_bit_offset(bs));
+        }
+
+        // read to the end of the buffer and beyond, zero is read out of the buffer
+        while (gts_bs_available(ref) > 0) {
+            EXPECT_EQ(ref_read_int(ref, 7), gts_bs_read_int(bs, 7));
+        }
+        EXPECT_EQ(ref_read_int(ref, 9), gts_bs_read_int(bs, 9));
+        EXPECT_EQ(ref->position, bs->position);
+
+        gts_bs_del(bs);
+        gts_bs_del(ref);
+    }
+}
+
+TEST_F(I360SCVPTest_bitstream, WriteWithEmulationPrevention)
+{
+    ASSERT_FALSE(sliceHeaders.empty());
+
+    GTS_BitStream *bs = gts_bs_new(NULL, 0, GTS_BITSTREAM_WRITE);
+    ASSERT_TRUE(bs != NULL);
+
+    std::vector<uint8_t> ref;
+    uint32_t current = 0, nbBits = 0;
+    uint8_t zeroCount = 0;
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < 20000; i++) {
+        seed = seed * 1103515245 + 12345;
+        int32_t nBits = (seed >> 16) % 32 + 1;
+        // plenty of zero values to trigger the emulation prevention
+        int32_t value = (i % 3) ? 0 : (int32_t)(seed >> (32 - nBits));
+        ref_write_int(ref, current, nbBits, zeroCount, value, nBits);
+        gts_bs_write_int(bs, value, nBits);
+        ASSERT_EQ(nbBits, bs->nbBits);
+    }
+    ASSERT_EQ(ref.size(), bs->position);
+    EXPECT_EQ(0, memcmp(ref.data(), bs->original, ref.size()));
+
+    gts_bs_del(bs);
+}
+
+TEST_F(I360SCVPTest_bitstream, BenchmarkParseNAL)
+{
+    std::ifstream input("./test.265", std::ios::binary);
+    std::vector<uint8_t> stream((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    ASSERT_FALSE(stream.empty());
+
+    std::vector<uint32_t> starts;
+    for (uint32_t i = 0; i + 4 < stream.size(); i++) {
+        if (!stream[i] && !stream[i + 1] && !stream[i + 2] && stream[i + 3] == 1)
+            starts.push_back(i);
+    }
+    starts.push_back(stream.size());
+    ASSERT_TRUE(starts.size() > 1);
+
+    param_360SCVP param;
+    memset(&param, 0, sizeof(param_360SCVP));
+    param.usedType = E_PARSER_ONENAL;
+    param.frameWidth = 3840;
+    param.frameHeight = 2048;
+    void *pI360SCVP = I360SCVP_Init(&param);
+    ASSERT_TRUE(pI360SCVP != NULL);
+
+    // every loop parses the VPS / SPS / PPS again before the slices, so
+    // the slice headers parsed in each loop are expected to be the same
+    const uint32_t loops = 10;
+    uint64_t firstSum = 0;
+    uint32_t slicesNum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t loop = 0; loop < loops; loop++) {
+        uint64_t sum = 0;
+        slicesNum = 0;
+        for (uint32_t i = 0; i + 1 < starts.size(); i++) {
+            Nalu nal;
+            memset(&nal, 0, sizeof(Nalu));
+            nal.data = stream.data() + starts[i];
+            nal.dataSize = starts[i + 1] - starts[i];
+            ASSERT_EQ(0, I360SCVP_ParseNAL(&nal, pI360SCVP));
+            if (nal.naluType < 32) {
+                sum += nal.sliceHeaderLen;
+                slicesNum++;
+            }
+        }
+        if (!loop)
+            firstSum = sum;
+        EXPECT_EQ(firstSum, sum);
+    }
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now() - start).count();
+
+    I360SCVP_unInit(pI360SCVP);
+
+    EXPECT_TRUE(slicesNum > 0);
+    EXPECT_TRUE(firstSum > 0);
+    std::cout << "Benchmark: " << loops * (starts.size() - 1) << " nalus with " << loops * slicesNum
+              << " slice headers parsed in " << time << " us" << std::endl;
+}
+
+}
@@ -27,9 +27,11 @@
 #include "gtest/gtest.h"
 #include <string>
 #include <fstream>
+#include <vector>
 #include "../360SCVPAPI.h"
 
 #include "../../utils/safe_mem.h"
+#include "../../utils/OmafStructure.h"
 
 namespace{
 class I360SCVPTest_common : public testing::Test {
@@ -280,6 +282,81 @@ TEST_F(I360SCVPTest_common, GenerateSPS_PPS_SliceHdr)
     EXPECT_TRUE(ret == 0);
 }
 
+TEST_F(I360SCVPTest_common, GenerateSliceHdr_TruncatedInput)
+{
+    // the extractor track only passes the start codes, the nalu header,
+    // the parsed slice header and a small tail to 360SCVP, the rewritten
+    // slice header must be the same as the one from the whole nalu
+    const uint32_t tailSize = 16;
+    param.usedType = E_PARSER_ONENAL;
+    void* pI360SCVP = I360SCVP_Init(&param);
+    ASSERT_TRUE(pI360SCVP != NULL);
+
+    std::vector<uint32_t> starts;
+    for (int i = 0; i + 4 < bufferlen; i++)
+    {
+        if (!pInputBuffer[i] && !pInputBuffer[i + 1] && !pInputBuffer[i + 2] && pInputBuffer[i + 3] == 1)
+            starts.push_back(i);
+    }
+    starts.push_back(bufferlen);
+
+    std::vector<uint8_t> fullOut(bufferlen * 2);
+    std::vector<uint8_t> truncOut(bufferlen * 2);
+    uint32_t truncatedNum = 0;
+    for (uint32_t i = 0; i + 1 < starts.size(); i++)
+    {
+        Nalu nal;
+        memset_s(&nal, sizeof(Nalu), 0);
+        nal.data = pInputBuffer + starts[i];
+        nal.dataSize = starts[i + 1] - starts[i];
+        uint32_t nalLen = nal.dataSize;
+        if (I360SCVP_ParseNAL(&nal, pI360SCVP))
+            break;
+        if (nal.naluType >= 32 || !nal.sliceHeaderLen)
+            continue;
+
+        uint32_t hdrRegionLen = HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nal.sliceHeaderLen + tailSize;
+        if (hdrRegionLen >= nalLen)
+            continue;
+
+        // the parsed slice header length doesn't count emulation prevention bytes
+        uint32_t epbNum = 0;
+        for (uint32_t j = HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + 2; j < hdrRegionLen; j++)
+        {
+            if (!nal.data[j - 2] && !nal.data[j - 1] && nal.data[j] == 3)
+                epbNum++;
+        }
+        EXPECT_TRUE(nal.sliceHeaderLen + epbNum <= hdrRegionLen - HEVC_STARTCODES_LEN - HEVC_NALUHEADER_LEN);
+
+        int32_t newSliceAddr = truncatedNum % 24;
+        param.destWidth = 1536;
+        param.destHeight = 1024;
+
+        param.pInputBitstream = nal.data;
+        param.inputBitstreamLen = nalLen;
+        param.pOutputBitstream = fullOut.data();
+        memset_s(fullOut.data(), fullOut.size(), 0);
+        ASSERT_EQ(0, I360SCVP_GenerateSliceHdr(&param, newSliceAddr, pI360SCVP));
+        uint32_t fullLen = param.outputBitstreamLen;
+
+        param.inputBitstreamLen = hdrRegionLen;
+        param.pOutputBitstream = truncOut.data();
+        memset_s(truncOut.data(), truncOut.size(), 0);
+        ASSERT_EQ(0, I360SCVP_GenerateSliceHdr(&param, newSliceAddr, pI360SCVP));
+        uint32_t truncLen = param.outputBitstreamLen;
+
+        ASSERT_EQ(fullLen, truncLen);
+        EXPECT_EQ(0, memcmp(fullOut.data(), truncOut.data(), fullLen));
+        truncatedNum++;
+    }
+
+    param.pInputBitstream = pInputBuffer;
+    param.inputBitstreamLen = bufferlen;
+    param.pOutputBitstream = pOutputBuffer;
+    I360SCVP_unInit(pI360SCVP);
+    EXPECT_TRUE(truncatedNum > 0);
+}
+
 TEST_F(I360SCVPTest_common, GetParameter_PicInfo_type0)
 {
     int ret = 0;
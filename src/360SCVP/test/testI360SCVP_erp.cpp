@@ -236,6 +236,89 @@ TEST_F(I360SCVPTest_erp, SetviewportAndMergeProcess)
     EXPECT_TRUE(ret == 0);
 }
 
+TEST_F(I360SCVPTest_erp, MergeProcessWithOutputSpans)
+{
+    int ret = 0;
+    param.paramViewPort.faceWidth = 3840;
+    param.paramViewPort.faceHeight = 2048;
+    param.paramViewPort.geoTypeInput = EGeometryType(E_SVIDEO_EQUIRECT);
+    param.paramViewPort.viewportHeight = 960;
+    param.paramViewPort.viewportWidth = 960;
+    param.paramViewPort.geoTypeOutput = E_SVIDEO_VIEWPORT;
+    param.paramViewPort.viewPortYaw = -90;
+    param.paramViewPort.viewPortPitch = 0;
+    param.paramViewPort.viewPortFOVH = 80;
+    param.paramViewPort.viewPortFOVV = 80;
+    param.usedType = E_MERGE_AND_VIEWPORT;
+    param.paramViewPort.paramVideoFP.faces[0][0].idFace = 0;
+    param.paramViewPort.paramVideoFP.faces[0][0].rotFace = NO_TRANSFORM;
+
+    // merge the frame in copy mode as reference
+    void* pI360SCVP = I360SCVP_Init(&param);
+    EXPECT_TRUE(pI360SCVP != NULL);
+    if (!pI360SCVP)
+        return;
+    I360SCVP_setViewPort(pI360SCVP, param.paramViewPort.viewPortYaw, param.paramViewPort.viewPortPitch);
+    ret = I360SCVP_process(&param, pI360SCVP);
+    I360SCVP_unInit(pI360SCVP);
+    EXPECT_TRUE(ret == 0);
+    EXPECT_TRUE(param.outputBitstreamLen > 0);
+    EXPECT_TRUE(param.outputSpansNum == 0);
+    if (ret || param.outputBitstreamLen <= 0)
+        return;
+    uint32_t refLen = param.outputBitstreamLen;
+
+    // merge the same frame in scatter/gather mode, only headers are written into the output buffer
+    unsigned char* pHeaderBuffer = new unsigned char[bufferlen];
+    unsigned char* pAssembledBuffer = new unsigned char[bufferlen];
+    Output_Span spans[256];
+    param.pOutputBitstream = pHeaderBuffer;
+    param.outputBitstreamLen = 0;
+    param.pOutputSpans = spans;
+    param.maxOutputSpansNum = 256;
+    pI360SCVP = I360SCVP_Init(&param);
+    EXPECT_TRUE(pI360SCVP != NULL);
+    if (!pI360SCVP)
+    {
+        delete[] pHeaderBuffer;
+        delete[] pAssembledBuffer;
+        return;
+    }
+    I360SCVP_setViewPort(pI360SCVP, param.paramViewPort.viewPortYaw, param.paramViewPort.viewPortPitch);
+    ret = I360SCVP_process(&param, pI360SCVP);
+    EXPECT_TRUE(ret == 0);
+    EXPECT_TRUE(param.outputBitstreamLen == refLen);
+    EXPECT_TRUE(param.outputSpansNum > 0);
+
+    // slice data is referred from the input bitstreams rather than copied
+    uint32_t spansLen = 0;
+    uint32_t inputSpansNum = 0;
+    for (uint32_t i = 0; i < param.outputSpansNum; i++)
+    {
+        spansLen += spans[i].dataLen;
+        if ((spans[i].pData >= pInputBuffer && spans[i].pData < pInputBuffer + bufferlen)
+            || (spans[i].pData >= pInputBufferlow && spans[i].pData < pInputBufferlow + bufferlenlow))
+            inputSpansNum++;
+    }
+    EXPECT_TRUE(spansLen == refLen);
+    EXPECT_TRUE(inputSpansNum > 0);
+
+    uint32_t assembledLen = 0;
+    ret = I360SCVP_AssembleSpans(spans, param.outputSpansNum, pAssembledBuffer, bufferlen, &assembledLen);
+    EXPECT_TRUE(ret == 0);
+    EXPECT_TRUE(assembledLen == refLen);
+    EXPECT_TRUE(memcmp(pAssembledBuffer, pOutputBuffer, refLen) == 0);
+
+    // too small span array is rejected
+    param.maxOutputSpansNum = 1;
+    ret = I360SCVP_process(&param, pI360SCVP);
+    EXPECT_TRUE(ret != 0);
+
+    I360SCVP_unInit(pI360SCVP);
+    delete[] pHeaderBuffer;
+    delete[] pAssembledBuffer;
+}
+
 TEST_F(I360SCVPTest_erp, GetTilesInViewport)
 {
     int32_t tileNum_fast, tileNum_legacy;
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "../360SCVPGeometry.h"
+#include "../360SCVPViewPort.h"
+
+namespace{
+
+struct MappingPose
+{
+    float yaw;
+    float pitch;
+    float hFOV;
+    float vFOV;
+};
+
+class I360SCVPTest_geometryMapping : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+    }
+    virtual void TearDown()
+    {
+    }
+
+    SVideoInfo sourceInfo(int32_t geoType, int32_t faceWidth, int32_t faceHeight)
+    {
+        SVideoInfo info;
+        memset(&info, 0, sizeof(SVideoInfo));
+        info.geoType = geoType;
+        info.iNumFaces = (geoType == SVIDEO_CUBEMAP) ? 6 : 1;
+        info.iFaceWidth = faceWidth;
+        info.iFaceHeight = faceHeight;
+        return info;
+    }
+
+    SVideoInfo viewportInfo(const SVideoInfo& srcInfo, const MappingPose& pose, int32_t rotX)
+    {
+        SVideoInfo info;
+        memset(&info, 0, sizeof(SVideoInfo));
+        info.geoType = SVIDEO_VIEWPORT;
+        info.iNumFaces = 1;
+        info.iFaceWidth = 512;
+        info.iFaceHeight = 512;
+        info.fullWidth = srcInfo.iFaceWidth * (srcInfo.geoType == SVIDEO_CUBEMAP ? 3 : 1);
+        info.fullHeight = srcInfo.iFaceHeight * (srcInfo.geoType == SVIDEO_CUBEMAP ? 2 : 1);
+        info.sVideoRotation.degree[0] = rotX;
+        info.viewPort.fYaw = pose.yaw;
+        info.viewPort.fPitch = pose.pitch;
+        info.viewPort.hFOV = pose.hFOV;
+        info.viewPort.vFOV = pose.vFOV;
+        return info;
+    }
+
+    // map one pose with the per pixel mapping and the fast viewport mapping,
+    // the bounding boxes on all faces are expected to be the same
+    void checkPose(SVideoInfo& srcInfo, const MappingPose& pose, int32_t rotX)
+    {
+        Geometry *pSrc = Geometry::create(srcInfo);
+        ASSERT_TRUE(pSrc != NULL);
+        SVideoInfo vpInfo = viewportInfo(srcInfo, pose, rotX);
+        ViewPort *pRef = new ViewPort(vpInfo);
+        ViewPort *pFast = new ViewPort(vpInfo);
+
+        pRef->Geometry::geometryMapping(pSrc);
+        pSrc->geoConvert(pFast);
+
+        EXPECT_EQ(pRef->m_numFaces, pFast->m_numFaces);
+        for (int32_t i = 0; i < FACE_NUMBER; i++)
+        {
+            EXPECT_EQ(pRef->m_upLeft[i].faceIdx, pFast->m_upLeft[i].faceIdx)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+            EXPECT_EQ(pRef->m_upLeft[i].x, pFast->m_upLeft[i].x)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+            EXPECT_EQ(pRef->m_upLeft[i].y, pFast->m_upLeft[i].y)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+            EXPECT_EQ(pRef->m_downRight[i].faceIdx, pFast->m_downRight[i].faceIdx)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+            EXPECT_EQ(pRef->m_downRight[i].x, pFast->m_downRight[i].x)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+            EXPECT_EQ(pRef->m_downRight[i].y, pFast->m_downRight[i].y)
+                << "yaw " << pose.yaw << " pitch " << pose.pitch << " face " << i;
+        }
+
+        pRef->geoUnInit();
+        pFast->geoUnInit();
+        delete pRef;
+        delete pFast;
+        delete pSrc;
+    }
+
+    void checkPoses(SVideoInfo& srcInfo, int32_t rotX)
+    {
+        const MappingPose fovs[] = { {0, 0, 80, 80}, {0, 0, 120, 90} };
+        for (uint32_t f = 0; f < sizeof(fovs) / sizeof(fovs[0]); f++)
+        {
+            for (float yaw = -180; yaw <= 180; yaw += 45)
+            {
+                for (float pitch = -90; pitch <= 90; pitch += 30)
+                {
+                    MappingPose pose = fovs[f];
+                    pose.yaw = yaw + 0.3f;
+                    pose.pitch = pitch;
+                    checkPose(srcInfo, pose, rotX);
+                    if (HasFailure())
+                        return;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(I360SCVPTest_geometryMapping, CubeMapSameBoundingBox)
+{
+    SVideoInfo srcInfo = sourceInfo(SVIDEO_CUBEMAP, 960, 960);
+    checkPoses(srcInfo, 0);
+}
+
+TEST_F(I360SCVPTest_geometryMapping, CubeMapRotatedSameBoundingBox)
+{
+    SVideoInfo srcInfo = sourceInfo(SVIDEO_CUBEMAP, 960, 960);
+    checkPoses(srcInfo, 30);
+}
+
+TEST_F(I360SCVPTest_geometryMapping, EquiRectSameBoundingBox)
+{
+    SVideoInfo srcInfo = sourceInfo(SVIDEO_EQUIRECT, 3840, 1920);
+    checkPoses(srcInfo, 0);
+}
+
+}
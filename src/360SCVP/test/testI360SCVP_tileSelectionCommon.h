@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   testI360SCVP_tileSelectionCommon.h
+//! \brief:  common fixture of the tile selection tests, it sets up the
+//!          viewport param and the ERP / cubemap layouts shared by the tests
+//!
+
+#ifndef _TESTI360SCVP_TILESELECTIONCOMMON_H_
+#define _TESTI360SCVP_TILESELECTIONCOMMON_H_
+
+#include "gtest/gtest.h"
+#include "../360SCVPAPI.h"
+
+#include "../../utils/safe_mem.h"
+
+class I360SCVPTest_tileSelection : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        memset_s((void*)&param, sizeof(param_360SCVP), 0);
+        param.usedType = E_VIEWPORT_ONLY;
+        param.paramViewPort.viewportHeight = 1024;
+        param.paramViewPort.viewportWidth = 1024;
+        param.paramViewPort.geoTypeOutput = E_SVIDEO_VIEWPORT;
+        param.paramViewPort.viewPortYaw = 0;
+        param.paramViewPort.viewPortPitch = 0;
+        param.paramViewPort.viewPortFOVH = 80;
+        param.paramViewPort.viewPortFOVV = 80;
+    }
+    virtual void TearDown()
+    {
+    }
+
+    void setERP()
+    {
+        param.paramViewPort.faceWidth = 7680;
+        param.paramViewPort.faceHeight = 3840;
+        param.paramViewPort.geoTypeInput = EGeometryType(E_SVIDEO_EQUIRECT);
+        param.paramViewPort.tileNumCol = 20;
+        param.paramViewPort.tileNumRow = 10;
+        param.paramViewPort.paramVideoFP.cols = 1;
+        param.paramViewPort.paramVideoFP.rows = 1;
+        param.paramViewPort.paramVideoFP.faces[0][0].faceWidth = param.paramViewPort.faceWidth;
+        param.paramViewPort.paramVideoFP.faces[0][0].faceHeight = param.paramViewPort.faceHeight;
+        param.paramViewPort.paramVideoFP.faces[0][0].idFace = 1;
+        param.paramViewPort.paramVideoFP.faces[0][0].rotFace = NO_TRANSFORM;
+    }
+
+    void setCubemap()
+    {
+        param.paramViewPort.faceWidth = 512 * 4;
+        param.paramViewPort.faceHeight = 512 * 4;
+        param.paramViewPort.geoTypeInput = EGeometryType(E_SVIDEO_CUBEMAP);
+        param.paramViewPort.tileNumCol = 4;
+        param.paramViewPort.tileNumRow = 4;
+        param.paramViewPort.paramVideoFP.cols = 3;
+        param.paramViewPort.paramVideoFP.rows = 2;
+        int32_t faceIds[2][3] = { {4, 0, 5}, {3, 1, 2} };
+        E_TransformType faceRots[2][3] = { {NO_TRANSFORM, NO_TRANSFORM, NO_TRANSFORM},
+                                           {ROTATION_180_ANTICLOCKWISE, ROTATION_270_ANTICLOCKWISE, NO_TRANSFORM} };
+        for (int32_t i = 0; i < 2; i++)
+        {
+            for (int32_t j = 0; j < 3; j++)
+            {
+                param.paramViewPort.paramVideoFP.faces[i][j].faceWidth = 512 * 4;
+                param.paramViewPort.paramVideoFP.faces[i][j].faceHeight = 512 * 4;
+                param.paramViewPort.paramVideoFP.faces[i][j].idFace = faceIds[i][j];
+                param.paramViewPort.paramVideoFP.faces[i][j].rotFace = faceRots[i][j];
+            }
+        }
+    }
+
+    param_360SCVP           param;
+};
+
+#endif /* _TESTI360SCVP_TILESELECTIONCOMMON_H_ */
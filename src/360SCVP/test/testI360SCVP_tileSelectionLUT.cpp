@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include "../360SCVPAPI.h"
+#include "testI360SCVP_tileSelectionCommon.h"
+
+#include "../../utils/safe_mem.h"
+#include "../../utils/error.h"
+
+namespace{
+class I360SCVPTest_tileSelectionLUT : public I360SCVPTest_tileSelection {
+public:
+    // select the tiles of the pose on both handles, the selections are expected to be the same
+    void checkPose(void* pRef, void* pLUT, float yaw, float pitch, float lutYaw, float lutPitch)
+    {
+        TileDef refTiles[1024];
+        TileDef lutTiles[1024];
+        Param_ViewportOutput refOutput;
+        Param_ViewportOutput lutOutput;
+
+        I360SCVP_setViewPort(pRef, yaw, pitch);
+        int32_t refNum = I360SCVP_getTilesInViewport(refTiles, &refOutput, pRef);
+        I360SCVP_setViewPort(pLUT, lutYaw, lutPitch);
+        int32_t lutNum = I360SCVP_getTilesInViewport(lutTiles, &lutOutput, pLUT);
+
+        EXPECT_TRUE(refNum > 0);
+        ASSERT_EQ(refNum, lutNum) << "yaw " << yaw << " pitch " << pitch;
+        for (int32_t i = 0; i < refNum; i++)
+        {
+            EXPECT_EQ(refTiles[i].idx, lutTiles[i].idx) << "yaw " << yaw << " pitch " << pitch;
+            EXPECT_EQ(refTiles[i].faceId, lutTiles[i].faceId) << "yaw " << yaw << " pitch " << pitch;
+        }
+        EXPECT_EQ(refOutput.dstWidthNet, lutOutput.dstWidthNet);
+        EXPECT_EQ(refOutput.dstHeightNet, lutOutput.dstHeightNet);
+        EXPECT_EQ(refOutput.xTopLeftNet, lutOutput.xTopLeftNet);
+        EXPECT_EQ(refOutput.yTopLeftNet, lutOutput.yTopLeftNet);
+    }
+
+    void checkLazyLUT()
+    {
+        void* pRef = I360SCVP_Init(&param);
+        void* pLUT = I360SCVP_Init(&param);
+        ASSERT_TRUE(pRef != NULL);
+        ASSERT_TRUE(pLUT != NULL);
+        EXPECT_EQ(I360SCVP_EnableTileSelectionLUT(pLUT, 1, 1, false), 0);
+
+        // integer poses are exact with 1 degree steps, and the other poses
+        // in the cell get the selection of the cell center
+        for (int32_t round = 0; round < 2; round++)
+        {
+            for (float yaw = -170; yaw <= 180; yaw += 35)
+            {
+                for (float pitch = -80; pitch <= 80; pitch += 20)
+                {
+                    checkPose(pRef, pLUT, yaw, pitch, yaw, pitch);
+                    checkPose(pRef, pLUT, yaw, pitch, yaw - 0.3f, pitch + 0.4f);
+                }
+            }
+        }
+
+        I360SCVP_unInit(pRef);
+        I360SCVP_unInit(pLUT);
+    }
+};
+
+TEST_F(I360SCVPTest_tileSelectionLUT, ERPLazyLookup)
+{
+    setERP();
+    checkLazyLUT();
+}
+
+TEST_F(I360SCVPTest_tileSelectionLUT, CubemapLazyLookup)
+{
+    setCubemap();
+    checkLazyLUT();
+}
+
+TEST_F(I360SCVPTest_tileSelectionLUT, BuildSaveAndLoad)
+{
+    const char* lutFile = "./tileSelectionLUT.bin";
+    setERP();
+    void* pRef = I360SCVP_Init(&param);
+    void* pBuilder = I360SCVP_Init(&param);
+    void* pLoader = I360SCVP_Init(&param);
+    ASSERT_TRUE(pRef != NULL);
+    ASSERT_TRUE(pBuilder != NULL);
+    ASSERT_TRUE(pLoader != NULL);
+
+    EXPECT_EQ(I360SCVP_SaveTileSelectionLUT(pBuilder, lutFile), ERROR_INVALID);
+    EXPECT_EQ(I360SCVP_EnableTileSelectionLUT(pBuilder, 10, 10, true), 0);
+    EXPECT_EQ(I360SCVP_SaveTileSelectionLUT(pBuilder, lutFile), 0);
+
+    // the steps come from the file
+    EXPECT_EQ(I360SCVP_EnableTileSelectionLUT(pLoader, 1, 1, false), 0);
+    EXPECT_EQ(I360SCVP_LoadTileSelectionLUT(pLoader, lutFile), 0);
+
+    for (float yaw = -180; yaw < 180; yaw += 30)
+    {
+        for (float pitch = -90; pitch <= 90; pitch += 30)
+        {
+            checkPose(pRef, pBuilder, yaw, pitch, yaw + 2, pitch - 3);
+            checkPose(pRef, pLoader, yaw, pitch, yaw + 4, pitch + 4);
+        }
+    }
+
+    // a table built for another FOV is rejected
+    param.paramViewPort.viewPortFOVH = 100;
+    void* pOther = I360SCVP_Init(&param);
+    ASSERT_TRUE(pOther != NULL);
+    EXPECT_EQ(I360SCVP_EnableTileSelectionLUT(pOther, 10, 10, false), 0);
+    EXPECT_EQ(I360SCVP_LoadTileSelectionLUT(pOther, lutFile), ERROR_BAD_PARAM);
+
+    I360SCVP_unInit(pRef);
+    I360SCVP_unInit(pBuilder);
+    I360SCVP_unInit(pLoader);
+    I360SCVP_unInit(pOther);
+    remove(lutFile);
+}
+
+}
@@ -152,6 +152,7 @@ int32_t CmafSegment::GetSegmentIndexRange(char* indexBuf, size_t size, std::map<
 }
 
 int32_t CmafSegment::GenerateChunkStream() {
+  std::lock_guard<std::mutex> lock(chunk_mutex_);
   // 1. check data validation
   if (index_range_.empty()) {
     OMAF_LOG(LOG_WARNING, "Index range map is empty!\n");
@@ -162,22 +163,18 @@ int32_t CmafSegment::GenerateChunkStream() {
     OMAF_LOG(LOG_WARNING, "available chunk id %d is greater than chunk num %d\n", processed_chunk_id_, chunk_num_);
     return ERROR_INVALID;
   }
-  // 2. generate chunk stream from dash stream
-  // 2.1 get processed bytes
-  size_t bytesProcessed = 0;
-  for (int32_t i = start_chunk_id_; i <= processed_chunk_id_; i++) {
-    bytesProcessed += index_range_[i];
-  }
-
-  // 2.2 generate chunk stream
-  while (processed_chunk_id_ < (int32_t)chunk_num_ - 1 &&
-          dash_stream_.GetStreamSize() - bytesProcessed >= index_range_[processed_chunk_id_ + 1] &&
-          index_range_[processed_chunk_id_ + 1] != 0) {
+  // 2. generate chunk stream from dash stream, chunk_offset_ skips the
+  //    bytes of generated chunks still in the first remaining block
+  while (processed_chunk_id_ < (int32_t)chunk_num_ - 1) {
+    auto range = index_range_.find(processed_chunk_id_ + 1);
+    if (range == index_range_.end() || range->second == 0 ||
+        dash_stream_.GetStreamSize() - chunk_offset_ < range->second) {
+      break;
+    }
 
-    uint32_t cur_chunk_size = index_range_[processed_chunk_id_ + 1];
+    uint32_t cur_chunk_size = range->second;
     char *buf = new char[cur_chunk_size];
-    size_t readSize = dash_stream_.ReadStreamFromOffset(buf, bytesProcessed, cur_chunk_size);
-    // LOG(INFO) << "readSize " << readSize <<" cur_chunk_size " << cur_chunk_size << endl;
+    size_t readSize = dash_stream_.ReadStreamFromOffset(buf, chunk_offset_, cur_chunk_size);
     if (readSize != cur_chunk_size) {
       DELETE_ARRAY(buf);
       OMAF_LOG(LOG_WARNING, "dash stream has not enough data\n");
@@ -185,7 +182,9 @@ int32_t CmafSegment::GenerateChunkStream() {
     }
     std::unique_ptr<StreamBlock> chunk_sb = make_unique_vcd<StreamBlock>(std::move(buf), cur_chunk_size);
     chunk_stream_.push_back(std::move(chunk_sb));
-    bytesProcessed += readSize;
+    // release the blocks of generated chunks instead of keeping the whole segment
+    chunk_offset_ += readSize;
+    chunk_offset_ -= dash_stream_.drop_front(chunk_offset_);
     processed_chunk_id_++;
     // chunk state change: generate node from chunk stream
     if (this->state_change_cb_) {
@@ -195,6 +194,7 @@ int32_t CmafSegment::GenerateChunkStream() {
 
   if (processed_chunk_id_ == (int32_t)chunk_num_ - 1) {
     dash_stream_.clear();
+    chunk_offset_ = 0;
   }
 
   return ERROR_NONE;
@@ -213,20 +213,28 @@ int32_t CmafSegment::UpdateIndexStream(std::unique_ptr<StreamBlock> sb)
     index_stream_.ReadStream(indexBuf, index_length_);
     // check dirty data
     if (!CheckIndexBuf(indexBuf, index_length_)) {
+        SAFE_DELARRAY(indexBuf);
         OMAF_LOG(LOG_WARNING, "Dirty data happen in index stream!\n");
         return ERROR_INVALID;
     }
     // 2. get index_range_
-    if (GetSegmentIndexRange(indexBuf, index_length_, index_range_) != ERROR_NONE) {
+    std::map<uint32_t, uint32_t> indexRange;
+    if (GetSegmentIndexRange(indexBuf, index_length_, indexRange) != ERROR_NONE) {
+      SAFE_DELARRAY(indexBuf);
       OMAF_LOG(LOG_ERROR, "Get segment index range failed!\n");
       return ERROR_INVALID;
     }
-    // for (auto index : index_range_) {
-    //   LOG(INFO) << "Index range " << index.first << " " << index.second << " segid " << GetSegID()<< endl;
-    // }
+    {
+      std::lock_guard<std::mutex> lock(chunk_mutex_);
+      index_range_.swap(indexRange);
+    }
     // 3. clear header stream
     SAFE_DELARRAY(indexBuf);
     index_stream_.clear();
+    // 4. the data of a newly indexed chunk may have arrived already
+    if (dash_stream_.GetStreamSize() > chunk_offset_) {
+      GenerateChunkStream();
+    }
   }
   return ERROR_NONE;
 }
@@ -79,10 +79,14 @@ class CmafSegment : public OmafSegment {
     return nullptr;
   }
 
-  inline map<uint32_t, uint32_t> GetIndexRange() { return index_range_; };
+  inline map<uint32_t, uint32_t> GetIndexRange() {
+    std::lock_guard<std::mutex> lock(chunk_mutex_);
+    return index_range_;
+  };
 
   //!
-  //! \brief  generate chunk stream from dash stream thread function
+  //! \brief  generate chunk stream from dash stream thread function,
+  //!         each chunk is published as soon as its last byte arrives
   //!
   int32_t GenerateChunkStream();
 
@@ -117,6 +121,10 @@ private:
 
   int64_t index_length_ = 0; //<! index box size
 
+  int64_t chunk_offset_ = 0; //<! offset of the next chunk in the remaining dash stream
+
+  std::mutex chunk_mutex_; //<! guards index_range_ and chunk generation between header and data callbacks
+
   // omaf reader
   OmafReader *reader_;
 
@@ -28,8 +28,9 @@
 //!
 
 //! \file:   DownloadManager.h
-//! \brief:
-//! \detail:
+//! \brief:  in-memory cache of downloaded segments
+//! \detail: segments are kept in memory keyed by URL, and evicted in least
+//!          recently used order when the total size exceeds the budget.
 //!
 //! Created on May 28, 2019, 2:39 PM
 //!
@@ -38,12 +39,26 @@
 #define _DOWNLOADMANAGER_H
 
 #include "general.h"
+#include "OmafDashDownload/Stream.h"
+#include <atomic>
 #include <mutex>
-
-typedef bool (*enum_dir_item)(void *cbck, std::string item_name, std::string item_path);
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 VCD_OMAF_BEGIN
 
+//<! the downloaded blocks of one segment, the block data are shared with the
+//<! segments which download or read it, so no copy is made for caching
+struct SegmentCacheBlocks {
+  std::vector<SharedBlockData> blocks;
+  uint64_t size = 0;
+};
+
+//<! the cached data of one segment, shared with readers so eviction never frees data in use
+using SegmentCacheData = std::shared_ptr<const SegmentCacheBlocks>;
+
 class DownloadManager {
 public:
     DownloadManager();
@@ -51,31 +66,32 @@ public:
 
 public:
     //!
-    //! \brief  Delete a cached file from cache.
+    //! \brief  Delete a stored segment file, which is assigned to a
+    //!         segment instead of downloading.
     //!
     int DeleteCacheFile(std::string url);
 
     //!
-    //! \brief  Delete a all cached files from cache.
+    //! \brief  Put the data of a downloaded segment to cache, and
+    //!         evict the least recently used ones to keep the total
+    //!         size within MaxCacheSize.
     //!
-    void CleanCache();
+    int PutSegment(const std::string &url, SegmentCacheData data);
 
     //!
-    //! \brief  Delete a all cached files from cache with condition that
-    //!         the file time is less than ...
+    //! \brief  Get the cached data of a segment, nullptr if not cached.
     //!
-    void DeleteCacheByTime( uint64_t interval );
+    SegmentCacheData GetSegment(const std::string &url);
 
     //!
-    //! \brief  Delete a all cached files from cache with condition that
-    //!         the total cache size is large thanm MaxCacheSize
+    //! \brief  Delete the cached data of a segment.
     //!
-    void DeleteCacheBySize( );
+    int DeleteSegment(const std::string &url);
 
     //!
-    //! \brief  Get a Cache file name
+    //! \brief  Delete a all cached segments from cache.
     //!
-    std::string AssignCacheFileName();
+    void CleanCache();
 
     //!
     //! \brief  Get a downloading bit rate
@@ -90,8 +106,10 @@ public:
     //!
     //! \brief  Get/Set methods for properties
     //!
-    void        SetMaxCacheSize(uint64_t size)          { mMaxCacheSize = size;        };
+    void        SetMaxCacheSize(uint64_t size);
     uint64_t    GetMaxCacheSize()                       { return mMaxCacheSize;        };
+    uint64_t    GetCacheSize();
+    size_t      GetCachedCount();
     void        SetStartTime(uint64_t size)             { mStartTime = size;           };
     uint64_t    GetStartTime()                          { return mStartTime;           };
     uint64_t    GetDownloadBytes()                      { return mDownloadedBytes;     };
@@ -100,59 +118,34 @@ public:
     void        SetFilePrefix(std::string prefix)       { mFilePrefix = prefix;        };
     std::string GetFilePrefix()                         { return mFilePrefix;          };
     bool        UseCache()                              { return mUseCache;            };
-    void        SetUseCache(bool bCache)                { mUseCache = bCache;          };
+    void        SetUseCache(bool bCache);
 
 private:
-
-    //!
-    //! \brief  the implementation to delete all files
-    //!
-    void delete_all_cached_files( std::string directory );
-
-    //!
-    //! \brief  the implementation to get cache size
-    //!
-    uint64_t CacheGetSize( std::string directory );
-
-    //!
-    //! \brief callback to delete file
-    //!
-    //static bool delete_cache_files( void *cbck,
-    //                         std::string item_name,
-    //                         std::string item_path );
-
-    //!
-    //! \brief  callback to get size of each file
-    //!
-    //static bool GatherCacheSize( void *cbck,
-    //                      std::string item_name,
-     //                     std::string item_path );
-
-    //!
-    //! \brief  enumerate all files in a directory
-    //!
-    int enum_directory( const char *dir,
-                        bool enum_directory,
-                        enum_dir_item enum_dir_fct,
-                        void *cbck,
-                        const char *filter = NULL);
-
     //!
-    //! \brief  generate a random string for assigning cache file name
+    //! \brief  evict the least recently used segments until the total
+    //!         size is not larger than the size, mCacheMtx must be held
     //!
-    std::string GetRandomString(int size);
+    void EvictToSize(uint64_t size);
 
 private:
+    struct CacheEntry {
+        std::string      url;
+        SegmentCacheData data;
+    };
+    using CacheList = std::list<CacheEntry>;
+
     int                            mDownloadedBytes;    //<! the total downloaded bytes
     int                            mDownloadedFiles;    //<! the total downloaded files
     std::string                    mCacheDir;           //<! the directory of the cache file
     std::string                    mFilePrefix;         //<! the prefix for each cached file
     std::mutex                     mMutex;              //<! for synchronization
     uint64_t                       mStartTime;          //<! the start time to caching in this process
-    uint64_t                       mMaxCacheSize;       //<! the threshold of total cache file size
-    bool                           mUseCache;           //<! the flag to indicate whether using file caching
-    int32_t                        m_count;             //<! count for random file name
-    std::mutex                     mCacheMtx;                //<! mutex for cache clear
+    uint64_t                       mMaxCacheSize;       //<! the threshold of total cached segment size
+    std::atomic<bool>              mUseCache;           //<! the flag to indicate whether using segment caching
+    std::mutex                     mCacheMtx;           //<! mutex for cache list and index
+    CacheList                      mCacheList;          //<! cached segments, the most recently used at front
+    std::unordered_map<std::string, CacheList::iterator> mCacheIndex; //<! url to the cached segment
+    uint64_t                       mCacheSize;          //<! total size of cached segments
 };
 
 typedef VCD::VRVideo::Singleton<DownloadManager> DOWNLOADMANAGER;    //<! singleton of DownloadManager
@@ -160,4 +153,3 @@ typedef VCD::VRVideo::Singleton<DownloadManager> DOWNLOADMANAGER;    //<! single
 VCD_OMAF_END;
 
 #endif /* DOWNLOADMANAGER_H */
-
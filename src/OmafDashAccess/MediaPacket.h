@@ -41,6 +41,7 @@
 #include "common.h"
 #include "general.h"
 #include "iso_structure.h"
+#include "PacketBufferPool.h"
 
 #include <memory>
 
@@ -69,7 +70,7 @@ class MediaPacket : public VCD::NonCopyable {
   //!
   virtual ~MediaPacket() {
     if (nullptr != m_pPayload) {
-      free(m_pPayload);
+      freePayload(m_pPayload, m_nAllocSize);
       m_pPayload = nullptr;
       m_nAllocSize = 0;
       m_type = -1;
@@ -83,6 +84,7 @@ class MediaPacket : public VCD::NonCopyable {
 
   MediaPacket* InsertParams(std::vector<uint8_t> params) {
     char* new_dest = nullptr;
+    size_t old_alloc_size = m_nAllocSize;
     // FIXME align size?
     if (m_nAllocSize >= m_nRealSize + params.size()) {
       new_dest = m_pPayload;
@@ -99,14 +101,16 @@ class MediaPacket : public VCD::NonCopyable {
 
     // this is a new buffer
     if (new_dest != m_pPayload) {
-      free(m_pPayload);
+      freePayload(m_pPayload, old_alloc_size);
       m_pPayload = new_dest;
+      m_pPool.reset();
     }
     return this;
   }
 
   MediaPacket* InsertADTSHdr() {
     char* new_dest = nullptr;
+    size_t old_alloc_size = m_nAllocSize;
     // FIXME align size?
     if (m_nAllocSize >= m_nRealSize + m_audioADTSHdr.size()) {
       new_dest = m_pPayload;
@@ -123,8 +127,9 @@ class MediaPacket : public VCD::NonCopyable {
 
     // this is a new buffer
     if (new_dest != m_pPayload) {
-      free(m_pPayload);
+      freePayload(m_pPayload, old_alloc_size);
       m_pPayload = new_dest;
+      m_pPool.reset();
     }
     return this;
   }
@@ -142,10 +147,11 @@ class MediaPacket : public VCD::NonCopyable {
   //!
   int AllocatePacket(int size, char fill = 0) {
     if (nullptr != m_pPayload) {
-      free(m_pPayload);
+      freePayload(m_pPayload, m_nAllocSize);
       m_pPayload = nullptr;
       m_nAllocSize = 0;
     }
+    m_pPool.reset();
 
     m_pPayload = (char*)malloc(size);
 
@@ -157,6 +163,83 @@ class MediaPacket : public VCD::NonCopyable {
     return size;
   };
 
+  //!
+  //! \brief  Allocate the packet buffer from the buffer pool, the buffer
+  //!         is given back to the pool when the packet is released
+  //!
+  //! \param  [in] pool
+  //!         the buffer pool of the track
+  //! \param  [in] size
+  //!         the buffer size to be allocated
+  //!
+  //! \return
+  //!         size of new allocated packet
+  //!
+  int AllocatePacketFromPool(PacketBufferPool::Ptr pool, size_t size) {
+    if (pool.get() == nullptr) return AllocatePacket(size);
+
+    if (nullptr != m_pPayload) {
+      freePayload(m_pPayload, m_nAllocSize);
+      m_pPayload = nullptr;
+      m_nAllocSize = 0;
+    }
+
+    size_t allocSize = 0;
+    m_pPayload = pool->Acquire(size, allocSize);
+
+    if (nullptr == m_pPayload) return -1;
+
+    m_pPool = std::move(pool);
+    m_nAllocSize = allocSize;
+    m_nRealSize = 0;
+    return size;
+  };
+
+  //!
+  //! \brief  Read one sample into the packet buffer allocated from the buffer
+  //!         pool. When the buffer is too small, the read function returns
+  //!         OMAF_MEMORY_TOO_SMALL_BUFFER with the size it requires, which is
+  //!         only the part resolved so far for the extractor sample, so the
+  //!         sample is read again with a larger buffer while the required
+  //!         size keeps growing
+  //!
+  //! \param  [in] pool
+  //!         the buffer pool of the track
+  //! \param  [in] size
+  //!         the estimated sample size
+  //! \param  [in] reservedSize
+  //!         the extra buffer size reserved for the sample
+  //! \param  [in] read
+  //!         the function reading the sample into the given buffer, whose
+  //!         size is updated to the read or required size
+  //! \param  [out] readSize
+  //!         the read size, or the required size if the buffer is too small
+  //!
+  //! \return
+  //!         ERROR_NONE if success, else the read or allocation failure
+  //!
+  template <typename ReadFunc>
+  int ReadFromPool(PacketBufferPool::Ptr pool, size_t size, size_t reservedSize, ReadFunc read, uint32_t& readSize) {
+    int ret = ERROR_NONE;
+    while (true) {
+      if (AllocatePacketFromPool(pool, size + reservedSize) < 0) return ERROR_NULL_PTR;
+      size_t allocSize = m_nAllocSize;
+      readSize = static_cast<uint32_t>(allocSize);
+      ret = read(m_pPayload, readSize);
+      if (ret != OMAF_MEMORY_TOO_SMALL_BUFFER) break;
+      // the reader can't tell a larger size, more retries don't help
+      if (readSize <= allocSize) break;
+      // at least double the buffer since the required size may be partial
+      size = (readSize > (allocSize << 1)) ? readSize : (allocSize << 1);
+    }
+    return ret;
+  };
+
+  //!
+  //! \brief  get the allocated size of the buffer
+  //!
+  size_t AllocSize() { return m_nAllocSize; };
+
   //!
   //! \brief  get the buffer pointer of the packet
   //!
@@ -167,6 +250,8 @@ class MediaPacket : public VCD::NonCopyable {
   char* MovePayload() {
     char* tmp = m_pPayload;
     m_pPayload = nullptr;
+    // the caller owns the buffer now and releases it by free
+    m_pPool.reset();
     return tmp;
   }
   //!
@@ -197,7 +282,8 @@ class MediaPacket : public VCD::NonCopyable {
 
     memcpy_s(m_pPayload, m_nAllocSize, buf, m_nAllocSize);
 
-    free(buf);
+    freePayload(buf, m_nAllocSize);
+    m_pPool.reset();
 
     m_nAllocSize = size;
     m_nRealSize = 0;
@@ -225,6 +311,19 @@ class MediaPacket : public VCD::NonCopyable {
 
   void SetRealSize(uint64_t realSize) { m_nRealSize = realSize; };
   uint64_t GetRealSize() { return m_nRealSize; };
+
+  //!
+  //! \brief  set the spans describing the merged frame in the scatter/gather
+  //!         output mode, the payload then only keeps the rewritten headers
+  //!         and the real size is the size of the whole frame, the spans
+  //!         owner keeps the data which the spans point to alive
+  //!
+  void SetSpans(std::vector<Output_Span> spans, std::shared_ptr<void> spansOwner) {
+    m_spans = std::move(spans);
+    m_spansOwner = std::move(spansOwner);
+  };
+  const std::vector<Output_Span>& GetSpans() { return m_spans; };
+  std::shared_ptr<void> GetSpansOwner() { return m_spansOwner; };
   // FIXME, refine and optimize
   void SetRwpk(std::unique_ptr<RegionWisePacking> rwpk) { m_rwpk = std::move(rwpk); };
   // RegionWisePacking* GetRwpk() { return m_rwpk.get(); };
@@ -377,8 +476,18 @@ private:
     MediaPacket& operator=(const MediaPacket& other) { return *this; };
     MediaPacket(const MediaPacket& other) { /* do not create copies */ };
 
+ private:
+  void freePayload(char* buf, size_t allocSize) {
+    if (m_pPool.get()) {
+      m_pPool->Release(buf, allocSize);
+    } else {
+      free(buf);
+    }
+  }
+
  private:
   char* m_pPayload = nullptr;  //!< the payload buffer of the packet
+  PacketBufferPool::Ptr m_pPool;  //!< the pool the payload buffer comes from
   size_t m_nAllocSize = 0;     //!< the allocated size of packet
   size_t m_nRealSize = 0;      //!< real size of packet
   int m_type = -1;             //!< the type of the payload
@@ -387,6 +496,8 @@ private:
   // RegionWisePacking* m_rwpk;
   std::unique_ptr<RegionWisePacking> m_rwpk;
   std::shared_ptr<ProducerReferenceTime> m_prft;
+  std::vector<Output_Span> m_spans;    //!< spans of the merged frame in scatter/gather output mode
+  std::shared_ptr<void> m_spansOwner;  //!< keeps the data the spans point to alive
   QualityRank m_qualityRanking = HIGHEST_QUALITY_RANKING;
   SRDInfo m_srd;
 
@@ -78,6 +78,7 @@ OmafAdaptationSet::OmafAdaptationSet() {
   mRwpkType = RWPK_UNKNOWN;
   mTileInfo = NULL;
   mIsExtractorTrack = false;
+  mViewportPriority = TaskPriority::HIGH;
   mGopSize = 0;
   mViewID.first = -1;
   mViewID.second = -1;
@@ -356,6 +357,7 @@ int OmafAdaptationSet::LoadAssignedInitSegment(std::string assignedSegment) {
 
   initSeg->SetSegmentCacheFile(assignedSegment);
   initSeg->SetSegStored();
+  initSeg->PrefetchStoredFile();
 
   return ret;
 }
@@ -382,6 +384,7 @@ OmafSegment::Ptr OmafAdaptationSet::LoadAssignedSegment(std::string assignedSegm
 
   newSeg->SetSegmentCacheFile(assignedSegment);
   newSeg->SetSegStored();
+  newSeg->PrefetchStoredFile();
 
   return newSeg;
 }
@@ -475,7 +478,8 @@ int OmafAdaptationSet::DownloadSegment(bool enableCMAF) {
   DashSegmentSourceParams params;
 
   params.dash_url_ = seg->GenerateCompleteURL(mBaseURL, repID, mActiveSegNum);
-  params.priority_ = TaskPriority::NORMAL;
+  params.priority_ = GetDownloadPriority();
+  params.adaptation_set_id_ = mID;
   params.timeline_point_ = static_cast<int64_t>(mSegNum);
   params.start_chunk_id_ = (mSegNum == 1) ? mStartChunkId : 0; // start chunk from 0
   params.chunk_num_ = (mChunkDuration == 0) ? 1 : mSegmentDuration * 1000 / mChunkDuration;
@@ -588,7 +592,9 @@ int OmafAdaptationSet::DownloadAssignedSegment(uint32_t trackID, uint32_t segID,
   DashSegmentSourceParams params;
 
   params.dash_url_ = seg->GenerateCompleteURL(mBaseURL, repID, realSegNum);
-  params.priority_ = TaskPriority::NORMAL;
+  // catch up tiles are the ones just moved into viewport
+  params.priority_ = TaskPriority::HIGH;
+  params.adaptation_set_id_ = mID;
   params.timeline_point_ = static_cast<int64_t>(segID);
   params.start_chunk_id_ = start_chunk_id;
   params.chunk_num_ = (mChunkDuration == 0) ? 1 : mSegmentDuration * 1000 / mChunkDuration;
@@ -716,6 +722,35 @@ int OmafAdaptationSet::UpdateStartNumberByTime(uint64_t nAvailableStartTime) {
   return mActiveSegNum;
 }
 
+int OmafAdaptationSet::UpdateSegmentTemplate() {
+  if (nullptr == mRepresentation) return ERROR_NULL_PTR;
+
+  SegmentElement* segment = mRepresentation->GetSegment();
+  if (nullptr == segment || 0 == segment->GetTimescale()) return ERROR_NONE;
+
+  int startNumber = segment->GetStartNumber();
+  uint64_t segmentDuration = segment->GetDuration() / segment->GetTimescale();
+  if (startNumber == mStartNumber && segmentDuration == mSegmentDuration) return ERROR_NONE;
+  if (0 == segmentDuration) {
+    OMAF_LOG(LOG_ERROR, "Invalid segment duration in the updated MPD for AdaptationSet %d\n", mID);
+    return ERROR_INVALID;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  // keep the time of the active segment: (num - startNumber) * duration
+  int64_t activeIndex = (int64_t)(mActiveSegNum - mStartNumber) * mSegmentDuration / segmentDuration;
+  int activeSegNum = (int)activeIndex + startNumber;
+  mStartSegNum += activeSegNum - mActiveSegNum;
+  mActiveSegNum = activeSegNum;
+  mStartNumber = startNumber;
+  mSegmentDuration = segmentDuration;
+  if (nullptr == mRepresentation->GetResync()) mChunkDuration = mSegmentDuration * 1000;
+
+  OMAF_LOG(LOG_INFO, "Updated start number %d and segment duration %ld\n", mStartNumber, mSegmentDuration);
+  OMAF_LOG(LOG_INFO, "Set active segment index= %d\n", mActiveSegNum);
+  return ERROR_NONE;
+}
+
 OmafSegment::Ptr OmafAdaptationSet::GetNextSegment() {
   OmafSegment::Ptr seg;
 
@@ -46,6 +46,7 @@
 
 #include "OmafDashRangeSync.h"
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -116,6 +117,13 @@ class OmafAdaptationSet {
   //!
   int UpdateStartNumberByTime(uint64_t nAvailableStartTime);
 
+  //!
+  //! \brief  reload startNumber and duration after the SegmentTemplate is
+  //!         refreshed by a live MPD update. the segments being processed
+  //!         are renumbered so that they still point to the same time
+  //!
+  int UpdateSegmentTemplate();
+
   void UpdateSegmentNumber(int64_t segnum) { mActiveSegNum = segnum; };
   int64_t GetSegmentNumber(void) const { return mActiveSegNum; };
   std::string GetUrl(const SegmentSyncNode& node) const;
@@ -194,6 +202,27 @@ class OmafAdaptationSet {
     }
   };
 
+  //!
+  //! \brief  Get the download priority of the media segments, the main and
+  //!         extractor tracks and the highest quality tiles in viewport are
+  //!         fetched first, then the predicted tiles, and the background tiles
+  //!         in lower quality are the last
+  //!
+  TaskPriority GetDownloadPriority() {
+    if (m_bMain || mIsExtractorTrack) return TaskPriority::HIGH;
+    if (mType == MediaType_Video && mRepresentation) {
+      std::string ranking = mRepresentation->GetQualityRanking();
+      if (!ranking.empty() && ranking != "1") return TaskPriority::LOW;
+    }
+    return mViewportPriority.load();
+  };
+
+  //!
+  //! \brief  Set by tracks selector, HIGH for the tiles in current viewport,
+  //!         and NORMAL for the tiles only in the predicted viewport
+  //!
+  void SetViewportPriority(TaskPriority priority) { mViewportPriority.store(priority); };
+
   ChunkInfoType GetChunkInfoType() { return mChunkInfoType; };
   void SetChunkInfoType(ChunkInfoType type) { mChunkInfoType = type; };
 
@@ -287,6 +316,7 @@ class OmafAdaptationSet {
 
   std::shared_ptr<OmafReaderManager> omaf_reader_mgr_;
   bool mIsExtractorTrack;
+  std::atomic<TaskPriority> mViewportPriority;  //<! download priority decided by viewport
 
   std::map<int32_t, TwoDQualityInfo> mTwoDQualityInfos; //<! map of <qualityRanking, TwoDQualityInfo> for all planar video sources
 };
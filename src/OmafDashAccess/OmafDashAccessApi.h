@@ -60,6 +60,8 @@ typedef struct _omafHttpParams {
   int32_t retry_times;
   int ssl_verify_peer;
   int ssl_verify_host;
+  int enable_http2; // multiplex segment downloads over HTTP/2 connections, fall back to HTTP/1.1 if not supported by server
+  long max_host_connections; // max connections to one host in HTTP/2 mode, 0 to use default value
 } OmafHttpParams;
 
 typedef struct _omafStatisticsParams {
@@ -87,9 +89,12 @@ typedef struct _omafDashParams {
   OmafPredictorParams predictor_params;
   long max_parallel_transfers;
   int segment_open_timeout_ms;
+  uint64_t max_segment_cache_size; // bytes of downloaded segments cached in memory for replay of static media, 0 to disable
   //for stitch
   uint32_t max_decode_width;
   uint32_t max_decode_height;
+  uint32_t max_stitch_threads; // worker threads to stitch merged packets in parallel, 0 to stitch on one thread
+  int enable_span_output; // output merged packets as spans over the tile data without copying it, see OmafAccess_ReleasePacketSpans
   //for catch up
   bool enable_in_time_viewport_update;
   uint32_t max_response_times_in_seg;
@@ -196,6 +201,15 @@ int OmafAccess_GetMediaInfo(Handler hdl, DashMediaInfo* info);
 int OmafAccess_GetPacket(Handler hdl, int stream_id, DashPacket* packet, int* size, uint64_t* pts, bool needParams,
                          bool clearBuf);
 
+/*
+ * description: API to release the spans of the packet gotten from OmafAccess_GetPacket when
+ * omaf_params.enable_span_output is set. Such packet has NULL buf, and the merged frame of
+ * size bytes is the concatenation of its spans, which can be assembled with I360SCVP_AssembleSpans
+ * params: packet - [in] the packet whose spans are released
+ * return: the error return from the API
+ */
+int OmafAccess_ReleasePacketSpans(DashPacket* packet);
+
 /*
  * description: API to set InitViewport before downloading segment.
  * params: hdl - [in]handler created with DashStreaming_Init
@@ -220,6 +234,25 @@ int OmafAccess_ChangeViewport(Handler hdl, HeadPose* pose);
  */
 int OmafAccess_Statistic(Handler hdl, DashStatisticInfo* info);
 
+/*
+ * description: API to get the latency of download, parse, stitch and get packet stages,
+ * available when statistic_params.enable is set in DashStreaming_Init
+ * params: hdl - [in] handler created with DashStreaming_Init
+ *         info - [out] the latency count, min, max, mean and percentiles of each stage
+ * return: the error return from the API, ERROR_NO_VALUE if statistic is disabled
+ */
+int OmafAccess_StageStatistic(Handler hdl, DashStageStatisticInfo* info);
+
+/*
+ * description: API to dump the latency of all stages as JSON string
+ * params: hdl - [in] handler created with DashStreaming_Init
+ *         buf - [out] the buffer for the JSON string, NULL to query the size
+ *         size - [in/out] the size of the buffer, set to the required size
+ *                including the terminating null byte
+ * return: the error return from the API, ERROR_BAD_PARAM if the buffer is too small
+ */
+int OmafAccess_DumpStageStatistic(Handler hdl, char* buf, uint32_t* size);
+
 /*
  * description: API to Close the Handle and release relative resources after dealing with
  * the media
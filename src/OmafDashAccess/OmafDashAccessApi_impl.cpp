@@ -52,6 +52,13 @@ using namespace std;
 VCD_USE_VROMAF;
 VCD_USE_VRVIDEO;
 
+// what the spans of one packet in span output mode point to
+typedef struct DashPacketSpans {
+  char *headers;                      // merged headers and rewritten slice headers
+  std::vector<Output_Span> spans;
+  std::shared_ptr<void> tilesOwner;   // tile packets holding the slice data
+} DashPacketSpans;
+
 Handler OmafAccess_Init(DashStreamingClient *pCtx) {
   if (pCtx == nullptr) {
     return nullptr;
@@ -92,6 +99,12 @@ Handler OmafAccess_Init(DashStreamingClient *pCtx) {
 
   omaf_dash_params.http_params_.bssl_verify_host_ = omaf_params.http_params.ssl_verify_host == 0 ? false : true;
 
+  omaf_dash_params.http_params_.enable_http2_ = omaf_params.http_params.enable_http2 == 0 ? false : true;
+
+  if (omaf_params.http_params.max_host_connections > 0) {
+    omaf_dash_params.http_params_.max_host_connections_ = omaf_params.http_params.max_host_connections;
+  }
+
   omaf_dash_params.prediector_params_.enable_ = omaf_params.predictor_params.enable == 0 ? false : true;
 
   if (omaf_params.predictor_params.name) {
@@ -118,6 +131,7 @@ Handler OmafAccess_Init(DashStreamingClient *pCtx) {
   if (omaf_params.segment_open_timeout_ms > 0) {
     omaf_dash_params.segment_open_timeout_ms_ = omaf_params.segment_open_timeout_ms;
   }
+  omaf_dash_params.max_segment_cache_size_ = omaf_params.max_segment_cache_size;
   // for stitch
   if (omaf_params.max_decode_width > 0) {
     omaf_dash_params.max_decode_width_ = omaf_params.max_decode_width;
@@ -125,6 +139,8 @@ Handler OmafAccess_Init(DashStreamingClient *pCtx) {
   if (omaf_params.max_decode_height > 0) {
     omaf_dash_params.max_decode_height_ = omaf_params.max_decode_height;
   }
+  omaf_dash_params.max_stitch_threads_ = omaf_params.max_stitch_threads;
+  omaf_dash_params.enable_span_output_ = omaf_params.enable_span_output != 0;
   // for catch up
   omaf_dash_params.enable_in_time_viewport_update = omaf_params.enable_in_time_viewport_update;
   omaf_dash_params.max_response_times_in_seg = omaf_params.max_response_times_in_seg;
@@ -228,6 +244,19 @@ int OmafAccess_GetPacket(Handler hdl, int stream_id, DashPacket *packet, int *si
           packet[i].rwpk = newRwpk;
           packet[i].buf = pPkt->MovePayload();
           packet[i].size = pPkt->Size();
+          packet[i].spans = NULL;
+          packet[i].spansNum = 0;
+          packet[i].spansOwner = NULL;
+          if (!pPkt->GetSpans().empty()) {
+            DashPacketSpans *spans = new DashPacketSpans;
+            spans->headers = packet[i].buf;
+            spans->spans = pPkt->GetSpans();
+            spans->tilesOwner = pPkt->GetSpansOwner();
+            packet[i].buf = NULL;
+            packet[i].spans = spans->spans.data();
+            packet[i].spansNum = spans->spans.size();
+            packet[i].spansOwner = spans;
+          }
           packet[i].segID = pPkt->GetSegID();
           packet[i].videoID = pPkt->GetVideoID();
           packet[i].video_codec = pPkt->GetCodecType();
@@ -275,6 +304,21 @@ int OmafAccess_GetPacket(Handler hdl, int stream_id, DashPacket *packet, int *si
   return ERROR_NONE;
 }
 
+int OmafAccess_ReleasePacketSpans(DashPacket *packet) {
+  if (packet == nullptr) {
+    return ERROR_INVALID;
+  }
+  DashPacketSpans *spans = (DashPacketSpans *)packet->spansOwner;
+  if (spans) {
+    SAFE_FREE(spans->headers);
+    delete spans;
+  }
+  packet->spans = NULL;
+  packet->spansNum = 0;
+  packet->spansOwner = NULL;
+  return ERROR_NONE;
+}
+
 int OmafAccess_SetupHeadSetInfo(Handler hdl, HeadSetInfo *clientInfo) {
   OmafMediaSource *pSource = (OmafMediaSource *)hdl;
 
@@ -292,6 +336,32 @@ int OmafAccess_Statistic(Handler hdl, DashStatisticInfo *info) {
   return pSource->GetStatistic(info);
 }
 
+int OmafAccess_StageStatistic(Handler hdl, DashStageStatisticInfo *info) {
+  if (NULL == hdl) return ERROR_NULL_PTR;
+
+  OmafMediaSource *pSource = (OmafMediaSource *)hdl;
+
+  return pSource->GetStageStatistic(info);
+}
+
+int OmafAccess_DumpStageStatistic(Handler hdl, char *buf, uint32_t *size) {
+  OmafMediaSource *pSource = (OmafMediaSource *)hdl;
+  if (pSource == nullptr || size == nullptr) return ERROR_NULL_PTR;
+
+  std::string json;
+  int ret = pSource->DumpStageStatistic(json);
+  if (ret != ERROR_NONE) return ret;
+
+  uint32_t required = static_cast<uint32_t>(json.size() + 1);
+  if (buf == nullptr || *size < required) {
+    *size = required;
+    return ERROR_BAD_PARAM;
+  }
+  memcpy_s(buf, *size, json.c_str(), required);
+  *size = required;
+  return ERROR_NONE;
+}
+
 int OmafAccess_Close(Handler hdl) {
   OmafMediaSource *pSource = (OmafMediaSource *)hdl;
   delete pSource;
@@ -102,6 +102,13 @@ OMAF_STATUS OmafCurlEasyHelper::setParams(CURL *easy_curl, CurlParams params) no
       curl_easy_setopt(easy_curl, CURLOPT_TIMEOUT_MS, params.http_params_.total_timeout_);
     }
 
+    if (params.http_params_.enable_http2_) {
+      // negotiate HTTP/2 by ALPN for https, and wait for an existing connection
+      // to multiplex on rather than opening a new one
+      curl_easy_setopt(easy_curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+      curl_easy_setopt(easy_curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
     if (!params.http_proxy_.http_proxy_.empty()) {
       curl_easy_setopt(easy_curl, CURLOPT_PROXY, params.http_proxy_.http_proxy_.c_str());
       curl_easy_setopt(easy_curl, CURLOPT_PROXYTYPE, CURLPROXY_HTTP);
@@ -126,6 +133,35 @@ OMAF_STATUS OmafCurlEasyHelper::setParams(CURL *easy_curl, CurlParams params) no
   }
 }
 
+OMAF_STATUS OmafCurlEasyHelper::setStreamWeight(CURL *easy_curl, TaskPriority priority) noexcept {
+  if (easy_curl == nullptr) {
+    return ERROR_NULL_PTR;
+  }
+
+  // HTTP/2 stream weight is in [1, 256], the server shares the connection
+  // bandwidth among concurrent streams in proportion to their weights
+  long weight = 16;
+  switch (priority) {
+    case TaskPriority::HIGH:
+      weight = 256;
+      break;
+    case TaskPriority::NORMAL:
+      weight = 64;
+      break;
+    case TaskPriority::LOW:
+      weight = 16;
+      break;
+    default:
+      break;
+  }
+  CURLcode res = curl_easy_setopt(easy_curl, CURLOPT_STREAM_WEIGHT, weight);
+  if (CURLE_OK != res) {
+    OMAF_LOG(LOG_WARNING, "Failed to set the http2 stream weight, code=%d\n", res);
+    return ERROR_INVALID;
+  }
+  return ERROR_NONE;
+}
+
 inline long OmafCurlEasyHelper::namelookupTime(CURL *easy_curl) noexcept {
   curl_off_t timev = 0;
   curl_easy_getinfo(easy_curl, CURLINFO_NAMELOOKUP_TIME_T, &timev);
@@ -95,6 +95,7 @@ class OmafCurlEasyHelper : public NonCopyable {
   static HttpHeader header(CURL *easy_curl) noexcept;
   static double speed(CURL *easy_curl) noexcept;
   static OMAF_STATUS setParams(CURL *easy_curl, CurlParams parmas) noexcept;
+  static OMAF_STATUS setStreamWeight(CURL *easy_curl, TaskPriority priority) noexcept;
   static bool success(const long http_status_code_) noexcept {
     return http_status_code_ >= 200 && http_status_code_ < 300;
   }
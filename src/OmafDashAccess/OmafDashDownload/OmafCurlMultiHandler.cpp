@@ -31,6 +31,7 @@
 //!
 
 #include "OmafCurlMultiHandler.h"
+#include <algorithm>
 #include <chrono>
 
 namespace VCD {
@@ -52,6 +53,19 @@ OMAF_STATUS OmafCurlMultiDownloader::init(const CurlParams& p, OmafDownloadTask:
     max_parallel_ = (max_parallel_transfers_ > 0) ? max_parallel_transfers_ : DEFAULT_MAX_PARALLER_TRANSFERS;
     OMAF_LOG(LOG_INFO, "Set max transfer to %ld\n", max_parallel_);
     curl_multi_setopt(curl_multi_, CURLMOPT_MAXCONNECTS, max_parallel_ << 1);
+    if (curl_params_.http_params_.enable_http2_) {
+      // tile segments from the same host share a few connections as
+      // multiplexed streams instead of one connection per transfer
+      long max_host_connections = curl_params_.http_params_.max_host_connections_ > 0
+                                      ? curl_params_.http_params_.max_host_connections_
+                                      : DEFAULT_HTTP2_MAX_HOST_CONNECTIONS;
+      curl_multi_setopt(curl_multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+      curl_multi_setopt(curl_multi_, CURLMOPT_MAX_HOST_CONNECTIONS, max_host_connections);
+#if LIBCURL_VERSION_NUM >= 0x074300
+      curl_multi_setopt(curl_multi_, CURLMOPT_MAX_CONCURRENT_STREAMS, max_parallel_);
+#endif
+      OMAF_LOG(LOG_INFO, "Enable http2 multiplexing with max %ld connections per host\n", max_host_connections);
+    }
 
     // 3. create the easy downloader pool
     downloader_pool_ = std::move(make_unique_vcd<OmafCurlEasyDownloaderPool>(max_parallel_ << 1));
@@ -103,8 +117,14 @@ OMAF_STATUS OmafCurlMultiDownloader::addTask(OmafDownloadTask::Ptr task) noexcep
     OMAF_LOG(LOG_INFO, "01-task id %lld, task count=%d\n", task->id(), task.use_count());
     task->state(OmafDownloadTask::State::READY);
     {
+      // keep the ready list ordered by priority, so a high priority task won't
+      // wait behind the low priority ones which are handed over earlier
       std::lock_guard<std::mutex> lock(ready_task_list_mutex_);
-      ready_task_list_.push_back(task);
+      auto it = ready_task_list_.begin();
+      while (it != ready_task_list_.end() && (*it)->priority() <= task->priority()) {
+        it++;
+      }
+      ready_task_list_.insert(it, task);
     }
     task_size_.fetch_add(1);
     OMAF_LOG(LOG_INFO, "02-task id %lld,  task count=%d\n", task->id(), task.use_count());
@@ -137,6 +157,23 @@ OMAF_STATUS OmafCurlMultiDownloader::removeTask(OmafDownloadTask::Ptr task) noex
   }
 }
 
+OMAF_STATUS OmafCurlMultiDownloader::cancelTask(OmafDownloadTask::Ptr task) noexcept {
+  try {
+    if (task.get() == nullptr) {
+      OMAF_LOG(LOG_ERROR, "Try to cancel empty task!\n");
+      return ERROR_INVALID;
+    }
+
+    // the curl multi handle is only touched in the worker thread
+    std::lock_guard<std::mutex> lock(cancel_task_list_mutex_);
+    cancel_tasks_.push_back(std::move(task));
+    return ERROR_NONE;
+  } catch (const std::exception& ex) {
+    OMAF_LOG(LOG_ERROR, "Exception when cancel task, ex: %s\n", ex.what());
+    return ERROR_INVALID;
+  }
+}
+
 OMAF_STATUS OmafCurlMultiDownloader::createTransferForTask(OmafDownloadTask::Ptr task) noexcept {
   int ret = ERROR_NONE;
   // 1. create header handler if in byte range mode
@@ -278,6 +315,9 @@ OMAF_STATUS OmafCurlMultiDownloader::startTransfer(OmafDownloadTask::Ptr task, O
       auto handler = downloader->handler();
       if (handler) {
         OMAF_LOG(LOG_INFO, "Add to multi handler transfer for url: %s, handler: %ld\n", task->url_.c_str(), reinterpret_cast<int64_t>(downloader->handler()));
+        if (curl_params_.http_params_.enable_http2_) {
+          OmafCurlEasyHelper::setStreamWeight(handler, task->priority());
+        }
         curl_multi_add_handle(curl_multi_, handler);
 
         task->state(OmafDownloadTask::State::RUNNING);
@@ -542,6 +582,8 @@ OMAF_STATUS OmafCurlMultiDownloader::moveHeaderTaskFromRun(OmafDownloadTask::Ptr
 void OmafCurlMultiDownloader::threadRunner(void) noexcept {
   try {
     while (bworking_) {
+      ProcessCancelTasks();
+
       startTaskDownload();
 
       int still_alive = 0;
@@ -702,5 +744,52 @@ OMAF_STATUS OmafCurlMultiDownloader::ProcessDataTasks() noexcept {
   return ERROR_NONE;
 }
 
+OMAF_STATUS OmafCurlMultiDownloader::ProcessCancelTasks() noexcept {
+  try {
+    std::vector<OmafDownloadTask::Ptr> tasks;
+    {
+      std::lock_guard<std::mutex> lock(cancel_task_list_mutex_);
+      if (cancel_tasks_.empty()) return ERROR_NONE;
+      tasks.swap(cancel_tasks_);
+    }
+
+    for (auto &task : tasks) {
+      bool bcanceled = false;
+      // 1. the task is still waiting in the ready list
+      {
+        std::lock_guard<std::mutex> lock(ready_task_list_mutex_);
+        auto it = std::find(ready_task_list_.begin(), ready_task_list_.end(), task);
+        if (it != ready_task_list_.end()) {
+          ready_task_list_.erase(it);
+          bcanceled = true;
+        }
+      }
+
+      // 2. the task is in transfer, the finished or failed ones have been reported
+      if (!bcanceled && task->state() == OmafDownloadTask::State::RUNNING) {
+        removeRunningTask(task);
+        {
+          std::lock_guard<std::mutex> lock(pending_data_task_list_mutex);
+          auto it = std::find(pending_data_tasks_.begin(), pending_data_tasks_.end(), task);
+          if (it != pending_data_tasks_.end()) {
+            pending_data_tasks_.erase(it);
+          }
+        }
+        bcanceled = true;
+      }
+
+      if (bcanceled) {
+        OMAF_LOG(LOG_INFO, "Cancel the %s\n", task->to_string().c_str());
+        task->state(OmafDownloadTask::State::STOPPED);
+        processTaskDone(std::move(task));
+      }
+    }
+    return ERROR_NONE;
+  } catch (const std::exception& ex) {
+    OMAF_LOG(LOG_ERROR, "Exception when process the cancel tasks, ex: %s\n", ex.what());
+    return ERROR_INVALID;
+  }
+}
+
 }  // namespace OMAF
 }  // namespace VCD
@@ -106,7 +106,8 @@ class OmafDownloadTask : public VCD::NonCopyable {
   OmafDownloadTask(const SourceParams &params, OmafDashSegmentClient::OnData dcb, OmafDashSegmentClient::OnChunkData cdcb, OmafDashSegmentClient::OnState scb)
       : url_(params.dash_url_), dcb_(dcb), cdcb_(cdcb), scb_(scb), header_size_(params.header_size_), cloc_size_(params.cloc_size_),
         chunk_num_(params.chunk_num_), enable_byte_range_(params.enable_byte_range_), downloaded_chunk_id_(params.start_chunk_id_ - 1),
-        stream_type_(params.stream_type_), chunk_info_type_(params.chunk_info_type_) {
+        stream_type_(params.stream_type_), chunk_info_type_(params.chunk_info_type_), priority_(params.priority_),
+        adaptation_set_id_(params.adaptation_set_id_) {
     id_ = TASK_ID.fetch_add(1);
     parseTask();
   };
@@ -132,6 +133,8 @@ class OmafDownloadTask : public VCD::NonCopyable {
   inline size_t headerSize(void) const noexcept { return header_size_; }
   inline size_t id() const noexcept { return id_; }
   inline bool enableByteRange() const noexcept { return enable_byte_range_; }
+  inline TaskPriority priority() const noexcept { return priority_; }
+  inline int32_t adaptationSetId() const noexcept { return adaptation_set_id_; }
   std::string to_string() const noexcept {
     std::stringstream ss;
     ss << "task, id=" << id_;
@@ -167,7 +170,8 @@ class OmafDownloadTask : public VCD::NonCopyable {
       case State::STOPPED:
       case State::TIMEOUT:
       case State::FINISH:
-        if (perf_counter_) {
+        // the task may be stopped before any transfer is created
+        if (perf_counter_ && easy_d_downloader_) {
           perf_counter_->downloadTime(easy_d_downloader_->downloadTime());
           perf_counter_->downloadSpeed(easy_d_downloader_->speed());
         }
@@ -262,6 +266,8 @@ class OmafDownloadTask : public VCD::NonCopyable {
   map<uint32_t, uint32_t> index_range_;
   DashStreamType stream_type_ = DASH_STREAM_STATIC;
   ChunkInfoType chunk_info_type_ = ChunkInfoType::NO_CHUNKINFO;
+  TaskPriority priority_ = TaskPriority::LOW;
+  int32_t adaptation_set_id_ = -1;
 
  private:
   static std::atomic_size_t TASK_ID;
@@ -288,6 +294,11 @@ class OmafCurlMultiDownloader : public VCD::NonCopyable {
  public:
   OMAF_STATUS addTask(OmafDownloadTask::Ptr task) noexcept;
   OMAF_STATUS removeTask(OmafDownloadTask::Ptr task) noexcept;
+  //!
+  //! \brief  Cancel a ready or running task. The task is stopped in the worker
+  //!         thread, and reported with STOPPED state through the done callback
+  //!
+  OMAF_STATUS cancelTask(OmafDownloadTask::Ptr task) noexcept;
 
   inline size_t size() const noexcept {  // return ready_task_list_.size() + run_task_map_.size();
     int size = task_size_.load();
@@ -311,6 +322,7 @@ class OmafCurlMultiDownloader : public VCD::NonCopyable {
   OMAF_STATUS startTaskDownload(void) noexcept;
   size_t retriveDoneTask(int msgNum = -1) noexcept;
   OMAF_STATUS ProcessDataTasks() noexcept;
+  OMAF_STATUS ProcessCancelTasks() noexcept;
   OMAF_STATUS createTransferForTask(OmafDownloadTask::Ptr task) noexcept;
   OMAF_STATUS startTransferForTask(OmafDownloadTask::Ptr task) noexcept;
   OMAF_STATUS createTransfer(OmafDownloadTask::Ptr task, OmafCurlEasyDownloader::Ptr& downloader) noexcept;
@@ -336,6 +348,8 @@ class OmafCurlMultiDownloader : public VCD::NonCopyable {
   bool bworking_ = false;
   std::mutex pending_data_task_list_mutex;
   std::vector<OmafDownloadTask::Ptr> pending_data_tasks_;
+  std::mutex cancel_task_list_mutex_;
+  std::vector<OmafDownloadTask::Ptr> cancel_tasks_;
 };
 
 }  // namespace OMAF
@@ -35,6 +35,7 @@
 #include "performance.h"
 
 #include <chrono>
+#include <iterator>
 #include <list>
 #include <map>
 #include <mutex>
@@ -52,6 +53,13 @@ struct _taskList {
 
   int64_t timeline_point_ = -1;
   std::list<OmafDownloadTask::Ptr> tasks_[PRIORITYTASKSIZE];
+
+  bool empty() const noexcept {
+    for (int i = 0; i < PRIORITYTASKSIZE; i++) {
+      if (tasks_[i].size()) return false;
+    }
+    return true;
+  }
 };
 using TaskList = struct _taskList;
 
@@ -80,6 +88,7 @@ class OmafDashSegmentHttpClientImpl : public OmafDashSegmentHttpClient {
   OMAF_STATUS open(const SourceParams &ds_params, OnData dcb, OnChunkData cdcb, OnState scb) noexcept override;
   OMAF_STATUS remove(const SourceParams &ds_params) noexcept override;
   OMAF_STATUS check(const SourceParams &ds_params) noexcept override;
+  OMAF_STATUS cancel(const std::set<int32_t> &adaptation_set_ids, TaskPriority priority) noexcept override;
   inline void setStatisticsWindows(int32_t time_window) noexcept override;
   inline std::unique_ptr<PerfStatistics> statistics(void) noexcept override;
 
@@ -328,6 +337,7 @@ OMAF_STATUS OmafDashSegmentHttpClientImpl::remove(const SourceParams &ds_params)
                 break;
               }
             }
+            it++;
           }
           break;
         }
@@ -369,6 +379,69 @@ OMAF_STATUS OmafDashSegmentHttpClientImpl::check(const SourceParams &ds_params)
   }
 }
 
+OMAF_STATUS OmafDashSegmentHttpClientImpl::cancel(const std::set<int32_t> &adaptation_set_ids,
+                                                  TaskPriority priority) noexcept {
+  try {
+    if (adaptation_set_ids.empty()) {
+      return ERROR_NONE;
+    }
+
+    auto is_stale = [&adaptation_set_ids, priority](const OmafDownloadTask::Ptr &task) {
+      return (task->priority() >= priority) &&
+             (adaptation_set_ids.find(task->adaptationSetId()) != adaptation_set_ids.end());
+    };
+
+    // 1. drop the tasks in the queue, they have never been started
+    std::list<OmafDownloadTask::Ptr> queued_tasks;
+    {
+      std::lock_guard<std::mutex> lock(task_queue_mutex_);
+      for (auto &tl : task_queue_) {
+        for (int i = static_cast<int>(priority); i < PRIORITYTASKSIZE; i++) {
+          auto &tasks = tl->tasks_[i];
+          std::list<OmafDownloadTask::Ptr>::iterator it = tasks.begin();
+          while (it != tasks.end()) {
+            if (is_stale(*it)) {
+              queued_tasks.push_back(std::move(*it));
+              it = tasks.erase(it);
+            } else {
+              it++;
+            }
+          }
+        }
+      }
+    }
+    for (auto &task : queued_tasks) {
+      task->state(OmafDownloadTask::State::STOPPED);
+      task->taskDoneCallback(OmafDownloadTask::State::STOPPED);
+    }
+
+    // 2. stop the downloading tasks, they will be reported in processDoneTask
+    std::list<OmafDownloadTask::Ptr> downloading_tasks;
+    {
+      std::lock_guard<std::mutex> lock(downloading_task_mutex_);
+      for (auto &it : downloading_tasks_) {
+        if (is_stale(it.second)) {
+          downloading_tasks.push_back(it.second);
+        }
+      }
+    }
+    if (segment_downloader_.get() != nullptr) {
+      for (auto &task : downloading_tasks) {
+        segment_downloader_->cancelTask(task);
+      }
+    }
+
+    if (queued_tasks.size() || downloading_tasks.size()) {
+      OMAF_LOG(LOG_INFO, "Cancel %lld queued and %lld downloading stale tasks\n", queued_tasks.size(),
+               downloading_tasks.size());
+    }
+    return ERROR_NONE;
+  } catch (const std::exception &ex) {
+    OMAF_LOG(LOG_ERROR, "Exception when cancel the dash source, ex: %s\n", ex.what());
+    return ERROR_INVALID;
+  }
+}
+
 inline void OmafDashSegmentHttpClientImpl::setStatisticsWindows(int32_t time_window) noexcept {
   if (perf_stats_ == nullptr) {
     perf_stats_.reset(new OmafDashSegmentHttpClientPerf());
@@ -419,21 +492,31 @@ OmafDownloadTask::Ptr OmafDashSegmentHttpClientImpl::fetchReadyTask(void) noexce
     std::unique_lock<std::mutex> lock(task_queue_mutex_);
 
     while (task_queue_.size()) {
-      auto &tl = task_queue_.front();
-      for (int i = 0; i < PRIORITYTASKSIZE; i++) {
-        if (tl->tasks_[i].size()) {
-          auto task = std::move(tl->tasks_[i].front());
-          tl->tasks_[i].pop_front();
-          return std::move(task);
+      // 1. drop the drained task lists, but keep the latest one for the coming tasks
+      std::list<TaskList::Ptr>::iterator it = task_queue_.begin();
+      while (std::next(it) != task_queue_.end()) {
+        if ((*it)->empty()) {
+          it = task_queue_.erase(it);
+        } else {
+          it++;
         }
       }
-      // no new task list with new timeline ready, then wait
-      if (task_queue_.size() <= 1) {
-        task_queue_cv_.wait(lock);
-      } else {
-        // drop the oldest task list of queue and move next
-        task_queue_.pop_front();
+
+      // 2. pick the task with the highest priority, so the tiles in viewport of
+      //    a later timeline won't wait behind the background tiles of earlier one.
+      //    the earlier queued timeline wins when the priority is the same
+      for (int i = 0; i < PRIORITYTASKSIZE; i++) {
+        for (auto &tl : task_queue_) {
+          if (tl->tasks_[i].size()) {
+            auto task = std::move(tl->tasks_[i].front());
+            tl->tasks_[i].pop_front();
+            return task;
+          }
+        }
       }
+
+      // 3. no new task ready, then wait
+      task_queue_cv_.wait(lock);
     }
 
     return nullptr;
@@ -42,6 +42,7 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <set>
 
 namespace VCD {
 namespace OMAF {
@@ -127,6 +128,9 @@ class OmafDashSegmentClient : public VCD::NonCopyable {
   virtual OMAF_STATUS open(const SourceParams &ds_params, OnData dcb, OnChunkData cdcb, OnState scb) noexcept = 0;
   virtual OMAF_STATUS remove(const SourceParams &dash_source) noexcept = 0;
   virtual OMAF_STATUS check(const SourceParams &dash_source) noexcept = 0;
+  // cancel the queued and downloading segments of the adaptation sets, whose
+  // priority is not higher than the given one
+  virtual OMAF_STATUS cancel(const std::set<int32_t> &adaptation_set_ids, TaskPriority priority) noexcept = 0;
   virtual void setStatisticsWindows(int32_t time_window) noexcept = 0;
   virtual std::unique_ptr<PerfStatistics> statistics(void) noexcept = 0;
 };
@@ -33,8 +33,10 @@
 #ifndef STREAM_H
 #define STREAM_H
 
-#include <fstream>
-#include <mutex>  //std::mutex, std::unique_lock
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "../OmafDashParser/Common.h"
 #include "../common.h"
@@ -53,19 +55,26 @@ class StreamBlock {
   //!
   StreamBlock() = default;
 
-  StreamBlock(char *data, int64_t size) : data_(data), size_(size), capacity_(size) {}
+  StreamBlock(char *data, int64_t size) : data_(data, std::default_delete<char[]>()), size_(size), capacity_(size) {}
+
+  //!
+  //! \brief Constructor for the read only block sharing the data of another block
+  //!
+  StreamBlock(std::shared_ptr<char> data, int64_t size)
+      : data_(std::move(data)), size_(size), capacity_(size), bOwner_(false) {}
   //!
   //! \brief Destructor
   //!
   ~StreamBlock() {
-    if (bOwner_ && data_ != nullptr) {
-      delete[] data_;
-      data_ = nullptr;
-    }
+    data_.reset();
     size_ = 0;
   }
-  char *buf() noexcept { return data_; }
-  const char *cbuf() const noexcept { return data_; }
+  char *buf() noexcept { return data_.get(); }
+  const char *cbuf() const noexcept { return data_.get(); }
+  //!
+  //! \brief the data shared by reference count, valid after the block is released
+  //!
+  std::shared_ptr<char> sharedData() const noexcept { return data_; }
   int64_t size() const noexcept { return size_; }
   int64_t capacity() const noexcept { return capacity_; }
   bool size(int64_t size) {
@@ -78,13 +87,10 @@ class StreamBlock {
   void *resize(int64_t size) {
     if (bOwner_) {
       if (size > capacity_) {
-        if (data_) {
-          delete[] data_;
-        }
-        data_ = new char[size];
+        data_.reset(new char[size], std::default_delete<char[]>());
         capacity_ = size;
       }
-      return data_;
+      return data_.get();
     } else {
       return nullptr;
     }
@@ -96,163 +102,287 @@ private:
 
  private:
   // stream data
-  char *data_ = nullptr;
+  std::shared_ptr<char> data_;
   // length of data
   int64_t size_ = 0;
   int64_t capacity_ = 0;
-  const bool bOwner_ = true;
+  bool bOwner_ = true;
 };
 
+//!
+//! \struct SharedBlockData
+//! \brief  data of one stream block shared by reference count
+//!
+struct SharedBlockData {
+  std::shared_ptr<char> data;
+  int64_t size = 0;
+};
+
+//! number of block slots in one page of the stream blocks index
+#define STREAM_BLOCKS_PAGE_SHIFT 10
+#define STREAM_BLOCKS_PAGE_SIZE (1 << STREAM_BLOCKS_PAGE_SHIFT)
+//! initial pages of the stream blocks index, 256K blocks in total, doubled when they are used up
+#define STREAM_BLOCKS_INIT_PAGES 256
+
+//!
+//! \class  StreamBlocks
+//! \brief  single producer single consumer store of downloaded stream blocks
+//! \detail the producer (the curl write callback) appends blocks by push_back, and
+//!          the consumer (the mp4 parser) reads, seeks and pops blocks. The blocks
+//!          are indexed by their cumulative end offsets in paged slots which are
+//!          never moved, so the consumer locates any offset by binary search
+//!          without lock. The page table grows by replacing it with a larger
+//!          copy, the replaced ones are kept until destruction since the
+//!          consumer may still walk them. clear() must not run concurrently
+//!          with push_back.
+//!
 class StreamBlocks : public VCD::MP4::StreamIO {
  public:
   StreamBlocks() = default;
-  ~StreamBlocks() {}
+  ~StreamBlocks() {
+    clear();
+    BlockSlot **pages = pages_.load(std::memory_order_relaxed);
+    for (uint64_t i = 0; i < pages_num_; i++) {
+      if (pages[i]) {
+        delete[] pages[i];
+        pages[i] = nullptr;
+      }
+    }
+    delete[] pages;
+    for (auto &retired : retired_pages_) {
+      delete[] retired;
+    }
+    retired_pages_.clear();
+  }
 
   StreamBlocks(const StreamBlocks& sbs) {}
 
- public:
-  offset_t ReadStream(char *buffer, offset_t size) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
+ private:
+  //!
+  //! \brief  index slot for one block
+  //!
+  struct BlockSlot {
+    StreamBlock *block = nullptr;  //!< the block, null after the block is popped
+    offset_t end = 0;              //!< cumulative end offset of the block since the first pushed one
+  };
 
-    offset_t offset = offset_;
+  BlockSlot &slot(uint64_t idx) const noexcept {
+    return pages_.load(std::memory_order_acquire)[idx >> STREAM_BLOCKS_PAGE_SHIFT][idx & (STREAM_BLOCKS_PAGE_SIZE - 1)];
+  }
 
-    std::list<std::unique_ptr<StreamBlock>>::const_iterator it = stream_blocks_.cbegin();
-    while (it != stream_blocks_.cend()) {
-      if (offset < (*it)->size()) {
-        break;
-      }
-      offset -= (*it)->size();
-      ++it;
+  //!
+  //! \brief  make the page table hold at least the given pages, only called by producer
+  //!
+  void ReservePages(uint64_t pagesNum) {
+    if (pagesNum <= pages_num_) return;
+    uint64_t newNum = pages_num_ ? pages_num_ : STREAM_BLOCKS_INIT_PAGES;
+    while (newNum < pagesNum) newNum <<= 1;
+
+    BlockSlot **pages = new BlockSlot *[newNum]();
+    BlockSlot **old = pages_.load(std::memory_order_relaxed);
+    for (uint64_t i = 0; i < pages_num_; i++) {
+      pages[i] = old[i];
     }
+    // the consumer loads the table after the count published by push_back,
+    // so it sees this table or the old one holding the same pages
+    pages_.store(pages, std::memory_order_release);
+    if (old) retired_pages_.push_back(old);
+    pages_num_ = newNum;
+  }
 
-    offset_t readSize = 0;
-    while (it != stream_blocks_.cend()) {
-      if (readSize >= size) break;
-
-      offset_t copySize = 0;
-      offset_t dataSize = (*it)->size() - offset;
-      if ((size - readSize) >= dataSize) {
-        copySize = dataSize;
+  //!
+  //! \brief  find the first block in [head, count) whose end is larger than the absolute offset
+  //!
+  uint64_t FindBlock(offset_t abs_offset, uint64_t head, uint64_t count) const noexcept {
+    uint64_t lo = head;
+    uint64_t hi = count;
+    while (lo < hi) {
+      uint64_t mid = lo + ((hi - lo) >> 1);
+      if (slot(mid).end <= abs_offset) {
+        lo = mid + 1;
       } else {
-        copySize = size - readSize;
+        hi = mid;
       }
+    }
+    return lo;
+  }
+
+  offset_t CopyFromOffset(char *buffer, offset_t offset, offset_t size) const noexcept {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t count = count_.load(std::memory_order_acquire);
+    offset_t base = base_.load(std::memory_order_acquire);
+    if (offset < 0 || size <= 0 || head >= count) return 0;
+
+    offset_t abs_offset = base + offset;
+    uint64_t idx = FindBlock(abs_offset, head, count);
 
-      memcpy_s(buffer + readSize, copySize, (*it)->cbuf() + offset, copySize);
+    offset_t readSize = 0;
+    while (idx < count && readSize < size) {
+      const BlockSlot &s = slot(idx);
+      offset_t blockStart = s.end - s.block->size();
+      offset_t inBlock = abs_offset + readSize - blockStart;
+      offset_t copySize = std::min(s.end - (abs_offset + readSize), size - readSize);
+
+      memcpy_s(buffer + readSize, copySize, s.block->cbuf() + inBlock, copySize);
       readSize += copySize;
-      offset = 0;  // set offset to 0 for coming blocks
-      ++it;
+      ++idx;
     }
+    return readSize;
+  }
 
+ public:
+  offset_t ReadStream(char *buffer, offset_t size) {
+    offset_t readSize = CopyFromOffset(buffer, offset_, size);
     offset_ += readSize;
 
     return readSize;
   };
 
   offset_t ReadStreamFromOffset(char *buffer, offset_t input_offset, offset_t size) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-
-    offset_t offset = input_offset;
-
-    if (stream_size_ < input_offset + size) {
+    if (GetStreamSize() < input_offset + size) {
       OMAF_LOG(LOG_WARNING, "dash stream has not enough data for offset %ld, size %ld\n", input_offset, size);
       return 0;
     }
 
-    std::list<std::unique_ptr<StreamBlock>>::const_iterator it = stream_blocks_.cbegin();
-    while (it != stream_blocks_.cend()) {
-      if (offset < (*it)->size()) {
-        break;
-      }
-      offset -= (*it)->size();
-      ++it;
-    }
-
-    offset_t readSize = 0;
-    while (it != stream_blocks_.cend()) {
-      if (readSize >= size) break;
-
-      offset_t copySize = 0;
-      offset_t dataSize = (*it)->size() - offset;
-      if ((size - readSize) >= dataSize) {
-        copySize = dataSize;
-      } else {
-        copySize = size - readSize;
-      }
-
-      memcpy_s(buffer + readSize, copySize, (*it)->cbuf() + offset, copySize);
-      readSize += copySize;
-      offset = 0;  // set offset to 0 for coming blocks
-      ++it;
-    }
-
-    return readSize;
+    return CopyFromOffset(buffer, input_offset, size);
   };
 
   bool SeekAbsoluteOffset(offset_t offset) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
     offset_ = offset;  // FIXME same logic with old file solution
     return true;
   };
 
+  //!
+  //! \brief  get the data of [offset, offset + size) in place when it lies in one block,
+  //!         the data is valid until the block is popped or the blocks are cleared
+  //!
+  const char *GetContiguousData(offset_t offset, offset_t size) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t count = count_.load(std::memory_order_acquire);
+    offset_t base = base_.load(std::memory_order_acquire);
+    if (offset < 0 || size <= 0 || head >= count) return nullptr;
+
+    offset_t abs_offset = base + offset;
+    uint64_t idx = FindBlock(abs_offset, head, count);
+    if (idx >= count) return nullptr;
+
+    const BlockSlot &s = slot(idx);
+    offset_t blockStart = s.end - s.block->size();
+    if (abs_offset + size > s.end) return nullptr;
+
+    return s.block->cbuf() + (abs_offset - blockStart);
+  };
+
   offset_t TellOffset() { return offset_; };
 
   offset_t GetStreamSize() {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    return stream_size_;
+    uint64_t count = count_.load(std::memory_order_acquire);
+    if (count == 0) return 0;
+    return slot(count - 1).end - base_.load(std::memory_order_acquire);
   };
 
  public:
   void push_back(std::unique_ptr<StreamBlock> sb) noexcept {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    stream_size_ += sb->size();
-    stream_blocks_.push_back(std::move(sb));
+    if (!sb) return;
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    uint64_t page = count >> STREAM_BLOCKS_PAGE_SHIFT;
+    ReservePages(page + 1);
+    BlockSlot **pages = pages_.load(std::memory_order_relaxed);
+    if (pages[page] == nullptr) {
+      pages[page] = new BlockSlot[STREAM_BLOCKS_PAGE_SIZE];
+    }
+
+    BlockSlot &s = slot(count);
+    s.end = (count ? slot(count - 1).end : 0) + sb->size();
+    s.block = sb.release();
+
+    // publish the slot to the consumer
+    count_.store(count + 1, std::memory_order_release);
   }
 
   std::unique_ptr<StreamBlock> pop_front() noexcept {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    std::unique_ptr<StreamBlock> sb = std::move(stream_blocks_.front());
-    stream_size_ -= sb->size();
-    stream_blocks_.pop_front();
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head >= count_.load(std::memory_order_acquire)) return nullptr;
+
+    BlockSlot &s = slot(head);
+    std::unique_ptr<StreamBlock> sb(s.block);
+    s.block = nullptr;
+    base_.store(s.end, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
     return sb;
   }
 
+  //!
+  //! \brief  pop and release the blocks lying completely in the first size bytes,
+  //!         return the released bytes which later offsets are shifted by
+  //!
+  offset_t drop_front(offset_t size) noexcept {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t count = count_.load(std::memory_order_acquire);
+    offset_t base = base_.load(std::memory_order_relaxed);
+    offset_t dropped = 0;
+    while (head < count && slot(head).end - base <= size) {
+      BlockSlot &s = slot(head);
+      delete s.block;
+      s.block = nullptr;
+      dropped = s.end - base;
+      base_.store(s.end, std::memory_order_release);
+      head_.store(++head, std::memory_order_release);
+    }
+    return dropped;
+  }
+
   void clear() noexcept {
-    while (!stream_blocks_.empty()) {
-      stream_blocks_.pop_front();
+    uint64_t count = count_.load(std::memory_order_acquire);
+    for (uint64_t idx = head_.load(std::memory_order_relaxed); idx < count; idx++) {
+      BlockSlot &s = slot(idx);
+      if (s.block) {
+        delete s.block;
+        s.block = nullptr;
+      }
     }
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    stream_size_ = 0;
+    count_.store(0, std::memory_order_release);
+    head_.store(0, std::memory_order_release);
+    base_.store(0, std::memory_order_release);
     offset_ = 0;
   }
 
-  bool cacheToFile(std::string &filename) noexcept {
-    std::ofstream of;  //<! file handle for writing
+  //!
+  //! \brief  share the data of all blocks without copy, fail if any block has been popped
+  //!
+  bool shareTo(std::vector<SharedBlockData> &blocks) const noexcept {
     try {
-      of.open(filename, ios::out | ios::binary);
-
-      for (auto &sb : stream_blocks_) {
-        of.write(sb->cbuf(), sb->size());
+      if (head_.load(std::memory_order_acquire) != 0) return false;
+
+      uint64_t count = count_.load(std::memory_order_acquire);
+      blocks.clear();
+      blocks.reserve(count);
+      for (uint64_t idx = 0; idx < count; idx++) {
+        const StreamBlock *block = slot(idx).block;
+        SharedBlockData shared;
+        shared.data = block->sharedData();
+        shared.size = block->size();
+        blocks.push_back(std::move(shared));
       }
-
-      of.close();
       return true;
     } catch (const std::exception &ex) {
-      OMAF_LOG(LOG_ERROR, "Exception when cache the file: %s, ex: %s\n", filename.c_str(), ex.what());
-      if (of.is_open()) {
-        of.close();
-      }
+      OMAF_LOG(LOG_ERROR, "Exception when share the stream blocks, ex: %s\n", ex.what());
       return false;
     }
   }
 
-  uint32_t GetStreamBlockSize() { return stream_blocks_.size(); }
-
- public:
-  std::list<std::unique_ptr<StreamBlock>> stream_blocks_;
+  uint32_t GetStreamBlockSize() {
+    return static_cast<uint32_t>(count_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+  }
 
-  std::mutex stream_mutex_;
-  offset_t stream_size_ = 0;
-  offset_t offset_ = 0;
+ private:
+  std::atomic<BlockSlot **> pages_{nullptr};              //!< page table of block slots, a page is never moved
+  uint64_t pages_num_ = 0;                                 //!< size of the page table, written by producer
+  std::vector<BlockSlot **> retired_pages_;                //!< replaced page tables, written by producer
+  std::atomic<uint64_t> count_{0};                         //!< number of pushed blocks, written by producer
+  std::atomic<uint64_t> head_{0};                          //!< index of the first block not popped
+  std::atomic<offset_t> base_{0};                          //!< cumulative end offset of popped blocks
+  offset_t offset_ = 0;                                    //!< read offset of consumer
 };
 }  // namespace OMAF
 }  // namespace VCD
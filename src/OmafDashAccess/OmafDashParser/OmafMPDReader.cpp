@@ -84,11 +84,11 @@ ODStatus OmafMPDReader::BuildMPD()
     m_mpd->SetPublishTime(m_rootXMLElement->GetAttributeVal(PUBLISHTIME));
     m_mpd->SetMediaPresentationDuration(m_rootXMLElement->GetAttributeVal(MEDIAPRESENTATIONDURATION));
 
-    map<string, string> attributes = m_rootXMLElement->GetAttributes();
+    const map<string, string>& attributes = m_rootXMLElement->GetAttributes();
     m_mpd->AddOriginalAttributes(attributes);
 
     CheckNullPtr_PrintLog_ReturnStatus(m_rootXMLElement, "Failed to create MPD node.\n", LOG_ERROR, OD_STATUS_OPERATION_FAILED);
-    vector<OmafXMLElement*> childElement = m_rootXMLElement->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = m_rootXMLElement->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -144,6 +144,127 @@ ODStatus OmafMPDReader::BuildMPD()
     return OD_STATUS_SUCCESS;
 }
 
+//!
+//! \brief  compare two XML trees, optionally ignoring the attributes of
+//!         SegmentTemplate elements which may be refreshed in place
+//!
+static bool IsSameXMLTree(OmafXMLElement* left, OmafXMLElement* right, bool skipSegmentAttrs)
+{
+    if(!left || !right)
+        return left == right;
+
+    if(left->GetName() != right->GetName() || left->GetText() != right->GetText())
+        return false;
+
+    if(!(skipSegmentAttrs && left->GetName() == "SegmentTemplate") &&
+       left->GetAttributes() != right->GetAttributes())
+        return false;
+
+    const vector<OmafXMLElement*>& leftChildren = left->GetChildElements();
+    const vector<OmafXMLElement*>& rightChildren = right->GetChildElements();
+    if(leftChildren.size() != rightChildren.size())
+        return false;
+
+    for(size_t i = 0; i < leftChildren.size(); i++)
+    {
+        if(!IsSameXMLTree(leftChildren[i], rightChildren[i], skipSegmentAttrs))
+            return false;
+    }
+
+    return true;
+}
+
+ODStatus OmafMPDReader::UpdateMPD(OmafXMLElement* root)
+{
+    if(!m_rootXMLElement || !m_mpd || !root)
+        return OD_STATUS_INVALID;
+
+    const vector<OmafXMLElement*>& oldChildren = m_rootXMLElement->GetChildElements();
+    const vector<OmafXMLElement*>& newChildren = root->GetChildElements();
+    if(root->GetName() != m_rootXMLElement->GetName() || oldChildren.size() != newChildren.size())
+        return OD_STATUS_INVALID;
+
+    // first pass only checks the layout, so the MPD tree is either refreshed
+    // completely or left untouched
+    vector<PeriodElement*> periods = m_mpd->GetPeriods();
+    vector<pair<PeriodElement*, pair<OmafXMLElement*, OmafXMLElement*>>> changedPeriods;
+    size_t periodIdx = 0;
+    for(size_t i = 0; i < oldChildren.size(); i++)
+    {
+        bool isPeriod = oldChildren[i]->GetName() == "Period";
+        if(IsSameXMLTree(oldChildren[i], newChildren[i], false))
+        {
+            if(isPeriod) periodIdx++;
+            continue;
+        }
+        // only SegmentTemplate attributes in Periods can be refreshed in place
+        if(!isPeriod || !IsSameXMLTree(oldChildren[i], newChildren[i], true) || periodIdx >= periods.size())
+            return OD_STATUS_INVALID;
+
+        changedPeriods.push_back(make_pair(periods[periodIdx], make_pair(oldChildren[i], newChildren[i])));
+        periodIdx++;
+    }
+
+    // the elements are built in the order of their XML elements, which lets
+    // the changed SegmentTemplates be located by index
+    vector<pair<SegmentElement*, pair<OmafXMLElement*, OmafXMLElement*>>> changedSegments;
+    for(auto& changed : changedPeriods)
+    {
+        vector<AdaptationSetElement*> adaptationSets = changed.first->GetAdaptationSets();
+
+        const vector<OmafXMLElement*>& oldAS = changed.second.first->GetChildElements();
+        const vector<OmafXMLElement*>& newAS = changed.second.second->GetChildElements();
+        size_t asIdx = 0;
+        for(size_t i = 0; i < oldAS.size(); i++)
+        {
+            if(oldAS[i]->GetName() != "AdaptationSet") continue;
+            if(asIdx >= adaptationSets.size()) return OD_STATUS_INVALID;
+            vector<RepresentationElement*> representations = adaptationSets[asIdx++]->GetRepresentations();
+
+            const vector<OmafXMLElement*>& oldRep = oldAS[i]->GetChildElements();
+            const vector<OmafXMLElement*>& newRep = newAS[i]->GetChildElements();
+            size_t repIdx = 0;
+            for(size_t j = 0; j < oldRep.size(); j++)
+            {
+                if(oldRep[j]->GetName() != "Representation") continue;
+                if(repIdx >= representations.size()) return OD_STATUS_INVALID;
+                SegmentElement* segment = representations[repIdx++]->GetSegment();
+
+                const vector<OmafXMLElement*>& oldSeg = oldRep[j]->GetChildElements();
+                const vector<OmafXMLElement*>& newSeg = newRep[j]->GetChildElements();
+                for(size_t k = 0; k < oldSeg.size(); k++)
+                {
+                    if(oldSeg[k]->GetName() != "SegmentTemplate" ||
+                       oldSeg[k]->GetAttributes() == newSeg[k]->GetAttributes())
+                        continue;
+                    if(!segment) return OD_STATUS_INVALID;
+                    changedSegments.push_back(make_pair(segment, make_pair(oldSeg[k], newSeg[k])));
+                }
+            }
+        }
+    }
+
+    m_mpd->SetType(root->GetAttributeVal(MPDTYPE));
+    m_mpd->SetMinBufferTime(root->GetAttributeVal(MINBUFFERTIME));
+    m_mpd->SetMaxSegmentDuration(root->GetAttributeVal(MAXSEGMENTDURATION));
+    m_mpd->SetAvailabilityStartTime(root->GetAttributeVal(AVAILABILITYSTARTTIME));
+    m_mpd->SetTimeShiftBufferDepth(root->GetAttributeVal(TIMESHIFTBUFFERDEPTH));
+    m_mpd->SetMinimumUpdatePeriod(root->GetAttributeVal(MINIMUMUPDATEPERIOD));
+    m_mpd->SetPublishTime(root->GetAttributeVal(PUBLISHTIME));
+    m_mpd->SetMediaPresentationDuration(root->GetAttributeVal(MEDIAPRESENTATIONDURATION));
+    m_rootXMLElement->SetAttributes(root->GetAttributes());
+
+    for(auto& changed : changedSegments)
+    {
+        ReadSegmentAttributes(changed.first, changed.second.second);
+        changed.second.first->SetAttributes(changed.second.second->GetAttributes());
+    }
+    OMAF_LOG(LOG_INFO, "Refresh MPD with %lu changed periods and %lu changed segment templates\n",
+             changedPeriods.size(), changedSegments.size());
+
+    return OD_STATUS_SUCCESS;
+}
+
 BaseUrlElement* OmafMPDReader::BuildBaseURL(OmafXMLElement* xmlBaseURL)
 {
     CheckNullPtr_PrintLog_ReturnNullPtr(xmlBaseURL, "Failed to read baseURL element.\n", LOG_ERROR);
@@ -153,7 +274,7 @@ BaseUrlElement* OmafMPDReader::BuildBaseURL(OmafXMLElement* xmlBaseURL)
     auto path = xmlBaseURL->GetPath();
     baseURL->SetPath(path);
 
-    map<string, string> attributes = xmlBaseURL->GetAttributes();
+    const map<string, string>& attributes = xmlBaseURL->GetAttributes();
     baseURL->AddOriginalAttributes(attributes);
 
     return baseURL;
@@ -167,10 +288,10 @@ PeriodElement* OmafMPDReader::BuildPeriod(OmafXMLElement* xmlPeriod)
     period->SetStart(xmlPeriod->GetAttributeVal(START));
     period->SetId(xmlPeriod->GetAttributeVal(INDEX));
 
-    map<string, string> attributes = xmlPeriod->GetAttributes();
+    const map<string, string>& attributes = xmlPeriod->GetAttributes();
     period->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlPeriod->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlPeriod->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -205,10 +326,10 @@ ServiceDescriptionElement* OmafMPDReader::BuildServiceDescription(OmafXMLElement
     CheckNullPtr_PrintLog_ReturnNullPtr(serviceDescription, "Failed to create serviceDescription node.\n", LOG_ERROR);
     serviceDescription->SetId(xmlServiceDescription->GetAttributeVal(INDEX));
 
-    map<string, string> attributes = xmlServiceDescription->GetAttributes();
+    const map<string, string>& attributes = xmlServiceDescription->GetAttributes();
     serviceDescription->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlServiceDescription->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlServiceDescription->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -245,10 +366,10 @@ LatencyElement* OmafMPDReader::BuildLatency(OmafXMLElement* xmlLatency)
 
     latency->SetTarget(xmlLatency->GetAttributeVal(TARGET));
 
-    map<string, string> attributes = xmlLatency->GetAttributes();
+    const map<string, string>& attributes = xmlLatency->GetAttributes();
     latency->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlLatency->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlLatency->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -274,10 +395,10 @@ ResyncElement* OmafMPDReader::BuildResync(OmafXMLElement* xmlResync)
 
     resync->SetChunkDuration(xmlResync->GetAttributeVal(DT));
 
-    map<string, string> attributes = xmlResync->GetAttributes();
+    const map<string, string>& attributes = xmlResync->GetAttributes();
     resync->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlResync->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlResync->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -305,10 +426,10 @@ ProducerReferenceTimeElement* OmafMPDReader::BuildProducerReferenceTime(OmafXMLE
     producerReferenceTime->SetWallclockTime(xmlProducerReferenceTime->GetAttributeVal(WALLCLOCKTIME));
     producerReferenceTime->SetPresentationTime(xmlProducerReferenceTime->GetAttributeVal(PRESENTATIONTIME));
 
-    map<string, string> attributes = xmlProducerReferenceTime->GetAttributes();
+    const map<string, string>& attributes = xmlProducerReferenceTime->GetAttributes();
     producerReferenceTime->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlProducerReferenceTime->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlProducerReferenceTime->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -346,10 +467,10 @@ AdaptationSetElement* OmafMPDReader::BuildAdaptationSet(OmafXMLElement* xml)
     adaptionSet->SetGopSize(xml->GetAttributeVal(GOPSIZE));
     adaptionSet->SetMode(xml->GetAttributeVal(MODE));
 
-    map<string, string> attributes = xml->GetAttributes();
+    const map<string, string>& attributes = xml->GetAttributes();
     adaptionSet->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xml->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xml->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -423,10 +544,10 @@ ViewportElement* OmafMPDReader::BuildViewport(OmafXMLElement* xmlViewport)
 
     viewport->ParseSchemeIdUriAndValue();
 
-    map<string, string> attributes = xmlViewport->GetAttributes();
+    const map<string, string>& attributes = xmlViewport->GetAttributes();
     viewport->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlViewport->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlViewport->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -456,10 +577,10 @@ EssentialPropertyElement* OmafMPDReader::BuildEssentialProperty(OmafXMLElement*
 
     essentialProperty->ParseSchemeIdUriAndValue();
 
-    map<string, string> attributes = xmlEssentialProperty->GetAttributes();
+    const map<string, string>& attributes = xmlEssentialProperty->GetAttributes();
     essentialProperty->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlEssentialProperty->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlEssentialProperty->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -492,10 +613,10 @@ RepresentationElement* OmafMPDReader::BuildRepresentation(OmafXMLElement* xmlRep
     representation->SetBandwidth(StringToInt(xmlRepresentation->GetAttributeVal(BANDWIDTH)));
     representation->SetDependencyID(xmlRepresentation->GetAttributeVal(DEPENDENCYID));
 
-    map<string, string> attributes = xmlRepresentation->GetAttributes();
+    const map<string, string>& attributes = xmlRepresentation->GetAttributes();
     representation->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlRepresentation->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlRepresentation->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -551,10 +672,10 @@ AudioChannelConfigurationElement* OmafMPDReader::BuildAudioChannelConfiguration(
 
     audioCfg->ParseSchemeIdUriAndValue();
 
-    map<string, string> attributes = xmlAudioChlCfg->GetAttributes();
+    const map<string, string>& attributes = xmlAudioChlCfg->GetAttributes();
     audioCfg->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlAudioChlCfg->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlAudioChlCfg->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -569,13 +690,8 @@ AudioChannelConfigurationElement* OmafMPDReader::BuildAudioChannelConfiguration(
     return audioCfg;
 }
 
-SegmentElement* OmafMPDReader::BuildSegment(OmafXMLElement* xmlSegment)
+void OmafMPDReader::ReadSegmentAttributes(SegmentElement* segment, OmafXMLElement* xmlSegment)
 {
-    CheckNullPtr_PrintLog_ReturnNullPtr(xmlSegment, "Failed to read segment element.\n", LOG_ERROR);
-
-    SegmentElement* segment = new SegmentElement();
-    CheckNullPtr_PrintLog_ReturnNullPtr(segment, "Failed to create segment node.\n", LOG_ERROR);
-
     segment->SetMedia(xmlSegment->GetAttributeVal(MEDIA));
     segment->SetInitialization(xmlSegment->GetAttributeVal(INITIALIZATION));
     segment->SetDuration(StringToInt(xmlSegment->GetAttributeVal(DURATION)));
@@ -590,11 +706,21 @@ SegmentElement* OmafMPDReader::BuildSegment(OmafXMLElement* xmlSegment)
         segment->SetAvailabilityTimeComplete(xmlSegment->GetAttributeVal(AVAILABILITYTIMECOMPLETE) == "true");
     else
         segment->SetAvailabilityTimeComplete(false);
+}
+
+SegmentElement* OmafMPDReader::BuildSegment(OmafXMLElement* xmlSegment)
+{
+    CheckNullPtr_PrintLog_ReturnNullPtr(xmlSegment, "Failed to read segment element.\n", LOG_ERROR);
+
+    SegmentElement* segment = new SegmentElement();
+    CheckNullPtr_PrintLog_ReturnNullPtr(segment, "Failed to create segment node.\n", LOG_ERROR);
+
+    ReadSegmentAttributes(segment, xmlSegment);
 
-    map<string, string> attributes = xmlSegment->GetAttributes();
+    const map<string, string>& attributes = xmlSegment->GetAttributes();
     segment->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlSegment->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlSegment->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -621,10 +747,10 @@ SupplementalPropertyElement* OmafMPDReader::BuildSupplementalProperty(OmafXMLEle
 
     supplementalProperty->ParseSchemeIdUriAndValue();
 
-    map<string, string> attributes = xmlSupplementalProperty->GetAttributes();
+    const map<string, string>& attributes = xmlSupplementalProperty->GetAttributes();
     supplementalProperty->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlSupplementalProperty->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlSupplementalProperty->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -661,10 +787,10 @@ SphRegionQualityElement* OmafMPDReader::BuildSphRegionQuality(OmafXMLElement* xm
     sphRegionQuality->SetQualityRankingLocalFlag((xmlSphRegionQuality->GetAttributeVal(QUALITY_RANKING_LOCAL_FLAG) == "true"));
     sphRegionQuality->SetQualityType(StringToInt(xmlSphRegionQuality->GetAttributeVal(QUALITY_TYPE)));
 
-    map<string, string> attributes = xmlSphRegionQuality->GetAttributes();
+    const map<string, string>& attributes = xmlSphRegionQuality->GetAttributes();
     sphRegionQuality->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlSphRegionQuality->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlSphRegionQuality->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -690,7 +816,7 @@ TwoDRegionQualityElement* OmafMPDReader::BuildTwoDRegionQuality(OmafXMLElement*
     TwoDRegionQualityElement* twoDRegionQuality = new TwoDRegionQualityElement();
     CheckNullPtr_PrintLog_ReturnNullPtr(twoDRegionQuality, "Failed to create sphere Region Quality node.\n", LOG_ERROR);
 
-    vector<OmafXMLElement*> childElement = xmlTwoDRegionQuality->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlTwoDRegionQuality->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -727,10 +853,10 @@ QualityInfoElement* OmafMPDReader::BuildQualityInfo(OmafXMLElement* xmlQualityIn
     qualityInfo->SetRegionWidth(StringToInt(xmlQualityInfo->GetAttributeVal(REGION_WIDTH)));
     qualityInfo->SetRegionHeight(StringToInt(xmlQualityInfo->GetAttributeVal(REGION_HEIGHT)));
 
-    map<string, string> attributes = xmlQualityInfo->GetAttributes();
+    const map<string, string>& attributes = xmlQualityInfo->GetAttributes();
     qualityInfo->AddOriginalAttributes(attributes);
 
-    vector<OmafXMLElement*> childElement = xmlQualityInfo->GetChildElements();
+    const vector<OmafXMLElement*>& childElement = xmlQualityInfo->GetChildElements();
     for(auto child : childElement)
     {
         if(!child)
@@ -85,6 +85,18 @@ public:
     //!
     virtual ODStatus BuildMPD();
 
+    //!
+    //! \brief    Refresh MPD tree in place with a newly parsed XML tree
+    //!
+    //! \param    [in] root
+    //!           root XML element of the updated MPD
+    //!
+    //! \return   ODStatus
+    //!           OD_STATUS_SUCCESS if refreshed in place, OD_STATUS_INVALID
+    //!           if the layout changed and the MPD tree needs to be rebuilt
+    //!
+    virtual ODStatus UpdateMPD(OmafXMLElement* root);
+
     //!
     //! \brief    Build Essential Property Element according to XML element
     //!
@@ -264,6 +276,17 @@ private:
     OmafMPDReader(const OmafMPDReader& other) { /* do not create copies */ };
 
 private:
+    //!
+    //! \brief    Read SegmentTemplate attributes into Segment Element
+    //!
+    //! \param    [in] segment
+    //!           OMAF Segment Element
+    //! \param    [in] xmlSegment
+    //!           Segment XML Element
+    //!
+    //! \return   void
+    //!
+    void ReadSegmentAttributes(SegmentElement* segment, OmafXMLElement* xmlSegment);
 
     OmafXMLElement      *m_rootXMLElement; //!< root XML element
     MPDElement          *m_mpd;            //!< root MPD element
@@ -90,6 +90,18 @@ public:
     //!
     virtual ODStatus BuildMPD() = 0;
 
+    //!
+    //! \brief    Refresh MPD tree in place with a newly parsed XML tree
+    //!
+    //! \param    [in] root
+    //!           root XML element of the updated MPD
+    //!
+    //! \return   ODStatus
+    //!           OD_STATUS_SUCCESS if refreshed in place, else the MPD tree
+    //!           needs to be rebuilt
+    //!
+    virtual ODStatus UpdateMPD(OmafXMLElement* root) = 0;
+
     //!
     //! \brief    Get MPD element
     //!
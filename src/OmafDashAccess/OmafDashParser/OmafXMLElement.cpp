@@ -69,20 +69,21 @@ string OmafXMLElement::GetPath()
     return m_path;
 }
 
-vector<OmafXMLElement*> OmafXMLElement::GetChildElements()
+const vector<OmafXMLElement*>& OmafXMLElement::GetChildElements()
 {
     return m_childElements;
 }
 
-map<string, string> OmafXMLElement::GetAttributes()
+const map<string, string>& OmafXMLElement::GetAttributes()
 {
     return m_attributes;
 }
 
-string OmafXMLElement::GetAttributeVal(string attrKey)
+string OmafXMLElement::GetAttributeVal(const string& attrKey)
 {
-    if(m_attributes.find(attrKey) != m_attributes.end())
-        return m_attributes[attrKey];
+    auto it = m_attributes.find(attrKey);
+    if(it != m_attributes.end())
+        return it->second;
 
     return "";
 }
@@ -112,4 +113,9 @@ void OmafXMLElement::AddAttribute(string attrKey, string attrVal)
     m_attributes.insert(pair<string, string>(attrKey, attrVal));
 }
 
+void OmafXMLElement::SetAttributes(const map<string, string>& attributes)
+{
+    m_attributes = attributes;
+}
+
 VCD_OMAF_END;
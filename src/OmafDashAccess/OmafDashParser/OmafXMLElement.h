@@ -85,7 +85,7 @@ public:
     //! \return   vector<OmafXMLElement*>
     //!           vector of XML elements
     //!
-    vector<OmafXMLElement*>      GetChildElements();
+    const vector<OmafXMLElement*>& GetChildElements();
 
     //!
     //! \brief    Get attributes of this element
@@ -93,7 +93,7 @@ public:
     //! \return   map<string, string>
     //!           map of attributes
     //!
-    map<string, string>          GetAttributes();
+    const map<string, string>&   GetAttributes();
 
     //!
     //! \brief    Get attributes of this element with key
@@ -104,7 +104,7 @@ public:
     //! \return   string
     //!           attribute value
     //!
-    string                       GetAttributeVal(string attrKey);
+    string                       GetAttributeVal(const string& attrKey);
 
     //!
     //! \brief    Set name for this element
@@ -158,6 +158,16 @@ public:
     //!
     void AddAttribute(string attrKey, string attrVal);
 
+    //!
+    //! \brief    Replace all attributes of this element
+    //!
+    //! \param    [in] attributes
+    //!           map of new attributes
+    //!
+    //! \return   void
+    //!
+    void SetAttributes(const map<string, string>& attributes);
+
 private:
 
     string                      m_name;          //!< name of this element
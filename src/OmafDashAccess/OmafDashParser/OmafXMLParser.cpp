@@ -33,6 +33,7 @@
 #include "OmafXMLParser.h"
 
 #include <fstream>
+#include <iterator>
 
 VCD_OMAF_BEGIN
 
@@ -40,87 +41,82 @@ using namespace tinyxml2;
 
 OmafXMLParser::OmafXMLParser() {
   m_mpdReader = nullptr;
-  m_xmlDoc = nullptr;
 }
 
 OmafXMLParser::~OmafXMLParser() {
   if (m_mpdReader) m_mpdReader->Close();
   SAFE_DELETE(m_mpdReader);
-  SAFE_DELETE(m_xmlDoc);
 }
 
-size_t OmafXMLParser::WriteData(void* ptr, size_t size, size_t nmemb, FILE* fp) { return fwrite(ptr, size, nmemb, fp); }
+bool OmafXMLParser::FetchManifest(string url, std::string& manifest) {
+  manifest.clear();
 
-std::string OmafXMLParser::DownloadXMLFile(string url, string cache_dir) {
-  if (cache_dir.empty()) {
-    cache_dir = ".";
-  }
-
-  std::string fileName =
-      cache_dir + "/" + url.substr(url.find_last_of('/') + 1, url.length() - url.find_last_of('/') - 1);
+  // define the url is local or through network with prefix
+  string url_prefix = "http";
+  bool local = url.length() < url_prefix.length() || url.substr(0, 4) != url_prefix;
 
-  std::ofstream mpd_file;
-  mpd_file.open(fileName, ios::out);
+  if (local) {
+    std::ifstream mpd_file(url, ios::in | ios::binary);
+    if (!mpd_file.is_open()) {
+      OMAF_LOG(LOG_ERROR, "Failed to open the mpd file: %s\n", url.c_str());
+      return false;
+    }
+    manifest.assign(std::istreambuf_iterator<char>(mpd_file), std::istreambuf_iterator<char>());
+    return true;
+  }
 
   OmafCurlEasyDownloader downloader(OmafCurlEasyDownloader::CurlWorkMode::EASY_MODE);
   int ret = downloader.init(m_curl_params);
   if (ret == ERROR_NONE) {
     OMAF_LOG(LOG_INFO, "To download the xml mpd with url: %s\n", url.c_str());
-    OMAF_LOG(LOG_INFO, "Save the xml mpd file to path: %s\n", fileName.c_str());
     ret = downloader.open(url);
     if (ret == ERROR_NONE) {
       ret = downloader.start(
           0, 0,
-          [&mpd_file, fileName](std::unique_ptr<StreamBlock> sb) {
+          [&manifest](std::unique_ptr<StreamBlock> sb) {
             OMAF_LOG(LOG_INFO, "Receive the stream block, size=%lld\n", sb->size());
-            if (mpd_file.is_open()) {
-              mpd_file.write(sb->cbuf(), sb->size());
-            } else {
-              OMAF_LOG(LOG_ERROR, "The file is not in open state, file: %s\n", fileName.c_str());
-            }
+            manifest.append(sb->cbuf(), sb->size());
           }, nullptr,
           [url](OmafCurlEasyDownloader::State s) {
             OMAF_LOG(LOG_INFO, "Download state: %d for url: %s\n", static_cast<int>(s), url.c_str());
           });
       if (ret == ERROR_NONE) {
-        OMAF_LOG(LOG_INFO, "Success to start the mpd downloader!\n");
-      } else {
-        OMAF_LOG(LOG_ERROR, "Failed to start the mpd downloader, err=%d\n", ret);
-      }
-
-      if (mpd_file.is_open()) {
-        mpd_file.close();
+        OMAF_LOG(LOG_INFO, "Success to download the mpd, size=%lu\n", manifest.size());
+        return !manifest.empty();
       }
-      return fileName;
+      OMAF_LOG(LOG_ERROR, "Failed to start the mpd downloader, err=%d\n", ret);
     }
   }
   OMAF_LOG(LOG_ERROR, "Failed to download the mpd file, whose url:%s\n", url.c_str());
-  return std::string();
+  return false;
 }
 
-ODStatus OmafXMLParser::Generate(string url, string cacheDir) {
-  ODStatus ret = OD_STATUS_SUCCESS;
+OmafXMLElement* OmafXMLParser::ParseManifest(const std::string& manifest) {
+  // the tinyxml document is only needed until the OMAF XML tree is built
+  XMLDocument xmlDoc;
+  XMLError result = xmlDoc.Parse(manifest.data(), manifest.size());
+  if (result != XML_SUCCESS) {
+    OMAF_LOG(LOG_ERROR, "Failed to parse the mpd, err=%d\n", static_cast<int>(result));
+    return nullptr;
+  }
 
-  m_path = url.substr(0, url.find_last_of('/'));
+  XMLElement* elmt = xmlDoc.FirstChildElement();
+  CheckNullPtr_PrintLog_ReturnNullPtr(elmt, "Failed to get element from XML Doc.\n", LOG_ERROR);
 
-  // define the url is local or through network with prefix
-  string url_prefix = "http";
-  bool local = m_path.length() < url_prefix.length() || m_path.substr(0, 4) != url_prefix;
+  return BuildXMLElementTree(elmt);
+}
 
-  string fileName = local ? url : DownloadXMLFile(url, cacheDir);
-  if (!fileName.length()) return OD_STATUS_INVALID;
+ODStatus OmafXMLParser::Generate(string url, string cacheDir) {
+  ODStatus ret = OD_STATUS_SUCCESS;
 
-  m_xmlDoc = new XMLDocument();
-  CheckNullPtr_PrintLog_ReturnStatus(m_xmlDoc, "Failed to create XMLDocument with tinyXML.\n", LOG_ERROR,
-                                     OD_STATUS_OPERATION_FAILED);
-  OMAF_LOG(LOG_INFO, "To parse the mpd file: %s\n", fileName.c_str());
-  XMLError result = m_xmlDoc->LoadFile(fileName.c_str());
-  if (result != XML_SUCCESS) return OD_STATUS_OPERATION_FAILED;
+  m_path = url.substr(0, url.find_last_of('/'));
 
-  XMLElement* elmt = m_xmlDoc->FirstChildElement();
-  CheckNullPtr_PrintLog_ReturnStatus(elmt, "Failed to get element from XML Doc.\n", LOG_ERROR, OD_STATUS_OPERATION_FAILED);
+  // the mpd is parsed from memory, so nothing is written to cacheDir
+  std::string manifest;
+  if (!FetchManifest(url, manifest)) return OD_STATUS_INVALID;
 
-  OmafXMLElement* root = BuildXMLElementTree(elmt);
+  OMAF_LOG(LOG_INFO, "To parse the mpd file: %s\n", url.c_str());
+  OmafXMLElement* root = ParseManifest(manifest);
   if (!root) {
     OMAF_LOG(LOG_ERROR, "Build XML elements tree failed!\n");
     return OD_STATUS_OPERATION_FAILED;
@@ -132,10 +128,38 @@ ODStatus OmafXMLParser::Generate(string url, string cacheDir) {
     return OD_STATUS_OPERATION_FAILED;
   }
 
-  // delete the downloaded mpd file after it's parsed.
-  // if (!local && 0 != remove(fileName.c_str())) {
-  //  LOG(WARNING) << "Failed to delete the downloaded MPD file: " << fileName);
-  //}
+  m_manifest.swap(manifest);
+
+  return ret;
+}
+
+ODStatus OmafXMLParser::Update(string url) {
+  if (!m_mpdReader) {
+    OMAF_LOG(LOG_ERROR, "please generate MPD tree firstly.\n");
+    return OD_STATUS_INVALID;
+  }
+
+  std::string manifest;
+  if (!FetchManifest(url, manifest)) return OD_STATUS_OPERATION_FAILED;
+
+  // most updates of a live mpd don't change anything
+  if (manifest == m_manifest) return OD_STATUS_SUCCESS;
+
+  OmafXMLElement* root = ParseManifest(manifest);
+  if (!root) {
+    OMAF_LOG(LOG_ERROR, "Build XML elements tree failed!\n");
+    return OD_STATUS_OPERATION_FAILED;
+  }
+
+  // the changed values are copied into the current trees
+  ODStatus ret = m_mpdReader->UpdateMPD(root);
+  SAFE_DELETE(root);
+  if (ret != OD_STATUS_SUCCESS) {
+    OMAF_LOG(LOG_WARNING, "The layout of the mpd changed, it needs to be generated again!\n");
+    return ret;
+  }
+
+  m_manifest.swap(manifest);
 
   return ret;
 }
@@ -71,17 +71,30 @@ class OmafXMLParser {
   ODStatus Generate(string url, string cacheDir);
 
   //!
-  //! \brief    Download MPD file
+  //! \brief    Refresh the generated MPD tree with the latest MPD
   //!
   //! \param    [in] url
   //!           MPD file url
-  //!           [in] cacheDir
-  //!           cache directory
   //!
-  //! \return   string
-  //!           the name of downloaded file
+  //! \return   ODStatus
+  //!           OD_STATUS_SUCCESS if the MPD is unchanged or refreshed in
+  //!           place, OD_STATUS_INVALID if its layout changed and it needs
+  //!           to be generated again, else fail reason
+  //!
+  ODStatus Update(string url);
+
+  //!
+  //! \brief    Fetch MPD file content into memory
+  //!
+  //! \param    [in] url
+  //!           MPD file url or local path
+  //! \param    [out] manifest
+  //!           MPD file content
   //!
-  std::string DownloadXMLFile(string url, string cacheDir);
+  //! \return   bool
+  //!           true if success, else false
+  //!
+  bool FetchManifest(string url, std::string& manifest);
 
   //!
   //! \brief    Generate XML tree
@@ -136,24 +149,18 @@ private:
   void ReadAttributes(OmafXMLElement* element, tinyxml2::XMLElement* orgElement);
 
   //!
-  //! \brief    Write data to file
+  //! \brief    Parse MPD file content into XML tree
   //!
-  //! \param    [in] ptr
-  //!           data pointer
-  //! \param    [in] size
-  //!           data size
-  //! \param    [in] nmemb
-  //!           data type size
-  //! \param    [in] fp
-  //!           file handle
+  //! \param    [in] manifest
+  //!           MPD file content
   //!
-  //! \return   size_t
-  //!           size of wrote data
+  //! \return   OmafXMLElement
+  //!           root OMAF XML element, nullptr if fail
   //!
-  static size_t WriteData(void* ptr, size_t size, size_t nmemb, FILE* fp);
+  OmafXMLElement* ParseManifest(const std::string& manifest);
 
-  tinyxml2::XMLDocument* m_xmlDoc = nullptr;  //!< tinyxml document
   string m_path;                              //!< url path
+  std::string m_manifest;                     //!< content of the last parsed MPD
   OmafReaderBase* m_mpdReader;                //!< MPD reader
   CurlParams m_curl_params;
 };
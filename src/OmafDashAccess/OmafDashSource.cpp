@@ -188,7 +188,11 @@ int OmafDashSource::OpenMedia(std::string url, std::string cacheDir, void* exter
   } else if (ret != ERROR_NONE)
     return ret;
 
-  mMPDinfo = this->GetMPDInfo();
+  SAFE_DELETE(mMPDinfo);
+  mMPDinfo = new MPDInfo;
+  if (nullptr == mMPDinfo) return ERROR_NULL_PTR;
+  ret = mMPDParser->GetMPDInfo(mMPDinfo);
+  if (ret != ERROR_NONE) return ret;
 
   ProjectionFormat projFmt = mMPDParser->GetProjectionFmt();
   std::string projStr;
@@ -219,7 +223,13 @@ int OmafDashSource::OpenMedia(std::string url, std::string cacheDir, void* exter
 
     std::string prefix = mMPDinfo->baseURL[0].substr(pos + 1, mMPDinfo->baseURL[0].length() - (pos + 1));
     pDM->SetFilePrefix(prefix);
-    pDM->SetUseCache((cacheDir == "") ? false : true);
+    // segments are cached in memory for seek back and replay of static media if configured
+    if (omaf_dash_params_.max_segment_cache_size_ > 0 && mMPDinfo->type == TYPE_STATIC) {
+      pDM->SetMaxCacheSize(omaf_dash_params_.max_segment_cache_size_);
+      pDM->SetUseCache(true);
+    } else {
+      pDM->SetUseCache(false);
+    }
 
     // sync local time according to the remote mechine for live mode
     if (mMPDinfo->type == TYPE_LIVE && bSync_time) {
@@ -250,6 +260,10 @@ int OmafDashSource::OpenMedia(std::string url, std::string cacheDir, void* exter
     params.mode_ = mode;
     params.proj_fmt_ = projFmt;
     params.segment_timeout_ms_ = mMPDinfo->max_segment_duration;
+    if (omaf_dash_params_.stats_params_.enable_) {
+      stage_stats_ = std::make_shared<OmafStageStatistics>();
+      params.stage_stats_ = stage_stats_;
+    }
 
     OMAF_LOG(LOG_INFO, "media stream type=%s\n", mMPDinfo->type.c_str());
     OMAF_LOG(LOG_INFO, "media stream duration=%lld\n", mMPDinfo->media_presentation_duration);
@@ -275,6 +289,8 @@ int OmafDashSource::OpenMedia(std::string url, std::string cacheDir, void* exter
     if (!enableExtractor && (stream->GetStreamMediaType() == MediaType_Video))
     {
       stream->SetMaxStitchResolution(omaf_dash_params_.max_decode_width_, omaf_dash_params_.max_decode_height_);
+      stream->SetStitchThreadNum(omaf_dash_params_.max_stitch_threads_);
+      stream->SetSpanOutput(omaf_dash_params_.enable_span_output_);
     }
     id++;
   }
@@ -380,6 +396,8 @@ int OmafDashSource::GetPacket(int streamID, std::list<MediaPacket*>* pkts, bool
   MediaPacket* pkt = nullptr;
 
   int currentExtractorID = 0;
+  auto get_start = std::chrono::steady_clock::now();
+  size_t pkts_size = pkts->size();
 
   if (pStream->GetDashMode() == OmafDashMode::EXTRACTOR) {
     std::list<OmafExtractor*> extractors = pStream->GetEnabledExtractor();
@@ -489,6 +507,13 @@ int OmafDashSource::GetPacket(int streamID, std::list<MediaPacket*>* pkts, bool
     }
   }
 
+  if (stage_stats_ && pkts->size() > pkts_size) {
+    stage_stats_->record(LatencyStage_GetPacket,
+                         OmafStageStatistics::trackType(pStream->GetStreamMediaType(),
+                                                        pStream->GetDashMode() == OmafDashMode::EXTRACTOR),
+                         get_start);
+  }
+
   return ERROR_NONE;
 }
 
@@ -509,8 +534,28 @@ int OmafDashSource::GetStatistic(DashStatisticInfo* dsInfo) {
   return ERROR_NONE;
 }
 
+int OmafDashSource::GetStageStatistic(DashStageStatisticInfo* info) {
+  if (info == nullptr) return ERROR_NULL_PTR;
+  if (!stage_stats_) return ERROR_NO_VALUE;
+
+  stage_stats_->statistic(info);
+  return ERROR_NONE;
+}
+
+int OmafDashSource::DumpStageStatistic(std::string& json) {
+  if (!stage_stats_) return ERROR_NO_VALUE;
+
+  json = stage_stats_->to_json();
+  return ERROR_NONE;
+}
+
 int OmafDashSource::SetupHeadSetInfo(HeadSetInfo* clientInfo) {
   memcpy_s(&mHeadSetInfo, sizeof(HeadSetInfo), clientInfo, sizeof(HeadSetInfo));
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mViewportSeq++;
+  }
+  mViewportCv.notify_all();
   return ERROR_NONE;
 }
 
@@ -519,13 +564,19 @@ int OmafDashSource::ChangeViewport(HeadPose* pose) {
     pose->pts += omaf_reader_mgr_->GetStartOffsetPts();
   }
   int ret = m_selector->UpdateViewport(pose);
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mViewportSeq++;
+  }
+  mViewportCv.notify_all();
 
   return ret;
 }
 
 int OmafDashSource::GetMediaInfo(DashMediaInfo* media_info) {
-  MPDInfo* mInfo = this->GetMPDInfo();
-  if (!mInfo) return ERROR_NULL_PTR;
+  MPDInfo info;
+  if (ERROR_NONE != this->GetMPDInfo(&info)) return ERROR_NULL_PTR;
+  MPDInfo* mInfo = &info;
 
   media_info->duration = mInfo->media_presentation_duration;
   media_info->stream_count = this->GetStreamCount();
@@ -657,6 +708,26 @@ int OmafDashSource::StartReadThread() {
   return ERROR_NONE;
 }
 
+bool OmafDashSource::WaitForReadThreadStarted() {
+  while (true) {
+    uint64_t viewportSeq = 0;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      viewportSeq = mViewportSeq;
+    }
+    if (ERROR_NONE == StartReadThread()) return true;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    // the timeout only guards against the selection waiting for something else than the viewport
+    mViewportCv.wait_for(lock, std::chrono::milliseconds(100),
+                         [this, viewportSeq] { return mViewportSeq != viewportSeq || STATUS_EXITING == mStatus; });
+    if (STATUS_EXITING == mStatus) {
+      OMAF_LOG(LOG_INFO, "Stop waiting for tracks selection since the source is exiting!\n");
+      return false;
+    }
+  }
+}
+
 int OmafDashSource::SelectSpecialSegments(int extractorTrackIdx) {
   int ret = ERROR_NONE;
 
@@ -694,10 +765,28 @@ int OmafDashSource::UpdateEnabledTracks() {
     OmafMediaStream* pStream = it->second;
     ret = m_selector->UpdateEnabledTracks(pStream);
     if (ERROR_NONE != ret) break;
+    CancelStaleDownloads(pStream);
   }
   return ret;
 }
 
+void OmafDashSource::CancelStaleDownloads(OmafMediaStream* pStream) {
+  if (nullptr == pStream || dash_client_.get() == nullptr) return;
+
+  std::set<int32_t> disabledAS;
+  std::map<int, OmafAdaptationSet*> mediaAS = pStream->GetMediaAdaptationSet();
+  for (auto it = mediaAS.begin(); it != mediaAS.end(); it++) {
+    OmafAdaptationSet* pAS = it->second;
+    if (pAS && !pAS->IsEnabled()) {
+      disabledAS.insert(pAS->GetID());
+    }
+  }
+  // the tiles in viewport are kept, they may be still used by current segment
+  if (!disabledAS.empty()) {
+    dash_client_->cancel(disabledAS, TaskPriority::NORMAL);
+  }
+}
+
 void OmafDashSource::ClearStreams() {
   std::map<int, OmafMediaStream*>::iterator it;
   for (it = this->mMapStream.begin(); it != this->mMapStream.end(); it++) {
@@ -774,25 +863,18 @@ void OmafDashSource::thread_dynamic() {
     SetStatus(STATUS_STOPPED);
     return;
   }
-  uint32_t wait_time = 10000;
-  uint32_t current_wait_time = 0;
-  bool isInitSegParsed = omaf_reader_mgr_->IsInitSegmentsParsed();
-  while (!isInitSegParsed) {
-    ::usleep(1000);
-    current_wait_time++;
-    if (current_wait_time > wait_time)
-    {
-      SetStatus(STATUS_STOPPED);
-      OMAF_LOG(LOG_ERROR, " Time out for waiting init segment parse!\n");
-      return;
-    }
-    isInitSegParsed = omaf_reader_mgr_->IsInitSegmentsParsed();
+  uint32_t wait_time = 10000; // ms
+  if (!omaf_reader_mgr_->WaitForInitSegmentsParsed(wait_time)) {
+    SetStatus(STATUS_STOPPED);
+    OMAF_LOG(LOG_ERROR, " Time out for waiting init segment parse!\n");
+    return;
   }
 
   m_enableCMAF = omaf_reader_mgr_->IsCmafContent();
 
-  while ((ERROR_NONE != StartReadThread())) {
-    ::usleep(1000);
+  if (!WaitForReadThreadStarted()) {
+    SetStatus(STATUS_STOPPED);
+    return;
   }
 
   uint32_t uLastUpdateTime = sys_clock();
@@ -875,24 +957,17 @@ void OmafDashSource::thread_static() {
     SetStatus(STATUS_STOPPED);
     return;
   }
-  uint32_t wait_time = 10000;
-  uint32_t current_wait_time = 0;
-  bool isInitSegParsed = omaf_reader_mgr_->IsInitSegmentsParsed();
-  while (!isInitSegParsed) {
-    ::usleep(1000);
-    current_wait_time++;
-    if (current_wait_time > wait_time)
-    {
-      SetStatus(STATUS_STOPPED);
-      OMAF_LOG(LOG_ERROR, " Time out for waiting init segment parse!\n");
-      return;
-    }
-    isInitSegParsed = omaf_reader_mgr_->IsInitSegmentsParsed();
+  uint32_t wait_time = 10000; // ms
+  if (!omaf_reader_mgr_->WaitForInitSegmentsParsed(wait_time)) {
+    SetStatus(STATUS_STOPPED);
+    OMAF_LOG(LOG_ERROR, " Time out for waiting init segment parse!\n");
+    return;
   }
   m_enableCMAF = omaf_reader_mgr_->IsCmafContent();
 
-  while ((ERROR_NONE != StartReadThread())) {
-    ::usleep(1000);
+  if (!WaitForReadThreadStarted()) {
+    SetStatus(STATUS_STOPPED);
+    return;
   }
 
   // -0.1 for framerate.den is 1001
@@ -1132,7 +1207,30 @@ int OmafDashSource::DownloadAssignedSegments(std::map<uint32_t, TracksMap> addit
   return ret;
 }
 
-int OmafDashSource::UpdateMPD() { return ERROR_NONE; }
+int OmafDashSource::UpdateMPD() {
+  if (nullptr == mMPDParser || nullptr == mMPDinfo || mMPDinfo->type != "dynamic") return ERROR_NONE;
+
+  int ret = mMPDParser->UpdateMPD();
+  if (ret == ERROR_INVALID) {
+    OMAF_LOG(LOG_WARNING, "Keep the current streams since the stream layout in MPD changed!\n");
+    return ret;
+  } else if (ret != ERROR_NONE) {
+    return ret;
+  }
+
+  // the SegmentTemplates are refreshed in place, the AdaptationSets cache
+  // the numbering taken from them
+  ret = mMPDParser->GetMPDInfo(mMPDinfo);
+  if (ret != ERROR_NONE) return ret;
+  for (auto it = mMapStream.begin(); it != mMapStream.end(); it++) {
+    ret = it->second->UpdateSegmentTemplate();
+    if (ERROR_NONE != ret) {
+      OMAF_LOG(LOG_ERROR, "Failed to update segment template for stream %d!\n", it->first);
+      return ret;
+    }
+  }
+  return ERROR_NONE;
+}
 
 std::map<uint32_t, std::map<int, OmafAdaptationSet*>> OmafDashSource::GetNewTracksFromDownloaded(std::map<uint32_t, std::map<int, OmafAdaptationSet*>> additional_tracks, std::list<pair<uint32_t, int>> downloadedCatchupTracks, map<uint32_t, uint32_t> catchupTimesInSeg)
 {
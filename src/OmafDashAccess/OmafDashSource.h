@@ -44,6 +44,8 @@
 #include "DownloadManager.h"
 #include "OmafTracksSelector.h"
 #include "OmafTilesStitch.h"
+#include "OmafStageStatistics.h"
+#include <condition_variable>
 #include <mutex>
 
 using namespace VCD::OMAF;
@@ -74,6 +76,8 @@ class OmafDashSource : public OmafMediaSource, Threadable {
   virtual int CloseMedia();
   virtual int GetPacket(int streamID, std::list<MediaPacket*>* pkts, bool needParams, bool clearBuf);
   virtual int GetStatistic(DashStatisticInfo* dsInfo);
+  virtual int GetStageStatistic(DashStageStatisticInfo* info);
+  virtual int DumpStageStatistic(std::string& json);
   virtual int SetupHeadSetInfo(HeadSetInfo* clientInfo);
   virtual int ChangeViewport(HeadPose* pose);
   virtual int GetMediaInfo(DashMediaInfo* media_info);
@@ -115,6 +119,12 @@ class OmafDashSource : public OmafMediaSource, Threadable {
   //!
   int UpdateEnabledTracks();
 
+  //!
+  //! \brief  Cancel the downloading of the predicted and background tracks
+  //!         which are no longer selected after viewport changes
+  //!
+  void CancelStaleDownloads(OmafMediaStream* pStream);
+
   //!
   //! \brief run thread for dynamic mpd processing
   //!
@@ -165,21 +175,32 @@ class OmafDashSource : public OmafMediaSource, Threadable {
   void SetStatus(DASH_STATUS status) {
     std::lock_guard<std::mutex> lock(mMutex);
     mStatus = status;
+    mViewportCv.notify_all();
   };
 
   //!
-  //! \brief Get MPD information
+  //! \brief Get a copy of MPD information
   //!
-  MPDInfo* GetMPDInfo() {
-    if (!mMPDParser) return nullptr;
+  int GetMPDInfo(MPDInfo* info) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mMPDParser) return ERROR_NULL_PTR;
 
-    return mMPDParser->GetMPDInfo();
+    return mMPDParser->GetMPDInfo(info);
   };
 
   int SyncTime(std::string url);
 
   int StartReadThread();
 
+  //!
+  //! \brief Start the read thread, the tracks selection it needs depends on the
+  //!        viewport, so it's retried once the viewport is updated
+  //!
+  //! \return bool
+  //!         true if started, false if the source is exiting
+  //!
+  bool WaitForReadThreadStarted();
+
   uint64_t GetChunkDuration() {
     uint64_t chunkDuration = 0;
     for (auto it = this->mMapStream.begin(); it != this->mMapStream.end(); it++) {
@@ -200,13 +221,16 @@ private:
   DASH_STATUS mStatus;             //<! the status of the source
   OmafTracksSelector* m_selector;  //<! tracks selector basing on viewport
   std::mutex mMutex;               //<! for synchronization
-  MPDInfo* mMPDinfo;               //<! MPD information
+  std::condition_variable mViewportCv;  //<! notified when the viewport is updated or the status changes
+  uint64_t mViewportSeq = 0;       //<! increased when the viewport is updated
+  MPDInfo* mMPDinfo;               //<! MPD information, refreshed by the download thread
   int dcount;
   int mPreExtractorID;
   vector<uint32_t> mPreTracksID;
   OmafTilesStitch* m_stitch = nullptr;
   std::shared_ptr<OmafDashSegmentClient> dash_client_;
   std::shared_ptr<OmafReaderManager> omaf_reader_mgr_;
+  OmafStageStatistics::Ptr stage_stats_;  //<! latency statistic of stages, null if disabled
   bool mIsLocalMedia;
   pthread_t m_catchupThread; //<! catch up thread ID
   bool m_enableCMAF = false;
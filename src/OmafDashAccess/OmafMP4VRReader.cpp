@@ -104,6 +104,22 @@ class SegmentStream : public VCD::MP4::StreamIO {
     return mSegment->GetStreamSize();
   };
 
+  //!
+  //! \brief Get the data of the segment in place without copy
+  //!
+  //! \param  [in] offset
+  //!         offset of the data
+  //! \param  [in] size
+  //!         size of the data
+  //!
+  //! \return const char*
+  //!         the data, or nullptr if it isn't held in contiguous memory
+  virtual const char* GetContiguousData(offset_t offset, offset_t size) {
+    if (nullptr == mSegment) return nullptr;
+
+    return mSegment->GetContiguousData(offset, size);
+  };
+
  private:
   OmafSegment* mSegment = nullptr;
 };
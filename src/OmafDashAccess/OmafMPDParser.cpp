@@ -48,6 +48,7 @@ OmafMPDParser::OmafMPDParser() {
 
 OmafMPDParser::~OmafMPDParser() {
   SAFE_DELETE(mParser);
+  SAFE_DELETE(mMPDInfo);
   mTwoDQualityInfos.clear();
   // SAFE_DELETE(mMpd);
   // SAFE_DELETE(mLock);
@@ -100,44 +101,47 @@ int OmafMPDParser::ParseMPD(std::string mpd_file, OMAFSTREAMS& listStream) {
 }
 
 int OmafMPDParser::ParseMPDInfo() {
-  mMPDInfo = new MPDInfo;
-  if (!mMPDInfo) return ERROR_NULL_PTR;
+  // the information is built aside and published as a whole, so readers
+  // holding mLock never see a half updated MPDInfo. caller holds mLock.
+  MPDInfo info = MPDInfo();
+  if (mMPDInfo) info = *mMPDInfo;
 
   auto baseUrl = mMpd->GetBaseUrls().back();
-  mMPDInfo->mpdPathBaseUrl = baseUrl->GetPath();
-  mMPDInfo->profiles = mMpd->GetProfiles();
-  mMPDInfo->type = mMpd->GetType();
+  info.mpdPathBaseUrl = baseUrl->GetPath();
+  info.profiles = mMpd->GetProfiles();
+  info.type = mMpd->GetType();
 
   if (!mMpd->GetMediaPresentationDuration().empty()) {
-    mMPDInfo->media_presentation_duration = parse_duration(mMpd->GetMediaPresentationDuration().c_str());
+    info.media_presentation_duration = parse_duration(mMpd->GetMediaPresentationDuration().c_str());
   }
 
   if (!mMpd->GetAvailabilityStartTime().empty()) {
-    mMPDInfo->availabilityStartTime = parse_date(mMpd->GetAvailabilityStartTime().c_str());
+    info.availabilityStartTime = parse_date(mMpd->GetAvailabilityStartTime().c_str());
   }
   if (!mMpd->GetAvailabilityEndTime().empty()) {
-    mMPDInfo->availabilityEndTime = parse_date(mMpd->GetAvailabilityEndTime().c_str());
+    info.availabilityEndTime = parse_date(mMpd->GetAvailabilityEndTime().c_str());
   }
   if (!mMpd->GetMaxSegmentDuration().empty()) {
-    mMPDInfo->max_segment_duration = parse_duration(mMpd->GetMaxSegmentDuration().c_str());
+    info.max_segment_duration = parse_duration(mMpd->GetMaxSegmentDuration().c_str());
   }
   if (!mMpd->GetMinBufferTime().empty()) {
-    mMPDInfo->min_buffer_time = parse_duration(mMpd->GetMinBufferTime().c_str());
+    info.min_buffer_time = parse_duration(mMpd->GetMinBufferTime().c_str());
   }
   if (!mMpd->GetMinimumUpdatePeriod().empty()) {
-    mMPDInfo->minimum_update_period = parse_duration(mMpd->GetMinimumUpdatePeriod().c_str());
+    info.minimum_update_period = parse_duration(mMpd->GetMinimumUpdatePeriod().c_str());
   }
   if (!mMpd->GetSuggestedPresentationDelay().empty()) {
-    mMPDInfo->suggested_presentation_delay = parse_int(mMpd->GetSuggestedPresentationDelay().c_str());
+    info.suggested_presentation_delay = parse_int(mMpd->GetSuggestedPresentationDelay().c_str());
   }
   if (!mMpd->GetTimeShiftBufferDepth().empty()) {
-    mMPDInfo->time_shift_buffer_depth = parse_duration(mMpd->GetTimeShiftBufferDepth().c_str());
+    info.time_shift_buffer_depth = parse_duration(mMpd->GetTimeShiftBufferDepth().c_str());
   }
 
   mBaseUrls = mMpd->GetBaseUrls();
+  info.baseURL.clear();
   // Get all base urls except the last one
   for (uint32_t i = 0; i < mBaseUrls.size() - 1; i++) {
-    mMPDInfo->baseURL.push_back(mBaseUrls[i]->GetPath());
+    info.baseURL.push_back(mBaseUrls[i]->GetPath());
   }
 
   mPF = mMpd->GetProjectionFormat();
@@ -147,20 +151,50 @@ int OmafMPDParser::ParseMPDInfo() {
   if (dsElem != nullptr) {
     latency = dsElem->GetLatency();
     if (latency != nullptr) {
-      mMPDInfo->target_latency = atoi(latency->GetTarget().c_str());
+      info.target_latency = atoi(latency->GetTarget().c_str());
     }
   }
   else {
-    mMPDInfo->target_latency = 0; // not in low latency mode
+    info.target_latency = 0; // not in low latency mode
   }
 
+  if (nullptr == mMPDInfo) {
+    mMPDInfo = new MPDInfo;
+    if (!mMPDInfo) return ERROR_NULL_PTR;
+  }
+  *mMPDInfo = info;
+
   return ERROR_NONE;
 }
 
-int OmafMPDParser::UpdateMPD(OMAFSTREAMS& listStream) { return ParseMPD(this->mMPDURL, listStream); }
+int OmafMPDParser::UpdateMPD() {
+  if (nullptr == mParser || nullptr == mMpd) return ERROR_NULL_PTR;
+
+  std::lock_guard<std::mutex> lock(mLock);
+
+  ODStatus st = mParser->Update(mMPDURL);
+  if (st == OD_STATUS_INVALID) {
+    OMAF_LOG(LOG_WARNING, "The layout of MPD %s changed, the streams need to be parsed again!\n", mMPDURL.c_str());
+    return ERROR_INVALID;
+  } else if (st != OD_STATUS_SUCCESS) {
+    OMAF_LOG(LOG_ERROR, "Failed to update MPD file: %s\n", mMPDURL.c_str());
+    return ERROR_PARSE;
+  }
+
+  return ParseMPDInfo();
+}
 
 MPDInfo* OmafMPDParser::GetMPDInfo() { return this->mMPDInfo; }
 
+int OmafMPDParser::GetMPDInfo(MPDInfo* info) {
+  if (nullptr == info) return ERROR_NULL_PTR;
+
+  std::lock_guard<std::mutex> lock(mLock);
+  if (nullptr == mMPDInfo) return ERROR_NULL_PTR;
+  *info = *mMPDInfo;
+  return ERROR_NONE;
+}
+
 //!
 //! \brief construct media streams.
 //!
@@ -80,15 +80,23 @@ class OmafMPDParser {
   int ParseMPD(std::string mpd_file, OMAFSTREAMS& listStream);
 
   //!
-  //! \brief  update MPD and get construct media streams for live if needed.
+  //! \brief  refresh the parsed MPD in place for live. only the changed
+  //!         SegmentTemplates are updated, so the streams built by ParseMPD
+  //!         stay valid. ERROR_INVALID means the layout changed and the
+  //!         streams need to be built again with ParseMPD.
   //!
-  int UpdateMPD(OMAFSTREAMS& listStream);
+  int UpdateMPD();
 
   //!
   //! \brief  Get MPD information.
   //!
   MPDInfo* GetMPDInfo();
 
+  //!
+  //! \brief  Copy MPD information, safe against a concurrent UpdateMPD.
+  //!
+  int GetMPDInfo(MPDInfo* info);
+
   //!
   //! \brief  Set cache dir.
   //!
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+
+ *
+ */
+
+//!
+//! \file:   OmafMappedFile.cpp
+//! \brief:  implementation of the memory mapped file stream
+//!
+//! Created on Nov 21, 2022, 10:20 AM
+//!
+
+#include "OmafMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace VCD {
+namespace OMAF {
+
+int OmafMappedFile::Open(const std::string &path) noexcept {
+  Close();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    OMAF_LOG(LOG_ERROR, "Failed to open file %s\n", path.c_str());
+    return ERROR_NOT_FOUND;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    OMAF_LOG(LOG_ERROR, "Failed to get the size of file %s\n", path.c_str());
+    close(fd);
+    return ERROR_INVALID;
+  }
+
+  if (st.st_size > 0) {
+    void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      OMAF_LOG(LOG_ERROR, "Failed to map file %s\n", path.c_str());
+      close(fd);
+      return ERROR_MEMORY;
+    }
+    data_ = static_cast<const char *>(addr);
+  }
+  // the mapping keeps the file referenced
+  close(fd);
+
+  size_ = static_cast<offset_t>(st.st_size);
+  offset_ = 0;
+  opened_ = true;
+  return ERROR_NONE;
+}
+
+void OmafMappedFile::Close() noexcept {
+  if (data_) {
+    munmap(const_cast<char *>(data_), static_cast<size_t>(size_));
+    data_ = nullptr;
+  }
+  size_ = 0;
+  offset_ = 0;
+  opened_ = false;
+}
+
+void OmafMappedFile::WillNeed() noexcept {
+  if (data_) {
+    madvise(const_cast<char *>(data_), static_cast<size_t>(size_), MADV_WILLNEED);
+  }
+}
+
+void OmafMappedFile::Sequential() noexcept {
+  if (data_) {
+    madvise(const_cast<char *>(data_), static_cast<size_t>(size_), MADV_SEQUENTIAL);
+  }
+}
+
+VCD::MP4::StreamIO::offset_t OmafMappedFile::ReadStream(char *buffer, offset_t size) {
+  if (!buffer || size <= 0 || offset_ >= size_) return 0;
+
+  offset_t readSize = std::min(size, size_ - offset_);
+  memcpy_s(buffer, readSize, data_ + offset_, readSize);
+  offset_ += readSize;
+  return readSize;
+}
+
+bool OmafMappedFile::SeekAbsoluteOffset(offset_t offset) {
+  // same as file stream, seeking beyond the end is ok and the next read returns nothing
+  if (!opened_ || offset < 0) return false;
+
+  offset_ = offset;
+  return true;
+}
+
+const char *OmafMappedFile::GetContiguousData(offset_t offset, offset_t size) {
+  if (!data_ || offset < 0 || size <= 0 || offset + size > size_) return nullptr;
+
+  return data_ + offset;
+}
+
+}  // namespace OMAF
+}  // namespace VCD
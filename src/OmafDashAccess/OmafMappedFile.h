@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+
+ *
+ */
+
+//!
+//! \file:   OmafMappedFile.h
+//! \brief:  memory mapped file stream for local and stored segments
+//! \detail: the whole segment file is mapped read-only, so the mp4 parser
+//!          reads atoms in place instead of copying them through a file
+//!          stream, and the kernel is advised to read ahead the mapped
+//!          segments before they are parsed.
+//!
+//! Created on Nov 21, 2022, 10:20 AM
+//!
+
+#ifndef OMAFMAPPEDFILE_H_
+#define OMAFMAPPEDFILE_H_
+
+#include "../utils/ns_def.h"
+#include "general.h"
+#include "common.h"
+#include "../isolib/dash_parser/Mp4StreamIO.h"
+
+#include <string>
+
+namespace VCD {
+namespace OMAF {
+
+//!
+//! \class  OmafMappedFile
+//! \brief  read-only StreamIO over a memory mapped file
+//!
+class OmafMappedFile : public VCD::MP4::StreamIO, public VCD::NonCopyable {
+ public:
+  OmafMappedFile() = default;
+  virtual ~OmafMappedFile() { Close(); };
+
+ public:
+  //!
+  //! \brief  map the file, an empty file is opened without mapping
+  //!
+  //! \param  [in] path
+  //!         file path
+  //!
+  //! \return int
+  //!         ERROR_NONE if success, else failed reason
+  //!
+  int Open(const std::string &path) noexcept;
+
+  //!
+  //! \brief  unmap the file
+  //!
+  void Close() noexcept;
+
+  bool IsOpen() const noexcept { return opened_; };
+
+  //!
+  //! \brief  advise the kernel to read the whole file ahead, it is called
+  //!         when the segment is queued so the data is loaded before parsing
+  //!
+  void WillNeed() noexcept;
+
+  //!
+  //! \brief  advise the kernel that the file is read sequentially
+  //!
+  void Sequential() noexcept;
+
+ public:
+  offset_t ReadStream(char *buffer, offset_t size) override;
+
+  bool SeekAbsoluteOffset(offset_t offset) override;
+
+  offset_t TellOffset() override { return offset_; };
+
+  offset_t GetStreamSize() override { return size_; };
+
+  const char *GetContiguousData(offset_t offset, offset_t size) override;
+
+ private:
+  const char *data_ = nullptr;
+  offset_t size_ = 0;
+  offset_t offset_ = 0;
+  bool opened_ = false;
+};
+
+}  // namespace OMAF
+}  // namespace VCD
+
+#endif /* OMAFMAPPEDFILE_H_ */
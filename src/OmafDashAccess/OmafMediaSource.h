@@ -176,6 +176,20 @@ class OmafMediaSource {
   //!
   virtual int GetStatistic(DashStatisticInfo* dsInfo) = 0;
 
+  //!
+  //! \brief  Get the latency statistic of download, parse, stitch and get packet stages
+  //! \param  [out] info
+  //!         the latency of each stage for each track type
+  //! \return
+  //!         ERROR_NO_VALUE if the statistic is disabled
+  //!
+  virtual int GetStageStatistic(DashStageStatisticInfo* info) { return ERROR_NO_VALUE; };
+
+  //!
+  //! \brief  Dump the latency statistic of all stages as JSON string
+  //!
+  virtual int DumpStageStatistic(std::string& json) { return ERROR_NO_VALUE; };
+
   //!
   //! \brief  seek to special position of the media in VOD mode
   //!
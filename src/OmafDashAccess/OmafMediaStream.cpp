@@ -156,8 +156,14 @@ void OmafMediaStream::SetOmafReaderMgr(std::shared_ptr<OmafReaderManager> mgr) n
 
 void OmafMediaStream::Close() {
   if (m_status != STATUS_STOPPED) {
-    m_status = STATUS_STOPPED;
-    m_catchup_status = STATUS_STOPPED;
+    {
+      std::lock_guard<std::mutex> lock(mCurrentMutex);
+      m_status = STATUS_STOPPED;
+      m_catchup_status = STATUS_STOPPED;
+    }
+    // wake up the stitching threads waiting for tiles selection or packets
+    m_selectionCond.notify_all();
+    if (omaf_reader_mgr_) omaf_reader_mgr_->WakeUpParsedSegmentWaiters();
     if (m_stitchThread) {
       pthread_join(m_stitchThread, NULL);
       m_stitchThread = 0;
@@ -550,6 +556,28 @@ int OmafMediaStream::UpdateStartNumber(uint64_t nAvailableStartTime) {
   return ret;
 }
 
+int OmafMediaStream::UpdateSegmentTemplate() {
+  int ret = ERROR_NONE;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (auto it = mMediaAdaptationSet.begin(); it != mMediaAdaptationSet.end(); it++) {
+    OmafAdaptationSet* pAS = (OmafAdaptationSet*)(it->second);
+    ret = pAS->UpdateSegmentTemplate();
+    if (ERROR_NONE != ret) return ret;
+  }
+  std::lock_guard<std::mutex> lock_et(mExtractorsMutex);
+  for (auto extrator_it = mExtractors.begin(); extrator_it != mExtractors.end(); extrator_it++) {
+    OmafExtractor* extractor = (OmafExtractor*)(extrator_it->second);
+    ret = extractor->UpdateSegmentTemplate();
+    if (ERROR_NONE != ret) return ret;
+  }
+  if (m_pStreamInfo && mMainAdaptationSet) {
+    m_pStreamInfo->segmentDuration = mMainAdaptationSet->GetSegmentDuration();
+    m_pStreamInfo->chunkDuration = mMainAdaptationSet->GetChunkDuration();
+  }
+  return ret;
+}
+
 int OmafMediaStream::DownloadInitSegment() {
   std::lock_guard<std::mutex> lock(mMutex);
   for (auto it = mMediaAdaptationSet.begin(); it != mMediaAdaptationSet.end(); it++) {
@@ -808,6 +836,7 @@ int OmafMediaStream::UpdateEnabledTileTracks(std::map<int, OmafAdaptationSet*> s
       mCurrentTracks.clear();
       mCurrentTracks = oneSelection;
     }
+    m_selectionCond.notify_all();
   }
 
   return ret;
@@ -892,18 +921,19 @@ int32_t OmafMediaStream::GetSelectedPacketsWithPTS(uint64_t targetPTS, pair<uint
       return ERROR_NULL_PTR;
     }
     // LOG(INFO) << "Target pts is " << targetPTS << " track id " << track.first << endl;
+    uint64_t parsed_seq = omaf_reader_mgr_->GetParsedSequence();
     ret = omaf_reader_mgr_->GetNextPacketWithPTS(track.first, targetPTS, onePacket, needParams);
 
-    uint32_t wait_time_get_packet = 0;
-    uint32_t wait_timeout_get_packet = 100;
-    while (((onePacket && onePacket->GetEOS()) || (ret == ERROR_NULL_PACKET)) && (wait_time_get_packet < wait_timeout_get_packet) && m_catchup_status != STATUS_STOPPED)
+    if (!m_pStreamInfo) {
+      SAFE_DELETE(onePacket);
+      return ERROR_NULL_PTR;
+    }
+    // wait for at most half segment duration, wake up once a new segment/chunk is parsed
+    auto wait_deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(m_pStreamInfo->segmentDuration * 1000000 / 2);
+    while (((onePacket && onePacket->GetEOS()) || (ret == ERROR_NULL_PACKET)) && m_catchup_status != STATUS_STOPPED)
     {
-      if (!m_pStreamInfo) {
-        SAFE_DELETE(onePacket);
-        return ERROR_NULL_PTR;
-      }
-      usleep((m_pStreamInfo->segmentDuration * 1000000 / 2) / wait_timeout_get_packet);
-      wait_time_get_packet++;
+      if (!omaf_reader_mgr_->WaitForParsedSegment(parsed_seq, wait_deadline))
+        break;
       //OMAF_LOG(LOG_INFO, "To get packet %ld for track %d\n", currFramePTS, trackID);
       ret = omaf_reader_mgr_->GetNextPacketWithPTS(track.first, targetPTS, onePacket, needParams);
     }
@@ -1049,31 +1079,26 @@ int32_t OmafMediaStream::TilesStitching() {
   }
   int ret = ERROR_NONE;
   bool selectedFlag = false;
-  uint32_t wait_time = 30000;
-  uint32_t current_wait_time = 0;
+  uint32_t wait_time = 3000; // ms
 
-  do
   {
-    {
-      std::lock_guard<std::mutex> lock(mCurrentMutex);
-      selectedFlag = m_hasTileTracksSelected;
-    }
-    usleep(100);
-    current_wait_time++;
-    if (current_wait_time > wait_time)
-    {
-      OMAF_LOG(LOG_ERROR, "Time out for tile track select!\n");
-      return ERROR_INVALID;
-    }
-  }while (!selectedFlag);
+    std::unique_lock<std::mutex> lock(mCurrentMutex);
+    selectedFlag = m_selectionCond.wait_for(lock, std::chrono::milliseconds(wait_time),
+                                            [this] { return m_hasTileTracksSelected || m_status == STATUS_STOPPED; });
+    if (m_status == STATUS_STOPPED) return ERROR_NONE;
+  }
+  if (!selectedFlag)
+  {
+    OMAF_LOG(LOG_ERROR, "Time out for tile track select!\n");
+    return ERROR_INVALID;
+  }
 
   uint64_t currFramePTS = 0;
   uint64_t currSegTimeLine = 0;
   std::map<int, OmafAdaptationSet*> mapSelectedAS;
   bool isEOS = false;
   uint32_t waitTimes = 1000;
-  uint32_t waitTimes_GetPacket = 100;
-  uint32_t selectionWaitTimes = 10000;
+  uint32_t selectionWaitTime = 500; // ms
   bool prevPoseChanged = false;
   std::map<int, OmafAdaptationSet*> prevSelectedAS;
   bool segmentEnded = false;
@@ -1082,11 +1107,15 @@ int32_t OmafMediaStream::TilesStitching() {
   bool skipFrames = false;
   bool beginNewSeg = false;
 
+  // start offset pts is set when the first segment is parsed
   int64_t startOffsetPts = -1;
-  do {
+  uint64_t parsedSeq = omaf_reader_mgr_->GetParsedSequence();
+  startOffsetPts = omaf_reader_mgr_->GetStartOffsetPts();
+  while (startOffsetPts < 0) {
+    if (m_status == STATUS_STOPPED) return ERROR_NONE;
+    omaf_reader_mgr_->WaitForParsedSegment(parsedSeq, std::chrono::steady_clock::now() + std::chrono::milliseconds(selectionWaitTime));
     startOffsetPts = omaf_reader_mgr_->GetStartOffsetPts();
-    usleep(50);
-  }while (startOffsetPts < 0);
+  }
 
   currFramePTS = startOffsetPts;
 
@@ -1117,25 +1146,15 @@ int32_t OmafMediaStream::TilesStitching() {
     {
         if (prevSelectedAS.empty())
         {
-          while (currWaitTimes < selectionWaitTimes)
           {
+            std::unique_lock<std::mutex> lock(mCurrentMutex);
+            bool selected = m_selectionCond.wait_for(lock, std::chrono::milliseconds(selectionWaitTime),
+                                                     [this] { return m_selectedTileTracks.size() >= 2 || m_status == STATUS_STOPPED; });
+            if (!selected || m_status == STATUS_STOPPED)
             {
-              std::lock_guard<std::mutex> lock(mCurrentMutex);
-              if (m_selectedTileTracks.size() >= 2)
-                  break;
+              OMAF_LOG(LOG_ERROR, "Wait too much time for tiles selection, timed out !\n");
+              break;
             }
-            usleep(50);
-            currWaitTimes++;
-          }
-          if (currWaitTimes >= selectionWaitTimes)
-          {
-            OMAF_LOG(LOG_ERROR, "Wait too much time for tiles selection, timed out !\n");
-            break;
-          }
-          currWaitTimes = 0;
-
-          {
-            std::lock_guard<std::mutex> lock(mCurrentMutex);
 
             //m_selectedTileTracks.pop_front(); //At the beginning, there are two same tiles selection in m_selectedTileTracks due to previous process in StartReadThread, so remove repeated one
             updatedSelectedAS = m_selectedTileTracks[1]; //At the beginning, there are two same tiles selection in m_selectedTileTracks due to previous process in StartReadThread, so remove repeated one
@@ -1144,23 +1163,14 @@ int32_t OmafMediaStream::TilesStitching() {
         }
         else
         {
-          while (currWaitTimes < selectionWaitTimes)
           {
-            {
-              std::lock_guard<std::mutex> lock(mCurrentMutex);
-              std::map<uint64_t, std::map<int, OmafAdaptationSet*>>::iterator it;
-              it = m_selectedTileTracks.find(currSegTimeLine);
-              if (it != m_selectedTileTracks.end())
-                  break;
-            }
-
-            usleep((m_pStreamInfo->segmentDuration * 1000000) / selectionWaitTimes);
-            currWaitTimes++;
-          }
-
-          {
-            std::lock_guard<std::mutex> lock(mCurrentMutex);
-            if (currWaitTimes < selectionWaitTimes)
+            std::unique_lock<std::mutex> lock(mCurrentMutex);
+            bool selected = m_selectionCond.wait_for(lock, std::chrono::microseconds(m_pStreamInfo->segmentDuration * 1000000),
+                                                     [this, currSegTimeLine] {
+                                                       return m_selectedTileTracks.find(currSegTimeLine) != m_selectedTileTracks.end() ||
+                                                              m_status == STATUS_STOPPED;
+                                                     });
+            if (selected && m_status != STATUS_STOPPED)
             {
               updatedSelectedAS = m_selectedTileTracks[currSegTimeLine];
             }
@@ -1232,17 +1242,19 @@ int32_t OmafMediaStream::TilesStitching() {
 
           if (pts == 0)
           {
-              while((!pts) && (currWaitTimes < waitTimes) && (m_status != STATUS_STOPPED))
+              // wait for at most half segment duration till the segment of the track is parsed
+              uint64_t waitSeq = omaf_reader_mgr_->GetParsedSequence();
+              auto waitDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds((m_pStreamInfo->segmentDuration * 1000000) / 2);
+              pts = omaf_reader_mgr_->GetOldestPacketPTSForTrack(trackID);
+              while((!pts) && (m_status != STATUS_STOPPED))
               {
-                  usleep(((m_pStreamInfo->segmentDuration * 1000000) / 2) / waitTimes);
-                  currWaitTimes++;
+                  if (!omaf_reader_mgr_->WaitForParsedSegment(waitSeq, waitDeadline))
+                  {
+                      OMAF_LOG(LOG_INFO, "Wait times has timed out for frame %ld from track %d\n", currFramePTS, trackID);
+                      break;
+                  }
                   pts = omaf_reader_mgr_->GetOldestPacketPTSForTrack(trackID);
               }
-              if (currWaitTimes >= waitTimes)
-              {
-                  OMAF_LOG(LOG_INFO, "Wait times has timed out for frame %ld from track %d\n", currFramePTS, trackID);
-              }
-              currWaitTimes = 0;
               if (pts > currFramePTS)
               {
                   OMAF_LOG(LOG_INFO, "After wait for a moment, outdated PTS %ld from track %d\n", pts, trackID);
@@ -1326,18 +1338,21 @@ int32_t OmafMediaStream::TilesStitching() {
         }
       }
       //2.2 get one packet according to PTS
+      uint64_t parsedSeq = omaf_reader_mgr_->GetParsedSequence();
       ret = omaf_reader_mgr_->GetNextPacketWithPTS(trackID, currFramePTS, onePacket, m_needParams);
 
       OMAF_LOG(LOG_INFO, "Get next packet !\n");
       currWaitTimes = 0;
 
-      while ((ret == ERROR_NULL_PACKET) && (currWaitTimes < waitTimes_GetPacket) && m_status != STATUS_STOPPED) {
+      // wait till the packet is parsed instead of polling, wake up once a new segment/chunk is parsed
 #ifdef _ANDROID_NDK_OPTION_
-        usleep((m_pStreamInfo->segmentDuration * 1000000) / waitTimes_GetPacket);
+      auto waitDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(m_pStreamInfo->segmentDuration * 1000000);
 #else
-        usleep((m_pStreamInfo->segmentDuration * 1000000 / 2) / waitTimes_GetPacket);
+      auto waitDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(m_pStreamInfo->segmentDuration * 1000000 / 2);
 #endif
-        currWaitTimes++;
+      while ((ret == ERROR_NULL_PACKET) && m_status != STATUS_STOPPED) {
+        if (!omaf_reader_mgr_->WaitForParsedSegment(parsedSeq, waitDeadline))
+          break;
         //OMAF_LOG(LOG_INFO, "To get packet %ld for track %d\n", currFramePTS, trackID);
         ret = omaf_reader_mgr_->GetNextPacketWithPTS(trackID, currFramePTS, onePacket, m_needParams);
       }
@@ -1461,6 +1476,7 @@ int32_t OmafMediaStream::TilesStitching() {
       continue;
     }
 
+    auto stitch_start = std::chrono::steady_clock::now();
     if (!isEOS && !(m_stitch->IsInitialized())) {
       ret = m_stitch->Initialize(selectedPackets, m_needParams,
                                  (VCD::OMAF::ProjectionFormat)(m_pStreamInfo->mProjFormat), m_sources);
@@ -1529,6 +1545,8 @@ int32_t OmafMediaStream::TilesStitching() {
       }
     } else {
       mergedPackets = m_stitch->GetTilesMergedPackets();
+      OmafStageStatistics::Ptr stage_stats = omaf_reader_mgr_->GetStageStatistics();
+      if (stage_stats) stage_stats->record(LatencyStage_Stitch, LatencyTrack_Video, stitch_start);
     }
 
     {
@@ -1676,11 +1694,12 @@ int OmafMediaStream::CatchupThreadFunc(void* thread)
       }
       m_catchupTasksList.pop_front();
 
-      while (m_catchupTriggerPTSList.empty()) {
+      std::unique_lock<std::mutex> lock(m_catchupPTSMutex);
+      if (m_catchupTriggerPTSList.empty()) {
         OMAF_LOG(LOG_INFO, "Wait for trigger pts coming for task %ld\n", task.first);
-        usleep(500);
+        m_catchupPTSCond.wait(lock, [this] { return !m_catchupTriggerPTSList.empty() || m_catchup_status == STATUS_STOPPED; });
+        if (m_catchupTriggerPTSList.empty()) break;
       }
-      std::unique_lock<std::mutex> lock(m_catchupPTSMutex);
       triggerPTS = m_catchupTriggerPTSList.front();
       m_catchupTriggerPTSList.pop_front();
       OMAF_LOG(LOG_INFO, "task pts %ld trigger pts %ld\n", task.first, triggerPTS);
@@ -1743,6 +1762,7 @@ int OmafMediaStream::AddCatchupTriggerPTS(uint64_t pts)
   std::unique_lock<std::mutex> lock(m_catchupPTSMutex);
   OMAF_LOG(LOG_INFO, "Push trigger pts : %lld\n", pts);
   m_catchupTriggerPTSList.push_back(pts);
+  m_catchupPTSCond.notify_all();
   return ERROR_NONE;
 }
 
@@ -1756,6 +1776,10 @@ int OmafMediaStream::StopAllCatchupThreads()
   OMAF_LOG(LOG_INFO, "All stitch thread will be stopped!\n");
   m_catchup_status = STATUS_STOPPED;
   m_catchupCond.notify_all();
+  {
+    std::lock_guard<std::mutex> lock(m_catchupPTSMutex);
+    m_catchupPTSCond.notify_all();
+  }
   for (size_t i = 0; i < m_catchupThreadsList.size(); i++)
   {
     SAFE_DELETE(m_catchupThreadsList[i]->catchupStitch);
@@ -44,6 +44,7 @@
 #include "OmafExtractor.h"
 #include "OmafReader.h"
 #include "OmafTilesStitch.h"
+#include <condition_variable>
 #include <mutex>
 
 VCD_OMAF_BEGIN
@@ -96,6 +97,12 @@ class OmafMediaStream {
   //! \return
   int UpdateStartNumber(uint64_t nAvailableStartTime);
 
+  //!
+  //! \brief reload the segment numbering of all AdaptationSets after the
+  //!        live mpd is refreshed in place
+  //! \return ERROR_NONE if success, else failed reason
+  int UpdateSegmentTemplate();
+
   uint32_t GetStartChunkId() {
     std::lock_guard<std::mutex> lock(mMutex);
     if (!mMediaAdaptationSet.empty()) {
@@ -284,6 +291,21 @@ class OmafMediaStream {
       m_stitch->SetMaxStitchResolution(width, height);
   };
 
+  void SetStitchThreadNum(uint32_t threadNum)
+  {
+    // keep one core for the calling thread which stitches together with workers
+    uint32_t coresNum = std::thread::hardware_concurrency();
+    if (coresNum && threadNum >= coresNum) threadNum = coresNum - 1;
+    if (m_stitch)
+      m_stitch->SetStitchThreadNum(threadNum);
+  };
+
+  void SetSpanOutput(bool enable)
+  {
+    if (m_stitch)
+      m_stitch->SetSpanOutput(enable);
+  };
+
   void SetSegmentNumber( uint32_t seg_num ) { m_activeSegmentNum = seg_num; } ;
 
   void SetEnableCatchUp(bool enableCatchUp) { m_enableCatchup = enableCatchUp; };
@@ -400,6 +422,8 @@ private:
   std::map<uint64_t, std::map<int, OmafAdaptationSet*>> m_selectedTileTracks;
 
   bool m_hasTileTracksSelected;
+  //<! cv notified when tiles selection is inserted into m_selectedTileTracks, used with mCurrentMutex
+  std::condition_variable m_selectionCond;
   //<! map of video sources for the media stream
   std::map<uint32_t, SourceInfo> m_sources;
   //<! tiles stitching thread ID
@@ -442,6 +466,7 @@ private:
   std::condition_variable m_catchupCond; //<! cv for catch up thread
   std::mutex m_catchupThreadMutex; // mutex for catch up thread
   std::mutex m_catchupPTSMutex; // mutex for catch up PTS
+  std::condition_variable m_catchupPTSCond; //<! cv for catch up trigger PTS coming
 
   OmafDashParams omaf_dash_params_;
   // function
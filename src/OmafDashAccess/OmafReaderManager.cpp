@@ -254,6 +254,9 @@ class OmafSegmentNode : public VCD::NonCopyable {
   int parseSegmentStream(std::shared_ptr<OmafReader> reader) noexcept;
   int removeSegmentStream(std::shared_ptr<OmafReader> reader) noexcept;
   int cachePackets(std::shared_ptr<OmafReader> reader) noexcept;
+  int readPacketData(std::shared_ptr<OmafReader> reader, uint32_t reader_track_id, size_t sample,
+                     PacketBufferPool::Ptr buffer_pool, size_t default_size, size_t reserved_size,
+                     MediaPacket *packet, uint32_t &packet_size) noexcept;
   std::shared_ptr<TrackInformation> findTrackInformation(std::shared_ptr<OmafReader> reader) noexcept;
   bool findSampleIndexRange(std::shared_ptr<TrackInformation>, size_t &begin, size_t &end) noexcept;
   OmafPacketParams::Ptr getPacketParams() {
@@ -335,6 +338,9 @@ class OmafSegmentNode : public VCD::NonCopyable {
   uint32_t chunk_id_ = 0;
 };
 
+//<! ADTS header size which is inserted before each audio packet
+#define ADTS_HEADER_SIZE 7
+
 uint32_t buildDashTrackId(uint32_t id) noexcept { return id & static_cast<uint32_t>(0xffff); }
 
 uint32_t buildReaderTrackId(uint32_t trackId, uint32_t initSegId) noexcept { return (initSegId << 16) | trackId; }
@@ -377,12 +383,15 @@ OMAF_STATUS OmafReaderManager::Close() noexcept {
     {
       std::lock_guard<std::mutex> lock(segment_opened_mutex_);
       segment_opened_list_.clear();
+      opened_sequence_++;
       segment_opened_cv_.notify_all();
     }
 
     {
       std::lock_guard<std::mutex> lock(segment_parsed_mutex_);
       segment_parsed_list_.clear();
+      parsed_sequence_++;
+      segment_parsed_cv_.notify_all();
     }
 
     if (segment_reader_worker_.joinable()) {
@@ -755,14 +764,15 @@ OMAF_STATUS OmafReaderManager::GetNextPacketArray(vector<uint32_t> trackIDs, lis
   }
   //4. process waiting packet array
   else if (!no_data_tracks.empty()) {
-    uint32_t waitdata_timeout = max(GetSegmentDuration() * 1000, uint64_t(3000));
-    uint32_t curr_waittime = 0;
+    uint64_t waitdata_timeout = max(GetSegmentDuration() * 1000, uint64_t(3000));
+    // wait for all tracks in total, wake up once a new segment/chunk is parsed
+    auto wait_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitdata_timeout);
     for (auto id : no_data_tracks) {
       MediaPacket *pkt = nullptr;
+      uint64_t parsed_seq = GetParsedSequence();
       int res = GetNextPacketWithPTS(trackIDs[id], fetch_pts_, pkt, requireParams);
-      while (res == ERROR_NULL_PACKET && curr_waittime < waitdata_timeout) {
-        usleep(1000);
-        curr_waittime++;
+      while (res == ERROR_NULL_PACKET && breader_working_) {
+        if (!WaitForParsedSegment(parsed_seq, wait_deadline)) break;
         res = GetNextPacketWithPTS(trackIDs[id], fetch_pts_, pkt, requireParams);
       }
       //4.1 wait and obtain the packet, push into output packets queue(first frame in segment always enters)
@@ -862,6 +872,41 @@ bool OmafReaderManager::checkEOS(int64_t segment_num) noexcept {
   }
 }
 
+bool OmafReaderManager::WaitForInitSegmentsParsed(uint32_t timeout_ms) noexcept {
+  try {
+    std::unique_lock<std::mutex> lock(initSeg_ready_mutex_);
+    return initSeg_ready_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                      [this] { return bInitSeg_all_ready_.load(); });
+  } catch (const std::exception &ex) {
+    OMAF_LOG(LOG_ERROR, "Failed to wait for init segments parsed, ex: %s\n", ex.what());
+    return bInitSeg_all_ready_.load();
+  }
+}
+
+uint64_t OmafReaderManager::GetParsedSequence() noexcept {
+  std::lock_guard<std::mutex> lock(segment_parsed_mutex_);
+  return parsed_sequence_;
+}
+
+bool OmafReaderManager::WaitForParsedSegment(uint64_t &sequence,
+                                             std::chrono::steady_clock::time_point deadline) noexcept {
+  try {
+    std::unique_lock<std::mutex> lock(segment_parsed_mutex_);
+    bool parsed = segment_parsed_cv_.wait_until(lock, deadline, [this, sequence] { return parsed_sequence_ != sequence; });
+    sequence = parsed_sequence_;
+    return parsed;
+  } catch (const std::exception &ex) {
+    OMAF_LOG(LOG_ERROR, "Failed to wait for parsed segment, ex: %s\n", ex.what());
+    return false;
+  }
+}
+
+void OmafReaderManager::WakeUpParsedSegmentWaiters() noexcept {
+  std::lock_guard<std::mutex> lock(segment_parsed_mutex_);
+  parsed_sequence_++;
+  segment_parsed_cv_.notify_all();
+}
+
 OMAF_STATUS OmafReaderManager::GetPacketQueueSize(uint32_t trackID, size_t &size) noexcept {
   try {
     std::unique_lock<std::mutex> lock(segment_parsed_mutex_);
@@ -1033,7 +1078,11 @@ void OmafReaderManager::buildInitSegmentInfo(void) noexcept {
         }  // end for extractors loop
       }    // end stream loop
     }      // end for track loop
-    bInitSeg_all_ready_ = true;
+    {
+      std::lock_guard<std::mutex> lock(initSeg_ready_mutex_);
+      bInitSeg_all_ready_ = true;
+    }
+    initSeg_ready_cv_.notify_all();
 
     // 2.2 setup the id map
     setupTrackIdMap();
@@ -1112,6 +1161,13 @@ void OmafReaderManager::normalSegmentStateChange(std::shared_ptr<OmafSegment> se
       return;
     }
 
+    if (work_params_.stage_stats_ && state == OmafSegment::State::OPEN_SUCCES) {
+      work_params_.stage_stats_->record(
+          LatencyStage_Download,
+          OmafStageStatistics::trackType(segment->GetMediaType(), opened_dash_node->isExtractor()),
+          opened_dash_node->startTime());
+    }
+
   // 2. push new opened node to opened list
   AddOpenedNode(segment, std::move(opened_dash_node));
 
@@ -1298,6 +1354,7 @@ void OmafReaderManager::AddOpenedNode(std::shared_ptr<OmafSegment> segment, std:
     }
     // TODO, refine the logic,
     // we may send the notify by checking all segment ready for extractor mode
+    opened_sequence_++;
     segment_opened_cv_.notify_all();
   }  // end of append to the dash opened list
 }
@@ -1308,12 +1365,18 @@ void OmafReaderManager::threadRunner() noexcept {
 
     while (breader_working_) {
       // 1. find the ready segment/dash_node opend list
+      uint64_t opened_sequence = 0;
+      {
+        std::lock_guard<std::mutex> lock(segment_opened_mutex_);
+        opened_sequence = opened_sequence_;
+      }
       OmafSegmentNode::Ptr ready_dash_node = findReadySegmentNode();
 
-      // 1.1 no ready dash node, then wait
+      // 1.1 no ready dash node, then wait.
+      // a chunk opened after the search must not be left until the next one arrives
       if (ready_dash_node.get() == nullptr) {
         std::unique_lock<std::mutex> lock(segment_opened_mutex_);
-        segment_opened_cv_.wait(lock);
+        segment_opened_cv_.wait(lock, [this, opened_sequence] { return !breader_working_ || opened_sequence_ != opened_sequence; });
         continue;
       }
 
@@ -1326,7 +1389,14 @@ void OmafReaderManager::threadRunner() noexcept {
       tracepoint(mthq_tp_provider, T4_parse_start_time, timeline_point);
 #endif
 #endif
+      auto parse_start = std::chrono::steady_clock::now();
       OMAF_STATUS ret = ready_dash_node->parse();
+      if (work_params_.stage_stats_ && ret == ERROR_NONE) {
+        work_params_.stage_stats_->record(
+            LatencyStage_Parse,
+            OmafStageStatistics::trackType(ready_dash_node->getMediaType(), ready_dash_node->isExtractor()),
+            parse_start);
+      }
       // if (ready_dash_node->isCatchup()) OMAF_LOG(LOG_INFO, "Catch up node parsed! timeline is %lld, track id %d\n", timeline_point, ready_dash_node->getTrackId());
 
       if (ready_dash_node->getMediaType() == MediaType_Video)
@@ -1369,6 +1439,7 @@ void OmafReaderManager::threadRunner() noexcept {
           nodeset.segment_nodes_.push_back(std::move(ready_dash_node));
           segment_parsed_list_.emplace_back(nodeset);
         }
+        parsed_sequence_++;
         segment_parsed_cv_.notify_all();
       } else {
         OMAF_LOG(LOG_ERROR, "Failed to parse %s\n", ready_dash_node->to_string().c_str());
@@ -1957,6 +2028,7 @@ int OmafSegmentNode::cachePackets(std::shared_ptr<OmafReader> reader) noexcept {
       }
 
       auto packet_params = (bExtractor_ == true) ? getPacketParamsForExtractors() : getPacketParams();
+      auto buffer_pool = reader_mgr->getPacketBufferPool(segment_->GetTrackId());
       for (size_t sample = sample_begin; sample < sample_end; sample++) {
         uint32_t reader_track_id = buildReaderTrackId(segment_->GetTrackId(), segment_->GetInitSegID());
 
@@ -1986,16 +2058,12 @@ int OmafSegmentNode::cachePackets(std::shared_ptr<OmafReader> reader) noexcept {
           OMAF_LOG(LOG_ERROR, "Failed to create the packet!\n");
           return ERROR_INVALID;
         }
-        uint32_t packet_size = ((packet_params->width_ * packet_params->height_ * 3) >> 1) >> 1;
-        // FIXME, we need refine the packet buffer. we may include the vps/pps/sps here
-        packet->ReAllocatePacket(packet_size);
-
-        if (mode_ == OmafDashMode::EXTRACTOR) {
-          ret = reader->getExtractorTrackSampleData(reader_track_id, sample, static_cast<char *>(packet->Payload()),
-                                                    packet_size);
-        } else {
-          ret = reader->getTrackSampleData(reader_track_id, sample, static_cast<char *>(packet->Payload()), packet_size);
-        }
+        // the worst case size, only used when the real sample size is unknown
+        size_t default_size = ((packet_params->width_ * packet_params->height_ * 3) >> 1) >> 1;
+        uint32_t packet_size = 0;
+        // reserve the space of vps/sps/pps, so that inserting params won't reallocate the payload
+        ret = readPacketData(reader, reader_track_id, sample, buffer_pool, default_size, packet_params->params_.size(),
+                             packet, packet_size);
         if (ret != ERROR_NONE) {
           OMAF_LOG(LOG_ERROR, "Failed to read sample data from reader, code= %d\n", ret);
           SAFE_DELETE(packet);
@@ -2130,6 +2198,7 @@ int OmafSegmentNode::cachePackets(std::shared_ptr<OmafReader> reader) noexcept {
     }
     else if (segment_->GetMediaType() == MediaType_Audio) {
       auto packet_params = getPacketParamsForAudio();
+      auto buffer_pool = reader_mgr->getPacketBufferPool(segment_->GetTrackId());
       for (size_t sample = sample_begin; sample < sample_end; sample++) {
         uint32_t reader_track_id = buildReaderTrackId(segment_->GetTrackId(), segment_->GetInitSegID());
 
@@ -2153,11 +2222,10 @@ int OmafSegmentNode::cachePackets(std::shared_ptr<OmafReader> reader) noexcept {
         }
 
         uint32_t chlNum = segment_->GetAudioChlNum();
-        uint32_t packet_size = 1024 * chlNum;
-
-        packet->ReAllocatePacket(packet_size);
+        uint32_t packet_size = 0;
 
-        ret = reader->getTrackSampleData(reader_track_id, sample, static_cast<char *>(packet->Payload()), packet_size);
+        ret = readPacketData(reader, reader_track_id, sample, buffer_pool, 1024 * chlNum, ADTS_HEADER_SIZE, packet,
+                             packet_size);
 
         if (ret != ERROR_NONE) {
           OMAF_LOG(LOG_ERROR, "Failed to read sample data from reader for audio track, code= %d\n", ret);
@@ -2197,6 +2265,51 @@ int OmafSegmentNode::cachePackets(std::shared_ptr<OmafReader> reader) noexcept {
   }
 }
 
+int OmafSegmentNode::readPacketData(std::shared_ptr<OmafReader> reader, uint32_t reader_track_id, size_t sample,
+                                    PacketBufferPool::Ptr buffer_pool, size_t default_size, size_t reserved_size,
+                                    MediaPacket *packet, uint32_t &packet_size) noexcept {
+  try {
+    // the sample size of normal track is known from the sample table,
+    // while the extractor sample is only resolved when reading it
+    size_t sample_size = 0;
+    if (mode_ != OmafDashMode::EXTRACTOR) {
+      uint64_t sample_offset = 0;
+      uint32_t sample_length = 0;
+      if (reader->getTrackSampleOffset(reader_track_id, sample, sample_offset, sample_length) == ERROR_NONE) {
+        sample_size = sample_length;
+      }
+    }
+    if (sample_size == 0 && buffer_pool.get()) {
+      size_t max_size = buffer_pool->GetMaxSampleSize();
+      sample_size = max_size + (max_size >> 2);
+    }
+    if (sample_size == 0) {
+      sample_size = default_size;
+    }
+
+    bool extractor = (mode_ == OmafDashMode::EXTRACTOR);
+    OMAF_STATUS ret = packet->ReadFromPool(buffer_pool, sample_size, reserved_size,
+        [&](char *buf, uint32_t &size) {
+          if (extractor) {
+            return reader->getExtractorTrackSampleData(reader_track_id, sample, buf, size);
+          }
+          return reader->getTrackSampleData(reader_track_id, sample, buf, size);
+        }, packet_size);
+    if (ret == ERROR_NULL_PTR) {
+      OMAF_LOG(LOG_ERROR, "Failed to allocate the packet buffer for sample %ld!\n", sample);
+      return ret;
+    }
+
+    if (ret == ERROR_NONE && buffer_pool.get()) {
+      buffer_pool->RecordSampleSize(packet_size);
+    }
+    return ret;
+  } catch (const std::exception &ex) {
+    OMAF_LOG(LOG_ERROR, "Exception when read the packet data! ex: %s\n", ex.what());
+    return ERROR_INVALID;
+  }
+}
+
 std::shared_ptr<TrackInformation> OmafSegmentNode::findTrackInformation(std::shared_ptr<OmafReader> reader) noexcept {
   try {
     std::vector<TrackInformation *> track_infos;
@@ -37,13 +37,16 @@
 #define OMAFMP4READERMGR_H
 
 #include "MediaPacket.h"
+#include "PacketBufferPool.h"
 #include "general.h"
 
 #include "OmafMediaSource.h"
 #include "OmafReader.h"
+#include "OmafStageStatistics.h"
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -76,6 +79,7 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
     size_t duration_ = 0;
     int32_t segment_timeout_ms_ = 3000;  // ms
     ProjectionFormat proj_fmt_  = ProjectionFormat::PF_ERP;
+    OmafStageStatistics::Ptr stage_stats_;  // null if statistic is disabled
   };
 
   using OmafReaderParams = struct _params;
@@ -125,6 +129,33 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
   //!
   inline bool IsInitSegmentsParsed() { return bInitSeg_all_ready_.load(); };
 
+  //!  \brief Wait until all initial segments are parsed, or time out.
+  //!
+  //!  \return true if all initial segments are parsed, false if timed out
+  //!
+  bool WaitForInitSegmentsParsed(uint32_t timeout_ms) noexcept;
+
+  //!  \brief Get the sequence number of parsed segments, it increases each
+  //!          time one segment/chunk is parsed and its packets are ready.
+  //!
+  uint64_t GetParsedSequence() noexcept;
+
+  //!  \brief Wait until a segment/chunk is parsed after the one of sequence,
+  //!          instead of polling the packet queues.
+  //!
+  //!  \param  [in/out] sequence
+  //!          the parsed sequence got last time, updated to the latest one
+  //!  \param  [in] deadline
+  //!          the time point to stop waiting
+  //!
+  //!  \return true if new segment is parsed, false if timed out
+  //!
+  bool WaitForParsedSegment(uint64_t &sequence, std::chrono::steady_clock::time_point deadline) noexcept;
+
+  //!  \brief Wake up all threads waiting for parsed segments, like when stopping
+  //!
+  void WakeUpParsedSegmentWaiters() noexcept;
+
   inline bool IsCmafContent() { return (sBrand_ == "cmfc"); };
 
   int64_t GetStartOffsetPts() { return offset_pts_; };
@@ -154,6 +185,8 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
 
   OmafReaderParams GetWorkParams() { return work_params_; };
 
+  OmafStageStatistics::Ptr GetStageStatistics() { return work_params_.stage_stats_; };
+
   DashStreamInfo* GetVideoStreamInfo() {
     for (int i = 0; i < media_source_->GetStreamCount(); i++) {
       OmafMediaStream *pStream = media_source_->GetStream(i);
@@ -216,6 +249,16 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
     packet_params_for_audio_[audioTrackIdx] = std::move(params);
   }
 
+  //! \brief get the packet buffer pool of the track, create one if not exist
+  PacketBufferPool::Ptr getPacketBufferPool(uint32_t trackId) noexcept {
+    std::lock_guard<std::mutex> lock(packet_buffer_pools_mutex_);
+    auto &pool = packet_buffer_pools_[trackId];
+    if (pool.get() == nullptr) {
+      pool = std::make_shared<PacketBufferPool>();
+    }
+    return pool;
+  }
+
  private:
   std::shared_ptr<OmafDashSegmentClient> dash_client_;
 
@@ -235,9 +278,13 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
   std::mutex segment_opened_mutex_;
   std::condition_variable segment_opened_cv_;
   std::list<OmafSegmentNodeTimedSet> segment_opened_list_;
+  //<! increased each time one node is added into segment_opened_list_, guarded by segment_opened_mutex_
+  uint64_t opened_sequence_ = 0;
   std::mutex segment_parsed_mutex_;
   std::condition_variable segment_parsed_cv_;
   std::list<OmafSegmentNodeTimedSet> segment_parsed_list_;
+  //<! increased each time one node is moved into segment_parsed_list_, guarded by segment_parsed_mutex_
+  uint64_t parsed_sequence_ = 0;
 
   OmafMediaSource *media_source_ = nullptr;
   std::map<uint32_t, std::shared_ptr<OmafPacketParams>> omaf_packet_params_;
@@ -246,6 +293,10 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
 
   std::map<uint32_t, std::shared_ptr<OmafAudioPacketParams>> packet_params_for_audio_;
 
+  std::mutex packet_buffer_pools_mutex_;
+  //<! packet payload buffer pool for each track
+  std::map<uint32_t, PacketBufferPool::Ptr> packet_buffer_pools_;
+
   std::mutex initSeg_mutex_;
 
   //<! ID pair for InitSegID to TrackID;
@@ -257,10 +308,12 @@ class OmafReaderManager : public VCD::NonCopyable, public enable_shared_from_thi
 
   std::atomic_int initSeg_ready_count_{0};
   std::atomic_bool bInitSeg_all_ready_{false};
+  std::mutex initSeg_ready_mutex_;
+  std::condition_variable initSeg_ready_cv_;
 
   std::string sBrand_;
 
-  int64_t offset_pts_ = -1;
+  std::atomic<int64_t> offset_pts_{-1};
   uint32_t timeout_for_checkEOS_ = 500;
   uint64_t fetch_pts_ = 0;
   vector<pair<uint32_t, uint32_t>> inactive_tracks_; // first: segment id, second: track id
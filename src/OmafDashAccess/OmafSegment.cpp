@@ -80,6 +80,7 @@ OmafSegment::OmafSegment(std::shared_ptr<OmafSegment> seg, std::unique_ptr<Strea
 }
 
 OmafSegment::~OmafSegment() {
+  mapped_file_.Close();
   if (buse_stored_file_ && !cache_file_.empty()) {
     DOWNLOADMANAGER::GetInstance()->DeleteCacheFile(cache_file_);
   }
@@ -96,6 +97,11 @@ int OmafSegment::Open(std::shared_ptr<OmafDashSegmentClient> dash_client) noexce
 
     state_ = State::CREATE;
 
+    // replay or seek back hits the cached segment, no download needed
+    if (OpenFromCache()) {
+      return ERROR_NONE;
+    }
+
     // mSegElement->StartDownloadSegment((OmafDownloaderObserver *)this);
     dash_client_->open(
         //dcb
@@ -106,6 +112,7 @@ int OmafSegment::Open(std::shared_ptr<OmafDashSegmentClient> dash_client) noexce
         [this](OmafDashSegmentClient::State s) {
           switch (s) {
             case OmafDashSegmentClient::State::SUCCESS:
+              this->CacheToMemory();
               this->state_ = State::OPEN_SUCCES;
               break;
             case OmafDashSegmentClient::State::STOPPED:
@@ -181,27 +188,72 @@ int OmafSegment::Close() {
   return ERROR_NONE;
 }
 #endif
-int OmafSegment::CacheToFile() noexcept {
+bool OmafSegment::IsCacheable() noexcept {
+  // CMAF chunks are published while the segment is downloading
+  return DOWNLOADMANAGER::GetInstance()->UseCache() && !ds_params_.enable_byte_range_ &&
+         !ds_params_.dash_url_.empty() && mSegmentType != SegmentType_Cmaf;
+}
+
+bool OmafSegment::OpenFromCache() noexcept {
   try {
-    std::string fileName =
-        ds_params_.dash_url_.substr(ds_params_.dash_url_.find_last_of('/') + 1,
-                                    ds_params_.dash_url_.length() - ds_params_.dash_url_.find_last_of('/') - 1);
-    cache_file_ = DOWNLOADMANAGER::GetInstance()->GetCacheFolder() + "/" +
-                  DOWNLOADMANAGER::GetInstance()->AssignCacheFileName() + fileName;
-    if (!dash_stream_.cacheToFile(cache_file_)) {
-      OMAF_LOG(LOG_ERROR, "Failed to cache the dash to file: %s\n", cache_file_.c_str());
-      return OMAF_ERROR_FILE_WRITE;
+    if (!IsCacheable()) return false;
+
+    SegmentCacheData data = DOWNLOADMANAGER::GetInstance()->GetSegment(ds_params_.dash_url_);
+    if (data.get() == nullptr || data->blocks.empty()) return false;
+
+    // the blocks share the cached data, so nothing is copied
+    for (auto &block : data->blocks) {
+      dash_stream_.push_back(std::unique_ptr<StreamBlock>(new StreamBlock(block.data, block.size)));
     }
+    state_ = State::OPEN_SUCCES;
 
-    OMAF_LOG(LOG_INFO, "Success to cache dash to file: %s. url=%s\n", cache_file_.c_str(), ds_params_.dash_url_.c_str());
-    OMAF_LOG(LOG_INFO, "And file size=%ld\n", dash_stream_.GetStreamSize());
-    return ERROR_NONE;
+    OMAF_LOG(LOG_INFO, "Open segment from cache, url=%s, size=%lld\n", ds_params_.dash_url_.c_str(),
+             static_cast<long long>(data->size));
+    if (state_change_cb_) {
+      state_change_cb_(shared_from_this(), state_);
+    }
+    return true;
+  } catch (const std::exception& ex) {
+    OMAF_LOG(LOG_ERROR, "Exception when open the segment from cache: %s, ex: %s\n", ds_params_.dash_url_.c_str(), ex.what());
+    return false;
+  }
+}
+
+int OmafSegment::CacheToMemory() noexcept {
+  try {
+    if (!IsCacheable()) return ERROR_NONE;
+
+    std::shared_ptr<SegmentCacheBlocks> data = std::make_shared<SegmentCacheBlocks>();
+    if (!dash_stream_.shareTo(data->blocks) || data->blocks.empty()) {
+      return ERROR_INVALID;
+    }
+    for (auto &block : data->blocks) {
+      data->size += block.size;
+    }
+
+    return DOWNLOADMANAGER::GetInstance()->PutSegment(ds_params_.dash_url_, std::move(data));
   } catch (const std::exception& ex) {
-    OMAF_LOG(LOG_ERROR, "Exception when cache dash to file: %s\n", cache_file_.c_str());
+    OMAF_LOG(LOG_ERROR, "Exception when cache the segment: %s, ex: %s\n", ds_params_.dash_url_.c_str(), ex.what());
     return ERROR_INVALID;
   }
 }
 
+bool OmafSegment::OpenStoredFile() noexcept {
+  if (mapped_file_.IsOpen()) return true;
+
+  if (mapped_file_.Open(cache_file_) != ERROR_NONE) {
+    return false;
+  }
+  mapped_file_.Sequential();
+  return true;
+}
+
+void OmafSegment::PrefetchStoredFile() noexcept {
+  if (buse_stored_file_ && OpenStoredFile()) {
+    mapped_file_.WillNeed();
+  }
+}
+
 std::string OmafSegment::to_string() const noexcept {
   std::stringstream ss;
   ss << "segment initsegId=" << initSeg_id_;
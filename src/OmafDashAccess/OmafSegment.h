@@ -42,6 +42,7 @@
 #include "../isolib/dash_parser/Mp4StreamIO.h"
 #include "general.h"
 #include "iso_structure.h"
+#include "OmafMappedFile.h"
 
 #include <memory>
 #include <atomic>
@@ -95,12 +96,8 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
     if (!buse_stored_file_) {
       return dash_stream_.ReadStream(buffer, size);
     } else {
-      if (!mFileStream.is_open()) {
-        mFileStream.open(this->GetSegmentCacheFile().c_str(), ios_base::binary | ios_base::in);
-      }
-      mFileStream.read(buffer, size);
-      std::streamsize readCnt = mFileStream.gcount();
-      return (offset_t)readCnt;
+      if (!OpenStoredFile()) return 0;
+      return mapped_file_.ReadStream(buffer, size);
     }
   };
 
@@ -108,16 +105,8 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
     if (!buse_stored_file_) {
       return dash_stream_.SeekAbsoluteOffset(offset);
     } else {
-      if (!mFileStream.is_open()) {
-        mFileStream.open(this->GetSegmentCacheFile().c_str(), ios_base::binary | ios_base::in);
-      }
-      if (mFileStream.tellg() == -1) {
-        mFileStream.clear();
-        mFileStream.seekg(0, ios_base::beg);
-      }
-
-      mFileStream.seekg(offset);
-      return true;
+      if (!OpenStoredFile()) return false;
+      return mapped_file_.SeekAbsoluteOffset(offset);
     }
   }
 
@@ -125,10 +114,8 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
     if (!buse_stored_file_) {
       return dash_stream_.TellOffset();
     } else {
-      if (!mFileStream.is_open()) {
-        mFileStream.open(this->GetSegmentCacheFile().c_str(), ios_base::binary | ios_base::in);
-      }
-      return mFileStream.tellg();
+      if (!OpenStoredFile()) return -1;
+      return mapped_file_.TellOffset();
     }
   };
 
@@ -136,13 +123,17 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
     if (!buse_stored_file_) {
       return dash_stream_.GetStreamSize();
     } else {
-      if (!mFileStream.is_open()) {
-        mFileStream.open(this->GetSegmentCacheFile().c_str(), ios_base::binary | ios_base::in);
-      }
-      mFileStream.seekg(0, ios_base::end);
-      int64_t size = mFileStream.tellg();
-      mFileStream.seekg(0, ios_base::beg);
-      return size;
+      if (!OpenStoredFile()) return 0;
+      return mapped_file_.GetStreamSize();
+    }
+  };
+
+  const char* GetContiguousData(offset_t offset, offset_t size) override {
+    if (!buse_stored_file_) {
+      return dash_stream_.GetContiguousData(offset, size);
+    } else {
+      if (!OpenStoredFile()) return nullptr;
+      return mapped_file_.GetContiguousData(offset, size);
     }
   };
 
@@ -230,6 +221,12 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
   void SetViewId(pair<int32_t, int32_t> id) noexcept { view_id_ = id; };
   pair<int32_t, int32_t> GetViewId() const noexcept { return view_id_; };
   void SetSegStored() noexcept { buse_stored_file_ = true; };
+
+  //!
+  //!  \brief map the stored file and advise the kernel to read it ahead,
+  //!         so it is loaded while the former segments are parsed.
+  //!
+  void PrefetchStoredFile() noexcept;
   int GetSegCount() const noexcept { return seg_count_; };
   void SetSegSize(uint64_t segSize) noexcept { seg_size_ = segSize; };
   uint64_t GetSegSize() const noexcept { return seg_size_; };
@@ -274,11 +271,26 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
 
   uint32_t GetChunkNum() { return chunk_num_; };
 
+  //!
+  //!  \brief check whether the segment could be cached in memory by url.
+  //!
+  bool IsCacheable() noexcept;
+
  private:
   //!
-  //!  \brief save the memory data to file.
+  //!  \brief open the segment with the cached data, return false if not cached.
+  //!
+  bool OpenFromCache() noexcept;
+
+  //!
+  //!  \brief put the downloaded data to the in-memory segment cache.
+  //!
+  int CacheToMemory() noexcept;
+
+  //!
+  //!  \brief map the stored file if not yet, return false if failed.
   //!
-  int CacheToFile() noexcept;
+  bool OpenStoredFile() noexcept;
 
  protected:
   std::shared_ptr<OmafDashSegmentClient> dash_client_;
@@ -318,7 +330,7 @@ class OmafSegment : public VCD::MP4::StreamIO, public enable_shared_from_this<Om
   QualityRank mQualityRanking;  //<! quality ranking of the segment
   SRDInfo mSRDInfo;             //<! top/left/width/height info for the tile track segment
 
-  std::ifstream mFileStream;
+  OmafMappedFile mapped_file_;  //<! mapping of the stored file
 
   MediaType mMediaType;
 
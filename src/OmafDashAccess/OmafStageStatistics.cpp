@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ *
+ */
+
+//!
+//! \file:   OmafStageStatistics.cpp
+//! \brief:  implementation of the stage latency histograms
+//!
+//! Created on Oct 24, 2022, 9:40 AM
+//!
+
+#include "OmafStageStatistics.h"
+
+#include <sstream>
+
+namespace VCD {
+namespace OMAF {
+
+static const char *kStageNames[LatencyStage_Num] = {"download", "parse", "stitch", "get_packet"};
+static const char *kTrackNames[LatencyTrack_Num] = {"video", "extractor", "audio"};
+
+uint32_t LatencyHistogram::bucketIndex(uint64_t value) noexcept {
+  if (value > LATENCY_HISTOGRAM_MAX_VALUE) value = LATENCY_HISTOGRAM_MAX_VALUE;
+  if (value < (1ULL << LATENCY_HISTOGRAM_SUB_BITS)) return static_cast<uint32_t>(value);
+
+  uint32_t msb = 63 - __builtin_clzll(value);
+  uint32_t shift = msb - LATENCY_HISTOGRAM_SUB_BITS;
+  return (shift << LATENCY_HISTOGRAM_SUB_BITS) + static_cast<uint32_t>(value >> shift);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(uint32_t index) noexcept {
+  uint32_t shift = (index < (2U << LATENCY_HISTOGRAM_SUB_BITS)) ? 0 : (index >> LATENCY_HISTOGRAM_SUB_BITS) - 1;
+  uint64_t mantissa = index - (shift << LATENCY_HISTOGRAM_SUB_BITS);
+  return (mantissa << shift) + (1ULL << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) noexcept {
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t cur = min_.load(std::memory_order_relaxed);
+  while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+  }
+  cur = max_.load(std::memory_order_relaxed);
+  while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+  }
+  // count is updated at last, so one reader which sees the count sees the bucket too
+  count_.fetch_add(1, std::memory_order_release);
+}
+
+void LatencyHistogram::reset() noexcept {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const noexcept {
+  uint64_t total = count_.load(std::memory_order_acquire);
+  if (total == 0) return 0;
+  if (percent < 0) percent = 0;
+  if (percent > 100) percent = 100;
+
+  uint64_t target = static_cast<uint64_t>(percent * total / 100.0 + 0.5);
+  if (target == 0) target = 1;
+  if (target > total) target = total;
+
+  uint64_t max_value = max_.load(std::memory_order_relaxed);
+  uint64_t accumulated = 0;
+  for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    accumulated += buckets_[i].load(std::memory_order_relaxed);
+    if (accumulated >= target) {
+      uint64_t bound = bucketUpperBound(i);
+      return bound < max_value ? bound : max_value;
+    }
+  }
+  return max_value;
+}
+
+void LatencyHistogram::snapshot(LatencyInfo *info) const noexcept {
+  if (info == nullptr) return;
+
+  info->count = count_.load(std::memory_order_acquire);
+  if (info->count == 0) {
+    info->min_us = info->max_us = info->mean_us = 0;
+    info->p50_us = info->p90_us = info->p99_us = 0;
+    return;
+  }
+  info->min_us = min_.load(std::memory_order_relaxed);
+  info->max_us = max_.load(std::memory_order_relaxed);
+  info->mean_us = sum_.load(std::memory_order_relaxed) / info->count;
+  info->p50_us = percentile(50);
+  info->p90_us = percentile(90);
+  info->p99_us = percentile(99);
+}
+
+void OmafStageStatistics::record(LatencyStage stage, LatencyTrackType type,
+                                 std::chrono::steady_clock::duration latency) noexcept {
+  if (stage < 0 || stage >= LatencyStage_Num || type < 0 || type >= LatencyTrack_Num) return;
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  histograms_[stage][type].record(us > 0 ? static_cast<uint64_t>(us) : 0);
+}
+
+void OmafStageStatistics::statistic(DashStageStatisticInfo *info) const noexcept {
+  if (info == nullptr) return;
+
+  for (int32_t stage = 0; stage < LatencyStage_Num; stage++) {
+    for (int32_t type = 0; type < LatencyTrack_Num; type++) {
+      histograms_[stage][type].snapshot(&info->latency[stage][type]);
+    }
+  }
+}
+
+std::string OmafStageStatistics::to_json() const {
+  DashStageStatisticInfo info;
+  statistic(&info);
+
+  std::stringstream ss;
+  ss << "{";
+  for (int32_t stage = 0; stage < LatencyStage_Num; stage++) {
+    ss << (stage ? "," : "") << "\"" << kStageNames[stage] << "\":{";
+    for (int32_t type = 0; type < LatencyTrack_Num; type++) {
+      const LatencyInfo &latency = info.latency[stage][type];
+      ss << (type ? "," : "") << "\"" << kTrackNames[type] << "\":{";
+      ss << "\"count\":" << latency.count;
+      ss << ",\"min_us\":" << latency.min_us;
+      ss << ",\"max_us\":" << latency.max_us;
+      ss << ",\"mean_us\":" << latency.mean_us;
+      ss << ",\"p50_us\":" << latency.p50_us;
+      ss << ",\"p90_us\":" << latency.p90_us;
+      ss << ",\"p99_us\":" << latency.p99_us;
+      ss << "}";
+    }
+    ss << "}";
+  }
+  ss << "}";
+  return ss.str();
+}
+
+void OmafStageStatistics::reset() noexcept {
+  for (auto &stage : histograms_) {
+    for (auto &histogram : stage) {
+      histogram.reset();
+    }
+  }
+}
+
+}  // namespace OMAF
+}  // namespace VCD
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ *
+ */
+
+//!
+//! \file:   OmafStageStatistics.h
+//! \brief:  latency statistic of the stages in OmafDashAccess
+//! \detail: download, parse, stitch and get packet latencies are recorded
+//!          into histograms per stage and per track type. Recording is lock
+//!          free, so it can be called from the download, parse and stitch
+//!          threads at the same time.
+//!
+//! Created on Oct 24, 2022, 9:40 AM
+//!
+
+#ifndef OMAFSTAGESTATISTICS_H_
+#define OMAFSTAGESTATISTICS_H_
+
+#include "../utils/ns_def.h"
+#include "../utils/data_type.h"
+#include "common.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace VCD {
+namespace OMAF {
+
+//! bits of sub buckets in each power of 2 range, the relative error is less than 1/32
+#define LATENCY_HISTOGRAM_SUB_BITS 5
+//! the max recorded latency in microsecond, larger ones are recorded as it
+#define LATENCY_HISTOGRAM_MAX_VALUE ((1ULL << 36) - 1)
+#define LATENCY_HISTOGRAM_BUCKETS ((36 - LATENCY_HISTOGRAM_SUB_BITS + 1) << LATENCY_HISTOGRAM_SUB_BITS)
+
+//!
+//! \class  LatencyHistogram
+//! \brief  log-linear histogram in the style of HDR histogram, values below
+//!         64 are exact, and each power of 2 range above has 32 buckets
+//!
+class LatencyHistogram : public VCD::NonCopyable {
+ public:
+  LatencyHistogram() { reset(); };
+  ~LatencyHistogram(){};
+
+ public:
+  //!
+  //! \brief  record one latency value in microsecond
+  //!
+  void record(uint64_t value) noexcept;
+
+  //!
+  //! \brief  clear all recorded values
+  //!
+  void reset() noexcept;
+
+  //!
+  //! \brief  get count, min, max, mean and percentiles of recorded values
+  //!
+  void snapshot(LatencyInfo *info) const noexcept;
+
+  //!
+  //! \brief  get the value at the percentile, the percentile is in [0, 100]
+  //!
+  uint64_t percentile(double percent) const noexcept;
+
+  uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); };
+
+  static uint32_t bucketIndex(uint64_t value) noexcept;
+  static uint64_t bucketUpperBound(uint32_t index) noexcept;
+
+ private:
+  std::atomic<uint64_t> buckets_[LATENCY_HISTOGRAM_BUCKETS];
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+class OmafStageStatistics : public VCD::NonCopyable {
+ public:
+  using Ptr = std::shared_ptr<OmafStageStatistics>;
+
+ public:
+  OmafStageStatistics(){};
+  ~OmafStageStatistics(){};
+
+ public:
+  //!
+  //! \brief  record the latency of one stage
+  //!
+  void record(LatencyStage stage, LatencyTrackType type, std::chrono::steady_clock::duration latency) noexcept;
+
+  //!
+  //! \brief  record the latency of one stage, which starts from the given time
+  //!
+  void record(LatencyStage stage, LatencyTrackType type, std::chrono::steady_clock::time_point start) noexcept {
+    record(stage, type, std::chrono::steady_clock::now() - start);
+  };
+
+  //!
+  //! \brief  get the latency of all stages for all track types
+  //!
+  void statistic(DashStageStatisticInfo *info) const noexcept;
+
+  //!
+  //! \brief  dump the latency of all stages as JSON string, like
+  //!         {"download":{"video":{"count":1,"min_us":..},..},..}
+  //!
+  std::string to_json() const;
+
+  void reset() noexcept;
+
+  //!
+  //! \brief  get the track type for statistic from the media type
+  //!
+  static LatencyTrackType trackType(MediaType type, bool isExtractor) noexcept {
+    if (type == MediaType_Audio) return LatencyTrack_Audio;
+    return isExtractor ? LatencyTrack_Extractor : LatencyTrack_Video;
+  };
+
+ private:
+  LatencyHistogram histograms_[LatencyStage_Num][LatencyTrack_Num];
+};
+
+}  // namespace OMAF
+}  // namespace VCD
+
+#endif  // OMAFSTAGESTATISTICS_H_
@@ -107,6 +107,7 @@ int OmafTileTracksSelector::SelectTracks(OmafMediaStream* pStream, bool isTimed)
             if (predictedTracksArray.empty()) // Prediction error occurs
             {
                 m_SelectedTracks = GetTileTracksByPose(pStream);
+                SetViewportPriority(m_SelectedTracks, TaskPriority::HIGH);
             }
             else
             {
@@ -122,7 +123,13 @@ int OmafTileTracksSelector::SelectTracks(OmafMediaStream* pStream, bool isTimed)
                         // ignore when key is identical and have tracks selection limitation.
                         if (m_SelectedTracks.size() <= rowSize * colSize / 2 || m_SelectedTracks.size() < oneTracks.size())
                         {
-                            m_SelectedTracks.insert(*iter);
+                            // the tiles only in low priority viewport are predicted ones, and they
+                            // are fetched after the ones in high priority viewport
+                            if (m_SelectedTracks.insert(*iter).second && iter->second)
+                            {
+                                iter->second->SetViewportPriority(predictedTracksArray[i].first == ViewportPriority::HIGH ?
+                                    TaskPriority::HIGH : TaskPriority::NORMAL);
+                            }
                         }
                         else break;
                     }
@@ -141,6 +148,7 @@ int OmafTileTracksSelector::SelectTracks(OmafMediaStream* pStream, bool isTimed)
         else // not using prediction
         {
             m_SelectedTracks = GetTileTracksByPose(pStream);
+            SetViewportPriority(m_SelectedTracks, TaskPriority::HIGH);
         }
 
         if (m_SelectedTracks.empty() && m_currentTracks.empty())
@@ -195,6 +203,17 @@ int OmafTileTracksSelector::UpdateEnabledTracks(OmafMediaStream* pStream)
     return ret;
 }
 
+void OmafTileTracksSelector::SetViewportPriority(TracksMap& tracks, TaskPriority priority)
+{
+    for (auto it = tracks.begin(); it != tracks.end(); it++)
+    {
+        if (it->second)
+        {
+            it->second->SetViewportPriority(priority);
+        }
+    }
+}
+
 bool OmafTileTracksSelector::IsPoseChanged(HeadPose* pose1, HeadPose* pose2)
 {
     // return false if two pose is same
@@ -316,6 +335,7 @@ TracksMap OmafTileTracksSelector::SelectTileTracks(
     // in planar projection format
     if (abs(pose->zoomFactor) < 1e-3 && mProjFmt == ProjectionFormat::PF_PLANAR)
     {
+        DELETE_ARRAY(tilesInViewport);
         return selectedTracks;
     }
 
@@ -326,6 +346,18 @@ TracksMap OmafTileTracksSelector::SelectTileTracks(
         return selectedTracks;
     }
 
+    selectedTracks = GetTracksByTiles(pStream, tilesInViewport, selectedTilesNum);
+    DELETE_ARRAY(tilesInViewport);
+    return selectedTracks;
+}
+
+TracksMap OmafTileTracksSelector::GetTracksByTiles(
+    OmafMediaStream* pStream,
+    TileDef* tilesInViewport,
+    int32_t selectedTilesNum)
+{
+    TracksMap selectedTracks;
+
     mASMap.clear();
     mASMap = pStream->GetMediaAdaptationSet();
     std::map<int, OmafAdaptationSet*>::iterator itAS;
@@ -381,7 +413,6 @@ TracksMap OmafTileTracksSelector::SelectTileTracks(
                     if (!tileInfo)
                     {
                         OMAF_LOG(LOG_ERROR, "NULL tile information for Cubemap !\n");
-                        DELETE_ARRAY(tilesInViewport);
                         return selectedTracks;
                     }
                     int32_t tileLeft = tileInfo->x;
@@ -410,7 +441,6 @@ TracksMap OmafTileTracksSelector::SelectTileTracks(
             if (itStrQua == mTwoDStreamQualityMap.end())
             {
                 OMAF_LOG(LOG_ERROR, "Can't find corresponding quality ranking for stream index %d !\n", strId);
-                DELETE_ARRAY(tilesInViewport);
                 return selectedTracks;
             }
 
@@ -480,9 +510,75 @@ TracksMap OmafTileTracksSelector::SelectTileTracks(
         }
     }
 
+    return selectedTracks;
+}
+
+std::vector<TracksMap> OmafTileTracksSelector::SelectTileTracksForPoses(
+    OmafMediaStream* pStream,
+    HeadPose* poses,
+    uint32_t posesNum)
+{
+    std::vector<TracksMap> posesTracks(posesNum);
+
+    if (mTilesLayout.empty())
+    {
+        int32_t tilesNum = I360SCVP_GetTilesLayout(m360ViewPortHandle, NULL, 0);
+        if (tilesNum > 0)
+        {
+            mTilesLayout.resize(tilesNum);
+            if (I360SCVP_GetTilesLayout(m360ViewPortHandle, mTilesLayout.data(), tilesNum) != tilesNum)
+                mTilesLayout.clear();
+        }
+    }
+
+    int32_t ret = ERROR_INVALID;
+    int32_t bitsetWords = (mTilesLayout.size() + 63) / 64;
+    std::vector<uint64_t> tilesBitsets(posesNum * bitsetWords, 0);
+    if (!mTilesLayout.empty())
+    {
+        TilesSelectionBatch batch;
+        memset_s(&batch, sizeof(TilesSelectionBatch), 0);
+        batch.pPoses = poses;
+        batch.posesNum = posesNum;
+        batch.bitsetWords = bitsetWords;
+        batch.pTilesBitsets = tilesBitsets.data();
+        ret = I360SCVP_SelectTilesForPoses(m360ViewPortHandle, &batch);
+    }
+
+    // tile selection plugin, like the planar one, only selects tiles of the current pose
+    if (ret != ERROR_NONE)
+    {
+        for (uint32_t i = 0; i < posesNum; i++)
+        {
+            posesTracks[i] = SelectTileTracks(pStream, &poses[i]);
+        }
+        return posesTracks;
+    }
+
+    std::lock_guard<std::mutex> lock(mASMutex);
+    TileDef *tilesInViewport = new TileDef[mTilesLayout.size()];
+    if (!tilesInViewport)
+        return posesTracks;
+
+    for (uint32_t i = 0; i < posesNum; i++)
+    {
+        const uint64_t *bitset = tilesBitsets.data() + i * bitsetWords;
+        int32_t selectedTilesNum = 0;
+        for (uint32_t idx = 0; idx < mTilesLayout.size(); idx++)
+        {
+            if (bitset[idx >> 6] & (1ULL << (idx & 63)))
+                tilesInViewport[selectedTilesNum++] = mTilesLayout[idx];
+        }
+        if (selectedTilesNum <= 0)
+        {
+            OMAF_LOG(LOG_ERROR, "Failed to get tiles information in viewport of yaw %f, pitch %f!\n", poses[i].yaw, poses[i].pitch);
+            continue;
+        }
+        posesTracks[i] = GetTracksByTiles(pStream, tilesInViewport, selectedTilesNum);
+    }
     DELETE_ARRAY(tilesInViewport);
 
-    return selectedTracks;
+    return posesTracks;
 }
 
 std::vector<std::pair<ViewportPriority, TracksMap>> OmafTileTracksSelector::GetTileTracksByPosePrediction(
@@ -566,15 +662,22 @@ std::vector<std::pair<ViewportPriority, TracksMap>> OmafTileTracksSelector::GetT
         OMAF_LOG(LOG_INFO, "pred_angle.PTS %ld \n", pred_angle.first);
         predictPose[i].yaw = pred_angle.second->yaw;
         predictPose[i].pitch = pred_angle.second->pitch;
+        i++;
+    }
 
-        OMAF_LOG(LOG_INFO, "Start to select tile tracks!\n");
+    OMAF_LOG(LOG_INFO, "Start to select tile tracks!\n");
 #ifndef _ANDROID_NDK_OPTION_
 #ifdef _USE_TRACE_
-        // trace
-        tracepoint(mthq_tp_provider, T1_select_tracks, "tiletracks");
+    // trace
+    tracepoint(mthq_tp_provider, T1_select_tracks, "tiletracks");
 #endif
 #endif
-        TracksMap selectedTracks = SelectTileTracks(pStream, &predictPose[i]);
+    // tiles of all the candidate poses are selected in one call
+    std::vector<TracksMap> posesTracks = SelectTileTracksForPoses(pStream, predictPose, poseCandicateNum);
+    i = 0;
+    for (auto pred_angle : predict_angles)
+    {
+        TracksMap &selectedTracks = posesTracks[i];
         if (selectedTracks.size() && previousPose)
         {
             predictedTracks.push_back(make_pair(pred_angle.second->priority, selectedTracks));
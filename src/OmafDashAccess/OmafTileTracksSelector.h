@@ -100,12 +100,27 @@ private:
 
     TracksMap SelectTileTracks(OmafMediaStream* pStream, HeadPose* pose);
 
+    //!
+    //! \brief  Select tile tracks for all the poses by one batched tile
+    //!         selection, the tile tracks of pose i are the element i
+    //!
+    std::vector<TracksMap> SelectTileTracksForPoses(OmafMediaStream* pStream, HeadPose* poses, uint32_t posesNum);
+
+    //!
+    //! \brief  Get the tile tracks of the selected tiles, mASMutex must be
+    //!         held by the caller
+    //!
+    TracksMap GetTracksByTiles(OmafMediaStream* pStream, TileDef* tilesInViewport, int32_t selectedTilesNum);
+
     bool IsPoseChanged(HeadPose* pose1, HeadPose* pose2);
 
+    void SetViewportPriority(TracksMap& tracks, TaskPriority priority);
+
 private:
     TracksMap                 m_currentTracks;
     std::mutex                mExtractorsMutex;
     TracksMap                 m_SelectedTracks;
+    std::vector<TileDef>      mTilesLayout;  //!< all tiles of the viewport handle, indexed by the tile bitset bit
 };
 
 VCD_OMAF_END;
@@ -51,35 +51,19 @@ OmafTilesStitch::OmafTilesStitch() {
   m_tmpRegionrwpk = nullptr;
   m_maxStitchWidth = 0;
   m_maxStitchHeight = 0;
+  m_stitchThreadNum = 0;
+  m_spanOutput = false;
+  m_pendingJobs = nullptr;
+  m_pendingContexts = nullptr;
+  m_nextJob = 0;
+  m_doneJobs = 0;
+  m_stopWorkers = false;
 }
 
 OmafTilesStitch::~OmafTilesStitch() {
-  if (m_selectedTiles.size()) {
-    std::list<MediaPacket *> allPackets;
-    std::map<QualityRank, std::map<uint32_t, MediaPacket *>>::iterator it;
-    for (it = m_selectedTiles.begin(); it != m_selectedTiles.end();) {
-      std::map<uint32_t, MediaPacket *> packets = it->second;
-      if (packets.size()) {
-        std::map<uint32_t, MediaPacket *>::iterator it1;
-        for (it1 = packets.begin(); it1 != packets.end();) {
-          MediaPacket *onePacket = it1->second;
-          std::list<MediaPacket *>::iterator pktIter;
-          pktIter = std::find(allPackets.begin(), allPackets.end(), onePacket);
-          if (pktIter == allPackets.end())
-          {
-            allPackets.push_back(onePacket);
-            SAFE_DELETE(onePacket);
-          }
-          packets.erase(it1++);
-        }
-        packets.clear();
-      }
-      allPackets.clear();
-      m_selectedTiles.erase(it++);
-    }
+  StopStitchWorkers();
 
-    m_selectedTiles.clear();
-  }
+  ReleaseSelectedTiles();
 
   if (m_initTilesMergeArr.size()) {
     std::map<QualityRank, vector<TilesMergeArrangement *>>::iterator it;
@@ -212,6 +196,7 @@ int32_t OmafTilesStitch::Initialize(std::map<uint32_t, MediaPacket *> &firstFram
 
     m_selectedTiles.insert(std::make_pair(oneQuality, packets));
   }
+  HoldSelectedTiles();
 
   if (m_allQualities.size() != m_selectedTiles.size()) {
     OMAF_LOG(LOG_ERROR, "Failed to differentiate media packets from different quality ranking !\n");
@@ -356,32 +341,7 @@ int32_t OmafTilesStitch::UpdateSelectedTiles(std::map<uint32_t, MediaPacket *> &
     return OMAF_ERROR_INVALID_DATA;
   }
 
-  if (m_selectedTiles.size()) {
-    std::list<MediaPacket *> allPackets;
-    std::map<QualityRank, std::map<uint32_t, MediaPacket *>>::iterator it;
-    for (it = m_selectedTiles.begin(); it != m_selectedTiles.end();) {
-      std::map<uint32_t, MediaPacket *> packets = it->second;
-      if (packets.size()) {
-        std::map<uint32_t, MediaPacket *>::iterator it1;
-        for (it1 = packets.begin(); it1 != packets.end();) {
-          MediaPacket *onePacket = it1->second;
-          std::list<MediaPacket *>::iterator pktIter;
-          pktIter = std::find(allPackets.begin(), allPackets.end(), onePacket);
-          if (pktIter == allPackets.end())
-          {
-            allPackets.push_back(onePacket);
-            SAFE_DELETE(onePacket);
-          }
-          packets.erase(it1++);
-        }
-        packets.clear();
-      }
-      allPackets.clear();
-      m_selectedTiles.erase(it++);
-    }
-
-    m_selectedTiles.clear();
-  }
+  ReleaseSelectedTiles();
 
   m_needHeaders = needParams;
 
@@ -443,6 +403,7 @@ int32_t OmafTilesStitch::UpdateSelectedTiles(std::map<uint32_t, MediaPacket *> &
 
     m_selectedTiles.insert(std::make_pair(oneQuality, packets));
   }
+  HoldSelectedTiles();
 
   if (m_allQualities.size() != m_selectedTiles.size()) {
     OMAF_LOG(LOG_ERROR, "Failed to differentiate media packets from different quality ranking !\n");
@@ -1569,11 +1530,25 @@ int32_t OmafTilesStitch::InitMergedDataAndRealSize(QualityRank qualityRanking, s
     return ERROR_NONE;
 }
 
+static void AddOutputSpan(std::vector<Output_Span> *spans, const uint8_t *data, uint32_t dataLen) {
+  if (!dataLen) return;
+  // merge with the previous span when they are contiguous in memory
+  if (!spans->empty() && spans->back().pData + spans->back().dataLen == data) {
+    spans->back().dataLen += dataLen;
+    return;
+  }
+  Output_Span span;
+  span.pData = data;
+  span.dataLen = dataLen;
+  spans->push_back(span);
+}
+
 int32_t OmafTilesStitch::UpdateMergedDataAndRealSize(
     QualityRank qualityRanking, std::map<uint32_t, MediaPacket *> packets,
     uint8_t tileColsNum, bool arrangeChanged, uint32_t width, uint32_t height,
     uint32_t initWidth, uint32_t initHeight, char *mergedData, uint64_t *realSize,
-    uint32_t index, vector<uint32_t> needPacketSize, uint64_t layoutNum) {
+    uint32_t index, vector<uint32_t> needPacketSize, uint64_t layoutNum,
+    param_360SCVP *scvpParam, void *scvpHandle, std::vector<Output_Span> *spans) {
 
     uint32_t tilesIdx = 0;
     int32_t tileWidth = 0;
@@ -1582,8 +1557,8 @@ int32_t OmafTilesStitch::UpdateMergedDataAndRealSize(
         OMAF_LOG(LOG_ERROR, "tile column number cannot be zero!\n");
         return OMAF_ERROR_INVALID_DATA;
     }
-    if (mergedData == NULL || realSize == NULL) {
-        OMAF_LOG(LOG_ERROR, "merged data or realSize is null ptr!\n");
+    if (mergedData == NULL || realSize == NULL || scvpParam == NULL || scvpHandle == NULL) {
+        OMAF_LOG(LOG_ERROR, "merged data, realSize or 360SCVP context is null ptr!\n");
         return OMAF_ERROR_NULL_PTR;
     }
     // calculate real size for merged packets
@@ -1675,23 +1650,28 @@ int32_t OmafTilesStitch::UpdateMergedDataAndRealSize(
 
         nalu->data = (uint8_t *)data;
         nalu->dataSize = dataSize;
-        I360SCVP_ParseNAL(nalu, m_360scvpHandle);
+        I360SCVP_ParseNAL(nalu, scvpHandle);
 
         nalu->sliceHeaderLen = nalu->sliceHeaderLen - HEVC_NALUHEADER_LEN;
 
-        m_360scvpParam->destWidth = (arrangeChanged ? width : initWidth);
-        m_360scvpParam->destHeight = (arrangeChanged ? height : initHeight);
-        m_360scvpParam->pInputBitstream = (uint8_t *)data;
-        m_360scvpParam->inputBitstreamLen = dataSize;
-        m_360scvpParam->pOutputBitstream = (uint8_t *)mergedData + *realSize;
-        I360SCVP_GenerateSliceHdr(m_360scvpParam, ctuIdx, m_360scvpHandle);
-        *realSize += m_360scvpParam->outputBitstreamLen;
-        memcpy_s(mergedData + *realSize,
-                 (size_t(nalu->dataSize) - (HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen)),
-                 (nalu->data + HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen),
-                 (size_t(nalu->dataSize) - (HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen)));
-
-        *realSize += nalu->dataSize - (HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen);
+        scvpParam->destWidth = (arrangeChanged ? width : initWidth);
+        scvpParam->destHeight = (arrangeChanged ? height : initHeight);
+        scvpParam->pInputBitstream = (uint8_t *)data;
+        scvpParam->inputBitstreamLen = dataSize;
+        scvpParam->pOutputBitstream = (uint8_t *)mergedData + *realSize;
+        I360SCVP_GenerateSliceHdr(scvpParam, ctuIdx, scvpHandle);
+        uint8_t *sliceData = nalu->data + HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen;
+        uint32_t sliceDataLen = nalu->dataSize - (HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + nalu->sliceHeaderLen);
+        if (spans) {
+          // only the rewritten slice header is written, the slice data stays in the tile packet
+          AddOutputSpan(spans, (uint8_t *)mergedData + *realSize, scvpParam->outputBitstreamLen);
+          *realSize += scvpParam->outputBitstreamLen;
+          AddOutputSpan(spans, sliceData, sliceDataLen);
+        } else {
+          *realSize += scvpParam->outputBitstreamLen;
+          memcpy_s(mergedData + *realSize, sliceDataLen, sliceData, sliceDataLen);
+          *realSize += sliceDataLen;
+        }
         SAFE_DELETE(nalu);
         tilesIdx++;
       } else {
@@ -1712,8 +1692,12 @@ int32_t OmafTilesStitch::UpdateMergedDataAndRealSize(
             OMAF_LOG(LOG_ERROR, "After video headers (VPS/SPS/PPS) are moved, invalid data in selected media packet !\n");
             return OMAF_ERROR_INVALID_DATA;
         }
-        memcpy_s(mergedData + *realSize, dataSize, data, dataSize);
-        *realSize += dataSize;
+        if (spans) {
+          AddOutputSpan(spans, (uint8_t *)data, dataSize);
+        } else {
+          memcpy_s(mergedData + *realSize, dataSize, data, dataSize);
+          *realSize += dataSize;
+        }
       }
     }
     return ERROR_NONE;
@@ -1802,11 +1786,17 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
   // for each quality ranking
   std::map<QualityRank, vector<TilesMergeArrangement *>>::iterator it;
   for (it = tilesMergeArr.begin(); it != tilesMergeArr.end(); it++) {
+    // merge jobs of this quality ranking in output order, headers and packet
+    // params are prepared sequentially, then tiles data are stitched
+    vector<TilesMergeJob> jobs;
     auto qualityRanking = it->first;
     bool packetLost = false;
     bool arrangeChanged = false;
     vector<TilesMergeArrangement *> layOut = it->second;
-    if (layOut.empty()) return OMAF_ERROR_NULL_PTR;
+    if (layOut.empty()) {
+      DeleteMergeJobs(jobs);
+      return OMAF_ERROR_NULL_PTR;
+    }
     vector<TilesMergeArrangement *> initLayOut = m_initTilesMergeArr[qualityRanking];
 
     // 1. check isArrChanged, packetLost and arrangeChanged flag.
@@ -1814,6 +1804,7 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
     if (ret != ERROR_NONE)
     {
         OMAF_LOG(LOG_ERROR, "error ocurrs in checking arrange changed!\n");
+        DeleteMergeJobs(jobs);
         return OMAF_ERROR_OPERATION;
     }
 
@@ -1823,12 +1814,14 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
     if (ret != ERROR_NONE)
     {
         OMAF_LOG(LOG_ERROR, "generate merged video headers failed! and error code is %d\n", ret);
+        DeleteMergeJobs(jobs);
         return OMAF_ERROR_OPERATION;
     }
     // 3. generate rwpk structure for ERP/Cubemap
     vector<std::unique_ptr<RegionWisePacking>> rwpk = GenerateMergedRWPK(qualityRanking, packetLost, arrangeChanged);
     if (rwpk.empty()) {
         OMAF_LOG(LOG_ERROR, "Failed to generate merged rwpk!\n");
+        DeleteMergeJobs(jobs);
         return OMAF_ERROR_GENERATE_RWPK;
     }
     // 4. init mergedData and realSize with headers
@@ -1848,6 +1841,7 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
       if (ERROR_NONE != InitMergedDataAndRealSize(qualityRanking, packets, mergedData, &realSize, index, layOut[index])) {
           SAFE_DELETE(mergedPacket);
           OMAF_LOG(LOG_ERROR, "Failed to calculated mergedData and realSize!\n");
+          DeleteMergeJobs(jobs);
           return OMAF_ERROR_OPERATION;
       }
       // 5. set params for merged packets
@@ -1859,6 +1853,7 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
 
       if (!arrange) {
         SAFE_DELETE(mergedPacket);
+        DeleteMergeJobs(jobs);
         return OMAF_ERROR_NULL_PTR;
       }
 
@@ -1871,6 +1866,7 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
       {
         OMAF_LOG(LOG_ERROR, "Packet map is empty!\n");
         SAFE_DELETE(mergedPacket);
+        DeleteMergeJobs(jobs);
         return OMAF_ERROR_INVALID_DATA;
       }
       MediaPacket *firstPacket = itPacket->second;
@@ -1900,19 +1896,50 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
       }
       mergedPacket->SetPRFT(std::move(newPrft));
 
-      if (ERROR_NONE != UpdateMergedDataAndRealSize(
-                            qualityRanking, packets, tileColsNum,
-                            arrangeChanged, width, height, initWidth,
-                            initHeight, mergedData, &realSize, index,
-                            needAccumPacketSize, layOut.size())) {
-          OMAF_LOG(LOG_ERROR, "Failed to update mergedData and realSize!\n");
-          SAFE_DELETE(mergedPacket);
-          return OMAF_ERROR_OPERATION;
+      TilesMergeJob job;
+      job.qualityRanking = qualityRanking;
+      job.packets = packets;
+      job.tileColsNum = tileColsNum;
+      job.arrangeChanged = arrangeChanged;
+      job.width = width;
+      job.height = height;
+      job.initWidth = initWidth;
+      job.initHeight = initHeight;
+      job.mergedPacket = mergedPacket;
+      job.realSize = realSize;
+      if (m_spanOutput && realSize) {
+        AddOutputSpan(&(job.spans), (uint8_t *)mergedData, realSize);
       }
+      job.index = index;
+      job.needPacketSize = needAccumPacketSize;
+      job.layoutNum = layOut.size();
+      job.ret = ERROR_NONE;
+      jobs.push_back(std::move(job));
+    }
 
-      mergedPacket->SetRealSize(realSize);
-
-      m_outMergedStream.push_back(mergedPacket);
+    // 6. stitch tiles data for merged packets of this quality ranking while
+    // 360SCVP handle still holds its SPS/PPS, the output order is the jobs order
+    RunMergeJobs(jobs, qualityRanking, packets);
+    for (auto &job : jobs) {
+      if (ERROR_NONE != job.ret) {
+        OMAF_LOG(LOG_ERROR, "Failed to update mergedData and realSize!\n");
+        DeleteMergeJobs(jobs);
+        return OMAF_ERROR_OPERATION;
+      }
+    }
+    for (auto &job : jobs) {
+      if (m_spanOutput) {
+        // the payload only keeps the merged headers and the rewritten slice
+        // headers, the real size is the size of the whole merged frame
+        uint64_t frameSize = 0;
+        for (auto &span : job.spans) frameSize += span.dataLen;
+        job.mergedPacket->SetRealSize(frameSize);
+        job.mergedPacket->SetSpans(std::move(job.spans), m_tilesOwner);
+      } else {
+        job.mergedPacket->SetRealSize(job.realSize);
+      }
+      m_outMergedStream.push_back(job.mergedPacket);
+      job.mergedPacket = nullptr;
     }
   } // each quality ranking
 
@@ -1926,6 +1953,247 @@ int32_t OmafTilesStitch::GenerateOutputMergedPackets() {
   return ERROR_NONE;
 }
 
+void OmafTilesStitch::HoldSelectedTiles() {
+  std::list<MediaPacket *> *allPackets = new std::list<MediaPacket *>;
+  for (auto it = m_selectedTiles.begin(); it != m_selectedTiles.end(); it++) {
+    for (auto it1 = it->second.begin(); it1 != it->second.end(); it1++) {
+      MediaPacket *onePacket = it1->second;
+      if (std::find(allPackets->begin(), allPackets->end(), onePacket) == allPackets->end())
+        allPackets->push_back(onePacket);
+    }
+  }
+  // merged packets in scatter/gather output mode share the ownership, since
+  // their spans point to the slice data inside these tile packets
+  m_tilesOwner.reset(allPackets, [](std::list<MediaPacket *> *packets) {
+    for (auto packet : *packets) {
+      SAFE_DELETE(packet);
+    }
+    delete packets;
+  });
+}
+
+void OmafTilesStitch::ReleaseSelectedTiles() {
+  m_selectedTiles.clear();
+  m_tilesOwner.reset();
+}
+
+void OmafTilesStitch::DeleteMergeJobs(vector<TilesMergeJob> &jobs) {
+  for (auto &job : jobs) {
+    SAFE_DELETE(job.mergedPacket);
+  }
+  jobs.clear();
+}
+
+void OmafTilesStitch::RunOneMergeJob(TilesMergeJob *job, param_360SCVP *scvpParam, void *scvpHandle) {
+  job->ret = UpdateMergedDataAndRealSize(
+      job->qualityRanking, job->packets, job->tileColsNum,
+      job->arrangeChanged, job->width, job->height, job->initWidth,
+      job->initHeight, job->mergedPacket->Payload(), &(job->realSize), job->index,
+      job->needPacketSize, job->layoutNum, scvpParam, scvpHandle,
+      m_spanOutput ? &(job->spans) : nullptr);
+}
+
+void OmafTilesStitch::RunMergeJobs(vector<TilesMergeJob> &jobs, QualityRank qualityRanking,
+                                   std::map<uint32_t, MediaPacket *> &packets) {
+  if (m_stitchThreadNum && m_stitchWorkers.empty() && jobs.size() > 1) {
+    if (ERROR_NONE != StartStitchWorkers()) {
+      OMAF_LOG(LOG_WARNING, "Failed to start stitch workers, stitch on the calling thread !\n");
+      m_stitchThreadNum = 0;
+    }
+  }
+
+  vector<TilesMergeContext> *contexts = nullptr;
+  if (!m_stitchWorkers.empty() && jobs.size() > 1) {
+    if (ERROR_NONE == PrepareMergeContexts(qualityRanking, packets)) {
+      contexts = &(m_mergeContexts[qualityRanking]);
+    } else {
+      OMAF_LOG(LOG_WARNING, "Failed to prepare stitch contexts for quality ranking %d, stitch on the calling thread !\n", qualityRanking);
+    }
+  }
+
+  if (!contexts) {
+    for (auto &job : jobs) {
+      RunOneMergeJob(&job, m_360scvpParam, m_360scvpHandle);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    m_pendingJobs = &jobs;
+    m_pendingContexts = contexts;
+    m_nextJob = 0;
+    m_doneJobs = 0;
+  }
+  m_jobsCond.notify_all();
+
+  // the calling thread stitches together with the workers
+  while (true) {
+    TilesMergeJob *job = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_jobsMutex);
+      if (m_nextJob < jobs.size()) job = &jobs[m_nextJob++];
+    }
+    if (!job) break;
+    RunOneMergeJob(job, m_360scvpParam, m_360scvpHandle);
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    m_doneJobs++;
+  }
+
+  std::unique_lock<std::mutex> lock(m_jobsMutex);
+  m_jobsDoneCond.wait(lock, [this, &jobs] { return m_doneJobs == jobs.size(); });
+  m_pendingJobs = nullptr;
+  m_pendingContexts = nullptr;
+}
+
+void OmafTilesStitch::StitchWorkerRun(uint32_t workerIdx) {
+  while (true) {
+    TilesMergeJob *job = nullptr;
+    TilesMergeContext ctx;
+    {
+      std::unique_lock<std::mutex> lock(m_jobsMutex);
+      m_jobsCond.wait(lock, [this] { return m_stopWorkers || (m_pendingJobs && m_nextJob < m_pendingJobs->size()); });
+      if (m_stopWorkers) break;
+      job = &(*m_pendingJobs)[m_nextJob++];
+      ctx = (*m_pendingContexts)[workerIdx];
+    }
+    RunOneMergeJob(job, ctx.scvpParam, ctx.scvpHandle);
+    {
+      std::lock_guard<std::mutex> lock(m_jobsMutex);
+      m_doneJobs++;
+      if (m_doneJobs == m_pendingJobs->size()) m_jobsDoneCond.notify_all();
+    }
+  }
+}
+
+int32_t OmafTilesStitch::InitMergeContext(TilesMergeContext *ctx, uint8_t *headers, uint32_t vpsLen, uint32_t spsLen, uint32_t ppsLen) {
+  if (!ctx || !headers) return OMAF_ERROR_NULL_PTR;
+
+  uint32_t headersSize = vpsLen + spsLen + ppsLen;
+  ctx->scvpParam = new param_360SCVP;
+  if (!ctx->scvpParam) return OMAF_ERROR_NULL_PTR;
+
+  memset(ctx->scvpParam, 0, sizeof(param_360SCVP));
+  ctx->scvpParam->usedType = E_PARSER_ONENAL;
+  ctx->scvpParam->pInputBitstream = headers;
+  ctx->scvpParam->inputBitstreamLen = headersSize;
+  ctx->scvpParam->logFunction = (void*)logCallBack;
+
+  ctx->scvpHandle = I360SCVP_Init(ctx->scvpParam);
+  if (!ctx->scvpHandle) {
+    SAFE_DELETE(ctx->scvpParam);
+    return OMAF_ERROR_NULL_PTR;
+  }
+
+  // parse VPS/SPS/PPS as the main handle does when headers are generated
+  Nalu oneNalu;
+  memset(&oneNalu, 0, sizeof(Nalu));
+  oneNalu.data = headers;
+  oneNalu.dataSize = headersSize;
+  uint32_t headerSizes[3] = { vpsLen, spsLen, ppsLen };
+  for (uint32_t i = 0; i < 3; i++) {
+    if (I360SCVP_ParseNAL(&oneNalu, ctx->scvpHandle) || (uint32_t)(oneNalu.dataSize) != headerSizes[i]) {
+      I360SCVP_unInit(ctx->scvpHandle);
+      ctx->scvpHandle = nullptr;
+      SAFE_DELETE(ctx->scvpParam);
+      return OMAF_ERROR_INVALID_HEADER;
+    }
+    oneNalu.data += headerSizes[i];
+    oneNalu.dataSize = headersSize - (oneNalu.data - headers);
+  }
+  return ERROR_NONE;
+}
+
+int32_t OmafTilesStitch::PrepareMergeContexts(QualityRank qualityRanking, std::map<uint32_t, MediaPacket *> &packets) {
+  uint8_t *headers = nullptr;
+  uint32_t vpsLen = 0;
+  uint32_t spsLen = 0;
+  uint32_t ppsLen = 0;
+  if (qualityRanking == HIGHEST_QUALITY_RANKING) {
+    headers = m_fullResVideoHeader;
+    vpsLen = m_fullResVPSSize;
+    spsLen = m_fullResSPSSize;
+    ppsLen = m_fullResPPSSize;
+  } else {
+    // same packet as the merged video headers are generated from
+    std::map<uint32_t, MediaPacket *>::iterator itPacket = packets.begin();
+    if (itPacket == packets.end() || !itPacket->second) return OMAF_ERROR_INVALID_DATA;
+    MediaPacket *onePacket = itPacket->second;
+    if (!(onePacket->GetHasVideoHeader())) return OMAF_ERROR_INVALID_DATA;
+    headers = (uint8_t *)(onePacket->Payload());
+    vpsLen = onePacket->GetVPSLen();
+    spsLen = onePacket->GetSPSLen();
+    ppsLen = onePacket->GetPPSLen();
+  }
+  if (!headers) return OMAF_ERROR_NULL_PTR;
+
+  vector<uint8_t> seedHeaders(headers, headers + vpsLen + spsLen + ppsLen);
+  std::map<QualityRank, vector<uint8_t>>::iterator itSeed = m_mergeContextHeaders.find(qualityRanking);
+  if (itSeed != m_mergeContextHeaders.end() && itSeed->second == seedHeaders &&
+      m_mergeContexts[qualityRanking].size() == m_stitchWorkers.size()) {
+    return ERROR_NONE;
+  }
+
+  ReleaseMergeContexts(qualityRanking);
+  // contexts keep pointing to the seed headers, so they live as long as the contexts
+  m_mergeContextHeaders[qualityRanking] = std::move(seedHeaders);
+  uint8_t *seedData = m_mergeContextHeaders[qualityRanking].data();
+  vector<TilesMergeContext> &contexts = m_mergeContexts[qualityRanking];
+  for (uint32_t i = 0; i < m_stitchWorkers.size(); i++) {
+    TilesMergeContext ctx;
+    int32_t ret = InitMergeContext(&ctx, seedData, vpsLen, spsLen, ppsLen);
+    if (ret != ERROR_NONE) {
+      ReleaseMergeContexts(qualityRanking);
+      return ret;
+    }
+    contexts.push_back(ctx);
+  }
+  return ERROR_NONE;
+}
+
+void OmafTilesStitch::ReleaseMergeContexts(QualityRank qualityRanking) {
+  std::map<QualityRank, vector<TilesMergeContext>>::iterator it = m_mergeContexts.find(qualityRanking);
+  if (it != m_mergeContexts.end()) {
+    for (auto &ctx : it->second) {
+      if (ctx.scvpHandle) {
+        I360SCVP_unInit(ctx.scvpHandle);
+        ctx.scvpHandle = nullptr;
+      }
+      SAFE_DELETE(ctx.scvpParam);
+    }
+    m_mergeContexts.erase(it);
+  }
+  m_mergeContextHeaders.erase(qualityRanking);
+}
+
+int32_t OmafTilesStitch::StartStitchWorkers() {
+  if (!m_stitchThreadNum) return OMAF_ERROR_INVALID_DATA;
+
+  m_stopWorkers = false;
+  for (uint32_t i = 0; i < m_stitchThreadNum; i++) {
+    m_stitchWorkers.push_back(std::thread(&OmafTilesStitch::StitchWorkerRun, this, i));
+  }
+  OMAF_LOG(LOG_INFO, "Start %u stitch workers\n", m_stitchThreadNum);
+  return ERROR_NONE;
+}
+
+void OmafTilesStitch::StopStitchWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    m_stopWorkers = true;
+  }
+  m_jobsCond.notify_all();
+  for (auto &worker : m_stitchWorkers) {
+    if (worker.joinable()) worker.join();
+  }
+  m_stitchWorkers.clear();
+
+  while (!m_mergeContexts.empty()) {
+    ReleaseMergeContexts(m_mergeContexts.begin()->first);
+  }
+  m_mergeContextHeaders.clear();
+}
+
 std::list<MediaPacket *> OmafTilesStitch::GetTilesMergedPackets() {
   this->GenerateOutputMergedPackets();
   return m_outMergedStream;
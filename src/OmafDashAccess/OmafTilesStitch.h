@@ -40,7 +40,10 @@
 #include "MediaPacket.h"
 #include "general.h"
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 VCD_OMAF_BEGIN
 
@@ -64,6 +67,40 @@ typedef struct TilesMergeArrangement {
   TileArrangement tilesLayout;
 } TilesMergeArrangement;
 
+//!
+//! \sturct: TilesMergeJob
+//! \brief:  all information to stitch the tiles of one merge arrangement
+//!          into one merged packet, which is independent of other jobs
+//!
+typedef struct TilesMergeJob {
+  QualityRank qualityRanking;
+  std::map<uint32_t, MediaPacket *> packets;
+  uint8_t tileColsNum;
+  bool arrangeChanged;
+  uint32_t width;
+  uint32_t height;
+  uint32_t initWidth;
+  uint32_t initHeight;
+  MediaPacket *mergedPacket;
+  uint64_t realSize;
+  uint32_t index;
+  vector<uint32_t> needPacketSize;
+  uint64_t layoutNum;
+  std::vector<Output_Span> spans;
+  int32_t ret;
+} TilesMergeJob;
+
+//!
+//! \sturct: TilesMergeContext
+//! \brief:  360SCVP library handle and parameter owned by one stitch worker,
+//!          slice header generation can't share one handle between threads,
+//!          and the handle keeps the SPS/PPS of the quality ranking it's for
+//!
+typedef struct TilesMergeContext {
+  param_360SCVP *scvpParam;
+  void *scvpHandle;
+} TilesMergeContext;
+
 //!
 //! \class OmafTilesStitch
 //! \brief The class for tiles stitching
@@ -135,6 +172,29 @@ class OmafTilesStitch {
 
   void SetMaxStitchResolution(uint32_t width, uint32_t height) { m_maxStitchWidth = width; m_maxStitchHeight = height; };
 
+  //!
+  //! \brief  Set the number of worker threads which stitch merge arrangements
+  //!         of one quality ranking in parallel with the calling thread, 0
+  //!         means all arrangements are stitched on the calling thread. The
+  //!         output packets don't depend on the worker threads number.
+  //!
+  //! \param  [in] threadNum
+  //!         the number of worker threads
+  //!
+  void SetStitchThreadNum(uint32_t threadNum) { m_stitchThreadNum = threadNum; };
+
+  //!
+  //! \brief  Set whether merged packets are output in scatter/gather mode, in
+  //!         which the slice data isn't copied into the merged packet, the
+  //!         packet describes the merged frame by spans over its own payload
+  //!         and the tile packets, which are kept alive until the merged
+  //!         packet is released
+  //!
+  //! \param  [in] enable
+  //!         whether to enable the scatter/gather output mode
+  //!
+  void SetSpanOutput(bool enable) { m_spanOutput = enable; };
+
  private:
   //!
   //! \brief  Parse the VPS/SPS/PPS information
@@ -257,7 +317,65 @@ private:
       QualityRank qualityRanking, std::map<uint32_t, MediaPacket *> packets,
       uint8_t tileColsNum, bool arrangeChanged, uint32_t width, uint32_t height,
       uint32_t initWidth, uint32_t initHeight, char *mergedData, uint64_t *realSize,
-      uint32_t index, vector<uint32_t> needPacketSize, uint64_t layoutNum);
+      uint32_t index, vector<uint32_t> needPacketSize, uint64_t layoutNum,
+      param_360SCVP *scvpParam, void *scvpHandle, std::vector<Output_Span> *spans);
+
+  //!
+  //! \brief  Stitch all merge jobs of one quality ranking, in parallel on the
+  //!         stitch workers if they are available, each job keeps its own
+  //!         result. It must run right after the merged video headers of
+  //!         the quality ranking are generated, since slice headers are
+  //!         generated against the SPS/PPS last parsed by the main handle
+  //!
+  //! \param  [in] jobs
+  //!         merge jobs of the quality ranking
+  //! \param  [in] qualityRanking
+  //!         the quality ranking all the jobs belong to
+  //! \param  [in] packets
+  //!         selected media packets of the quality ranking
+  //!
+  void RunMergeJobs(vector<TilesMergeJob> &jobs, QualityRank qualityRanking,
+                    std::map<uint32_t, MediaPacket *> &packets);
+
+  void RunOneMergeJob(TilesMergeJob *job, param_360SCVP *scvpParam, void *scvpHandle);
+
+  void DeleteMergeJobs(vector<TilesMergeJob> &jobs);
+
+  //!
+  //! \brief  Take the ownership of the tile packets in m_selectedTiles
+  //!
+  void HoldSelectedTiles();
+
+  //!
+  //! \brief  Drop m_selectedTiles, the tile packets are deleted once no
+  //!         merged packet in scatter/gather output mode refers to them
+  //!
+  void ReleaseSelectedTiles();
+
+  int32_t StartStitchWorkers();
+
+  void StopStitchWorkers();
+
+  void StitchWorkerRun(uint32_t workerIdx);
+
+  int32_t InitMergeContext(TilesMergeContext *ctx, uint8_t *headers, uint32_t vpsLen, uint32_t spsLen, uint32_t ppsLen);
+
+  //!
+  //! \brief  Make sure there is one 360SCVP context for each stitch worker
+  //!         seeded with the original VPS/SPS/PPS of the quality ranking
+  //!
+  //! \param  [in] qualityRanking
+  //!         the quality ranking the contexts are for
+  //! \param  [in] packets
+  //!         selected media packets of the quality ranking, the first one
+  //!         carries the original VPS/SPS/PPS for low quality ranking
+  //!
+  //! \return int32_t
+  //!         ERROR_NONE if success, else failed reason
+  //!
+  int32_t PrepareMergeContexts(QualityRank qualityRanking, std::map<uint32_t, MediaPacket *> &packets);
+
+  void ReleaseMergeContexts(QualityRank qualityRanking);
 
   int32_t UpdateInitTilesMergeArr();
 
@@ -270,6 +388,8 @@ private:
 
   PacketsMap m_selectedTiles;  //<! map of <qualityRanking, <trackID, MediaPacket*>>
 
+  std::shared_ptr<std::list<MediaPacket *>> m_tilesOwner;  //<! owner of the tile packets in m_selectedTiles
+
   std::set<QualityRank> m_allQualities;  //<! set of all quality ranking values
 
   param_360SCVP *m_360scvpParam;  //<! 360SCVP library input parameter
@@ -316,6 +436,32 @@ private:
   uint32_t m_maxStitchHeight; //<! max merged height for stitching
 
   std::map<uint32_t, SourceInfo> m_sources; //all video source information corresponding to different quality ranking <qualityRanking, SourceInfo>
+
+  uint32_t m_stitchThreadNum; //<! number of stitch worker threads, 0 for stitching on the calling thread
+
+  bool m_spanOutput; //<! whether merged packets are output in scatter/gather mode
+
+  vector<std::thread> m_stitchWorkers; //<! stitch worker threads
+
+  std::map<QualityRank, vector<TilesMergeContext>> m_mergeContexts; //<! 360SCVP contexts for each stitch worker per quality ranking
+
+  std::map<QualityRank, vector<uint8_t>> m_mergeContextHeaders; //<! original VPS/SPS/PPS the contexts of each quality ranking are seeded with
+
+  vector<TilesMergeContext> *m_pendingContexts; //<! contexts for the pending merge jobs
+
+  std::mutex m_jobsMutex; //<! mutex for the pending merge jobs
+
+  std::condition_variable m_jobsCond; //<! cv to notify stitch workers of new merge jobs
+
+  std::condition_variable m_jobsDoneCond; //<! cv to notify the calling thread all merge jobs are done
+
+  vector<TilesMergeJob> *m_pendingJobs; //<! merge jobs of current frame, null if there is none
+
+  size_t m_nextJob; //<! index of the next merge job to run
+
+  size_t m_doneJobs; //<! number of finished merge jobs
+
+  bool m_stopWorkers; //<! whether stitch workers need to exit
 };
 
 VCD_OMAF_END;
@@ -44,6 +44,7 @@ namespace VCD {
 namespace OMAF {
 
 const long DEFAULT_MAX_PARALLEL_TRANSFERS = 50;
+const long DEFAULT_HTTP2_MAX_HOST_CONNECTIONS = 2;
 const int32_t DEFAULT_SEGMENT_OPEN_TIMEOUT = 3000;
 
 enum class OmafDashMode { EXTRACTOR = 0, LATER_BINDING = 1, MULTI_VIEW = 2 };
@@ -76,6 +77,8 @@ class OmafDashHttpParams {
   bool bssl_verify_peer_ = false;
   bool bssl_verify_host_ = false;
   bool enable_byte_range_ = false;
+  bool enable_http2_ = false;
+  long max_host_connections_ = DEFAULT_HTTP2_MAX_HOST_CONNECTIONS;
   std::string to_string() {
     std::stringstream ss;
     ss << "http params: {" << std::endl;
@@ -85,6 +88,8 @@ class OmafDashHttpParams {
     ss << "\tssl verify peer state: " << bssl_verify_peer_ << "" << std::endl;
     ss << "\tssl verify host state: " << bssl_verify_host_ << "" << std::endl;
     ss << "\tbyte range: " << enable_byte_range_ << "" << std::endl;
+    ss << "\thttp2: " << enable_http2_ << "" << std::endl;
+    ss << "\tmax host connections: " << max_host_connections_ << "" << std::endl;
     ss << "}";
     return ss.str();
   }
@@ -145,9 +150,12 @@ class OmafDashParams {
   OmafDashPredictorParams prediector_params_;
   long max_parallel_transfers_ = DEFAULT_MAX_PARALLEL_TRANSFERS;
   int32_t segment_open_timeout_ms_ = DEFAULT_SEGMENT_OPEN_TIMEOUT;
+  uint64_t max_segment_cache_size_ = 0;
   // for stitch
   uint32_t max_decode_width_;
   uint32_t max_decode_height_;
+  uint32_t max_stitch_threads_ = 0;
+  bool enable_span_output_ = false;
   // for catch up
   bool enable_in_time_viewport_update;
   uint32_t max_response_times_in_seg;
@@ -198,6 +206,8 @@ class DashSegmentSourceParams {
   int64_t timeline_point_ = -1;
   std::string dash_url_;  // unique in the system
   TaskPriority priority_ = TaskPriority::LOW;
+  // the adaptation set which the segment belongs to, used to cancel the stale downloads
+  int32_t adaptation_set_id_ = -1;
   // for chunked structure in segment
   uint32_t start_chunk_id_ = 0;
   uint32_t chunk_num_ = 0;
@@ -211,6 +221,7 @@ class DashSegmentSourceParams {
     std::stringstream ss;
     ss << "url=" << dash_url_;
     ss << ", priority=" << priority(priority_);
+    ss << ", adaptation_set_id=" << adaptation_set_id_;
     ss << ", timeline_point=" << timeline_point_;
     ss << ", start_chunk_id=" << start_chunk_id_;
     ss << ", chunk num=" << chunk_num_;
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   PacketBufferPool.h
+//! \brief:  the class for pooled media packet payload buffers
+//! \detail: each track owns one pool. Buffers are handed out by the size of
+//!          the sample read from the segment and returned to the pool when
+//!          the media packet holding them is released.
+//!
+//! Created on Oct 10, 2022, 10:20 AM
+//!
+
+#ifndef PACKETBUFFERPOOL_H_
+#define PACKETBUFFERPOOL_H_
+
+#include "../utils/ns_def.h"
+#include "common.h"
+
+#include <stdlib.h>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace VCD {
+namespace OMAF {
+
+//! granularity of pooled buffer sizes, so close sample sizes share buffers
+#define PACKET_BUFFER_ALIGN_SIZE 4096
+//! upper bound of idle bytes kept by one pool
+#define PACKET_BUFFER_POOL_MAX_BYTES (64 * 1024 * 1024)
+
+class PacketBufferPool : public VCD::NonCopyable {
+ public:
+  using Ptr = std::shared_ptr<PacketBufferPool>;
+
+ public:
+  //!
+  //! \brief  construct
+  //!
+  //! \param  [in] maxIdleBytes
+  //!         the max bytes of idle buffers kept in the pool
+  //!
+  PacketBufferPool(size_t maxIdleBytes = PACKET_BUFFER_POOL_MAX_BYTES) : m_maxIdleBytes(maxIdleBytes){};
+
+  //!
+  //! \brief  de-construct
+  //!
+  virtual ~PacketBufferPool() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &buf : m_idleBufs) {
+      free(buf.second);
+    }
+    m_idleBufs.clear();
+    m_idleBytes = 0;
+  };
+
+  //!
+  //! \brief  Get one buffer which can hold at least size bytes
+  //!
+  //! \param  [in] size
+  //!         the required buffer size
+  //! \param  [out] allocSize
+  //!         the real size of the returned buffer
+  //!
+  //! \return
+  //!         the buffer pointer, nullptr if failed
+  //!
+  char *Acquire(size_t size, size_t &allocSize) {
+    allocSize = AlignSize(size);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_idleBufs.lower_bound(allocSize);
+      // don't hand out a buffer much larger than required, it wastes memory
+      if (it != m_idleBufs.end() && it->first <= (allocSize << 1)) {
+        char *buf = it->second;
+        allocSize = it->first;
+        m_idleBytes -= it->first;
+        m_idleBufs.erase(it);
+        return buf;
+      }
+    }
+    char *buf = (char *)malloc(allocSize);
+    if (nullptr == buf) allocSize = 0;
+    return buf;
+  };
+
+  //!
+  //! \brief  Return one buffer to the pool, the buffer must be allocated by malloc
+  //!
+  //! \param  [in] buf
+  //!         the buffer pointer
+  //! \param  [in] allocSize
+  //!         the allocated size of the buffer
+  //!
+  void Release(char *buf, size_t allocSize) {
+    if (nullptr == buf) return;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (allocSize > 0 && m_idleBytes + allocSize <= m_maxIdleBytes) {
+        m_idleBufs.insert(std::make_pair(allocSize, buf));
+        m_idleBytes += allocSize;
+        return;
+      }
+    }
+    free(buf);
+  };
+
+  //!
+  //! \brief  Record the real size of one sample read into a pooled buffer
+  //!
+  void RecordSampleSize(size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (size > m_maxSampleSize) m_maxSampleSize = size;
+  };
+
+  //!
+  //! \brief  Get the max sample size recorded by the pool, used as size hint
+  //!         when the sample size can't be known before reading, like the
+  //!         extractor track sample which is resolved during reading
+  //!
+  //! \return
+  //!         the max recorded sample size, 0 if no sample is recorded
+  //!
+  size_t GetMaxSampleSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxSampleSize;
+  };
+
+  size_t GetIdleBytes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idleBytes;
+  };
+
+ private:
+  static size_t AlignSize(size_t size) {
+    if (size == 0) size = 1;
+    return (size + PACKET_BUFFER_ALIGN_SIZE - 1) / PACKET_BUFFER_ALIGN_SIZE * PACKET_BUFFER_ALIGN_SIZE;
+  };
+
+ private:
+  std::mutex m_mutex;
+  std::multimap<size_t, char *> m_idleBufs;  //!< idle buffers sorted by allocated size
+  size_t m_idleBytes = 0;                    //!< total bytes of idle buffers
+  size_t m_maxIdleBytes = 0;                 //!< max bytes of idle buffers
+  size_t m_maxSampleSize = 0;                //!< max real sample size ever recorded
+};
+}  // namespace OMAF
+}  // namespace VCD
+
+#endif /* PACKETBUFFERPOOL_H_ */
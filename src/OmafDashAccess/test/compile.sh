@@ -9,9 +9,15 @@ g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testOmafReade
 g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testDownloader.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testDownloaderPerf.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testTracksSelector.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testStreamBlocks.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testStageStatistics.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testSegmentCache.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testMappedFile.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testTilesStitch.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../../isolib -I../../google_test -std=c++11 -I../util/ -g -c testMediaPacket.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 
 LD_FLAGS="-I/usr/local/include/ -lcurl -lstdc++ -lOmafDashAccess -llttng-ust -ldl -lpthread -lglog -l360SCVP -lm -L/usr/local/lib"
-g++ -L/usr/local/lib testDownloaderPerf.o testDownloader.o testMediaSource.o testMPDParser.o testOmafReader.o testOmafReaderManager.o testTracksSelector.o libgtest.a -o testLib ${LD_FLAGS}
+g++ -L/usr/local/lib testDownloaderPerf.o testDownloader.o testMediaSource.o testMPDParser.o testOmafReader.o testOmafReaderManager.o testTracksSelector.o testStreamBlocks.o testStageStatistics.o testSegmentCache.o testMappedFile.o testTilesStitch.o testMediaPacket.o libgtest.a -o testLib ${LD_FLAGS}
 g++ -L/usr/local/lib testMediaSource.o libgtest.a -o testMediaSource ${LD_FLAGS}
 g++ -L/usr/local/lib testMPDParser.o libgtest.a -o testMPDParser ${LD_FLAGS}
 g++ -L/usr/local/lib testOmafReader.o libgtest.a -o testOmafReader ${LD_FLAGS}
@@ -19,6 +25,12 @@ g++ -L/usr/local/lib testOmafReaderManager.o libgtest.a -o testOmafReaderManager
 g++ -L/usr/local/lib testDownloader.o libgtest.a -o testDownloader ${LD_FLAGS}
 g++ -L/usr/local/lib testDownloaderPerf.o libgtest.a -o testDownloaderPerf ${LD_FLAGS}
 g++ -L/usr/local/lib testTracksSelector.o libgtest.a -o testTracksSelector ${LD_FLAGS}
+g++ -L/usr/local/lib testStreamBlocks.o libgtest.a -o testStreamBlocks ${LD_FLAGS}
+g++ -L/usr/local/lib testStageStatistics.o libgtest.a -o testStageStatistics ${LD_FLAGS}
+g++ -L/usr/local/lib testSegmentCache.o libgtest.a -o testSegmentCache ${LD_FLAGS}
+g++ -L/usr/local/lib testMappedFile.o libgtest.a -o testMappedFile ${LD_FLAGS}
+g++ -L/usr/local/lib testTilesStitch.o libgtest.a -o testTilesStitch ${LD_FLAGS}
+g++ -L/usr/local/lib testMediaPacket.o libgtest.a -o testMediaPacket ${LD_FLAGS}
 
 ./run.sh
 if [ $? -ne 0 ]; then exit 1; fi
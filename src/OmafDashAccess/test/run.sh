@@ -12,6 +12,24 @@ if [ $? -ne 0 ]; then exit 1; fi
 ./testOmafReaderManager
 if [ $? -ne 0 ]; then exit 1; fi
 
+./testStreamBlocks
+if [ $? -ne 0 ]; then exit 1; fi
+
+./testStageStatistics
+if [ $? -ne 0 ]; then exit 1; fi
+
+./testSegmentCache
+if [ $? -ne 0 ]; then exit 1; fi
+
+./testMappedFile
+if [ $? -ne 0 ]; then exit 1; fi
+
+./testTilesStitch
+if [ $? -ne 0 ]; then exit 1; fi
+
+./testMediaPacket
+if [ $? -ne 0 ]; then exit 1; fi
+
 ./testDownloaderPerf
 if [ $? -ne 0 ]; then exit 1; fi
 
@@ -27,7 +27,9 @@
 #include "gtest/gtest.h"
 #include <string>
 #include <thread>
+#include <map>
 #include <memory>
+#include <set>
 #include <pwd.h>
 
 #include "../OmafDashDownload/OmafDownloader.h"
@@ -92,6 +94,33 @@ TEST_F(DownloaderTest, Create) {
   EXPECT_TRUE(dash_client != nullptr);
 }
 
+TEST_F(DownloaderTest, cancelStaleTasks) {
+  // the client is not started, so all tasks are kept in the queue
+  std::map<int, OmafDashSegmentClient::State> states;
+  TaskPriority priorities[] = {TaskPriority::HIGH, TaskPriority::NORMAL, TaskPriority::LOW, TaskPriority::LOW};
+  int32_t as_ids[] = {1, 1, 1, 2};
+  for (int i = 0; i < 4; i++) {
+    DashSegmentSourceParams ds;
+    ds.dash_url_ = valid_url + std::to_string(i);
+    ds.timeline_point_ = 1;
+    ds.priority_ = priorities[i];
+    ds.adaptation_set_id_ = as_ids[i];
+    OMAF_STATUS ret = dash_client_->open(
+        ds, nullptr, nullptr, [&states, i](OmafDashSegmentClient::State state) { states[i] = state; });
+    EXPECT_TRUE(ret == ERROR_NONE);
+  }
+
+  std::set<int32_t> stale_ids = {1};
+  OMAF_STATUS ret = dash_client_->cancel(stale_ids, TaskPriority::NORMAL);
+  EXPECT_TRUE(ret == ERROR_NONE);
+
+  // the high priority task and the task of other adaptation set are kept
+  EXPECT_TRUE(states.find(0) == states.end());
+  EXPECT_TRUE(states.find(3) == states.end());
+  EXPECT_TRUE(states[1] == OmafDashSegmentClient::State::STOPPED);
+  EXPECT_TRUE(states[2] == OmafDashSegmentClient::State::STOPPED);
+}
+
 TEST_F(DownloaderTest, downloadSuccess) {
   OMAF_STATUS ret = dash_client_->start();
   EXPECT_TRUE(ret == ERROR_NONE);
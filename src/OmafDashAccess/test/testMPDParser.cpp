@@ -27,6 +27,7 @@
 #include "gtest/gtest.h"
 #include <string>
 #include "../OmafMPDParser.h"
+#include "../OmafAdaptationSet.h"
 
 VCD_USE_VRVIDEO;
 
@@ -158,4 +159,70 @@ TEST_F(MPDParserTest, ParseMPD_cmaf_live)
     delete MPDParser;
 }
 
+TEST_F(MPDParserTest, UpdateMPD_inplace)
+{
+    std::string mpdFile = "./testUpdate.mpd";
+    std::string head = "<?xml version=\"1.0\"?>\n"
+        "<MPD type=\"dynamic\" minimumUpdatePeriod=\"PT2S\" profiles=\"urn:mpeg:dash:profile:isoff-live:2011\">\n"
+        "<Period id=\"0\" start=\"PT0S\">\n"
+        "<AdaptationSet id=\"0\" mimeType=\"audio/mp4\">\n"
+        "<Representation id=\"track0\" audioSamplingRate=\"48000\">\n"
+        "<AudioChannelConfiguration schemeIdUri=\"urn:mpeg:dash:23003:3:audio_channel_configuration:2011\" value=\"2\"/>\n";
+    std::string tail = "</Representation>\n</AdaptationSet>\n</Period>\n</MPD>\n";
+    auto writeMPD = [&](std::string body) {
+        FILE* fp = fopen(mpdFile.c_str(), "w");
+        ASSERT_TRUE(fp != NULL);
+        fputs(body.c_str(), fp);
+        fclose(fp);
+    };
+
+    writeMPD(head + "<SegmentTemplate media=\"track0.$Number$.mp4\" startNumber=\"1\" duration=\"1000\" timescale=\"1000\"/>\n" + tail);
+    OmafXMLParser* parser = new OmafXMLParser();
+    EXPECT_TRUE(parser->Generate(mpdFile, "") == OD_STATUS_SUCCESS);
+    MPDElement* mpd = parser->GetGeneratedMPD();
+    ASSERT_TRUE(mpd != NULL);
+    SegmentElement* segment = mpd->GetPeriods()[0]->GetAdaptationSets()[0]->GetRepresentations()[0]->GetSegment();
+    ASSERT_TRUE(segment != NULL);
+    EXPECT_EQ(1, segment->GetStartNumber());
+    OmafAdaptationSet* as = new OmafAdaptationSet(mpd->GetPeriods()[0]->GetAdaptationSets()[0], PF_ERP, false);
+    EXPECT_EQ(1u, as->GetStartNumber());
+    EXPECT_EQ(1u, as->GetSegmentDuration());
+    // 10 segments of 1s have been processed
+    as->UpdateSegmentNumber(11);
+
+    // unchanged mpd
+    EXPECT_TRUE(parser->Update(mpdFile) == OD_STATUS_SUCCESS);
+    EXPECT_EQ(1, segment->GetStartNumber());
+    EXPECT_EQ(ERROR_NONE, as->UpdateSegmentTemplate());
+    EXPECT_EQ(11, as->GetSegmentNumber());
+
+    // changed segment template is refreshed in the same elements
+    writeMPD(head + "<SegmentTemplate media=\"live0.$Number$.mp4\" startNumber=\"25\" duration=\"2000\" timescale=\"1000\"/>\n" + tail);
+    EXPECT_TRUE(parser->Update(mpdFile) == OD_STATUS_SUCCESS);
+    EXPECT_TRUE(mpd == parser->GetGeneratedMPD());
+    EXPECT_EQ(25, segment->GetStartNumber());
+    EXPECT_EQ(2000, segment->GetDuration());
+    EXPECT_TRUE(segment->GetMedia() == "live0.$Number$.mp4");
+
+    // the adaptation set renumbers the active segment at the same time, 10s
+    // are 5 segments of 2s after the new start number
+    EXPECT_EQ(ERROR_NONE, as->UpdateSegmentTemplate());
+    EXPECT_EQ(25u, as->GetStartNumber());
+    EXPECT_EQ(2u, as->GetSegmentDuration());
+    EXPECT_EQ(2000u, as->GetChunkDuration());
+    EXPECT_EQ(30, as->GetSegmentNumber());
+
+    // changed layout can't be refreshed in place
+    writeMPD(head + "<SegmentTemplate media=\"live0.$Number$.mp4\" startNumber=\"25\" duration=\"2000\" timescale=\"1000\"/>\n"
+        "</Representation>\n<Representation id=\"track1\">\n" + tail);
+    EXPECT_TRUE(parser->Update(mpdFile) == OD_STATUS_INVALID);
+    EXPECT_EQ(25, segment->GetStartNumber());
+    EXPECT_EQ(ERROR_NONE, as->UpdateSegmentTemplate());
+    EXPECT_EQ(30, as->GetSegmentNumber());
+
+    delete as;
+    delete parser;
+    remove(mpdFile.c_str());
+}
+
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../OmafMappedFile.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+class MappedFileTest : public testing::Test {
+ public:
+  virtual void SetUp() {
+    file_name_ = "./mapped_file_test.mp4";
+    for (uint32_t i = 0; i < 100000; i++) {
+      data_.push_back(static_cast<char>((i * 7 + 3) & 0xff));
+    }
+    FILE *fp = fopen(file_name_.c_str(), "wb");
+    ASSERT_TRUE(fp != NULL);
+    fwrite(data_.data(), 1, data_.size(), fp);
+    fclose(fp);
+  }
+
+  virtual void TearDown() {
+    remove(file_name_.c_str());
+    data_.clear();
+  }
+
+  std::string file_name_;
+  std::vector<char> data_;
+};
+
+TEST_F(MappedFileTest, ReadAndSeek) {
+  OmafMappedFile file;
+  ASSERT_EQ(ERROR_NONE, file.Open(file_name_));
+  file.WillNeed();
+  EXPECT_EQ(static_cast<int64_t>(data_.size()), file.GetStreamSize());
+
+  std::vector<char> buf(4096);
+  EXPECT_EQ(4096, file.ReadStream(buf.data(), 4096));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data(), 4096));
+  EXPECT_EQ(4096, file.TellOffset());
+
+  // read to the end
+  EXPECT_TRUE(file.SeekAbsoluteOffset(data_.size() - 100));
+  EXPECT_EQ(100, file.ReadStream(buf.data(), 4096));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data() + data_.size() - 100, 100));
+  EXPECT_EQ(0, file.ReadStream(buf.data(), 4096));
+
+  // the data is exposed in place
+  const char *data = file.GetContiguousData(1000, 50000);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(0, memcmp(data, data_.data() + 1000, 50000));
+  EXPECT_TRUE(file.GetContiguousData(data_.size() - 10, 11) == nullptr);
+
+  file.Close();
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_TRUE(file.GetContiguousData(0, 1) == nullptr);
+}
+
+TEST_F(MappedFileTest, EmptyAndMissingFile) {
+  OmafMappedFile file;
+  EXPECT_NE(ERROR_NONE, file.Open("./not_existed_file.mp4"));
+  EXPECT_FALSE(file.IsOpen());
+
+  FILE *fp = fopen(file_name_.c_str(), "wb");
+  ASSERT_TRUE(fp != NULL);
+  fclose(fp);
+
+  ASSERT_EQ(ERROR_NONE, file.Open(file_name_));
+  EXPECT_EQ(0, file.GetStreamSize());
+  char ch;
+  EXPECT_EQ(0, file.ReadStream(&ch, 1));
+  EXPECT_TRUE(file.GetContiguousData(0, 1) == nullptr);
+}
+
+}  // namespace
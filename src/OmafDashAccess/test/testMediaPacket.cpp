@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <memory>
+#include <vector>
+
+#include "../MediaPacket.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+// resolves the sample chunk by chunk like the extractor sample, when the buffer
+// is too small only the size resolved up to the chunk not fitting is reported
+class ChunkedSampleReader {
+ public:
+  ChunkedSampleReader(size_t chunkNum, size_t chunkSize) {
+    for (size_t i = 0; i < chunkNum * chunkSize; i++) {
+      data_.push_back(static_cast<char>((i * 7 + 3) & 0xff));
+    }
+    chunk_size_ = chunkSize;
+  }
+
+  int32_t operator()(char *buf, uint32_t &size) {
+    reads_++;
+    uint32_t extracted = 0;
+    while (extracted < data_.size()) {
+      if (extracted + chunk_size_ > size) {
+        size = extracted + chunk_size_;
+        return OMAF_MEMORY_TOO_SMALL_BUFFER;
+      }
+      memcpy(buf + extracted, data_.data() + extracted, chunk_size_);
+      extracted += chunk_size_;
+    }
+    size = extracted;
+    return ERROR_NONE;
+  }
+
+  std::vector<char> data_;
+  size_t chunk_size_ = 0;
+  uint32_t reads_ = 0;
+};
+
+TEST(MediaPacketTest, ReadSampleOutgrowingPoolEstimate) {
+  PacketBufferPool::Ptr pool = std::make_shared<PacketBufferPool>();
+  pool->RecordSampleSize(8 * 1024);
+  // the sample is 20 times the largest one recorded, and each retry only
+  // tells the size of one more chunk
+  ChunkedSampleReader reader(40, 4 * 1024);
+  size_t estimate = pool->GetMaxSampleSize() + (pool->GetMaxSampleSize() >> 2);
+
+  MediaPacket *packet = new MediaPacket();
+  uint32_t packetSize = 0;
+  auto read = [&](char *buf, uint32_t &size) { return reader(buf, size); };
+  EXPECT_EQ(ERROR_NONE, packet->ReadFromPool(pool, estimate, 0, read, packetSize));
+  ASSERT_EQ(reader.data_.size(), packetSize);
+  EXPECT_EQ(0, memcmp(reader.data_.data(), packet->Payload(), packetSize));
+  EXPECT_GT(reader.reads_, 2u);
+  EXPECT_LT(reader.reads_, 10u);
+  delete packet;
+}
+
+TEST(MediaPacketTest, ReadSampleFailsWithoutLargerSize) {
+  MediaPacket *packet = new MediaPacket();
+  uint32_t packetSize = 0;
+  uint32_t reads = 0;
+  // a broken reader never asks for more than the given buffer
+  auto read = [&](char *buf, uint32_t &size) {
+    reads++;
+    return OMAF_MEMORY_TOO_SMALL_BUFFER;
+  };
+  EXPECT_EQ(OMAF_MEMORY_TOO_SMALL_BUFFER, packet->ReadFromPool(nullptr, 1024, 0, read, packetSize));
+  EXPECT_EQ(1u, reads);
+  delete packet;
+}
+
+}  // namespace
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../DownloadManager.h"
+#include "../OmafDashDownload/Stream.h"
+#include "../OmafSegment.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+class SegmentCacheTest : public testing::Test {
+ public:
+  virtual void SetUp() {
+    cache_.SetUseCache(true);
+    cache_.SetMaxCacheSize(1000);
+  }
+
+  virtual void TearDown() { cache_.CleanCache(); }
+
+  static SegmentCacheData makeData(size_t size, char value) {
+    std::shared_ptr<SegmentCacheBlocks> data = std::make_shared<SegmentCacheBlocks>();
+    SharedBlockData block;
+    block.data.reset(new char[size], std::default_delete<char[]>());
+    memset(block.data.get(), value, size);
+    block.size = size;
+    data->blocks.push_back(block);
+    data->size = size;
+    return data;
+  }
+
+  DownloadManager cache_;
+};
+
+TEST_F(SegmentCacheTest, evictLeastRecentlyUsed) {
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg1", makeData(400, 1)));
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg2", makeData(400, 2)));
+  EXPECT_EQ(800u, cache_.GetCacheSize());
+
+  // seg1 is used, so seg2 is the least recently used one
+  SegmentCacheData seg1 = cache_.GetSegment("seg1");
+  ASSERT_TRUE(seg1 != nullptr);
+  EXPECT_EQ(1, seg1->blocks[0].data.get()[0]);
+
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg3", makeData(400, 3)));
+  EXPECT_EQ(800u, cache_.GetCacheSize());
+  EXPECT_EQ(2u, cache_.GetCachedCount());
+  EXPECT_TRUE(cache_.GetSegment("seg2") == nullptr);
+  EXPECT_TRUE(cache_.GetSegment("seg1") != nullptr);
+  EXPECT_TRUE(cache_.GetSegment("seg3") != nullptr);
+
+  // the evicted data is still valid for the one who holds it
+  seg1.reset();
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg4", makeData(900, 4)));
+  EXPECT_EQ(900u, cache_.GetCacheSize());
+  EXPECT_EQ(1u, cache_.GetCachedCount());
+}
+
+TEST_F(SegmentCacheTest, replaceAndBudget) {
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg1", makeData(300, 1)));
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg1", makeData(500, 5)));
+  EXPECT_EQ(500u, cache_.GetCacheSize());
+  EXPECT_EQ(5, cache_.GetSegment("seg1")->blocks[0].data.get()[0]);
+
+  // larger than the whole budget
+  EXPECT_NE(ERROR_NONE, cache_.PutSegment("big", makeData(1001, 1)));
+  EXPECT_EQ(500u, cache_.GetCacheSize());
+
+  cache_.SetMaxCacheSize(400);
+  EXPECT_EQ(0u, cache_.GetCacheSize());
+  EXPECT_TRUE(cache_.GetSegment("seg1") == nullptr);
+
+  EXPECT_EQ(ERROR_NONE, cache_.PutSegment("seg2", makeData(100, 2)));
+  EXPECT_EQ(ERROR_NONE, cache_.DeleteSegment("seg2"));
+  EXPECT_EQ(ERROR_NOT_FOUND, cache_.DeleteSegment("seg2"));
+  EXPECT_EQ(0u, cache_.GetCacheSize());
+
+  cache_.SetUseCache(false);
+  EXPECT_NE(ERROR_NONE, cache_.PutSegment("seg3", makeData(100, 3)));
+  EXPECT_TRUE(cache_.GetSegment("seg3") == nullptr);
+}
+
+TEST_F(SegmentCacheTest, shareStreamBlocks) {
+  std::vector<SharedBlockData> shared;
+  std::string expected;
+  {
+    StreamBlocks blocks;
+    for (int i = 0; i < 10; i++) {
+      std::string part(i * 7 + 1, static_cast<char>('a' + i));
+      char *buf = new char[part.size()];
+      memcpy(buf, part.data(), part.size());
+      blocks.push_back(std::unique_ptr<StreamBlock>(new StreamBlock(buf, part.size())));
+      expected += part;
+    }
+
+    ASSERT_TRUE(blocks.shareTo(shared));
+    ASSERT_EQ(10u, shared.size());
+    // the shared data is the block data itself, not a copy
+    EXPECT_EQ(blocks.GetContiguousData(0, 1), shared[0].data.get());
+
+    // popped blocks make the stream incomplete
+    std::vector<SharedBlockData> incomplete;
+    blocks.pop_front();
+    EXPECT_FALSE(blocks.shareTo(incomplete));
+  }
+
+  // the shared data outlives the blocks, and reads back without copy
+  StreamBlocks replay;
+  for (auto &block : shared) {
+    replay.push_back(std::unique_ptr<StreamBlock>(new StreamBlock(block.data, block.size)));
+  }
+  EXPECT_EQ(shared[0].data.get(), replay.GetContiguousData(0, 1));
+  std::vector<char> buffer(expected.size());
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), replay.ReadStream(buffer.data(), expected.size()));
+  EXPECT_EQ(expected, std::string(buffer.begin(), buffer.end()));
+}
+
+TEST(SegmentCacheableTest, cmafAndByteRangeNotCached) {
+  DOWNLOADMANAGER::GetInstance()->SetUseCache(true);
+
+  DashSegmentSourceParams params;
+  params.dash_url_ = "http://localhost/seg_1.mp4";
+  OmafSegment segment(params, 1);
+  EXPECT_TRUE(segment.IsCacheable());
+
+  // CMAF chunks are published before the whole segment is downloaded
+  segment.SetSegmentType(SegmentType_Cmaf);
+  EXPECT_FALSE(segment.IsCacheable());
+
+  params.enable_byte_range_ = true;
+  OmafSegment rangeSegment(params, 2);
+  EXPECT_FALSE(rangeSegment.IsCacheable());
+
+  DOWNLOADMANAGER::GetInstance()->SetUseCache(false);
+  OmafSegment disabledSegment(params, 3);
+  EXPECT_FALSE(disabledSegment.IsCacheable());
+}
+
+}  // namespace
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../OmafStageStatistics.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+TEST(StageStatisticsTest, bucketBounds) {
+  // every value falls into the bucket whose upper bound is not less than it,
+  // and the bucket width keeps the relative error within 1/32
+  for (uint64_t v = 0; v < (1ULL << 20); v += (v < 4096 ? 1 : 97)) {
+    uint32_t idx = LatencyHistogram::bucketIndex(v);
+    ASSERT_LT(idx, static_cast<uint32_t>(LATENCY_HISTOGRAM_BUCKETS));
+    uint64_t upper = LatencyHistogram::bucketUpperBound(idx);
+    ASSERT_GE(upper, v);
+    ASSERT_LE(upper - v, v / 32);
+    if (idx > 0) {
+      ASSERT_LT(LatencyHistogram::bucketUpperBound(idx - 1), v);
+    }
+  }
+  EXPECT_EQ(static_cast<uint32_t>(LATENCY_HISTOGRAM_BUCKETS - 1),
+            LatencyHistogram::bucketIndex(LATENCY_HISTOGRAM_MAX_VALUE + 1000));
+}
+
+TEST(StageStatisticsTest, percentiles) {
+  LatencyHistogram histogram;
+  LatencyInfo info;
+  histogram.snapshot(&info);
+  EXPECT_EQ(0u, info.count);
+  EXPECT_EQ(0u, info.p99_us);
+
+  for (uint64_t v = 1; v <= 10000; v++) {
+    histogram.record(v);
+  }
+  histogram.snapshot(&info);
+  EXPECT_EQ(10000u, info.count);
+  EXPECT_EQ(1u, info.min_us);
+  EXPECT_EQ(10000u, info.max_us);
+  EXPECT_EQ(5000u, info.mean_us);
+  EXPECT_NEAR(5000.0, static_cast<double>(info.p50_us), 5000.0 / 32);
+  EXPECT_NEAR(9000.0, static_cast<double>(info.p90_us), 9000.0 / 32);
+  EXPECT_NEAR(9900.0, static_cast<double>(info.p99_us), 9900.0 / 32);
+  EXPECT_LE(info.p99_us, info.max_us);
+
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.count());
+}
+
+TEST(StageStatisticsTest, concurrentRecord) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&histogram, t]() {
+      for (uint64_t v = 0; v < 100000; v++) {
+        histogram.record(v % 1000 + t);
+      }
+    });
+  }
+  for (auto &th : threads) th.join();
+
+  LatencyInfo info;
+  histogram.snapshot(&info);
+  EXPECT_EQ(400000u, info.count);
+  EXPECT_EQ(0u, info.min_us);
+  EXPECT_EQ(1002u, info.max_us);
+}
+
+TEST(StageStatisticsTest, stagesToJson) {
+  OmafStageStatistics stats;
+  stats.record(LatencyStage_Download, LatencyTrack_Video, std::chrono::milliseconds(20));
+  stats.record(LatencyStage_Parse, OmafStageStatistics::trackType(MediaType_Audio, false), std::chrono::microseconds(40));
+
+  DashStageStatisticInfo info;
+  stats.statistic(&info);
+  EXPECT_EQ(1u, info.latency[LatencyStage_Download][LatencyTrack_Video].count);
+  EXPECT_EQ(20000u, info.latency[LatencyStage_Download][LatencyTrack_Video].max_us);
+  EXPECT_EQ(1u, info.latency[LatencyStage_Parse][LatencyTrack_Audio].count);
+  EXPECT_EQ(0u, info.latency[LatencyStage_Stitch][LatencyTrack_Video].count);
+
+  std::string json = stats.to_json();
+  EXPECT_EQ(0u, json.find("{\"download\":{\"video\":{\"count\":1,\"min_us\":20000,\"max_us\":20000"));
+  EXPECT_NE(std::string::npos, json.find("\"get_packet\":{\"video\":{\"count\":0"));
+  EXPECT_NE(std::string::npos, json.find("\"parse\":{\"video\":{\"count\":0"));
+  EXPECT_EQ('}', json.back());
+}
+
+}  // namespace
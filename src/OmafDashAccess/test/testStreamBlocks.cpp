@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2019, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <memory>
+#include <vector>
+
+#include "../OmafDashDownload/Stream.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+class StreamBlocksTest : public testing::Test {
+ public:
+  virtual void SetUp() {
+    // data with small blocks of varied sizes, like the ones from curl write callbacks
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < 20000; i++) {
+      seed = seed * 1103515245 + 12345;
+      block_sizes_.push_back((seed >> 16) % 1024 + 1);
+    }
+    for (auto size : block_sizes_) {
+      for (int64_t i = 0; i < size; i++) {
+        data_.push_back(static_cast<char>((data_.size() * 7 + 3) & 0xff));
+      }
+    }
+  }
+
+  virtual void TearDown() {
+    block_sizes_.clear();
+    data_.clear();
+  }
+
+  std::unique_ptr<StreamBlock> CreateBlock(int64_t offset, int64_t size) {
+    std::unique_ptr<StreamBlock> sb = make_unique_vcd<StreamBlock>();
+    sb->resize(size);
+    sb->size(size);
+    memcpy(sb->buf(), data_.data() + offset, size);
+    return sb;
+  }
+
+  std::vector<int64_t> block_sizes_;
+  std::vector<char> data_;
+};
+
+TEST_F(StreamBlocksTest, ReadFromOffset) {
+  StreamBlocks sbs;
+  int64_t offset = 0;
+  for (auto size : block_sizes_) {
+    sbs.push_back(CreateBlock(offset, size));
+    offset += size;
+  }
+  EXPECT_EQ(static_cast<int64_t>(data_.size()), sbs.GetStreamSize());
+  EXPECT_EQ(block_sizes_.size(), sbs.GetStreamBlockSize());
+
+  std::vector<char> buf(4096);
+  uint32_t seed = 7;
+  for (uint32_t i = 0; i < 10000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int64_t size = (seed >> 16) % buf.size() + 1;
+    int64_t pos = (seed >> 8) % (data_.size() - size);
+    ASSERT_EQ(size, sbs.ReadStreamFromOffset(buf.data(), pos, size));
+    ASSERT_EQ(0, memcmp(buf.data(), data_.data() + pos, size));
+  }
+
+  // not enough data
+  EXPECT_EQ(0, sbs.ReadStreamFromOffset(buf.data(), data_.size() - 10, 11));
+
+  // sequential read after seek
+  EXPECT_TRUE(sbs.SeekAbsoluteOffset(1000));
+  EXPECT_EQ(100, sbs.ReadStream(buf.data(), 100));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data() + 1000, 100));
+  EXPECT_EQ(1100, sbs.TellOffset());
+
+  // read to the end
+  EXPECT_TRUE(sbs.SeekAbsoluteOffset(data_.size() - 50));
+  EXPECT_EQ(50, sbs.ReadStream(buf.data(), 100));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data() + data_.size() - 50, 50));
+
+  sbs.clear();
+  EXPECT_EQ(0, sbs.GetStreamSize());
+  EXPECT_EQ(0u, sbs.GetStreamBlockSize());
+}
+
+TEST_F(StreamBlocksTest, ContiguousData) {
+  StreamBlocks sbs;
+  int64_t offset = 0;
+  for (size_t i = 0; i < 10; i++) {
+    sbs.push_back(CreateBlock(offset, block_sizes_[i]));
+    offset += block_sizes_[i];
+  }
+
+  // data inside one block is exposed in place
+  const char *data = sbs.GetContiguousData(0, block_sizes_[0]);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(0, memcmp(data, data_.data(), block_sizes_[0]));
+
+  int64_t pos = block_sizes_[0] + block_sizes_[1] / 2;
+  int64_t size = block_sizes_[0] + block_sizes_[1] - pos;
+  data = sbs.GetContiguousData(pos, size);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(0, memcmp(data, data_.data() + pos, size));
+
+  // data across blocks or out of the stream is not
+  EXPECT_TRUE(sbs.GetContiguousData(pos, size + 1) == nullptr);
+  EXPECT_TRUE(sbs.GetContiguousData(offset, 1) == nullptr);
+  EXPECT_TRUE(sbs.GetContiguousData(-1, 1) == nullptr);
+
+  // offset is relative to the remaining blocks after pop
+  std::unique_ptr<StreamBlock> sb = sbs.pop_front();
+  data = sbs.GetContiguousData(0, block_sizes_[1]);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(0, memcmp(data, data_.data() + block_sizes_[0], block_sizes_[1]));
+}
+
+TEST_F(StreamBlocksTest, PopFront) {
+  StreamBlocks sbs;
+  int64_t offset = 0;
+  for (size_t i = 0; i < 10; i++) {
+    sbs.push_back(CreateBlock(offset, block_sizes_[i]));
+    offset += block_sizes_[i];
+  }
+
+  std::unique_ptr<StreamBlock> sb = sbs.pop_front();
+  ASSERT_TRUE(sb != nullptr);
+  EXPECT_EQ(block_sizes_[0], sb->size());
+  EXPECT_EQ(0, memcmp(sb->cbuf(), data_.data(), sb->size()));
+  EXPECT_EQ(offset - block_sizes_[0], sbs.GetStreamSize());
+  EXPECT_EQ(9u, sbs.GetStreamBlockSize());
+
+  // offset is relative to the remaining blocks
+  std::vector<char> buf(64);
+  EXPECT_EQ(64, sbs.ReadStreamFromOffset(buf.data(), 0, 64));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data() + block_sizes_[0], 64));
+
+  for (size_t i = 1; i < 10; i++) {
+    sb = sbs.pop_front();
+    ASSERT_TRUE(sb != nullptr);
+    EXPECT_EQ(block_sizes_[i], sb->size());
+  }
+  EXPECT_TRUE(sbs.pop_front() == nullptr);
+  EXPECT_EQ(0, sbs.GetStreamSize());
+}
+
+TEST_F(StreamBlocksTest, DropFront) {
+  StreamBlocks sbs;
+  int64_t offset = 0;
+  for (size_t i = 0; i < 10; i++) {
+    sbs.push_back(CreateBlock(offset, block_sizes_[i]));
+    offset += block_sizes_[i];
+  }
+
+  // the block which is partly in the range is kept
+  EXPECT_EQ(0, sbs.drop_front(block_sizes_[0] - 1));
+  EXPECT_EQ(10u, sbs.GetStreamBlockSize());
+
+  int64_t dropped = block_sizes_[0] + block_sizes_[1];
+  EXPECT_EQ(dropped, sbs.drop_front(dropped + block_sizes_[2] / 2));
+  EXPECT_EQ(8u, sbs.GetStreamBlockSize());
+  EXPECT_EQ(offset - dropped, sbs.GetStreamSize());
+
+  // offset is relative to the remaining blocks
+  std::vector<char> buf(64);
+  EXPECT_EQ(64, sbs.ReadStreamFromOffset(buf.data(), 0, 64));
+  EXPECT_EQ(0, memcmp(buf.data(), data_.data() + dropped, 64));
+
+  EXPECT_EQ(offset - dropped, sbs.drop_front(offset));
+  EXPECT_EQ(0u, sbs.GetStreamBlockSize());
+  EXPECT_EQ(0, sbs.drop_front(1));
+}
+
+TEST_F(StreamBlocksTest, ConcurrentWriteAndRead) {
+  StreamBlocks sbs;
+
+  std::thread producer([this, &sbs]() {
+    int64_t offset = 0;
+    for (auto size : block_sizes_) {
+      sbs.push_back(CreateBlock(offset, size));
+      offset += size;
+    }
+  });
+
+  // read the stream while it grows, like the parser does during downloading
+  std::vector<char> buf(2048);
+  int64_t pos = 0;
+  int64_t total = static_cast<int64_t>(data_.size());
+  while (pos < total) {
+    int64_t size = std::min(static_cast<int64_t>(buf.size()), total - pos);
+    if (sbs.GetStreamSize() < pos + size) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(size, sbs.ReadStreamFromOffset(buf.data(), pos, size));
+    ASSERT_EQ(0, memcmp(buf.data(), data_.data() + pos, size));
+    pos += size;
+  }
+
+  producer.join();
+  EXPECT_EQ(total, sbs.GetStreamSize());
+}
+
+TEST_F(StreamBlocksTest, GrowBeyondInitialPages) {
+  StreamBlocks sbs;
+  // more tiny blocks than the initial page table holds, while being read
+  const int64_t blocksNum = STREAM_BLOCKS_INIT_PAGES * STREAM_BLOCKS_PAGE_SIZE * 2 + 100;
+  std::vector<char> data;
+  for (int64_t i = 0; i < blocksNum; i++) {
+    data.push_back(static_cast<char>((i * 13 + 5) & 0xff));
+  }
+
+  std::thread producer([&data, &sbs]() {
+    for (size_t i = 0; i < data.size(); i++) {
+      std::unique_ptr<StreamBlock> sb = make_unique_vcd<StreamBlock>();
+      sb->resize(1);
+      sb->size(1);
+      sb->buf()[0] = data[i];
+      sbs.push_back(std::move(sb));
+    }
+  });
+
+  std::vector<char> buf(4096);
+  int64_t pos = 0;
+  int64_t total = static_cast<int64_t>(data.size());
+  while (pos < total) {
+    int64_t size = std::min(static_cast<int64_t>(buf.size()), total - pos);
+    if (sbs.GetStreamSize() < pos + size) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(size, sbs.ReadStreamFromOffset(buf.data(), pos, size));
+    ASSERT_EQ(0, memcmp(buf.data(), data.data() + pos, size));
+    pos += size;
+  }
+
+  producer.join();
+  // no block is dropped
+  EXPECT_EQ(total, sbs.GetStreamSize());
+  EXPECT_EQ(static_cast<uint32_t>(blocksNum), sbs.GetStreamBlockSize());
+  EXPECT_EQ(total, sbs.drop_front(total));
+}
+
+}  // namespace
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string.h>
+#include <vector>
+
+#include "../OmafTilesStitch.h"
+
+using namespace VCD::OMAF;
+
+namespace {
+
+// the first frame of one tiled HEVC stream, one slice per tile
+typedef struct TiledFrame {
+  std::vector<uint8_t> headers;
+  uint32_t vpsLen;
+  uint32_t spsLen;
+  uint32_t ppsLen;
+  std::vector<std::vector<uint8_t>> slices;
+} TiledFrame;
+
+static bool ReadFirstFrame(const char *fileName, TiledFrame *frame) {
+  std::ifstream input(fileName, std::ios::binary);
+  if (!input.good()) return false;
+  std::vector<uint8_t> stream((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+  std::vector<size_t> starts;
+  for (size_t i = 0; i + 4 < stream.size(); i++) {
+    if (!stream[i] && !stream[i + 1] && !stream[i + 2] && stream[i + 3] == 1) starts.push_back(i);
+  }
+  starts.push_back(stream.size());
+
+  frame->vpsLen = frame->spsLen = frame->ppsLen = 0;
+  for (size_t i = 0; i + 1 < starts.size(); i++) {
+    const uint8_t *nal = stream.data() + starts[i];
+    uint32_t nalLen = starts[i + 1] - starts[i];
+    uint8_t nalType = (nal[4] >> 1) & 0x3f;
+    bool firstSlice = (nal[6] & 0x80) != 0;
+    if (nalType < 32) {
+      if (firstSlice && !frame->slices.empty()) break;
+      frame->slices.push_back(std::vector<uint8_t>(nal, nal + nalLen));
+    } else if (nalType >= 32 && nalType <= 34) {
+      frame->headers.insert(frame->headers.end(), nal, nal + nalLen);
+      if (nalType == 32) frame->vpsLen = nalLen;
+      if (nalType == 33) frame->spsLen = nalLen;
+      if (nalType == 34) frame->ppsLen = nalLen;
+    }
+  }
+  return frame->vpsLen && frame->spsLen && frame->ppsLen && !frame->slices.empty();
+}
+
+class TilesStitchTest : public testing::Test {
+ public:
+  virtual void SetUp() {
+    ASSERT_TRUE(ReadFirstFrame("../../360SCVP/test/test.265", &highFrame));
+    ASSERT_TRUE(ReadFirstFrame("../../360SCVP/test/test_low.265", &lowFrame));
+    // 3840x2048 in 10x8 tiles and 1280x768 in 5x3 tiles
+    ASSERT_EQ(80u, highFrame.slices.size());
+    ASSERT_EQ(15u, lowFrame.slices.size());
+
+    SourceInfo high = { HIGHEST_QUALITY_RANKING, 3840, 2048 };
+    SourceInfo low = { SECOND_QUALITY_RANKING, 1280, 768 };
+    sources[HIGHEST_QUALITY_RANKING] = high;
+    sources[SECOND_QUALITY_RANKING] = low;
+  }
+
+  MediaPacket *CreateTilePacket(TiledFrame &frame, QualityRank qualityRanking, uint32_t tileIdx,
+                                uint32_t tileCols, int32_t tileWidth, int32_t tileHeight) {
+    std::vector<uint8_t> data(frame.headers);
+    data.insert(data.end(), frame.slices[tileIdx].begin(), frame.slices[tileIdx].end());
+    MediaPacket *packet = new MediaPacket((char *)data.data(), data.size());
+    packet->SetRealSize(data.size());
+    packet->SetCodecType(VideoCodec_HEVC);
+    packet->SetQualityRanking(qualityRanking);
+    packet->SetVideoHeaderSize(frame.headers.size());
+    packet->SetVPSLen(frame.vpsLen);
+    packet->SetSPSLen(frame.spsLen);
+    packet->SetPPSLen(frame.ppsLen);
+    SRDInfo srd;
+    srd.left = (tileIdx % tileCols) * tileWidth;
+    srd.top = (tileIdx / tileCols) * tileHeight;
+    srd.width = tileWidth;
+    srd.height = tileHeight;
+    packet->SetSRDInfo(srd);
+    return packet;
+  }
+
+  //! 12 high resolution tiles and all low resolution tiles, each quality
+  //! ranking is split into several merged packets
+  std::map<uint32_t, MediaPacket *> CreateSelectedPackets() {
+    std::map<uint32_t, MediaPacket *> packets;
+    const uint32_t highTiles[12] = { 3, 4, 5, 6, 13, 14, 15, 16, 23, 24, 25, 26 };
+    for (uint32_t i = 0; i < 12; i++) {
+      packets[highTiles[i] + 1] = CreateTilePacket(highFrame, HIGHEST_QUALITY_RANKING, highTiles[i], 10, 384, 256);
+    }
+    for (uint32_t i = 0; i < lowFrame.slices.size(); i++) {
+      packets[1000 + i] = CreateTilePacket(lowFrame, SECOND_QUALITY_RANKING, i, 5, 256, 256);
+    }
+    return packets;
+  }
+
+  std::list<MediaPacket *> Stitch(uint32_t threadNum, bool spanOutput = false) {
+    OmafTilesStitch stitch;
+    stitch.SetMaxStitchResolution(768, 512);
+    stitch.SetStitchThreadNum(threadNum);
+    stitch.SetSpanOutput(spanOutput);
+    std::map<uint32_t, MediaPacket *> packets = CreateSelectedPackets();
+    EXPECT_EQ(ERROR_NONE, stitch.Initialize(packets, true, VCD::OMAF::PF_ERP, sources));
+    return stitch.GetTilesMergedPackets();
+  }
+
+  TiledFrame highFrame;
+  TiledFrame lowFrame;
+  std::map<uint32_t, SourceInfo> sources;
+};
+
+TEST_F(TilesStitchTest, ParallelStitchMatchesSerial) {
+  std::list<MediaPacket *> serial = Stitch(0);
+  std::list<MediaPacket *> parallel = Stitch(2);
+
+  // 3 merged packets for each quality ranking
+  ASSERT_EQ(6u, serial.size());
+  ASSERT_EQ(serial.size(), parallel.size());
+  std::list<MediaPacket *>::iterator itSerial = serial.begin();
+  std::list<MediaPacket *>::iterator itParallel = parallel.begin();
+  uint32_t highNum = 0;
+  for (; itSerial != serial.end(); itSerial++, itParallel++) {
+    MediaPacket *one = *itSerial;
+    MediaPacket *other = *itParallel;
+    if (one->GetQualityRanking() == HIGHEST_QUALITY_RANKING) highNum++;
+    EXPECT_EQ(one->GetQualityRanking(), other->GetQualityRanking());
+    EXPECT_EQ(one->GetVideoWidth(), other->GetVideoWidth());
+    EXPECT_EQ(one->GetVideoHeight(), other->GetVideoHeight());
+    ASSERT_EQ(one->GetRealSize(), other->GetRealSize());
+    EXPECT_EQ(0, memcmp(one->Payload(), other->Payload(), one->GetRealSize()));
+  }
+  EXPECT_EQ(3u, highNum);
+
+  for (auto packet : serial) delete packet;
+  for (auto packet : parallel) delete packet;
+}
+
+TEST_F(TilesStitchTest, SpanOutputMatchesCopy) {
+  std::list<MediaPacket *> copied = Stitch(0);
+  // the stitch class is gone, the spans keep the tile packets alive
+  std::list<MediaPacket *> spanned = Stitch(2, true);
+
+  ASSERT_EQ(6u, copied.size());
+  ASSERT_EQ(copied.size(), spanned.size());
+  std::list<MediaPacket *>::iterator itCopied = copied.begin();
+  std::list<MediaPacket *>::iterator itSpanned = spanned.begin();
+  for (; itCopied != copied.end(); itCopied++, itSpanned++) {
+    MediaPacket *one = *itCopied;
+    MediaPacket *other = *itSpanned;
+    EXPECT_TRUE(one->GetSpans().empty());
+    std::vector<Output_Span> spans = other->GetSpans();
+    // the merged headers and each rewritten slice header are in the payload,
+    // each slice data span points into one tile packet
+    ASSERT_GT(spans.size(), 1u);
+    ASSERT_EQ(one->GetRealSize(), other->GetRealSize());
+
+    std::vector<uint8_t> assembled(other->GetRealSize());
+    uint32_t assembledLen = 0;
+    ASSERT_EQ(0, I360SCVP_AssembleSpans(spans.data(), spans.size(), assembled.data(), assembled.size(), &assembledLen));
+    ASSERT_EQ(one->GetRealSize(), assembledLen);
+    EXPECT_EQ(0, memcmp(one->Payload(), assembled.data(), assembledLen));
+  }
+
+  for (auto packet : copied) delete packet;
+  for (auto packet : spanned) delete packet;
+}
+
+}  // namespace
@@ -33,11 +33,77 @@
 
 #include <algorithm>
 #include <sstream>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
 
 #include "DashSegmenter.h"
 
 VCD_NS_BEGIN
 
+SegmentFileSink::~SegmentFileSink()
+{
+    EndSegment();
+}
+
+bool SegmentFileSink::BeginSegment(const char *segName)
+{
+    EndSegment();
+
+    m_fd = open(segName, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (m_fd < 0)
+    {
+        OMAF_LOG(LOG_ERROR, "Failed to open segment file %s !\n", segName);
+        return false;
+    }
+    return true;
+}
+
+bool SegmentFileSink::Write(const struct iovec *spans, int32_t spansNum)
+{
+    if (m_fd < 0 || (spansNum && !spans))
+        return false;
+
+    std::vector<struct iovec> vec(spans, spans + spansNum);
+    struct iovec *curr = vec.data();
+    int32_t remained = spansNum;
+    while (remained > 0)
+    {
+        ssize_t written = writev(m_fd, curr, std::min(remained, (int32_t)IOV_MAX));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            OMAF_LOG(LOG_ERROR, "Failed to write segment file, errno %d !\n", errno);
+            return false;
+        }
+        // skip the spans which have been written, and adjust the partially written one
+        while (remained > 0 && (size_t)written >= curr->iov_len)
+        {
+            written -= curr->iov_len;
+            curr++;
+            remained--;
+        }
+        if (remained > 0 && written > 0)
+        {
+            curr->iov_base = (uint8_t*)(curr->iov_base) + written;
+            curr->iov_len -= written;
+        }
+    }
+    return true;
+}
+
+bool SegmentFileSink::EndSegment()
+{
+    if (m_fd < 0)
+        return true;
+
+    int32_t ret = close(m_fd);
+    m_fd = -1;
+    return (ret == 0);
+}
+
 DashSegmenter::DashSegmenter(GeneralSegConfig *dashConfig, bool createWriter)
     : m_config(*dashConfig)
 {
@@ -160,24 +226,12 @@ int32_t DashSegmenter::WriteSegment(char *baseName)
 {
     if (!m_config.cmafEnabled)
     {
-        std::ostringstream frameStream;
-
-        m_segWriter->WriteSegments(frameStream, &(m_segNum), m_segName, baseName, NULL);
+        uint64_t segSize = 0;
+        if (!m_segWriter->WriteSegments(&m_fileSink, &(m_segNum), m_segName, baseName, &segSize))
+            return OMAF_ERROR_FILE_WRITE;
 
-        std::string frameString(frameStream.str());
-
-        if (frameString.size())
-        {
-            m_file = fopen(m_segName, "wb+");
-            if (!m_file)
-                return OMAF_ERROR_NULL_PTR;
-
-            m_segSize = frameString.size();
-            fwrite(frameString.c_str(), 1, frameString.size(), m_file);
-
-            fclose(m_file);
-            m_file = NULL;
-        }
+        if (segSize)
+            m_segSize = segSize;
     }
     else
     {
@@ -39,6 +39,7 @@
 #include <fstream>
 #include <map>
 #include <set>
+#include <sstream>
 #include <dlfcn.h>
 
 #include "MediaData.h"
@@ -317,6 +318,44 @@ private:
     //    VCD::MP4::TrackMeta& aTrackMeta);
 };
 
+//!
+//! \class SegmentFileSink
+//! \brief Define the output of segment writer, which writes each segment
+//!        to its own file with gathered writes, without intermediate copy
+//!
+
+class SegmentFileSink : public VCD::MP4::SegmentSink
+{
+public:
+    //!
+    //! \brief  Constructor
+    //!
+    SegmentFileSink() {};
+
+    //!
+    //! \brief  Destructor
+    //!
+    ~SegmentFileSink();
+
+    //!
+    //! \brief  Create the segment file and truncate it
+    //!
+    bool BeginSegment(const char *segName) override;
+
+    //!
+    //! \brief  Write the data spans to the segment file by writev
+    //!
+    bool Write(const struct iovec *spans, int32_t spansNum) override;
+
+    //!
+    //! \brief  Close the segment file
+    //!
+    bool EndSegment() override;
+
+private:
+    int32_t     m_fd = -1;          //!< file descriptor of current segment file
+};
+
 //!
 //! \class DashSegmenter
 //! \brief Define the operation of generating data segments for one track
@@ -470,7 +509,7 @@ private:
     uint64_t                                                          m_segNum = 0;            //!< current segments number
     uint64_t                                                          m_subSegNum = 0;
     std::ostringstream                                                m_frameStream;
-    FILE                                                              *m_file = NULL;          //!< file pointer to write segments
+    SegmentFileSink                                                   m_fileSink;              //!< sink to write segments to files
     char                                                              m_segName[1024];           //!< segment file name string
     uint64_t                                                          m_segSize = 0;
     uint64_t                                                          m_prevSegSize = 0;
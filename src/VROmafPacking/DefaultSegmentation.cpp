@@ -145,20 +145,7 @@ DefaultSegmentation::~DefaultSegmentation()
     }
     m_extractorASCtx.clear();
 
-    if (m_extractorThreadIds.size())
-    {
-        std::map<pthread_t, ExtractorTrack*>::iterator itThreadId;
-        for (itThreadId = m_extractorThreadIds.begin(); itThreadId != m_extractorThreadIds.end(); )
-        {
-            pthread_t oneThread = itThreadId->first;
-            if (oneThread)
-            {
-                pthread_join(oneThread, NULL);
-            }
-            m_extractorThreadIds.erase(itThreadId++);
-        }
-        m_extractorThreadIds.clear();
-    }
+    DELETE_MEMORY(m_segTaskPool);
 
     DELETE_ARRAY(m_videosBitrate);
 
@@ -1134,11 +1121,16 @@ int32_t DefaultSegmentation::WriteSegmentForEachVideo(MediaStream *stream, bool
         //trackSegCtxs[tileIdx].codedMeta.presTime.m_den = 1000;
         //cout << "presTime  " << trackSegCtxs[tileIdx].codedMeta.presTime.m_num << endl;
 
-        m_segNum = dashSegmenter->GetSegmentsNum();
+        uint64_t segNum = dashSegmenter->GetSegmentsNum();
+        {
+            // video streams may be segmented in parallel
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_segNum = segNum;
+        }
 
 #ifdef _USE_TRACE_
         //trace
-        if (m_segNum == (m_prevSegNum + 1))
+        if (segNum == (m_prevSegNum + 1))
         {
             uint64_t segSize = dashSegmenter->GetSegmentSize();
             uint32_t trackIndex = trackSegCtxs[tileIdx].trackIdx.GetIndex();
@@ -1146,7 +1138,7 @@ int32_t DefaultSegmentation::WriteSegmentForEachVideo(MediaStream *stream, bool
             char tileRes[128] = { 0 };
             snprintf(tileRes, 128, "%d x %d", (trackSegCtxs[tileIdx].tileInfo)->tileWidth, (trackSegCtxs[tileIdx].tileInfo)->tileHeight);
 
-            tracepoint(bandwidth_tp_provider, packed_segment_size, trackIndex, trackType, tileRes, m_segNum, segSize);
+            tracepoint(bandwidth_tp_provider, packed_segment_size, trackIndex, trackType, tileRes, segNum, segSize);
         }
 #endif
     }
@@ -1266,239 +1258,168 @@ int32_t DefaultSegmentation::WriteSegmentForEachExtractorTrack(
     return ERROR_NONE;
 }
 
-int32_t DefaultSegmentation::StartExtractorTrackSegmentation(
-    ExtractorTrack *extractorTrack)
+int32_t DefaultSegmentation::SegmentVideoFrame(
+    VideoStream *vs,
+    bool *isKeyFrame,
+    bool *isEOS)
 {
-    pthread_t threadId;
-    int32_t ret = pthread_create(&threadId, NULL, ExtractorTrackSegThread, this);
-
-    if (ret)
-    {
-        OMAF_LOG(LOG_ERROR, "Failed to create extractor track segmentation thread !\n");
-        return OMAF_ERROR_CREATE_THREAD;
-    }
+    if (!vs || !isKeyFrame || !isEOS)
+        return OMAF_ERROR_NULL_PTR;
 
-    m_extractorThreadIds.insert(std::make_pair(threadId, extractorTrack));
-    return ERROR_NONE;
-}
+    vs->SetCurrFrameInfo();
+    FrameBSInfo *currFrame = vs->GetCurrFrameInfo();
 
-int32_t DefaultSegmentation::StartLastExtractorTrackSegmentation(
-    ExtractorTrack *extractorTrack)
-{
-    pthread_t threadId;
-    int32_t ret = pthread_create(&threadId, NULL, LastExtractorTrackSegThread, this);
-
-    if (ret)
+    while (!currFrame)
     {
-        OMAF_LOG(LOG_ERROR, "Failed to create extractor track segmentation thread !\n");
-        return OMAF_ERROR_CREATE_THREAD;
+        usleep(50);
+        vs->SetCurrFrameInfo();
+        currFrame = vs->GetCurrFrameInfo();
+        if (!currFrame && (vs->GetEOS()))
+            break;
     }
 
-    m_extractorThreadIds.insert(std::make_pair(threadId, extractorTrack));
-    return ERROR_NONE;
-}
-
-void *DefaultSegmentation::ExtractorTrackSegThread(void *pThis)
-{
-    DefaultSegmentation *defaultSegmentation = (DefaultSegmentation*)pThis;
+    // the frame has left the queue of the stream
+    NotifyProgress();
 
-    defaultSegmentation->ExtractorTrackSegmentation();
+    if (currFrame)
+    {
+        *isKeyFrame = currFrame->isKeyFrame;
+        *isEOS = false;
 
-    return NULL;
-}
+#ifdef _USE_TRACE_
+        //trace
+        char resolution[1024] = { 0 };
+        snprintf(resolution, 1024, "%d x %d", vs->GetSrcWidth(), vs->GetSrcHeight());
+        char tileSplit[1024] = { 0 };
+        snprintf(tileSplit, 1024, "%d x %d", vs->GetTileInCol(), vs->GetTileInRow());
+        tracepoint(bandwidth_tp_provider, encoded_frame_size,
+                    &resolution[0], &tileSplit[0], m_framesNum, currFrame->dataSize);
+#endif
 
-void *DefaultSegmentation::LastExtractorTrackSegThread(void *pThis)
-{
-    DefaultSegmentation *defaultSegmentation = (DefaultSegmentation*)pThis;
+        vs->UpdateTilesNalu();
+        int32_t ret = WriteSegmentForEachVideo(vs, currFrame->isKeyFrame, false);
+        if (ret)
+            return ret;
+    }
+    else
+    {
+        *isKeyFrame = false;
+        *isEOS = true;
 
-    defaultSegmentation->LastExtractorTrackSegmentation();
+        int32_t ret = WriteSegmentForEachVideo(vs, false, true);
+        if (ret)
+            return ret;
+    }
 
-    return NULL;
+    return ERROR_NONE;
 }
 
-int32_t DefaultSegmentation::ExtractorTrackSegmentation()
+int32_t DefaultSegmentation::SegmentAllVideoFrames()
 {
-    bool isFrameReady = false;
-    ExtractorTrack *extractorTrack = NULL;
-    pthread_t threadId = pthread_self();
-    if (threadId == 0)
+    std::vector<VideoStream*> videoStreams;
+    std::map<uint8_t, MediaStream*>::iterator itStream;
+    for (itStream = m_streamMap->begin(); itStream != m_streamMap->end(); itStream++)
     {
-        OMAF_LOG(LOG_ERROR, "NULL thread id for extractor track segmentation !\n");
-        return OMAF_ERROR_INVALID_THREAD;
+        MediaStream *stream = itStream->second;
+        if (stream && (stream->GetMediaType() == VIDEOTYPE))
+        {
+            videoStreams.push_back((VideoStream*)stream);
+        }
     }
 
-    while(1)
+    // each task writes its own status, so that there is no race
+    // on m_framesIsKey and m_streamsIsEOS
+    std::vector<std::pair<bool, bool>> framesStatus(videoStreams.size(), std::make_pair(false, false));
+    int32_t ret = ERROR_NONE;
+    if (m_segTaskPool && (videoStreams.size() > 1))
     {
-        std::map<pthread_t, ExtractorTrack*>::iterator itETThread;
-        itETThread = m_extractorThreadIds.find(threadId);
-        if (itETThread != m_extractorThreadIds.end())
+        std::vector<TaskPool::Task> tasks;
+        tasks.reserve(videoStreams.size());
+        for (uint32_t vsIdx = 0; vsIdx < videoStreams.size(); vsIdx++)
         {
-            extractorTrack = itETThread->second;
-            break;
+            VideoStream *vs = videoStreams[vsIdx];
+            std::pair<bool, bool> *status = &(framesStatus[vsIdx]);
+            tasks.push_back([this, vs, status]() { return SegmentVideoFrame(vs, &(status->first), &(status->second)); });
         }
-        usleep(50);
+        ret = m_segTaskPool->RunAll(tasks);
     }
-
-    while(1)
+    else
     {
-
-        std::map<uint16_t, ExtractorTrack*> *extractorTracks = m_extractorTrackMan->GetAllExtractorTracks();
-        std::map<uint16_t, ExtractorTrack*>::iterator itExtractorTrack;
-
-        for (itExtractorTrack = extractorTracks->begin();
-            itExtractorTrack != extractorTracks->end(); itExtractorTrack++)
+        for (uint32_t vsIdx = 0; vsIdx < videoStreams.size(); vsIdx++)
         {
-            if (itExtractorTrack->second == extractorTrack)
+            std::pair<bool, bool> *status = &(framesStatus[vsIdx]);
+            ret = SegmentVideoFrame(videoStreams[vsIdx], &(status->first), &(status->second));
+            if (ret)
                 break;
         }
-        if (itExtractorTrack == extractorTracks->end())
-        {
-            OMAF_LOG(LOG_ERROR, "Can't find specified Extractor Track!\n");
-            return OMAF_ERROR_INVALID_DATA;
-        }
-        isFrameReady = ((m_currSegedFrmNum == (m_prevSegedFrmNum + 1)) && (extractorTrack->GetProcessedFrmNum() == m_currProcessedFrmNum) && (m_currSegedFrmNum == (m_currProcessedFrmNum + 1)));
-        while (!isFrameReady)
-        {
-            usleep(50);
-            isFrameReady = ((m_currSegedFrmNum == (m_prevSegedFrmNum + 1)) && (extractorTrack->GetProcessedFrmNum() == m_currProcessedFrmNum) && (m_currSegedFrmNum == (m_currProcessedFrmNum + 1)));
-        }
-
-        uint8_t etId = 0;
-        for ( ; etId < m_aveETPerSegThread; etId++)
-        {
-
-            if (itExtractorTrack == extractorTracks->end())
-            {
-                OMAF_LOG(LOG_ERROR, "Can't find specified Extractor Track!\n");
-                return OMAF_ERROR_INVALID_DATA;
-            }
-
-            ExtractorTrack *extractorTrack1 = itExtractorTrack->second;
-
-            extractorTrack1->ConstructExtractors();
-            WriteSegmentForEachExtractorTrack(extractorTrack1, m_nowKeyFrame, m_isEOS);
-
-            std::map<ExtractorTrack*, TrackSegmentCtx*>::iterator itET;
-            itET = m_extractorSegCtx.find(extractorTrack1);
-            if (itET == m_extractorSegCtx.end())
-            {
-                OMAF_LOG(LOG_ERROR, "Can't find segmentation context for specified extractor track !\n");
-                return OMAF_ERROR_INVALID_DATA;
-            }
-            TrackSegmentCtx *trackSegCtx = itET->second;
-
-            if (m_segNum == (m_prevSegNum + 1))
-            {
-                extractorTrack1->DestroyCurrSegNalus();
-            }
-
-            if (trackSegCtx->extractorTrackNalu.data)
-            {
-                extractorTrack1->AddExtractorsNaluToSeg(trackSegCtx->extractorTrackNalu.data);
-                trackSegCtx->extractorTrackNalu.data = NULL;
-            }
-            trackSegCtx->extractorTrackNalu.dataSize = 0;
+    }
+    if (ret)
+        return ret;
 
-            extractorTrack1->IncreaseProcessedFrmNum();
-            itExtractorTrack++;
-        }
-        if (m_isEOS)
-            break;
+    for (uint32_t vsIdx = 0; vsIdx < videoStreams.size(); vsIdx++)
+    {
+        VideoStream *vs = videoStreams[vsIdx];
+        m_framesIsKey[vs] = framesStatus[vsIdx].first;
+        m_streamsIsEOS[vs] = framesStatus[vsIdx].second;
     }
 
     return ERROR_NONE;
 }
 
-int32_t DefaultSegmentation::LastExtractorTrackSegmentation()
+int32_t DefaultSegmentation::SegmentExtractorTrack(
+    ExtractorTrack *extractorTrack)
 {
-    bool isFrameReady = false;
-    ExtractorTrack *extractorTrack = NULL;
-    pthread_t threadId = pthread_self();
-    if (threadId == 0)
+    std::map<ExtractorTrack*, TrackSegmentCtx*>::iterator itET;
+    itET = m_extractorSegCtx.find(extractorTrack);
+    if (itET == m_extractorSegCtx.end())
     {
-        OMAF_LOG(LOG_ERROR, "NULL thread id for extractor track segmentation !\n");
-        return OMAF_ERROR_INVALID_THREAD;
+        OMAF_LOG(LOG_ERROR, "Can't find segmentation context for specified extractor track !\n");
+        return OMAF_ERROR_INVALID_DATA;
     }
+    TrackSegmentCtx *trackSegCtx = itET->second;
 
-    while(1)
+    extractorTrack->ConstructExtractors();
+    int32_t ret = WriteSegmentForEachExtractorTrack(extractorTrack, m_nowKeyFrame, m_isEOS);
+    if (ret)
+        return ret;
+
+    if (m_segNum == (m_prevSegNum + 1))
     {
-        std::map<pthread_t, ExtractorTrack*>::iterator itETThread;
-        itETThread = m_extractorThreadIds.find(threadId);
-        if (itETThread != m_extractorThreadIds.end())
-        {
-            extractorTrack = itETThread->second;
-            break;
-        }
-        usleep(50);
+        extractorTrack->DestroyCurrSegNalus();
     }
 
-    while(1)
+    if (trackSegCtx->extractorTrackNalu.data)
     {
-        std::map<uint16_t, ExtractorTrack*> *extractorTracks = m_extractorTrackMan->GetAllExtractorTracks();
-        std::map<uint16_t, ExtractorTrack*>::iterator itExtractorTrack;
-
-        for (itExtractorTrack = extractorTracks->begin();
-            itExtractorTrack != extractorTracks->end(); itExtractorTrack++)
-        {
-            if (itExtractorTrack->second == extractorTrack)
-                break;
-        }
-        if (itExtractorTrack == extractorTracks->end())
-        {
-            OMAF_LOG(LOG_ERROR, "Can't find specified Extractor Track!\n");
-            return OMAF_ERROR_INVALID_DATA;
-        }
-
-        isFrameReady = ((m_currSegedFrmNum == (m_prevSegedFrmNum + 1)) && (extractorTrack->GetProcessedFrmNum() == m_currProcessedFrmNum) && (m_currSegedFrmNum == (m_currProcessedFrmNum + 1)));
-        while (!isFrameReady)
-        {
-            usleep(50);
-            isFrameReady = ((m_currSegedFrmNum == (m_prevSegedFrmNum + 1)) && (extractorTrack->GetProcessedFrmNum() == m_currProcessedFrmNum) && (m_currSegedFrmNum == (m_currProcessedFrmNum + 1)));
-        }
-
-        uint8_t etId = 0;
-        for ( ; etId < m_lastETPerSegThread; etId++)
-        {
-
-            if (itExtractorTrack == extractorTracks->end())
-            {
-                OMAF_LOG(LOG_ERROR, "Can't find specified Extractor Track!\n");
-                return OMAF_ERROR_INVALID_DATA;
-            }
+        extractorTrack->AddExtractorsNaluToSeg(trackSegCtx->extractorTrackNalu.data);
+        trackSegCtx->extractorTrackNalu.data = NULL;
+    }
+    trackSegCtx->extractorTrackNalu.dataSize = 0;
 
-            ExtractorTrack *extractorTrack1 = itExtractorTrack->second;
-            extractorTrack1->ConstructExtractors();
-            WriteSegmentForEachExtractorTrack(extractorTrack1, m_nowKeyFrame, m_isEOS);
+    extractorTrack->IncreaseProcessedFrmNum();
 
-            std::map<ExtractorTrack*, TrackSegmentCtx*>::iterator itET;
-            itET = m_extractorSegCtx.find(extractorTrack1);
-            if (itET == m_extractorSegCtx.end())
-            {
-                OMAF_LOG(LOG_ERROR, "Can't find segmentation context for specified extractor track !\n");
-                return OMAF_ERROR_INVALID_DATA;
-            }
-            TrackSegmentCtx *trackSegCtx = itET->second;
+    return ERROR_NONE;
+}
 
-            if (m_segNum == (m_prevSegNum + 1))
-            {
-                extractorTrack1->DestroyCurrSegNalus();
-            }
+int32_t DefaultSegmentation::SegmentAllExtractorTracks()
+{
+    std::map<uint16_t, ExtractorTrack*> *extractorTracks = m_extractorTrackMan->GetAllExtractorTracks();
+    if (!extractorTracks->size())
+        return ERROR_NONE;
 
-            if (trackSegCtx->extractorTrackNalu.data)
-            {
-                extractorTrack1->AddExtractorsNaluToSeg(trackSegCtx->extractorTrackNalu.data);
-                trackSegCtx->extractorTrackNalu.data = NULL;
-            }
-            trackSegCtx->extractorTrackNalu.dataSize = 0;
+    if (!m_segTaskPool)
+        return OMAF_ERROR_NULL_PTR;
 
-            extractorTrack1->IncreaseProcessedFrmNum();
-            itExtractorTrack++;
-        }
-        if (m_isEOS)
-            break;
+    std::vector<TaskPool::Task> tasks;
+    tasks.reserve(extractorTracks->size());
+    std::map<uint16_t, ExtractorTrack*>::iterator itExtractorTrack;
+    for (itExtractorTrack = extractorTracks->begin();
+        itExtractorTrack != extractorTracks->end(); itExtractorTrack++)
+    {
+        ExtractorTrack *extractorTrack = itExtractorTrack->second;
+        tasks.push_back([this, extractorTrack]() { return SegmentExtractorTrack(extractorTrack); });
     }
 
-    return ERROR_NONE;
+    return m_segTaskPool->RunAll(tasks);
 }
 
 bool DefaultSegmentation::HasAudio()
@@ -1685,24 +1606,32 @@ int32_t DefaultSegmentation::VideoSegmentation()
     m_prevSegNum = m_segNum;
 
     uint16_t extractorTrackNum = m_extractorSegCtx.size();
-    if (extractorTrackNum)
+    uint32_t videosNum = 0;
+    std::map<uint8_t, MediaStream*>::iterator itVideo;
+    for (itVideo = m_streamMap->begin(); itVideo != m_streamMap->end(); itVideo++)
     {
-        if (extractorTrackNum % m_segInfo->extractorTracksPerSegThread == 0)
-        {
-            m_aveETPerSegThread = m_segInfo->extractorTracksPerSegThread;
-            m_lastETPerSegThread = m_segInfo->extractorTracksPerSegThread;
-            m_threadNumForET = extractorTrackNum / m_segInfo->extractorTracksPerSegThread;
-        }
-        else
-        {
-            m_aveETPerSegThread = m_segInfo->extractorTracksPerSegThread;
-            m_lastETPerSegThread = extractorTrackNum % m_segInfo->extractorTracksPerSegThread;
-            m_threadNumForET = extractorTrackNum / m_segInfo->extractorTracksPerSegThread + 1;
-        }
+        MediaStream *stream = itVideo->second;
+        if (stream && (stream->GetMediaType() == VIDEOTYPE))
+            videosNum++;
+    }
 
-        OMAF_LOG(LOG_INFO, "Lanuch %d threads for Extractor Track segmentation!\n", m_threadNumForET);
-        OMAF_LOG(LOG_INFO, "Average Extractor Track number per thread is %d\n", m_aveETPerSegThread);
-        OMAF_LOG(LOG_INFO, "The last thread involves %d Extractor Tracks !\n", m_lastETPerSegThread);
+    uint32_t tasksNum = (extractorTrackNum > videosNum) ? extractorTrackNum : videosNum;
+    if (extractorTrackNum || (videosNum > 1))
+    {
+        long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+        uint32_t threadsNum = (cpuNum > 0) ? (uint32_t)cpuNum : 1;
+        if (threadsNum > tasksNum)
+            threadsNum = tasksNum;
+
+        m_segTaskPool = new TaskPool;
+        if (!m_segTaskPool)
+            return OMAF_ERROR_NULL_PTR;
+
+        int32_t ret = m_segTaskPool->Initialize(threadsNum);
+        if (ret)
+            return ret;
+
+        OMAF_LOG(LOG_INFO, "Lanuch %d threads in task pool for %d video streams and %d Extractor Tracks segmentation!\n", threadsNum, videosNum, extractorTrackNum);
     }
 
 #ifdef _USE_TRACE_
@@ -1742,52 +1671,9 @@ int32_t DefaultSegmentation::VideoSegmentation()
             }
         }
 
-        std::map<uint8_t, MediaStream*>::iterator itStream = m_streamMap->begin();
-        for ( ; itStream != m_streamMap->end(); itStream++)
-        {
-            MediaStream *stream = itStream->second;
-            if (stream->GetMediaType() == VIDEOTYPE)
-            {
-                VideoStream *vs = (VideoStream*)stream;
-                vs->SetCurrFrameInfo();
-                FrameBSInfo *currFrame = vs->GetCurrFrameInfo();
-
-                while (!currFrame)
-                {
-                    usleep(50);
-                    vs->SetCurrFrameInfo();
-                    currFrame = vs->GetCurrFrameInfo();
-                    if (!currFrame && (vs->GetEOS()))
-                        break;
-                }
-
-                if (currFrame)
-                {
-                    m_framesIsKey[vs] = currFrame->isKeyFrame;
-                    m_streamsIsEOS[vs] = false;
-
-#ifdef _USE_TRACE_
-                    //trace
-                    char resolution[1024] = { 0 };
-                    snprintf(resolution, 1024, "%d x %d", vs->GetSrcWidth(), vs->GetSrcHeight());
-                    char tileSplit[1024] = { 0 };
-                    snprintf(tileSplit, 1024, "%d x %d", vs->GetTileInCol(), vs->GetTileInRow());
-                    tracepoint(bandwidth_tp_provider, encoded_frame_size,
-                                &resolution[0], &tileSplit[0], m_framesNum, currFrame->dataSize);
-#endif
-
-                    vs->UpdateTilesNalu();
-                    WriteSegmentForEachVideo(vs, currFrame->isKeyFrame, false);
-                }
-                else
-                {
-                    m_framesIsKey[vs] = false;
-                    m_streamsIsEOS[vs] = true;
-
-                    WriteSegmentForEachVideo(vs, false, true);
-                }
-            }
-        }
+        int32_t retVS = SegmentAllVideoFrames();
+        if (retVS)
+            return retVS;
 
         std::map<MediaStream*, bool>::iterator itKeyFrame = m_framesIsKey.begin();
         if (itKeyFrame == m_framesIsKey.end())
@@ -1817,90 +1703,14 @@ int32_t DefaultSegmentation::VideoSegmentation()
 
         m_currSegedFrmNum++;
 
-        std::map<uint16_t, ExtractorTrack*> *extractorTracks = m_extractorTrackMan->GetAllExtractorTracks();
-        if (extractorTracks->size())
-        {
-            std::map<uint16_t, ExtractorTrack*>::iterator itExtractorTrack = extractorTracks->begin();
-            for ( ; itExtractorTrack != extractorTracks->end(); /*itExtractorTrack++*/)
-            {
-                ExtractorTrack *extractorTrack = itExtractorTrack->second;
-                if (m_extractorThreadIds.size() < m_threadNumForET)
-                {
-                    if (m_aveETPerSegThread == m_lastETPerSegThread)
-                    {
-                        int32_t retET = StartExtractorTrackSegmentation(extractorTrack);
-                        if (retET)
-                            return retET;
-
-                        for (uint16_t num = 0; num < m_aveETPerSegThread; num++)
-                        {
-                            if (itExtractorTrack != extractorTracks->end())
-                            {
-                                itExtractorTrack++;
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if ((uint16_t)(m_extractorThreadIds.size()) < (m_threadNumForET - 1))
-                        {
-                            int32_t retET = StartExtractorTrackSegmentation(extractorTrack);
-                            if (retET)
-                                return retET;
-
-                            for (uint16_t num = 0; num < m_aveETPerSegThread; num++)
-                            {
-                                if (itExtractorTrack != extractorTracks->end())
-                                {
-                                    itExtractorTrack++;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            int32_t retET = StartLastExtractorTrackSegmentation(extractorTrack);
-                            if (retET)
-                                return retET;
-
-                            for ( ; itExtractorTrack != extractorTracks->end(); )
-                            {
-                                itExtractorTrack++;
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    break;
-                }
-            }
-            if (m_extractorThreadIds.size() != m_threadNumForET)
-            {
-                 OMAF_LOG(LOG_ERROR, "Launched threads number %ld doesn't match calculated threads number %d\n", (m_extractorThreadIds.size()), m_threadNumForET);
-            }
-
-            usleep(2000);
-
-            for (itExtractorTrack = extractorTracks->begin();
-                itExtractorTrack != extractorTracks->end();
-                itExtractorTrack++)
-            {
-                ExtractorTrack *extractorTrack = itExtractorTrack->second;
-                while (extractorTrack->GetProcessedFrmNum() == m_framesNum)
-                {
-                    usleep(1);
-
-                    if (extractorTrack->GetProcessedFrmNum() == (m_framesNum + 1))
-                    {
-                        break;
-                    }
-                }
-            }
-        }
+        int32_t retET = SegmentAllExtractorTracks();
+        if (retET)
+            return retET;
 
         m_prevSegedFrmNum++;
         m_currProcessedFrmNum++;
 
+        std::map<uint8_t, MediaStream*>::iterator itStream;
         for (itStream = m_streamMap->begin(); itStream != m_streamMap->end(); itStream++)
         {
             MediaStream *stream = itStream->second;
@@ -2051,6 +1861,8 @@ int32_t DefaultSegmentation::VideoSegmentation()
                    m_framesNum,
                    tag.c_str());
 #endif
+        m_segedVideoFrmNum++;
+        NotifyProgress();
         m_framesNum++;
     }
 
@@ -2167,11 +1979,14 @@ int32_t DefaultSegmentation::AudioSegmentation()
                     if (!currFrame && (as->GetEOS()))
                         break;
                 }
+                NotifyProgress();
                 nowEOS = as->GetEOS();
                 if (currFrame)
                 {
                     WriteSegmentForEachAudio(as, currFrame, true, false);
                     framesWritten++;
+                    m_segedAudioFrmNum++;
+                    NotifyProgress();
                 }
                 else
                 {
@@ -38,6 +38,7 @@
 #include <mutex>
 #include "Segmentation.h"
 #include "DashSegmenter.h"
+#include "TaskPool.h"
 
 VCD_NS_BEGIN
 
@@ -65,9 +66,7 @@ public:
         m_nowKeyFrame = false;
         m_prevSegNum = 0;
         m_isFramesReady = false;
-        m_aveETPerSegThread = 0;
-        m_lastETPerSegThread = 0;
-        m_threadNumForET = 0;
+        m_segTaskPool = NULL;
         m_videosNum = 0;
         m_videosBitrate = NULL;
         m_prevSegedFrmNum = 0;
@@ -102,9 +101,7 @@ public:
         m_nowKeyFrame = false;
         m_prevSegNum = 0;
         m_isFramesReady = false;
-        m_aveETPerSegThread = 0;
-        m_lastETPerSegThread = 0;
-        m_threadNumForET = 0;
+        m_segTaskPool = NULL;
         m_videosNum = 0;
         m_videosBitrate = NULL;
         m_prevSegedFrmNum = 0;
@@ -127,9 +124,7 @@ public:
         m_nowKeyFrame = src.m_nowKeyFrame;
         m_prevSegNum = src.m_prevSegNum;
         m_isFramesReady = src.m_isFramesReady;
-        m_aveETPerSegThread = src.m_aveETPerSegThread;
-        m_lastETPerSegThread = src.m_lastETPerSegThread;
-        m_threadNumForET = src.m_threadNumForET;
+        m_segTaskPool = NULL;
         m_videosNum = src.m_videosNum;
         m_videosBitrate = std::move(src.m_videosBitrate);
         m_prevSegedFrmNum = src.m_prevSegedFrmNum;
@@ -152,9 +147,7 @@ public:
         m_nowKeyFrame = other.m_nowKeyFrame;
         m_prevSegNum = other.m_prevSegNum;
         m_isFramesReady = other.m_isFramesReady;
-        m_aveETPerSegThread = other.m_aveETPerSegThread;
-        m_lastETPerSegThread = other.m_lastETPerSegThread;
-        m_threadNumForET = other.m_threadNumForET;
+        m_segTaskPool = NULL;
         m_videosNum = other.m_videosNum;
         m_videosBitrate = NULL;
         m_prevSegedFrmNum = other.m_prevSegedFrmNum;
@@ -307,67 +300,54 @@ private:
     int32_t EndEachAudio(MediaStream *stream);
 
     //!
-    //! \brief  Start segmentation thread for specified extractor track
+    //! \brief  Get current frame of specified video stream and write
+    //!         it into tile tracks segments, which is run as one task
+    //!         in segmentation task pool
     //!
-    //! \param  [in] extractorTrack
-    //!         pointer to the specified extractor track
+    //! \param  [in] vs
+    //!         pointer to the specified video stream
+    //! \param  [out] isKeyFrame
+    //!         whether current frame is key frame
+    //! \param  [out] isEOS
+    //!         whether the video stream reaches EOS
     //!
     //! \return int32_t
     //!         ERROR_NONE if success, else failed reason
     //!
-    int32_t StartExtractorTrackSegmentation(ExtractorTrack *extractorTrack);
+    int32_t SegmentVideoFrame(VideoStream *vs, bool *isKeyFrame, bool *isEOS);
 
     //!
-    //! \brief  Start last segmentation thread for rest extractor tracks
-    //!
-    //! \param  [in] extractorTrack
-    //!         pointer to the first extractor track in rest extractor
-    //!         tracks which are not created segmentation thread
+    //! \brief  Segment current frames for all video streams in
+    //!         parallel, so that streams of different resolutions
+    //!         are processed at the same time
     //!
     //! \return int32_t
     //!         ERROR_NONE if success, else failed reason
     //!
-    int32_t StartLastExtractorTrackSegmentation(ExtractorTrack *extractorTrack);
+    int32_t SegmentAllVideoFrames();
 
     //!
-    //! \brief  extractor track segmentation thread function
-    //!
-    //! \param  [in] pThis
-    //!         this DefaultSegmentation
-    //!
-    //! \return void*
-    //!         return NULL
-    //!
-    static void* ExtractorTrackSegThread(void *pThis);
-
+    //! \brief  Generate extractor track segment for current frame
+    //!         for specified extractor track, which is run as one
+    //!         task in segmentation task pool
     //!
-    //! \brief  extractor track segmentation thread function for last extractor
-    //!         tracks
-    //!
-    //! \param  [in] pThis
-    //!         this DefaultSegmentation
-    //!
-    //! \return void*
-    //!         return NULL
-    //!
-    static void* LastExtractorTrackSegThread(void *pThis);
-
-    //!
-    //! \brief  Generate extractor track segments
+    //! \param  [in] extractorTrack
+    //!         pointer to the specified extractor track
     //!
     //! \return int32_t
     //!         ERROR_NONE if success, else failed reason
     //!
-    int32_t ExtractorTrackSegmentation();
+    int32_t SegmentExtractorTrack(ExtractorTrack *extractorTrack);
 
     //!
-    //! \brief  Generate extractor track segments for last
-    //!         extractor tracks
+    //! \brief  Generate extractor track segments for current frame
+    //!         for all extractor tracks in parallel, and wait for
+    //!         all of them to be done
     //!
     //! \return int32_t
     //!         ERROR_NONE if success, else failed reason
     //!
-    int32_t LastExtractorTrackSegmentation();
+    int32_t SegmentAllExtractorTracks();
 
     //!
     //! \brief  Set frames ready status for extractor track
@@ -421,15 +401,12 @@ private:
     uint64_t                                       m_audioPrevSegNum;
     bool                                           m_audioSegCtxsConsted;
     uint64_t                                       m_framesNum;          //!< current written frames number
-    std::map<pthread_t, ExtractorTrack*>           m_extractorThreadIds; //!< map of thread ID for extractor track segmentation and corresponding extractor track
+    TaskPool                                       *m_segTaskPool;        //!< task pool for video streams and extractor tracks segmentation
     bool                                           m_isEOS;              //!< whether EOS has been gotten for all media streams
     bool                                           m_nowKeyFrame;        //!< whether current frames are key frames for each corresponding media stream
     uint64_t                                       m_prevSegNum;         //!< previously written segments number
     std::mutex                                     m_mutex;              //!< thread mutex for main segmentation thread
     bool                                           m_isFramesReady;      //!< whether frames are ready for extractor track
-    uint16_t                                       m_aveETPerSegThread;  //!< average extractor tracks number in segmentation thread
-    uint16_t                                       m_lastETPerSegThread; //!< extractor tracks number in last segmentation thread
-    uint16_t                                       m_threadNumForET;     //!< threads number for extractor track segmentation
     uint32_t                                       m_videosNum;          //!< video streams number
     uint64_t                                       *m_videosBitrate;     //!< video stream bitrate array
     uint64_t                                       m_prevSegedFrmNum;    //!< previous number of frames which have been segmented for their tile tracks
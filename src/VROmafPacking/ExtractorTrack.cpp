@@ -35,6 +35,13 @@
 #include "ExtractorTrack.h"
 #include "VideoStreamPluginAPI.h"
 
+//! size of the inline constructor data for the rewritten slice header
+#define INLINE_CTOR_DATA_SIZE    256
+//! bytes following the slice header which are also passed to 360SCVP,
+//! they cover emulation prevention bytes within the slice header, the
+//! whole nalu is passed when there are more of them
+#define SLICE_HEADER_TAIL_SIZE   16
+
 VCD_NS_BEGIN
 
 ExtractorTrack::ExtractorTrack()
@@ -56,6 +63,7 @@ ExtractorTrack::ExtractorTrack()
     m_360scvpParam = NULL;
     m_dstWidth = 0;
     m_dstHeight = 0;
+    m_sliceHdrCache = NULL;
 }
 
 int32_t ExtractorTrack::Initialize()
@@ -126,6 +134,7 @@ ExtractorTrack::ExtractorTrack(uint8_t viewportIdx, std::map<uint8_t, MediaStrea
     m_360scvpParam = NULL;
     m_dstWidth = 0;
     m_dstHeight = 0;
+    m_sliceHdrCache = NULL;
 }
 
 ExtractorTrack::ExtractorTrack(const ExtractorTrack& src)
@@ -147,6 +156,7 @@ ExtractorTrack::ExtractorTrack(const ExtractorTrack& src)
     m_360scvpParam = std::move(src.m_360scvpParam);
     m_dstWidth = src.m_dstWidth;
     m_dstHeight = src.m_dstHeight;
+    m_sliceHdrCache = src.m_sliceHdrCache;
 }
 
 ExtractorTrack& ExtractorTrack::operator=(ExtractorTrack&& other)
@@ -168,6 +178,8 @@ ExtractorTrack& ExtractorTrack::operator=(ExtractorTrack&& other)
     m_360scvpParam = std::move(other.m_360scvpParam);
     m_dstWidth = other.m_dstWidth;
     m_dstHeight = other.m_dstHeight;
+    m_sliceHdrCache = other.m_sliceHdrCache;
+    m_sliceHdrInput = std::move(other.m_sliceHdrInput);
 
     return *this;
 }
@@ -305,6 +317,100 @@ int32_t ExtractorTrack::ConstructExtractors()
     return ERROR_NONE;
 }
 
+int32_t ExtractorTrack::RewriteSliceHeader(
+    SingleTile *tile,
+    VideoStream *video,
+    VCD::MP4::InlineConstructor *inlineCtor)
+{
+    if (!tile || !video || !inlineCtor || !(inlineCtor->inlineData))
+        return OMAF_ERROR_NULL_PTR;
+
+    if (!m_dstWidth || !m_dstHeight)
+        return OMAF_ERROR_INVALID_DATA;
+
+    TileInfo *allTiles = video->GetAllTilesInfo();
+    Nalu *tileNalu = allTiles[tile->origTileIdx].tileNalu;
+    if (!tileNalu || !(tileNalu->data) || (tileNalu->dataSize <= HEVC_STARTCODES_LEN))
+        return OMAF_ERROR_INVALID_DATA;
+
+    // only the slice header and some following bytes are needed to
+    // rewrite the slice header, so the whole tile nalu isn't copied
+    uint32_t inputLen = tileNalu->dataSize;
+    if (tileNalu->sliceHeaderLen)
+    {
+        uint32_t hdrRegionLen = HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN +
+                                tileNalu->sliceHeaderLen + SLICE_HEADER_TAIL_SIZE;
+        if (hdrRegionLen < inputLen)
+        {
+            // the parsed slice header length doesn't count emulation
+            // prevention bytes, fall back to the whole nalu when the
+            // slice header may not be within the truncated buffer
+            uint32_t epbNum = 0;
+            for (uint32_t i = HEVC_STARTCODES_LEN + HEVC_NALUHEADER_LEN + 2; i < hdrRegionLen; i++)
+            {
+                if (!(tileNalu->data[i - 2]) && !(tileNalu->data[i - 1]) && (tileNalu->data[i] == 3))
+                    epbNum++;
+            }
+            if (tileNalu->sliceHeaderLen + epbNum <= hdrRegionLen - HEVC_STARTCODES_LEN - HEVC_NALUHEADER_LEN)
+                inputLen = hdrRegionLen;
+        }
+    }
+
+    SliceHeaderKey key;
+    key.streamIdx   = tile->streamIdxInMedia;
+    key.origTileIdx = tile->origTileIdx;
+    key.ctuIdx      = tile->dstCTUIndex;
+    key.dstWidth    = m_dstWidth;
+    key.dstHeight   = m_dstHeight;
+
+    const uint8_t *srcHdr = tileNalu->data + HEVC_STARTCODES_LEN;
+    uint32_t srcHdrLen = inputLen - HEVC_STARTCODES_LEN;
+    uint32_t outputLen = 0;
+    if (!m_sliceHdrCache ||
+        !m_sliceHdrCache->Lookup(key, srcHdr, srcHdrLen, inlineCtor->inlineData, INLINE_CTOR_DATA_SIZE, &outputLen))
+    {
+        std::map<MediaStream*, void*>::iterator itHdl;
+        itHdl = m_360scvpHandles.find((MediaStream*)video);
+        if (itHdl == m_360scvpHandles.end())
+        {
+            void *handle = I360SCVP_New(video->Get360SCVPHandle());
+            if (!handle)
+                return OMAF_ERROR_SCVP_OPERATION_FAILED;
+
+            itHdl = m_360scvpHandles.insert(std::make_pair((MediaStream*)video, handle)).first;
+        }
+
+        m_sliceHdrInput.resize(inputLen);
+        m_sliceHdrInput[0] = 0;
+        m_sliceHdrInput[1] = 0;
+        m_sliceHdrInput[2] = 0;
+        m_sliceHdrInput[3] = 1;
+        memcpy_s(m_sliceHdrInput.data() + HEVC_STARTCODES_LEN, srcHdrLen, srcHdr, srcHdrLen);
+
+        memcpy_s(m_360scvpParam, sizeof(param_360SCVP), video->Get360SCVPParam(), sizeof(param_360SCVP));
+        m_360scvpParam->destWidth = m_dstWidth;
+        m_360scvpParam->destHeight = m_dstHeight;
+        m_360scvpParam->pInputBitstream = m_sliceHdrInput.data();
+        m_360scvpParam->inputBitstreamLen = inputLen;
+        m_360scvpParam->pOutputBitstream = inlineCtor->inlineData;
+
+        memset_s(inlineCtor->inlineData, INLINE_CTOR_DATA_SIZE, 0);
+        int32_t ret = I360SCVP_GenerateSliceHdr(m_360scvpParam, tile->dstCTUIndex, itHdl->second);
+        if (ret)
+            return OMAF_ERROR_SCVP_OPERATION_FAILED;
+
+        outputLen = m_360scvpParam->outputBitstreamLen;
+        if (m_sliceHdrCache)
+            m_sliceHdrCache->Store(key, srcHdr, srcHdrLen, inlineCtor->inlineData, outputLen);
+    }
+
+    inlineCtor->length = DASH_SAMPLELENFIELD_SIZE + outputLen - HEVC_STARTCODES_LEN;
+
+    memset_s(inlineCtor->inlineData, DASH_SAMPLELENFIELD_SIZE, 0xff);
+
+    return ERROR_NONE;
+}
+
 int32_t ExtractorTrack::GenerateExtractors()
 {
     if (!m_tilesMergeDir)
@@ -326,7 +432,6 @@ int32_t ExtractorTrack::GenerateExtractors()
             SingleTile *tile = *itTile;
             uint8_t  vsIdx    = tile->streamIdxInMedia;
             uint8_t  origTileIdx  = tile->origTileIdx;
-            uint16_t ctuIdx   = tile->dstCTUIndex;
 
             std::map<uint8_t, MediaStream*>::iterator itStream;
             itStream = m_streams->find(vsIdx);
@@ -349,69 +454,24 @@ int32_t ExtractorTrack::GenerateExtractors()
 
             memset_s(inlineCtor, sizeof(VCD::MP4::InlineConstructor), 0);
 
-            inlineCtor->inlineData = new uint8_t[256];
+            inlineCtor->inlineData = new uint8_t[INLINE_CTOR_DATA_SIZE];
             if (!inlineCtor->inlineData)
             {
                 DELETE_MEMORY(extractor);
                 DELETE_MEMORY(inlineCtor);
                 return OMAF_ERROR_NULL_PTR;
             }
-            memset_s(inlineCtor->inlineData, 256, 0);
+            memset_s(inlineCtor->inlineData, INLINE_CTOR_DATA_SIZE, 0);
 
-            std::map<MediaStream*, void*>::iterator itHdl;
-            itHdl = m_360scvpHandles.find((MediaStream*)video);
-            if (itHdl == m_360scvpHandles.end())
-            {
-                void *handle = I360SCVP_New(video->Get360SCVPHandle());
-                m_360scvpHandles.insert(std::make_pair((MediaStream*)video, handle));
-            }
-            void *m_360scvpHandle = m_360scvpHandles[(MediaStream*)video];
-            memcpy_s(m_360scvpParam, sizeof(param_360SCVP), video->Get360SCVPParam(), sizeof(param_360SCVP));
-
-            if (!m_dstWidth || !m_dstHeight)
-            {
-                DELETE_MEMORY(extractor);
-                DELETE_ARRAY(inlineCtor->inlineData);
-                DELETE_MEMORY(inlineCtor);
-                return OMAF_ERROR_INVALID_DATA;
-            }
-
-            m_360scvpParam->destWidth = m_dstWidth;
-            m_360scvpParam->destHeight = m_dstHeight;
-
-            uint8_t *tempData = new uint8_t[tileInfo->tileNalu->dataSize];
-            if (!tempData)
-            {
-                DELETE_MEMORY(extractor);
-                DELETE_ARRAY(inlineCtor->inlineData);
-                DELETE_MEMORY(inlineCtor);
-                return OMAF_ERROR_NULL_PTR;
-            }
-            memcpy_s(tempData, tileInfo->tileNalu->dataSize, tileInfo->tileNalu->data, tileInfo->tileNalu->dataSize);
-
-            tempData[0] = 0;
-            tempData[1] = 0;
-            tempData[2] = 0;
-            tempData[3] = 1;
-
-            m_360scvpParam->pInputBitstream = tempData;
-            m_360scvpParam->inputBitstreamLen = tileInfo->tileNalu->dataSize;
-            m_360scvpParam->pOutputBitstream = inlineCtor->inlineData;
-
-            int32_t ret = I360SCVP_GenerateSliceHdr(m_360scvpParam, ctuIdx, m_360scvpHandle);
+            int32_t ret = RewriteSliceHeader(tile, video, inlineCtor);
             if (ret)
             {
                 DELETE_MEMORY(extractor);
                 DELETE_ARRAY(inlineCtor->inlineData);
                 DELETE_MEMORY(inlineCtor);
-                DELETE_ARRAY(tempData);
-                return OMAF_ERROR_SCVP_OPERATION_FAILED;
+                return ret;
             }
 
-            inlineCtor->length = DASH_SAMPLELENFIELD_SIZE + m_360scvpParam->outputBitstreamLen - HEVC_STARTCODES_LEN;
-
-            memset_s(inlineCtor->inlineData, DASH_SAMPLELENFIELD_SIZE, 0xff);
-
             extractor->inlineConstructor.push_back(inlineCtor);
 
             VCD::MP4::SampleConstructor *sampleCtor = new VCD::MP4::SampleConstructor;
@@ -420,7 +480,6 @@ int32_t ExtractorTrack::GenerateExtractors()
                 DELETE_MEMORY(extractor);
                 DELETE_ARRAY(inlineCtor->inlineData);
                 DELETE_MEMORY(inlineCtor);
-                DELETE_ARRAY(tempData);
                 return OMAF_ERROR_NULL_PTR;
             }
 
@@ -437,7 +496,6 @@ int32_t ExtractorTrack::GenerateExtractors()
             m_extractors.insert(std::make_pair(tileIdx, extractor));
 
             tileIdx++;
-            DELETE_ARRAY(tempData);
         }
     }
     return ERROR_NONE;
@@ -529,7 +587,6 @@ int32_t ExtractorTrack::UpdateExtractors()
             SingleTile *tile = *itTile;
             uint8_t  vsIdx    = tile->streamIdxInMedia;
             uint8_t  origTileIdx  = tile->origTileIdx;
-            uint16_t ctuIdx   = tile->dstCTUIndex;
 
             std::map<uint8_t, MediaStream*>::iterator itStream;
             itStream = m_streams->find(vsIdx);
@@ -546,55 +603,21 @@ int32_t ExtractorTrack::UpdateExtractors()
 
             if (!(inlineCtor->inlineData))
                 return OMAF_ERROR_NULL_PTR;
-            memset_s(inlineCtor->inlineData, 256, 0);
-
-            void *m_360scvpHandle = m_360scvpHandles[(MediaStream*)video];
-            memcpy_s(m_360scvpParam, sizeof(param_360SCVP), video->Get360SCVPParam(), sizeof(param_360SCVP));
-
-            m_360scvpParam->destWidth = m_dstWidth;
-            m_360scvpParam->destHeight = m_dstHeight;
-
-            uint8_t *tempData = new uint8_t[tileInfo->tileNalu->dataSize];
-            if (!tempData)
-                return OMAF_ERROR_NULL_PTR;
-
-            memcpy_s(tempData, tileInfo->tileNalu->dataSize, tileInfo->tileNalu->data, tileInfo->tileNalu->dataSize);
-
-            tempData[0] = 0;
-            tempData[1] = 0;
-            tempData[2] = 0;
-            tempData[3] = 1;
-
-            m_360scvpParam->pInputBitstream = tempData;
-            m_360scvpParam->inputBitstreamLen = tileInfo->tileNalu->dataSize;
-            m_360scvpParam->pOutputBitstream  = inlineCtor->inlineData;
 
-            int32_t ret = I360SCVP_GenerateSliceHdr(m_360scvpParam, ctuIdx, m_360scvpHandle);
+            int32_t ret = RewriteSliceHeader(tile, video, inlineCtor);
             if (ret)
-            {
-                DELETE_ARRAY(tempData);
-                return OMAF_ERROR_SCVP_OPERATION_FAILED;
-            }
-
-            inlineCtor->length = DASH_SAMPLELENFIELD_SIZE + m_360scvpParam->outputBitstreamLen - HEVC_STARTCODES_LEN;
-
-            memset_s(inlineCtor->inlineData, DASH_SAMPLELENFIELD_SIZE, 0xff);
+                return ret;
 
             VCD::MP4::SampleConstructor *sampleCtor = extractor->sampleConstructor.front();
             if (!sampleCtor)
-            {
-                DELETE_ARRAY(tempData);
                 return OMAF_ERROR_NULL_PTR;
-            }
 
             sampleCtor->dataOffset    = DASH_SAMPLELENFIELD_SIZE + HEVC_NALUHEADER_LEN + tileInfo->tileNalu->sliceHeaderLen;
             sampleCtor->dataLength = tileInfo->tileNalu->dataSize -
                                      tileInfo->tileNalu->startCodesSize -
                                      HEVC_NALUHEADER_LEN - tileInfo->tileNalu->sliceHeaderLen;
 
-
             tileIdx++;
-            DELETE_ARRAY(tempData);
         }
     }
     return ERROR_NONE;
@@ -41,10 +41,14 @@
 #include "RegionWisePackingGenerator.h"
 #include "../utils/OmafStructure.h"
 #include "MediaData.h"
+#include "SliceHeaderCache.h"
 
 #include <list>
 #include <map>
 #include <mutex>
+#include <vector>
+
+class VideoStream;
 
 VCD_NS_BEGIN
 
@@ -289,8 +293,36 @@ public:
 
     void SetPackedPicHeight(uint32_t packedHeight) { m_dstHeight = packedHeight; };
 
+    //!
+    //! \brief  Set the slice header cache shared by all extractor tracks
+    //!
+    //! \param  [in] sliceHdrCache
+    //!         pointer to the slice header cache, NULL to rewrite
+    //!         each slice header by 360SCVP
+    //!
+    void SetSliceHeaderCache(SliceHeaderCache *sliceHdrCache) { m_sliceHdrCache = sliceHdrCache; };
+
 private:
 
+    //!
+    //! \brief  Rewrite the slice header of one tile for its position
+    //!         in the packed picture into the inline constructor
+    //!
+    //! \param  [in] tile
+    //!         pointer to the tile in the packed picture
+    //! \param  [in] video
+    //!         pointer to the video stream the tile belongs to
+    //! \param  [out] inlineCtor
+    //!         pointer to the inline constructor for the rewritten header
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t RewriteSliceHeader(
+        SingleTile *tile,
+        VideoStream *video,
+        VCD::MP4::InlineConstructor *inlineCtor);
+
     //!
     //! \brief  Generate projection SEI
     //!
@@ -328,6 +360,8 @@ private:
     uint64_t                        m_processedFrmNum;   //!< processed frames number in extractor track
     uint32_t                         m_dstWidth;
     uint32_t                         m_dstHeight;
+    SliceHeaderCache                *m_sliceHdrCache;    //!< pointer to the slice header cache shared by all extractor tracks
+    std::vector<uint8_t>            m_sliceHdrInput;     //!< reused buffer of the slice header bitstream input to 360SCVP
 };
 
 VCD_NS_END;
@@ -40,6 +40,7 @@ ExtractorTrackManager::ExtractorTrackManager()
     m_extractorTrackGen = NULL;
     m_initInfo = NULL;
     m_streams  = NULL;
+    m_sliceHdrCache = NULL;
 }
 
 ExtractorTrackManager::ExtractorTrackManager(InitialInfo *initInfo)
@@ -47,6 +48,7 @@ ExtractorTrackManager::ExtractorTrackManager(InitialInfo *initInfo)
     m_extractorTrackGen = NULL;
     m_initInfo = initInfo;
     m_streams  = NULL;
+    m_sliceHdrCache = NULL;
 }
 
 ExtractorTrackManager::ExtractorTrackManager(const ExtractorTrackManager& src)
@@ -54,6 +56,7 @@ ExtractorTrackManager::ExtractorTrackManager(const ExtractorTrackManager& src)
     m_extractorTrackGen = std::move(src.m_extractorTrackGen);
     m_initInfo = std::move(src.m_initInfo);
     m_streams  = std::move(src.m_streams);
+    m_sliceHdrCache = std::move(src.m_sliceHdrCache);
 }
 
 ExtractorTrackManager& ExtractorTrackManager::operator=(ExtractorTrackManager&& other)
@@ -61,6 +64,7 @@ ExtractorTrackManager& ExtractorTrackManager::operator=(ExtractorTrackManager&&
     m_extractorTrackGen = std::move(other.m_extractorTrackGen);
     m_initInfo = std::move(other.m_initInfo);
     m_streams  = std::move(other.m_streams);
+    m_sliceHdrCache = std::move(other.m_sliceHdrCache);
 
     return *this;
 }
@@ -77,6 +81,8 @@ ExtractorTrackManager::~ExtractorTrackManager()
         m_extractorTracks.erase(it++);
     }
     m_extractorTracks.clear();
+
+    DELETE_MEMORY(m_sliceHdrCache);
 }
 
 int32_t ExtractorTrackManager::AddExtractorTracks()
@@ -85,6 +91,20 @@ int32_t ExtractorTrackManager::AddExtractorTracks()
     if (ret)
         return ret;
 
+    m_sliceHdrCache = new SliceHeaderCache;
+    if (!m_sliceHdrCache)
+        return OMAF_ERROR_NULL_PTR;
+
+    std::map<uint16_t, ExtractorTrack*>::iterator it;
+    for (it = m_extractorTracks.begin(); it != m_extractorTracks.end(); it++)
+    {
+        ExtractorTrack *extractorTrack = it->second;
+        if (!extractorTrack)
+            return OMAF_ERROR_NULL_PTR;
+
+        extractorTrack->SetSliceHeaderCache(m_sliceHdrCache);
+    }
+
     return ERROR_NONE;
 }
 
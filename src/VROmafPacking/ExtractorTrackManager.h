@@ -41,6 +41,7 @@
 //#include "VideoStream.h"
 #include "ExtractorTrack.h"
 #include "ExtractorTrackGenerator.h"
+#include "SliceHeaderCache.h"
 
 VCD_NS_BEGIN
 
@@ -108,6 +109,7 @@ private:
     std::map<uint16_t, ExtractorTrack*> m_extractorTracks;     //!< extractor tracks map
     ExtractorTrackGenerator            *m_extractorTrackGen;  //!< extractor track generator to generate all extractor tracks
     InitialInfo                        *m_initInfo;           //!< the initial information input by library interface
+    SliceHeaderCache                   *m_sliceHdrCache;      //!< slice header cache shared by all extractor tracks
 };
 
 VCD_NS_END;
@@ -828,6 +828,9 @@ int32_t MultiViewSegmentation::VideoSegmentation()
                         break;
                 }
 
+                // the frame has left the queue of the stream
+                NotifyProgress();
+
                 if (currFrame)
                 {
                     m_framesIsKey[vs] = currFrame->isKeyFrame;
@@ -1004,6 +1007,8 @@ int32_t MultiViewSegmentation::VideoSegmentation()
                    m_framesNum,
                    tag.c_str());
 #endif
+        m_segedVideoFrmNum++;
+        NotifyProgress();
         m_framesNum++;
     }
 
@@ -1120,11 +1125,14 @@ int32_t MultiViewSegmentation::AudioSegmentation()
                     if (!currFrame && (as->GetEOS()))
                         break;
                 }
+                NotifyProgress();
                 nowEOS = as->GetEOS();
                 if (currFrame)
                 {
                     WriteSegmentForEachAudio(as, currFrame, true, false);
                     framesWritten++;
+                    m_segedAudioFrmNum++;
+                    NotifyProgress();
                 }
                 else
                 {
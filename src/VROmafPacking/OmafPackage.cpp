@@ -33,6 +33,7 @@
 
 #include <dlfcn.h>
 #include <math.h>
+#include <unistd.h>
 
 #include "OmafPackage.h"
 #include "VideoStreamPluginAPI.h"
@@ -54,6 +55,7 @@ OmafPackage::OmafPackage()
     m_hasChunkDurCorrected = false;
     m_hasViewSEI = false;
     m_sourceMode = OMNIDIRECTIONAL_VIDEO_PACKING;
+    m_maxQueuedFrames = 0;
 }
 
 OmafPackage::OmafPackage(const OmafPackage& src)
@@ -68,6 +70,8 @@ OmafPackage::OmafPackage(const OmafPackage& src)
     m_hasChunkDurCorrected = src.m_hasChunkDurCorrected;
     m_hasViewSEI = src.m_hasViewSEI;
     m_sourceMode = src.m_sourceMode;
+    m_maxQueuedFrames = src.m_maxQueuedFrames;
+    m_inputFrmNum = src.m_inputFrmNum;
 }
 
 OmafPackage& OmafPackage::operator=(OmafPackage&& other)
@@ -82,6 +86,8 @@ OmafPackage& OmafPackage::operator=(OmafPackage&& other)
     m_hasChunkDurCorrected = other.m_hasChunkDurCorrected;
     m_hasViewSEI = other.m_hasViewSEI;
     m_sourceMode = other.m_sourceMode;
+    m_maxQueuedFrames = other.m_maxQueuedFrames;
+    m_inputFrmNum = std::move(other.m_inputFrmNum);
 
     return *this;
 }
@@ -562,7 +568,11 @@ void* OmafPackage::VideoSegmentationThread(void* pThis)
 
 void OmafPackage::SegmentAllVideoStreams()
 {
-    m_segmentation->VideoSegmentation();
+    int32_t ret = m_segmentation->VideoSegmentation();
+    if (ret)
+        OMAF_LOG(LOG_ERROR, "Video segmentation exits with error %d !\n", ret);
+
+    m_segmentation->NotifyExit(VIDEOTYPE);
 }
 
 void* OmafPackage::AudioSegmentationThread(void* pThis)
@@ -576,7 +586,11 @@ void* OmafPackage::AudioSegmentationThread(void* pThis)
 
 void OmafPackage::SegmentAllAudioStreams()
 {
-    m_segmentation->AudioSegmentation();
+    int32_t ret = m_segmentation->AudioSegmentation();
+    if (ret)
+        OMAF_LOG(LOG_ERROR, "Audio segmentation exits with error %d !\n", ret);
+
+    m_segmentation->NotifyExit(AUDIOTYPE);
 }
 
 int32_t OmafPackage::OmafPacketStream(uint8_t streamIdx, FrameBSInfo *frameInfo)
@@ -587,10 +601,17 @@ int32_t OmafPackage::OmafPacketStream(uint8_t streamIdx, FrameBSInfo *frameInfo)
     //}
     //printf("\n");
 
-    int32_t ret = SetFrameInfo(streamIdx, frameInfo);
+    int32_t ret = WaitForQueueSpace(streamIdx);
     if (ret)
         return ret;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ret = SetFrameInfo(streamIdx, frameInfo);
+    if (ret)
+        return ret;
+
+    m_inputFrmNum[streamIdx]++;
+
     if (!m_isSegmentationStarted)
     {
         uint32_t vsNum = 0;
@@ -670,4 +691,122 @@ int32_t OmafPackage::OmafEndStreams()
     return ERROR_NONE;
 }
 
+int32_t OmafPackage::SetMaxQueuedFrames(uint32_t maxFrames)
+{
+    if (!m_initInfo || !(m_initInfo->segmentationInfo))
+        return OMAF_ERROR_NULL_PTR;
+
+    if (maxFrames && (maxFrames < (uint32_t)(m_initInfo->segmentationInfo->needBufedFrames)))
+    {
+        OMAF_LOG(LOG_ERROR, "Max queued frames %d is less than frames number %d needed to be buffered !\n",
+            maxFrames, m_initInfo->segmentationInfo->needBufedFrames);
+        return OMAF_ERROR_BAD_PARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxQueuedFrames = maxFrames;
+
+    return ERROR_NONE;
+}
+
+uint64_t OmafPackage::GetSegmentedFrmNum()
+{
+    if (!m_segmentation)
+        return 0;
+
+    return (m_segmentation->GetSegmentedVideoFrmNum() + m_segmentation->GetSegmentedAudioFrmNum());
+}
+
+int32_t OmafPackage::WaitForQueueSpace(uint8_t streamIdx)
+{
+    uint32_t maxFrames = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // frames must be buffered before segmentation starts
+        if (!m_isSegmentationStarted || !m_maxQueuedFrames)
+            return ERROR_NONE;
+
+        maxFrames = m_maxQueuedFrames;
+    }
+
+    std::map<uint8_t, MediaStream*>::iterator itStream = m_streams.find(streamIdx);
+    if (itStream == m_streams.end() || !(itStream->second))
+        return OMAF_ERROR_STREAM_NOT_FOUND;
+
+    MediaStream *stream = itStream->second;
+    MediaType mediaType = stream->GetMediaType();
+    if ((mediaType != VIDEOTYPE) && (mediaType != AUDIOTYPE))
+        return OMAF_ERROR_MEDIA_TYPE;
+
+    // woken up each time segmentation takes frames from the queues
+    int32_t ret = m_segmentation->WaitForProgress(mediaType, [stream, mediaType, maxFrames]() {
+        uint32_t bufedFrmNum = (mediaType == VIDEOTYPE) ?
+            ((VideoStream*)stream)->GetBufferedFrameNum() : ((AudioStream*)stream)->GetBufferedFrameNum();
+        return (bufedFrmNum < maxFrames);
+    });
+    if (ret)
+    {
+        OMAF_LOG(LOG_ERROR, "Frame queue of stream %d is full and segmentation has exited !\n", streamIdx);
+        return ret;
+    }
+
+    return ERROR_NONE;
+}
+
+int32_t OmafPackage::OmafFlushStreams()
+{
+    uint64_t videoFrmNum = 0;
+    uint64_t audioFrmNum = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_segmentation)
+            return OMAF_ERROR_NULL_PTR;
+
+        if (!m_isSegmentationStarted)
+        {
+            OMAF_LOG(LOG_ERROR, "Segmentation hasn't started, which needs %d buffered frames for each stream !\n",
+                m_initInfo->segmentationInfo->needBufedFrames);
+            return OMAF_ERROR_OPERATION;
+        }
+
+        // all video streams are segmented frame by frame together,
+        // while audio frames are counted over all audio streams
+        std::map<uint8_t, uint64_t>::iterator it;
+        for (it = m_inputFrmNum.begin(); it != m_inputFrmNum.end(); it++)
+        {
+            MediaStream *stream = m_streams[it->first];
+            if (stream && (stream->GetMediaType() == VIDEOTYPE))
+            {
+                if (it->second > videoFrmNum)
+                    videoFrmNum = it->second;
+            }
+            else if (stream && (stream->GetMediaType() == AUDIOTYPE))
+            {
+                audioFrmNum += it->second;
+            }
+        }
+    }
+
+    Segmentation *segmentation = m_segmentation;
+    int32_t ret = segmentation->WaitForProgress(VIDEOTYPE, [segmentation, videoFrmNum]() {
+        return (segmentation->GetSegmentedVideoFrmNum() >= videoFrmNum);
+    });
+    if (ret)
+    {
+        OMAF_LOG(LOG_ERROR, "Video segmentation has exited before all frames are flushed !\n");
+        return ret;
+    }
+
+    ret = segmentation->WaitForProgress(AUDIOTYPE, [segmentation, audioFrmNum]() {
+        return (segmentation->GetSegmentedAudioFrmNum() >= audioFrmNum);
+    });
+    if (ret)
+    {
+        OMAF_LOG(LOG_ERROR, "Audio segmentation has exited before all frames are flushed !\n");
+        return ret;
+    }
+
+    return ERROR_NONE;
+}
+
 VCD_NS_END
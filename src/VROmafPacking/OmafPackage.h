@@ -42,6 +42,7 @@
 #include "ExtractorTrackManager.h"
 
 #include <map>
+#include <mutex>
 
 VCD_NS_BEGIN
 
@@ -110,6 +111,40 @@ public:
     //!
     int32_t OmafEndStreams();
 
+    //!
+    //! \brief  Set the max number of frames queued for each stream,
+    //!         OmafPacketStream blocks when the queue of the stream
+    //!         is full after segmentation is started, so that input
+    //!         can't run too far ahead of segmentation
+    //!
+    //! \param  [in] maxFrames
+    //!         the max number of queued frames, 0 means no limit,
+    //!         else it can't be less than frames number needed to
+    //!         be buffered before segmentation starts
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t SetMaxQueuedFrames(uint32_t maxFrames);
+
+    //!
+    //! \brief  Wait until all frames which have been input are
+    //!         written into segments
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t OmafFlushStreams();
+
+    //!
+    //! \brief  Get the number of frames which have been segmented
+    //!         for both video streams and audio streams
+    //!
+    //! \return uint64_t
+    //!         the number of segmented frames
+    //!
+    uint64_t GetSegmentedFrmNum();
+
 private:
 
     //!
@@ -176,6 +211,18 @@ private:
     //!
     int32_t SetFrameInfo(uint8_t streamIdx, FrameBSInfo *frameInfo);
 
+    //!
+    //! \brief  Wait until there is space in frame queue of the
+    //!         stream when the max number of queued frames is set
+    //!
+    //! \param  [in] streamIdx
+    //!         the index of the stream to be handled
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t WaitForQueueSpace(uint8_t streamIdx);
+
     //!
     //! \brief  Segment all video media streams
     //!
@@ -203,6 +250,9 @@ private:
     bool                            m_hasChunkDurCorrected;    //!< whether CMAF chunk duration has been corrected
     bool                            m_hasViewSEI;              //!< whether input video stream has NovelViewSEI
     PackingSourceMode               m_sourceMode;              //!< the source mode for packing
+    std::mutex                      m_mutex;                   //!< mutex for frames input from different threads
+    uint32_t                        m_maxQueuedFrames;         //!< max number of queued frames for each stream, 0 means no limit
+    std::map<uint8_t, uint64_t>     m_inputFrmNum;             //!< map of stream index and its number of input frames
 };
 
 VCD_NS_END;
@@ -52,6 +52,10 @@ Segmentation::Segmentation()
     m_mpdWriterPluginPath = NULL;
     m_mpdWriterPluginName = NULL;
     m_mpdWriterPluginHdl  = NULL;
+    m_segedVideoFrmNum    = 0;
+    m_segedAudioFrmNum    = 0;
+    m_videoExited         = false;
+    m_audioExited         = false;
 }
 
 Segmentation::Segmentation(
@@ -76,6 +80,10 @@ Segmentation::Segmentation(
     m_mpdWriterPluginPath = initInfo->mpdWriterPluginPath;
     m_mpdWriterPluginName = initInfo->mpdWriterPluginName;
     m_mpdWriterPluginHdl  = NULL;
+    m_segedVideoFrmNum    = 0;
+    m_segedAudioFrmNum    = 0;
+    m_videoExited         = false;
+    m_audioExited         = false;
 }
 
 Segmentation::Segmentation(const Segmentation& src)
@@ -95,6 +103,10 @@ Segmentation::Segmentation(const Segmentation& src)
     m_mpdWriterPluginPath = std::move(src.m_mpdWriterPluginPath);
     m_mpdWriterPluginName = std::move(src.m_mpdWriterPluginName);
     m_mpdWriterPluginHdl  = std::move(src.m_mpdWriterPluginHdl);
+    m_segedVideoFrmNum    = src.m_segedVideoFrmNum.load();
+    m_segedAudioFrmNum    = src.m_segedAudioFrmNum.load();
+    m_videoExited         = src.m_videoExited;
+    m_audioExited         = src.m_audioExited;
 }
 
 Segmentation& Segmentation::operator=(Segmentation&& other)
@@ -114,6 +126,10 @@ Segmentation& Segmentation::operator=(Segmentation&& other)
     m_mpdWriterPluginPath = std::move(other.m_mpdWriterPluginPath);
     m_mpdWriterPluginName = std::move(other.m_mpdWriterPluginName);
     m_mpdWriterPluginHdl  = std::move(other.m_mpdWriterPluginHdl);
+    m_segedVideoFrmNum    = other.m_segedVideoFrmNum.load();
+    m_segedAudioFrmNum    = other.m_segedAudioFrmNum.load();
+    m_videoExited         = other.m_videoExited;
+    m_audioExited         = other.m_audioExited;
 
     return *this;
 }
@@ -242,4 +258,41 @@ int32_t Segmentation::Initialize()
     return ERROR_NONE;
 }
 
+int32_t Segmentation::WaitForProgress(MediaType mediaType, const std::function<bool()>& isDone)
+{
+    std::unique_lock<std::mutex> lock(m_progressMutex);
+    while (!isDone())
+    {
+        bool exited = (mediaType == VIDEOTYPE) ? m_videoExited : m_audioExited;
+        if (exited)
+            return OMAF_ERROR_OPERATION;
+
+        m_progressCond.wait(lock);
+    }
+
+    return ERROR_NONE;
+}
+
+void Segmentation::NotifyExit(MediaType mediaType)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        if (mediaType == VIDEOTYPE)
+            m_videoExited = true;
+        else
+            m_audioExited = true;
+    }
+    m_progressCond.notify_all();
+}
+
+void Segmentation::NotifyProgress()
+{
+    // taking the mutex orders the progress before a waiter's check,
+    // so that the wakeup can't be lost
+    {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+    }
+    m_progressCond.notify_all();
+}
+
 VCD_NS_END
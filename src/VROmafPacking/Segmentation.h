@@ -37,6 +37,11 @@
 #ifndef _SEGMENTATION_H_
 #define _SEGMENTATION_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
 #include "MediaStream.h"
 #include "ExtractorTrackManager.h"
 //#include "MpdGenerator.h"
@@ -124,6 +129,58 @@ public:
     //!
     virtual int32_t AudioEndSegmentation() = 0;
 
+    //!
+    //! \brief  Get the number of video frames which have been
+    //!         written into segments for all video streams
+    //!
+    //! \return uint64_t
+    //!         number of segmented video frames
+    //!
+    uint64_t GetSegmentedVideoFrmNum() { return m_segedVideoFrmNum.load(); };
+
+    //!
+    //! \brief  Get the number of audio frames which have been
+    //!         written into segments, counted over all audio streams
+    //!
+    //! \return uint64_t
+    //!         number of segmented audio frames
+    //!
+    uint64_t GetSegmentedAudioFrmNum() { return m_segedAudioFrmNum.load(); };
+
+    //!
+    //! \brief  Block until the condition is met, which is checked
+    //!         again each time segmentation takes frames from the
+    //!         stream queues or writes frames into segments
+    //!
+    //! \param  [in] mediaType
+    //!         media type whose segmentation the condition depends on
+    //! \param  [in] isDone
+    //!         the condition to wait for
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if the condition is met, OMAF_ERROR_OPERATION
+    //!         if segmentation of the media type has exited before
+    //!
+    int32_t WaitForProgress(MediaType mediaType, const std::function<bool()>& isDone);
+
+    //!
+    //! \brief  Mark segmentation of the media type as exited and
+    //!         wake up all waiters, called when the segmentation
+    //!         thread ends
+    //!
+    //! \param  [in] mediaType
+    //!         media type whose segmentation has exited
+    //!
+    void NotifyExit(MediaType mediaType);
+
+protected:
+    //!
+    //! \brief  Wake up all waiters in WaitForProgress, called after
+    //!         frames are taken from the stream queues or written
+    //!         into segments
+    //!
+    void NotifyProgress();
+
 private:
 
     //!
@@ -157,6 +214,12 @@ protected:
     const char                      *m_mpdWriterPluginPath;
     const char                      *m_mpdWriterPluginName;
     void                            *m_mpdWriterPluginHdl;
+    std::atomic<uint64_t>           m_segedVideoFrmNum;     //!< number of video frames written into segments for all video streams
+    std::atomic<uint64_t>           m_segedAudioFrmNum;     //!< number of audio frames written into segments
+    std::mutex                      m_progressMutex;        //!< mutex for m_progressCond
+    std::condition_variable         m_progressCond;         //!< signalled when segmentation makes progress or exits
+    bool                            m_videoExited;          //!< whether video segmentation thread has exited
+    bool                            m_audioExited;          //!< whether audio segmentation thread has exited
 };
 
 VCD_NS_END;
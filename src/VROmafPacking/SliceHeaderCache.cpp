@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   SliceHeaderCache.cpp
+//! \brief:  Slice header cache class implementation
+//!
+//! Created on Nov 21, 2022, 2:15 PM
+//!
+
+#include <string.h>
+
+#include "SliceHeaderCache.h"
+#include "../utils/safe_mem.h"
+
+VCD_NS_BEGIN
+
+SliceHeaderCache::SliceHeaderCache()
+{
+    m_hitsNum = 0;
+    m_missesNum = 0;
+}
+
+SliceHeaderCache::~SliceHeaderCache()
+{
+    m_entries.clear();
+}
+
+bool SliceHeaderCache::Lookup(
+    const SliceHeaderKey &key,
+    const uint8_t *srcHdr,
+    uint32_t srcHdrLen,
+    uint8_t *dstHdr,
+    uint32_t dstCapacity,
+    uint32_t *dstHdrLen)
+{
+    if (!srcHdr || !srcHdrLen || !dstHdr || !dstHdrLen)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<SliceHeaderKey, SliceHeaderEntry>::iterator it = m_entries.find(key);
+    if ((it == m_entries.end()) ||
+        (it->second.srcHdr.size() != srcHdrLen) ||
+        (it->second.dstHdr.size() > dstCapacity) ||
+        memcmp(it->second.srcHdr.data(), srcHdr, srcHdrLen))
+    {
+        m_missesNum++;
+        return false;
+    }
+
+    memcpy_s(dstHdr, dstCapacity, it->second.dstHdr.data(), it->second.dstHdr.size());
+    *dstHdrLen = (uint32_t)(it->second.dstHdr.size());
+    m_hitsNum++;
+    return true;
+}
+
+void SliceHeaderCache::Store(
+    const SliceHeaderKey &key,
+    const uint8_t *srcHdr,
+    uint32_t srcHdrLen,
+    const uint8_t *dstHdr,
+    uint32_t dstHdrLen)
+{
+    if (!srcHdr || !srcHdrLen || !dstHdr || !dstHdrLen)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SliceHeaderEntry &entry = m_entries[key];
+    entry.srcHdr.assign(srcHdr, srcHdr + srcHdrLen);
+    entry.dstHdr.assign(dstHdr, dstHdr + dstHdrLen);
+}
+
+VCD_NS_END
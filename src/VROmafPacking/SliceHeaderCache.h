@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   SliceHeaderCache.h
+//! \brief:  Slice header cache class definition
+//! \detail: Rewritten slice headers of extractors are cached by the source
+//!          tile and its position in the packed picture, so that extractor
+//!          tracks which merge the same tile at the same place reuse the
+//!          header rewritten by the first one instead of calling 360SCVP.
+//!
+//! Created on Nov 21, 2022, 2:15 PM
+//!
+
+#ifndef _SLICEHEADERCACHE_H_
+#define _SLICEHEADERCACHE_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "VROmafPacking_def.h"
+#include "ns_def.h"
+
+VCD_NS_BEGIN
+
+//!
+//! \struct: SliceHeaderKey
+//! \brief:  define the position of one source tile in the packed picture
+//!
+struct SliceHeaderKey
+{
+    uint8_t  streamIdx;    //!< index of the video stream the tile belongs to
+    uint8_t  origTileIdx;  //!< index of the tile in the video stream
+    uint16_t ctuIdx;       //!< the first CTU index of the tile in the packed picture
+    uint32_t dstWidth;     //!< width of the packed picture
+    uint32_t dstHeight;    //!< height of the packed picture
+
+    bool operator<(const SliceHeaderKey &other) const
+    {
+        if (streamIdx != other.streamIdx)
+            return streamIdx < other.streamIdx;
+        if (origTileIdx != other.origTileIdx)
+            return origTileIdx < other.origTileIdx;
+        if (ctuIdx != other.ctuIdx)
+            return ctuIdx < other.ctuIdx;
+        if (dstWidth != other.dstWidth)
+            return dstWidth < other.dstWidth;
+        return dstHeight < other.dstHeight;
+    }
+};
+
+//!
+//! \class SliceHeaderCache
+//! \brief Define the cache of rewritten slice headers shared by all
+//!        extractor tracks. The rewritten header only depends on the
+//!        source slice header bytes and the key, so one entry is reused
+//!        only when the source bytes are identical to the cached ones.
+//!        It is thread safe since extractor tracks are segmented in
+//!        parallel
+//!
+
+class SliceHeaderCache
+{
+public:
+    //!
+    //! \brief  Constructor
+    //!
+    SliceHeaderCache();
+
+    //!
+    //! \brief  Destructor
+    //!
+    ~SliceHeaderCache();
+
+    //!
+    //! \brief  Look up the rewritten slice header for the source header
+    //!
+    //! \param  [in] key
+    //!         position of the source tile in the packed picture
+    //! \param  [in] srcHdr
+    //!         pointer to the source slice header bytes
+    //! \param  [in] srcHdrLen
+    //!         size of the source slice header bytes
+    //! \param  [out] dstHdr
+    //!         pointer to the buffer for the rewritten slice header
+    //! \param  [in] dstCapacity
+    //!         size of the buffer for the rewritten slice header
+    //! \param  [out] dstHdrLen
+    //!         size of the rewritten slice header
+    //!
+    //! \return bool
+    //!         true if the rewritten slice header is found, else false
+    //!
+    bool Lookup(
+        const SliceHeaderKey &key,
+        const uint8_t *srcHdr,
+        uint32_t srcHdrLen,
+        uint8_t *dstHdr,
+        uint32_t dstCapacity,
+        uint32_t *dstHdrLen);
+
+    //!
+    //! \brief  Store the rewritten slice header for the source header,
+    //!         the former entry for the same key is replaced
+    //!
+    //! \param  [in] key
+    //!         position of the source tile in the packed picture
+    //! \param  [in] srcHdr
+    //!         pointer to the source slice header bytes
+    //! \param  [in] srcHdrLen
+    //!         size of the source slice header bytes
+    //! \param  [in] dstHdr
+    //!         pointer to the rewritten slice header
+    //! \param  [in] dstHdrLen
+    //!         size of the rewritten slice header
+    //!
+    void Store(
+        const SliceHeaderKey &key,
+        const uint8_t *srcHdr,
+        uint32_t srcHdrLen,
+        const uint8_t *dstHdr,
+        uint32_t dstHdrLen);
+
+    //!
+    //! \brief  Get the number of lookups which found the header
+    //!
+    uint64_t GetHitsNum() { return m_hitsNum.load(); };
+
+    //!
+    //! \brief  Get the number of lookups which didn't find the header
+    //!
+    uint64_t GetMissesNum() { return m_missesNum.load(); };
+
+private:
+    //!
+    //! \struct: SliceHeaderEntry
+    //! \brief:  define one source slice header and its rewritten one
+    //!
+    struct SliceHeaderEntry
+    {
+        std::vector<uint8_t> srcHdr;
+        std::vector<uint8_t> dstHdr;
+    };
+
+    std::mutex                                   m_mutex;      //!< mutex for the entries
+    std::map<SliceHeaderKey, SliceHeaderEntry>   m_entries;    //!< cached slice headers for each tile position
+    std::atomic<uint64_t>                        m_hitsNum;    //!< number of lookups which found the header
+    std::atomic<uint64_t>                        m_missesNum;  //!< number of lookups which didn't find the header
+};
+
+VCD_NS_END;
+#endif /* _SLICEHEADERCACHE_H_ */
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   TaskPool.cpp
+//! \brief:  Implement TaskPool class
+//!
+//! Created on Nov 14, 2022, 10:20 AM
+//!
+
+#include <sched.h>
+#include <unistd.h>
+
+#include "TaskPool.h"
+#include "OmafPackingLog.h"
+#include "error.h"
+
+VCD_NS_BEGIN
+
+TaskPool::TaskPool()
+{
+    m_nextWorker = 0;
+    m_launchedNum = 0;
+    m_pendingNum = 0;
+    m_stop = false;
+}
+
+TaskPool::~TaskPool()
+{
+    Stop();
+
+    std::vector<TaskQueue*>::iterator it;
+    for (it = m_queues.begin(); it != m_queues.end(); it++)
+    {
+        TaskQueue *queue = *it;
+        DELETE_MEMORY(queue);
+    }
+    m_queues.clear();
+}
+
+int32_t TaskPool::Initialize(uint32_t threadsNum)
+{
+    if (m_threads.size())
+        return OMAF_ERROR_OPERATION;
+
+    if (threadsNum == 0)
+    {
+        long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+        threadsNum = (cpuNum > 0) ? (uint32_t)cpuNum : 1;
+    }
+
+    for (uint32_t i = 0; i < threadsNum; i++)
+    {
+        TaskQueue *queue = new TaskQueue;
+        if (!queue)
+            return OMAF_ERROR_NULL_PTR;
+
+        m_queues.push_back(queue);
+    }
+
+    for (uint32_t i = 0; i < threadsNum; i++)
+    {
+        pthread_t threadId;
+        int32_t ret = pthread_create(&threadId, NULL, WorkerThread, this);
+        if (ret)
+        {
+            OMAF_LOG(LOG_ERROR, "Failed to create task pool worker thread !\n");
+            Stop();
+            return OMAF_ERROR_CREATE_THREAD;
+        }
+        m_threads.push_back(threadId);
+    }
+
+    return ERROR_NONE;
+}
+
+std::future<int32_t> TaskPool::Submit(Task task)
+{
+    std::packaged_task<int32_t()> packagedTask(task);
+    std::future<int32_t> result = packagedTask.get_future();
+
+    if (m_queues.empty())
+    {
+        // no worker, run the task in caller thread
+        packagedTask();
+        return result;
+    }
+
+    uint32_t workerIdx = m_nextWorker.fetch_add(1) % (uint32_t)(m_queues.size());
+    TaskQueue *queue = m_queues[workerIdx];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(std::move(packagedTask));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingNum++;
+    }
+    m_cond.notify_one();
+
+    return result;
+}
+
+int32_t TaskPool::RunAll(std::vector<Task>& tasks)
+{
+    std::vector<std::future<int32_t>> results;
+    results.reserve(tasks.size());
+
+    std::vector<Task>::iterator itTask;
+    for (itTask = tasks.begin(); itTask != tasks.end(); itTask++)
+    {
+        results.push_back(Submit(*itTask));
+    }
+
+    // wait for all tasks even if some one fails, since
+    // tasks may refer to data owned by the caller
+    int32_t ret = ERROR_NONE;
+    std::vector<std::future<int32_t>>::iterator itResult;
+    for (itResult = results.begin(); itResult != results.end(); itResult++)
+    {
+        int32_t taskRet = itResult->get();
+        if (taskRet && (ret == ERROR_NONE))
+        {
+            ret = taskRet;
+        }
+    }
+
+    return ret;
+}
+
+void TaskPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_all();
+
+    std::vector<pthread_t>::iterator it;
+    for (it = m_threads.begin(); it != m_threads.end(); it++)
+    {
+        pthread_join(*it, NULL);
+    }
+    m_threads.clear();
+}
+
+bool TaskPool::PopTask(uint32_t workerIdx, std::packaged_task<int32_t()>& task)
+{
+    uint32_t queuesNum = (uint32_t)(m_queues.size());
+    for (uint32_t i = 0; i < queuesNum; i++)
+    {
+        TaskQueue *queue = m_queues[(workerIdx + i) % queuesNum];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->tasks.empty())
+            continue;
+
+        // take tasks from front of own queue, and steal
+        // from back of other queues
+        if (i == 0)
+        {
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(queue->tasks.back());
+            queue->tasks.pop_back();
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void *TaskPool::WorkerThread(void *pThis)
+{
+    TaskPool *taskPool = (TaskPool*)pThis;
+
+    uint32_t workerIdx = taskPool->m_launchedNum.fetch_add(1);
+    taskPool->WorkerLoop(workerIdx);
+
+    return NULL;
+}
+
+void TaskPool::WorkerLoop(uint32_t workerIdx)
+{
+    while (1)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop && (m_pendingNum == 0))
+            {
+                m_cond.wait(lock);
+            }
+            if (m_pendingNum == 0)
+                break;
+
+            m_pendingNum--;
+        }
+
+        // one pending task has been reserved for this worker,
+        // so it must be in one of the queues
+        std::packaged_task<int32_t()> task;
+        while (!PopTask(workerIdx, task))
+        {
+            sched_yield();
+        }
+
+        task();
+    }
+}
+
+VCD_NS_END
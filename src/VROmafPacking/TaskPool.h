@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   TaskPool.h
+//! \brief:  Task pool class definition
+//! \detail: Define the work stealing task pool used to run segmentation
+//!          tasks, like segmenting each extractor track for one frame,
+//!          in parallel.
+//!
+//! Created on Nov 14, 2022, 10:20 AM
+//!
+
+#ifndef _TASKPOOL_H_
+#define _TASKPOOL_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "VROmafPacking_def.h"
+#include "ns_def.h"
+
+VCD_NS_BEGIN
+
+//!
+//! \class TaskPool
+//! \brief Define the work stealing task pool. Each worker thread has its
+//!        own task queue, submitted tasks are spread over the queues and
+//!        idle workers steal tasks from the other queues, so that workers
+//!        never busy wait and heavier tasks don't stall the others
+//!
+
+class TaskPool
+{
+public:
+    typedef std::function<int32_t()> Task;
+
+    //!
+    //! \brief  Constructor
+    //!
+    TaskPool();
+
+    //!
+    //! \brief  Destructor
+    //!
+    ~TaskPool();
+
+    //!
+    //! \brief  Launch worker threads
+    //!
+    //! \param  [in] threadsNum
+    //!         number of worker threads, 0 means the number
+    //!         of online processors
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t Initialize(uint32_t threadsNum);
+
+    //!
+    //! \brief  Submit one task into the pool
+    //!
+    //! \param  [in] task
+    //!         the task to be run
+    //!
+    //! \return std::future<int32_t>
+    //!         future which gets the return value of the task
+    //!
+    std::future<int32_t> Submit(Task task);
+
+    //!
+    //! \brief  Run all tasks in the pool and wait for them
+    //!         to be done
+    //!
+    //! \param  [in] tasks
+    //!         tasks to be run
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if all tasks succeed, else the failed
+    //!         reason of the first failed task
+    //!
+    int32_t RunAll(std::vector<Task>& tasks);
+
+    //!
+    //! \brief  Stop and join all worker threads, tasks which
+    //!         have been submitted are run before stopping
+    //!
+    //! \return void
+    //!
+    void Stop();
+
+    //!
+    //! \brief  Get number of worker threads
+    //!
+    //! \return uint32_t
+    //!         number of worker threads
+    //!
+    uint32_t GetThreadsNum() { return (uint32_t)(m_threads.size()); };
+
+private:
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    //!
+    //! \brief  Get one task from own queue, or steal one
+    //!         from other queues
+    //!
+    //! \param  [in] workerIdx
+    //!         index of the worker which gets the task
+    //! \param  [out] task
+    //!         the task which is gotten
+    //!
+    //! \return bool
+    //!         true if one task is gotten, else false
+    //!
+    bool PopTask(uint32_t workerIdx, std::packaged_task<int32_t()>& task);
+
+    //!
+    //! \brief  Worker thread function
+    //!
+    //! \param  [in] pThis
+    //!         this TaskPool
+    //!
+    //! \return void*
+    //!         return NULL
+    //!
+    static void* WorkerThread(void *pThis);
+
+    //!
+    //! \brief  Run tasks until the pool is stopped
+    //!
+    //! \param  [in] workerIdx
+    //!         index of the worker
+    //!
+    //! \return void
+    //!
+    void WorkerLoop(uint32_t workerIdx);
+
+    struct TaskQueue
+    {
+        std::mutex                                  mutex;
+        std::deque<std::packaged_task<int32_t()>>   tasks;
+    };
+
+private:
+    std::vector<TaskQueue*>     m_queues;         //!< task queue of each worker
+    std::vector<pthread_t>      m_threads;        //!< worker threads
+    std::atomic<uint32_t>       m_nextWorker;     //!< queue index which next task is pushed into
+    std::atomic<uint32_t>       m_launchedNum;    //!< number of workers which have gotten their index
+    std::mutex                  m_mutex;          //!< mutex for pending tasks number and stop flag
+    std::condition_variable     m_cond;           //!< condition for idle workers
+    uint64_t                    m_pendingNum;     //!< number of tasks which haven't been popped
+    bool                        m_stop;           //!< whether the pool is stopping
+};
+
+VCD_NS_END;
+#endif /* _TASKPOOL_H_ */
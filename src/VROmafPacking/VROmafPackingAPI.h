@@ -92,6 +92,39 @@ int32_t VROmafPackingSetLogCallBack(Handler hdl, void* externalLog);
 //!
 int32_t VROmafPackingWriteSegment(Handler hdl, uint8_t streamIdx, FrameBSInfo *frameInfo);
 
+//!
+//! \brief  VR OMAF Packing library sets the max number of frames
+//!         queued for each media stream. Frames are queued by
+//!         VROmafPackingWriteSegment and segmented asynchronously,
+//!         with all video streams segmented in parallel. When the
+//!         max number is set, VROmafPackingWriteSegment blocks while
+//!         the queue of the stream is full, so that frames of
+//!         different streams need to be input interleavedly
+//!
+//! \param  [in] hdl
+//!         VR OMAF Packing library handle
+//! \param  [in] maxFrames
+//!         the max number of queued frames for each stream, 0 means
+//!         no limit which is the default, else it can't be less than
+//!         needBufedFrames in segmentation information
+//!
+//! \return int32_t
+//!         ERROR_NONE if success, else failed reason
+//!
+int32_t VROmafPackingSetMaxQueuedFrames(Handler hdl, uint32_t maxFrames);
+
+//!
+//! \brief  VR OMAF Packing library waits until all frames input
+//!         by VROmafPackingWriteSegment are written into segments
+//!
+//! \param  [in] hdl
+//!         VR OMAF Packing library handle
+//!
+//! \return int32_t
+//!         ERROR_NONE if success, else failed reason
+//!
+int32_t VROmafPackingFlush(Handler hdl);
+
 //!
 //! \brief  VR OMAF Packing library ends the processing
 //!         for all media streams, called when there is
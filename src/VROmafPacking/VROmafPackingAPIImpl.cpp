@@ -97,6 +97,32 @@ int32_t VROmafPackingWriteSegment(Handler hdl, uint8_t streamIdx, FrameBSInfo *f
     return ERROR_NONE;
 }
 
+int32_t VROmafPackingSetMaxQueuedFrames(Handler hdl, uint32_t maxFrames)
+{
+    OmafPackage *omafPackage = (OmafPackage*)hdl;
+    if (!omafPackage)
+        return OMAF_ERROR_NULL_PTR;
+
+    int32_t ret = omafPackage->SetMaxQueuedFrames(maxFrames);
+    if (ret)
+        return ret;
+
+    return ERROR_NONE;
+}
+
+int32_t VROmafPackingFlush(Handler hdl)
+{
+    OmafPackage *omafPackage = (OmafPackage*)hdl;
+    if (!omafPackage)
+        return OMAF_ERROR_NULL_PTR;
+
+    int32_t ret = omafPackage->OmafFlushStreams();
+    if (ret)
+        return ret;
+
+    return ERROR_NONE;
+}
+
 int32_t VROmafPackingEndStreams(Handler hdl)
 {
     OmafPackage *omafPackage = (OmafPackage*)hdl;
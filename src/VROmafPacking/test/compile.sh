@@ -14,6 +14,9 @@ g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashW
 g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -c testVideoStream.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -c testExtractorTrack.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -c testDefaultSegmentation.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -c testTaskPool.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -c testSliceHeaderCache.cpp -D_GLIBCXX_USE_CXX11_ABI=0
+g++ -I../ -I./vs_plugin -I../../plugins/DashWriter_Plugin/ -I../../plugins/DashWriter_Plugin/common/ -I../../google_test/ -std=c++11 -g -O2 -c testPackingPerf.cpp -D_GLIBCXX_USE_CXX11_ABI=0
 
 LD_FLAGS="-L/usr/local/lib -lVROmafPacking -l360SCVP -lHevcVideoStreamProcess -lHevcVideoStreamProcessEx -ldl -lstdc++ -lpthread -lm -L/usr/local/lib"
 
@@ -21,10 +24,16 @@ g++ -L/usr/local/lib testHevcNaluParser.o libgtest.a -o testHevcNaluParser ${LD_
 g++ -L/usr/local/lib testVideoStream.o libgtest.a -o testVideoStream ${LD_FLAGS}
 g++ -L/usr/local/lib testExtractorTrack.o libgtest.a -o testExtractorTrack ${LD_FLAGS}
 g++ -L/usr/local/lib testDefaultSegmentation.o libgtest.a -o testDefaultSegmentation ${LD_FLAGS}
+g++ -L/usr/local/lib testTaskPool.o libgtest.a -o testTaskPool ${LD_FLAGS}
+g++ -L/usr/local/lib testSliceHeaderCache.o libgtest.a -o testSliceHeaderCache ${LD_FLAGS}
+g++ -L/usr/local/lib testPackingPerf.o libgtest.a -o testPackingPerf ${LD_FLAGS}
 
 ./testHevcNaluParser
 ./testVideoStream
 ./testExtractorTrack
 ./testDefaultSegmentation
+./testTaskPool
+./testSliceHeaderCache
+./testPackingPerf
 
 rm -rf vs_plugin
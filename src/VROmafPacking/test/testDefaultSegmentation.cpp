@@ -31,6 +31,8 @@
 //! Created on April 30, 2019, 6:04 AM
 //!
 
+#include <atomic>
+#include <thread>
 #include "gtest/gtest.h"
 #include "../OmafPackage.h"
 #include "DashSegmentWriterPluginAPI.h"
@@ -265,6 +267,26 @@ public:
         DELETE_MEMORY(m_omafPackage);
     }
 
+    //! stream 0 is the low resolution one and stream 1 is the high resolution one
+    int32_t PushFrame(uint8_t streamIdx, uint8_t frameIdx)
+    {
+        uint64_t frameSize[2][5] = { { 97161, 39, 544, 44, 1980 }, { 101531, 159, 613, 170, 1684 } };
+        uint64_t offset = 0;
+        for (uint8_t i = 0; i < frameIdx; i++)
+        {
+            offset += frameSize[streamIdx][i];
+        }
+
+        FrameBSInfo frame;
+        memset_s(&frame, sizeof(FrameBSInfo), 0);
+        frame.data = (streamIdx ? m_totalDataHigh : m_totalDataLow) + offset;
+        frame.dataSize = frameSize[streamIdx][frameIdx];
+        frame.pts = frameIdx;
+        frame.isKeyFrame = (frameIdx == 0);
+
+        return m_omafPackage->OmafPacketStream(streamIdx, &frame);
+    }
+
     InitialInfo                     *m_initInfo;
     uint8_t                         *m_highResHeader;
     uint8_t                         *m_lowResHeader;
@@ -366,4 +388,88 @@ TEST_F(DefaultSegmentationTest, AllProcess)
         EXPECT_TRUE(buf.st_size != 0);
     }
 }
+
+TEST_F(DefaultSegmentationTest, BlockedPushResumes)
+{
+    int32_t ret = m_omafPackage->SetMaxQueuedFrames(1);
+    EXPECT_TRUE(ret == ERROR_NONE);
+
+    // segmentation takes the 2nd frame of stream 0 only after the 1st
+    // frame of stream 1 comes, so pushing the 3rd frame blocks
+    std::atomic<bool> pushed(false);
+    int32_t producerRet = ERROR_NONE;
+    std::thread producer([this, &pushed, &producerRet]() {
+        for (uint8_t frameIdx = 0; frameIdx < 3; frameIdx++)
+        {
+            producerRet = PushFrame(0, frameIdx);
+            if (producerRet)
+                break;
+        }
+        pushed = true;
+    });
+
+    usleep(200000);
+    EXPECT_FALSE(pushed.load());
+
+    ret = PushFrame(1, 0);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    EXPECT_TRUE(producerRet == ERROR_NONE);
+
+    for (uint8_t frameIdx = 1; frameIdx < 5; frameIdx++)
+    {
+        if (frameIdx >= 3)
+        {
+            ret = PushFrame(0, frameIdx);
+            EXPECT_TRUE(ret == ERROR_NONE);
+        }
+        ret = PushFrame(1, frameIdx);
+        EXPECT_TRUE(ret == ERROR_NONE);
+    }
+
+    ret = m_omafPackage->OmafFlushStreams();
+    EXPECT_TRUE(ret == ERROR_NONE);
+    EXPECT_TRUE(m_omafPackage->GetSegmentedFrmNum() == 5);
+
+    ret = m_omafPackage->OmafEndStreams();
+    EXPECT_TRUE(ret == ERROR_NONE);
+}
+
+TEST_F(DefaultSegmentationTest, FlushDrainsAllStreams)
+{
+    int32_t ret = ERROR_NONE;
+    for (uint8_t frameIdx = 0; frameIdx < 5; frameIdx++)
+    {
+        ret = PushFrame(0, frameIdx);
+        EXPECT_TRUE(ret == ERROR_NONE);
+        if (frameIdx < 4)
+        {
+            ret = PushFrame(1, frameIdx);
+            EXPECT_TRUE(ret == ERROR_NONE);
+        }
+    }
+
+    // the last frame of stream 1 is missing, so flush can't finish
+    std::atomic<bool> flushed(false);
+    int32_t flushRet = ERROR_NONE;
+    std::thread flusher([this, &flushed, &flushRet]() {
+        flushRet = m_omafPackage->OmafFlushStreams();
+        flushed = true;
+    });
+
+    usleep(200000);
+    EXPECT_FALSE(flushed.load());
+    EXPECT_TRUE(m_omafPackage->GetSegmentedFrmNum() < 5);
+
+    ret = PushFrame(1, 4);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    flusher.join();
+    EXPECT_TRUE(flushed.load());
+    EXPECT_TRUE(flushRet == ERROR_NONE);
+    EXPECT_TRUE(m_omafPackage->GetSegmentedFrmNum() == 5);
+
+    ret = m_omafPackage->OmafEndStreams();
+    EXPECT_TRUE(ret == ERROR_NONE);
+}
 }
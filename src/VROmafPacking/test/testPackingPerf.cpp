@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   testPackingPerf.cpp
+//! \brief:  Packing throughput benchmark
+//! \detail: Drive VROmafPackingInit / VROmafPackingWriteSegment with the
+//!          tiled HEVC streams in this directory, or the ones set by the
+//!          environment variables below, and report frames per second,
+//!          time of each stage, heap allocations and bytes written.
+//!
+//!          PACKING_PERF_HIGH_RES    high resolution tiled HEVC stream
+//!          PACKING_PERF_LOW_RES     low resolution tiled HEVC stream
+//!          PACKING_PERF_FRAMES      number of frames to pack, input
+//!                                   streams are looped, default 250
+//!          PACKING_PERF_FPS         frame rate of input streams, default 25
+//!          PACKING_PERF_CMAF        1 to generate CMAF segments, default 0
+//!          PACKING_PERF_VIEWPORT    viewport "width x height x hFOV x vFOV",
+//!                                   which decides the extractor tracks,
+//!                                   default "1024x1024x80x90"
+//!          PACKING_PERF_OUT_DIR     output directory, default on tmpfs
+//!                                   "/dev/shm/omaf_packing_perf/"
+//!
+//!          Input streams should start with an IDR frame and have the
+//!          same GOP structure. The resolution and tile grid are those of
+//!          the input streams.
+//!
+//! Created on Nov 24, 2022, 10:05 AM
+//!
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "../VROmafPackingAPI.h"
+#include "error.h"
+
+static std::atomic<uint64_t> g_allocNum(0);
+static std::atomic<uint64_t> g_allocBytes(0);
+
+//! count heap allocations of the whole process, including the ones in
+//! VROmafPacking library and plugins
+void* operator new(size_t size)
+{
+    g_allocNum++;
+    g_allocBytes += size;
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace {
+
+#define HEVC_NALU_TYPE_VPS        32
+#define HEVC_NALU_TYPE_AUD        35
+#define HEVC_NALU_TYPE_PREFIX_SEI 39
+#define HEVC_NALU_TYPE_IRAP_FIRST 16
+#define HEVC_NALU_TYPE_IRAP_LAST  23
+
+struct PerfFrame
+{
+    uint64_t offset;
+    uint64_t size;
+    bool     isKeyFrame;
+};
+
+struct PerfStream
+{
+    std::vector<uint8_t>   data;
+    std::vector<PerfFrame> frames;
+    uint64_t               headerSize;
+};
+
+static uint32_t GetEnvUint(const char *name, uint32_t defaultValue)
+{
+    const char *value = getenv(name);
+    if (!value || !(*value))
+        return defaultValue;
+
+    return (uint32_t)strtoul(value, NULL, 10);
+}
+
+static const char* GetEnvStr(const char *name, const char *defaultValue)
+{
+    const char *value = getenv(name);
+    if (!value || !(*value))
+        return defaultValue;
+
+    return value;
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! split Annex-B HEVC stream into access units, one access unit starts
+//! from VPS/AUD/prefix SEI ahead of slices, or from the slice whose
+//! first_slice_segment_in_pic_flag is set
+static bool LoadStream(const char *fileName, PerfStream *stream)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (!fp)
+        return false;
+
+    fseek(fp, 0, SEEK_END);
+    long fileSize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (fileSize <= 0)
+    {
+        fclose(fp);
+        return false;
+    }
+
+    stream->data.resize(fileSize);
+    size_t readSize = fread(stream->data.data(), 1, fileSize, fp);
+    fclose(fp);
+    if (readSize != (size_t)fileSize)
+        return false;
+
+    const uint8_t *data = stream->data.data();
+    uint64_t size = stream->data.size();
+    bool hasSlice = false;
+    bool isKeyFrame = false;
+    bool auStarted = false;
+    uint64_t auStart = 0;
+    stream->headerSize = 0;
+    stream->frames.clear();
+
+    for (uint64_t pos = 0; pos + 5 < size; pos++)
+    {
+        if (data[pos] || data[pos + 1] || data[pos + 2] != 1)
+            continue;
+
+        uint64_t naluStart = (pos > 0 && !data[pos - 1]) ? (pos - 1) : pos;
+        uint8_t naluType = (data[pos + 3] >> 1) & 0x3f;
+        bool isSlice = (naluType < HEVC_NALU_TYPE_VPS);
+        bool newAU = false;
+        if (isSlice)
+        {
+            bool firstSliceInPic = (data[pos + 5] & 0x80) != 0;
+            newAU = hasSlice && firstSliceInPic;
+        }
+        else if ((naluType >= HEVC_NALU_TYPE_VPS && naluType <= HEVC_NALU_TYPE_AUD) ||
+            (naluType == HEVC_NALU_TYPE_PREFIX_SEI))
+        {
+            newAU = hasSlice;
+        }
+
+        if (newAU)
+        {
+            PerfFrame frame = { auStart, naluStart - auStart, isKeyFrame };
+            stream->frames.push_back(frame);
+            auStart = naluStart;
+            hasSlice = false;
+            isKeyFrame = false;
+        }
+        else if (!auStarted)
+        {
+            auStart = naluStart;
+        }
+        auStarted = true;
+
+        if (isSlice)
+        {
+            if (!hasSlice && stream->frames.empty())
+                stream->headerSize = naluStart;
+            hasSlice = true;
+            if (naluType >= HEVC_NALU_TYPE_IRAP_FIRST && naluType <= HEVC_NALU_TYPE_IRAP_LAST)
+                isKeyFrame = true;
+        }
+        pos += 2;
+    }
+
+    if (hasSlice)
+    {
+        PerfFrame frame = { auStart, size - auStart, isKeyFrame };
+        stream->frames.push_back(frame);
+    }
+
+    return !stream->frames.empty() && stream->headerSize && stream->frames[0].isKeyFrame;
+}
+
+static uint64_t CleanOutputDir(const char *dirName, bool removeFiles)
+{
+    uint64_t totalBytes = 0;
+    DIR *dir = opendir(dirName);
+    if (!dir)
+        return 0;
+
+    struct dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        std::string path = std::string(dirName) + entry->d_name;
+        struct stat fileStat;
+        if (stat(path.c_str(), &fileStat) || !S_ISREG(fileStat.st_mode))
+            continue;
+
+        totalBytes += fileStat.st_size;
+        if (removeFiles)
+            remove(path.c_str());
+    }
+    closedir(dir);
+
+    return totalBytes;
+}
+
+class PackingPerfTest : public testing::Test
+{
+public:
+    virtual void SetUp()
+    {
+        m_framesNum = GetEnvUint("PACKING_PERF_FRAMES", 250);
+        m_frameRate = GetEnvUint("PACKING_PERF_FPS", 25);
+        m_cmafEnabled = GetEnvUint("PACKING_PERF_CMAF", 0) != 0;
+        m_outDir = GetEnvStr("PACKING_PERF_OUT_DIR", "/dev/shm/omaf_packing_perf/");
+        if (m_outDir.back() != '/')
+            m_outDir += "/";
+
+        m_viewportWidth = 1024;
+        m_viewportHeight = 1024;
+        m_hFOV = 80;
+        m_vFOV = 90;
+        const char *viewport = GetEnvStr("PACKING_PERF_VIEWPORT", NULL);
+        if (viewport)
+        {
+            sscanf(viewport, "%ux%ux%ux%u", &m_viewportWidth, &m_viewportHeight, &m_hFOV, &m_vFOV);
+        }
+
+        m_loaded = LoadStream(GetEnvStr("PACKING_PERF_LOW_RES", "1920x960_10frames.h265"), &m_lowRes) &&
+                   LoadStream(GetEnvStr("PACKING_PERF_HIGH_RES", "3840x1920_10frames.h265"), &m_highRes);
+
+        mkdir(m_outDir.c_str(), 0777);
+        CleanOutputDir(m_outDir.c_str(), true);
+    }
+
+    virtual void TearDown()
+    {
+        CleanOutputDir(m_outDir.c_str(), true);
+    }
+
+    void FillInitInfo(InitialInfo *initInfo, BSBuffer *bsBuffers, SegmentationInfo *segInfo, ViewportInformation *vpInfo)
+    {
+        PerfStream *streams[2] = { &m_lowRes, &m_highRes };
+        for (uint8_t idx = 0; idx < 2; idx++)
+        {
+            uint64_t avgFrameSize = streams[idx]->data.size() / streams[idx]->frames.size();
+            bsBuffers[idx].data = streams[idx]->data.data();
+            bsBuffers[idx].dataSize = streams[idx]->headerSize;
+            bsBuffers[idx].mediaType = MediaType::VIDEOTYPE;
+            bsBuffers[idx].codecId = CodecId::CODEC_ID_H265;
+            bsBuffers[idx].bitRate = avgFrameSize * 8 * m_frameRate;
+            bsBuffers[idx].frameRate.num = m_frameRate;
+            bsBuffers[idx].frameRate.den = 1;
+        }
+
+        segInfo->needBufedFrames = 0;
+        segInfo->segDuration = 1;
+        segInfo->dirName = m_outDir.c_str();
+        segInfo->outName = "Test";
+        segInfo->baseUrl = NULL;
+        segInfo->utcTimingUrl = NULL;
+        segInfo->isLive = false;
+        if (m_cmafEnabled)
+        {
+            segInfo->chunkDuration = 1000 / m_frameRate * 5;
+            segInfo->chunkInfoType = E_NO_CHUNKINFO;
+        }
+
+        vpInfo->viewportWidth      = m_viewportWidth;
+        vpInfo->viewportHeight     = m_viewportHeight;
+        vpInfo->viewportPitch      = 0;
+        vpInfo->viewportYaw        = 90;
+        vpInfo->horizontalFOVAngle = m_hFOV;
+        vpInfo->verticalFOVAngle   = m_vFOV;
+        vpInfo->outGeoType         = E_SVIDEO_VIEWPORT;
+        vpInfo->inGeoType          = E_SVIDEO_EQUIRECT;
+
+        initInfo->bsNumVideo = 2;
+        initInfo->bsNumAudio = 0;
+        initInfo->bsBuffers = bsBuffers;
+        initInfo->packingPluginPath = "/usr/local/lib";
+        initInfo->packingPluginName = "HighResPlusFullLowResPacking";
+        initInfo->videoProcessPluginPath = "/usr/local/lib";
+        initInfo->videoProcessPluginName = "HevcVideoStreamProcess";
+        initInfo->cmafEnabled = m_cmafEnabled;
+        initInfo->segWriterPluginPath = "/usr/local/lib";
+        initInfo->segWriterPluginName = "SegmentWriter";
+        initInfo->mpdWriterPluginPath = "/usr/local/lib";
+        initInfo->mpdWriterPluginName = "MPDWriter";
+        initInfo->segmentationInfo = segInfo;
+        initInfo->viewportInfo = vpInfo;
+        initInfo->projType = E_SVIDEO_EQUIRECT;
+    }
+
+    uint32_t     m_framesNum;
+    uint32_t     m_frameRate;
+    bool         m_cmafEnabled;
+    std::string  m_outDir;
+    uint32_t     m_viewportWidth;
+    uint32_t     m_viewportHeight;
+    uint32_t     m_hFOV;
+    uint32_t     m_vFOV;
+    bool         m_loaded;
+    PerfStream   m_lowRes;
+    PerfStream   m_highRes;
+};
+
+TEST_F(PackingPerfTest, Throughput)
+{
+    ASSERT_TRUE(m_loaded);
+    ASSERT_TRUE(m_lowRes.frames.size() == m_highRes.frames.size());
+    ASSERT_TRUE(m_framesNum > 0);
+
+    InitialInfo initInfo;
+    BSBuffer bsBuffers[2];
+    SegmentationInfo segInfo;
+    ViewportInformation vpInfo;
+    memset(&initInfo, 0, sizeof(InitialInfo));
+    memset(bsBuffers, 0, sizeof(bsBuffers));
+    memset(&segInfo, 0, sizeof(SegmentationInfo));
+    memset(&vpInfo, 0, sizeof(ViewportInformation));
+    FillInitInfo(&initInfo, bsBuffers, &segInfo, &vpInfo);
+
+    uint64_t allocNumStart = g_allocNum;
+    uint64_t allocBytesStart = g_allocBytes;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Handler hdl = VROmafPackingInit(&initInfo);
+    double initMs = ElapsedMs(start);
+    ASSERT_TRUE(hdl != NULL);
+
+    uint64_t allocNumInit = g_allocNum;
+
+    PerfStream *streams[2] = { &m_lowRes, &m_highRes };
+    uint64_t inputBytes = 0;
+    int32_t ret = ERROR_NONE;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t frameIdx = 0; frameIdx < m_framesNum; frameIdx++)
+    {
+        for (uint8_t streamIdx = 0; streamIdx < 2; streamIdx++)
+        {
+            PerfStream *stream = streams[streamIdx];
+            PerfFrame &frame = stream->frames[frameIdx % stream->frames.size()];
+
+            FrameBSInfo frameInfo;
+            frameInfo.data = stream->data.data() + frame.offset;
+            frameInfo.dataSize = frame.size;
+            frameInfo.pts = frameIdx;
+            frameInfo.isKeyFrame = frame.isKeyFrame;
+            inputBytes += frame.size;
+
+            ret = VROmafPackingWriteSegment(hdl, streamIdx, &frameInfo);
+            EXPECT_TRUE(ret == ERROR_NONE);
+        }
+    }
+    double feedMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    ret = VROmafPackingFlush(hdl);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    double flushMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    ret = VROmafPackingEndStreams(hdl);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    double endMs = ElapsedMs(start);
+
+    uint64_t allocNumPacking = g_allocNum - allocNumInit;
+
+    start = std::chrono::steady_clock::now();
+    ret = VROmafPackingClose(hdl);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    double closeMs = ElapsedMs(start);
+
+    uint64_t outputBytes = CleanOutputDir(m_outDir.c_str(), false);
+    double packingMs = feedMs + flushMs + endMs;
+    double fps = packingMs > 0 ? (m_framesNum * 1000.0 / packingMs) : 0;
+
+    printf("[ PERF     ] frames %u, cmaf %d, viewport %ux%u fov %ux%u, output %s\n",
+        m_framesNum, m_cmafEnabled, m_viewportWidth, m_viewportHeight, m_hFOV, m_vFOV, m_outDir.c_str());
+    printf("[ PERF     ] throughput %.2f frames/s, %.2f MB/s input\n",
+        fps, packingMs > 0 ? (inputBytes / packingMs / 1000.0) : 0);
+    printf("[ PERF     ] init %.2f ms, feed %.2f ms, flush %.2f ms, end %.2f ms, close %.2f ms\n",
+        initMs, feedMs, flushMs, endMs, closeMs);
+    printf("[ PERF     ] allocations %lu (%lu bytes) in total, %.2f per frame while packing\n",
+        (unsigned long)(g_allocNum - allocNumStart), (unsigned long)(g_allocBytes - allocBytesStart),
+        (double)allocNumPacking / m_framesNum);
+    printf("[ PERF     ] bytes written %lu, input bytes %lu\n",
+        (unsigned long)outputBytes, (unsigned long)inputBytes);
+
+    EXPECT_TRUE(outputBytes > 0);
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   testSliceHeaderCache.cpp
+//! \brief:  Slice header cache class unit test
+//!
+//! Created on Nov 21, 2022, 2:15 PM
+//!
+
+#include "gtest/gtest.h"
+#include "../SliceHeaderCache.h"
+
+VCD_USE_VRVIDEO;
+
+namespace {
+
+static SliceHeaderKey MakeKey(uint8_t streamIdx, uint8_t origTileIdx, uint16_t ctuIdx)
+{
+    SliceHeaderKey key;
+    key.streamIdx   = streamIdx;
+    key.origTileIdx = origTileIdx;
+    key.ctuIdx      = ctuIdx;
+    key.dstWidth    = 3840;
+    key.dstHeight   = 1920;
+    return key;
+}
+
+TEST(SliceHeaderCacheTest, ReuseIdenticalHeader)
+{
+    SliceHeaderCache cache;
+    uint8_t srcHdr[8] = { 0x02, 0x01, 0xd0, 0x0a, 0x5c, 0x31, 0x80, 0x00 };
+    uint8_t dstHdr[10] = { 0, 0, 0, 1, 0x02, 0x01, 0x40, 0x12, 0x88, 0x80 };
+    uint8_t output[256] = { 0 };
+    uint32_t outputLen = 0;
+
+    SliceHeaderKey key = MakeKey(0, 5, 120);
+    EXPECT_FALSE(cache.Lookup(key, srcHdr, sizeof(srcHdr), output, sizeof(output), &outputLen));
+
+    cache.Store(key, srcHdr, sizeof(srcHdr), dstHdr, sizeof(dstHdr));
+    EXPECT_TRUE(cache.Lookup(key, srcHdr, sizeof(srcHdr), output, sizeof(output), &outputLen));
+    EXPECT_TRUE(outputLen == sizeof(dstHdr));
+    EXPECT_TRUE(0 == memcmp(output, dstHdr, sizeof(dstHdr)));
+
+    EXPECT_TRUE(cache.GetHitsNum() == 1);
+    EXPECT_TRUE(cache.GetMissesNum() == 1);
+}
+
+TEST(SliceHeaderCacheTest, MissOnDifferentHeaderOrPosition)
+{
+    SliceHeaderCache cache;
+    uint8_t srcHdr[8] = { 0x02, 0x01, 0xd0, 0x0a, 0x5c, 0x31, 0x80, 0x00 };
+    uint8_t dstHdr[10] = { 0, 0, 0, 1, 0x02, 0x01, 0x40, 0x12, 0x88, 0x80 };
+    uint8_t output[256] = { 0 };
+    uint32_t outputLen = 0;
+
+    SliceHeaderKey key = MakeKey(0, 5, 120);
+    cache.Store(key, srcHdr, sizeof(srcHdr), dstHdr, sizeof(dstHdr));
+
+    // next frame has different POC bits in the source header
+    uint8_t nextHdr[8] = { 0x02, 0x01, 0xd0, 0x0a, 0x5e, 0x31, 0x80, 0x00 };
+    EXPECT_FALSE(cache.Lookup(key, nextHdr, sizeof(nextHdr), output, sizeof(output), &outputLen));
+    EXPECT_FALSE(cache.Lookup(key, srcHdr, sizeof(srcHdr) - 1, output, sizeof(output), &outputLen));
+
+    // same tile placed at another position
+    SliceHeaderKey otherKey = MakeKey(0, 5, 60);
+    EXPECT_FALSE(cache.Lookup(otherKey, srcHdr, sizeof(srcHdr), output, sizeof(output), &outputLen));
+    otherKey = MakeKey(0, 5, 120);
+    otherKey.dstWidth = 2560;
+    EXPECT_FALSE(cache.Lookup(otherKey, srcHdr, sizeof(srcHdr), output, sizeof(output), &outputLen));
+
+    // output buffer which can't hold the cached header
+    EXPECT_FALSE(cache.Lookup(key, srcHdr, sizeof(srcHdr), output, 4, &outputLen));
+
+    // the latest stored header replaces the former one
+    cache.Store(key, nextHdr, sizeof(nextHdr), dstHdr, sizeof(dstHdr));
+    EXPECT_TRUE(cache.Lookup(key, nextHdr, sizeof(nextHdr), output, sizeof(output), &outputLen));
+    EXPECT_FALSE(cache.Lookup(key, srcHdr, sizeof(srcHdr), output, sizeof(output), &outputLen));
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//!
+//! \file:   testTaskPool.cpp
+//! \brief:  Task pool class unit test
+//!
+//! Created on Nov 14, 2022, 10:20 AM
+//!
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "gtest/gtest.h"
+#include "../TaskPool.h"
+#include "error.h"
+
+VCD_USE_VRVIDEO;
+
+namespace {
+
+TEST(TaskPoolTest, RunAllTasks)
+{
+    TaskPool taskPool;
+    int32_t ret = taskPool.Initialize(4);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    EXPECT_TRUE(taskPool.GetThreadsNum() == 4);
+
+    for (uint32_t frameIdx = 0; frameIdx < 100; frameIdx++)
+    {
+        std::atomic<uint32_t> doneNum(0);
+        std::vector<TaskPool::Task> tasks;
+        for (uint32_t i = 0; i < 24; i++)
+        {
+            tasks.push_back([&doneNum]() { doneNum++; return (int32_t)ERROR_NONE; });
+        }
+
+        ret = taskPool.RunAll(tasks);
+        EXPECT_TRUE(ret == ERROR_NONE);
+        EXPECT_TRUE(doneNum == 24);
+    }
+}
+
+TEST(TaskPoolTest, HeavyTasksAreStolen)
+{
+    TaskPool taskPool;
+    int32_t ret = taskPool.Initialize(4);
+    EXPECT_TRUE(ret == ERROR_NONE);
+
+    // tasks are pushed to queues round robin, so all heavy
+    // tasks land in the same queue unless they are stolen.
+    // each heavy task waits until all heavy tasks have been
+    // started, which only happens when they are run by
+    // different workers
+    std::mutex heavyMutex;
+    std::condition_variable heavyCond;
+    std::set<std::thread::id> heavyThreads;
+    uint32_t startedNum = 0;
+    std::vector<TaskPool::Task> tasks;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (i % 4)
+        {
+            tasks.push_back([]() { return (int32_t)ERROR_NONE; });
+            continue;
+        }
+
+        tasks.push_back([&heavyMutex, &heavyCond, &heavyThreads, &startedNum]() {
+            std::unique_lock<std::mutex> lock(heavyMutex);
+            heavyThreads.insert(std::this_thread::get_id());
+            startedNum++;
+            heavyCond.notify_all();
+            bool allStarted = heavyCond.wait_for(lock, std::chrono::seconds(5),
+                [&startedNum]() { return startedNum == 4; });
+            return allStarted ? (int32_t)ERROR_NONE : (int32_t)OMAF_ERROR_TIMED_OUT;
+        });
+    }
+
+    ret = taskPool.RunAll(tasks);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    EXPECT_TRUE(heavyThreads.size() == 4);
+}
+
+TEST(TaskPoolTest, ReturnFirstError)
+{
+    TaskPool taskPool;
+    int32_t ret = taskPool.Initialize(0);
+    EXPECT_TRUE(ret == ERROR_NONE);
+    EXPECT_TRUE(taskPool.GetThreadsNum() > 0);
+
+    std::atomic<uint32_t> doneNum(0);
+    std::vector<TaskPool::Task> tasks;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        int32_t taskRet = (i == 3) ? OMAF_ERROR_INVALID_DATA : ERROR_NONE;
+        tasks.push_back([&doneNum, taskRet]() { doneNum++; return taskRet; });
+    }
+
+    ret = taskPool.RunAll(tasks);
+    EXPECT_TRUE(ret == OMAF_ERROR_INVALID_DATA);
+    EXPECT_TRUE(doneNum == 8);
+
+    taskPool.Stop();
+    EXPECT_TRUE(taskPool.GetThreadsNum() == 0);
+}
+
+}
@@ -40,6 +40,8 @@ VCD_MP4_BEGIN
 
 Stream::Stream()
     : m_storage()
+    , m_borrowedData(nullptr)
+    , m_borrowedSize(0)
     , m_currByte(0)
     , m_byteOffset(0)
     , m_bitOffset(0)
@@ -49,6 +51,8 @@ Stream::Stream()
 
 Stream::Stream(const std::vector<std::uint8_t>& strData)
     : m_storage(strData)
+    , m_borrowedData(nullptr)
+    , m_borrowedSize(0)
     , m_currByte(0)
     , m_byteOffset(0)
     , m_bitOffset(0)
@@ -58,6 +62,8 @@ Stream::Stream(const std::vector<std::uint8_t>& strData)
 
 Stream::Stream(Stream&& other)
     : m_storage(std::move(other.m_storage))
+    , m_borrowedData(other.m_borrowedData)
+    , m_borrowedSize(other.m_borrowedSize)
     , m_currByte(other.m_currByte)
     , m_byteOffset(other.m_byteOffset)
     , m_bitOffset(other.m_bitOffset)
@@ -67,6 +73,8 @@ Stream::Stream(Stream&& other)
     other.m_byteOffset       = {};
     other.m_bitOffset        = {};
     other.m_storageAllocated = {};
+    other.m_borrowedData     = nullptr;
+    other.m_borrowedSize     = 0;
     other.m_storage.clear();
 }
 
@@ -77,6 +85,10 @@ Stream& Stream::operator=(Stream&& other)
     m_bitOffset        = other.m_bitOffset;
     m_storageAllocated = other.m_storageAllocated;
     m_storage          = std::move(other.m_storage);
+    m_borrowedData     = other.m_borrowedData;
+    m_borrowedSize     = other.m_borrowedSize;
+    other.m_borrowedData = nullptr;
+    other.m_borrowedSize = 0;
     return *this;
 }
 
@@ -95,20 +107,45 @@ bool Stream::IsByteAligned() const
 
 std::uint64_t Stream::GetSize() const
 {
-    std::uint64_t size = m_storage.size();
+    std::uint64_t size = GetDataSize();
     return size;
 }
 
 void Stream::SetSize(const std::uint64_t newSize)
 {
+    PrepareWrite();
     m_storage.resize(newSize);
 }
 
 const std::vector<std::uint8_t>& Stream::GetStorage() const
 {
+    if (m_borrowedData)
+    {
+        // content is unchanged, only the place holding it
+        m_storage.assign(m_borrowedData, m_borrowedData + m_borrowedSize);
+        m_borrowedData = nullptr;
+        m_borrowedSize = 0;
+    }
     return m_storage;
 }
 
+void Stream::BorrowData(const std::uint8_t* data, const std::uint64_t size)
+{
+    m_storage.clear();
+    m_borrowedData = data;
+    m_borrowedSize = size;
+}
+
+void Stream::OwnData()
+{
+    GetStorage();
+}
+
+bool Stream::IsBorrowed() const
+{
+    return m_borrowedData != nullptr;
+}
+
 void Stream::Reset()
 {
     m_currByte   = 0;
@@ -119,6 +156,8 @@ void Stream::Reset()
 void Stream::Clear()
 {
     m_storage.clear();
+    m_borrowedData = nullptr;
+    m_borrowedSize = 0;
 }
 
 void Stream::SkipBytes(const std::uint64_t x)
@@ -128,12 +167,13 @@ void Stream::SkipBytes(const std::uint64_t x)
 
 void Stream::SetByte(const std::uint64_t offset, const std::uint8_t byte)
 {
+    PrepareWrite();
     m_storage.at(offset) = byte;
 }
 
 std::uint8_t Stream::GetByte(const std::uint64_t offset) const
 {
-    std::uint8_t ret = m_storage.at(offset);
+    std::uint8_t ret = GetDataByte(offset);
     return ret;
 }
 
@@ -146,16 +186,23 @@ std::uint64_t Stream::ReadAtomHeaders(FourCCInt& type)
 
 std::uint64_t Stream::BytesRemain() const
 {
-    return m_storage.size() - m_byteOffset;
+    return GetDataSize() - m_byteOffset;
 }
 void Stream::Extract(const std::uint64_t begin, const std::uint64_t end, Stream& dest) const
 {
     dest.Clear();
     dest.Reset();
-    if (begin <= m_storage.size() && end <= m_storage.size() && begin <= end)
+    if (begin <= GetDataSize() && end <= GetDataSize() && begin <= end)
     {
-        dest.m_storage.insert(dest.m_storage.begin(), m_storage.begin() + static_cast<std::int64_t>(begin),
-                                m_storage.begin() + static_cast<std::int64_t>(end));
+        if (m_borrowedData)
+        {
+            dest.BorrowData(m_borrowedData + begin, end - begin);
+        }
+        else
+        {
+            dest.m_storage.insert(dest.m_storage.begin(), m_storage.begin() + static_cast<std::int64_t>(begin),
+                                    m_storage.begin() + static_cast<std::int64_t>(end));
+        }
     }
     else
     {
@@ -166,17 +213,20 @@ void Stream::Extract(const std::uint64_t begin, const std::uint64_t end, Stream&
 
 void Stream::WriteStream(const Stream& str)
 {
-    m_storage.insert(m_storage.end(), str.m_storage.begin(), str.m_storage.end());
+    PrepareWrite();
+    m_storage.insert(m_storage.end(), str.GetData(), str.GetData() + str.GetDataSize());
 }
 
 
 void Stream::Write8(const std::uint8_t bits)
 {
+    PrepareWrite();
     m_storage.push_back(bits);
 }
 
 void Stream::Write16(const std::uint16_t bits)
 {
+    PrepareWrite();
     for (int i=8;i>=0;)
     {
         m_storage.push_back(static_cast<uint8_t>((bits >> i) & 0xff));
@@ -186,6 +236,7 @@ void Stream::Write16(const std::uint16_t bits)
 
 void Stream::Write24(const std::uint32_t bits)
 {
+    PrepareWrite();
     for (int i=16;i>=0;)
     {
         m_storage.push_back(static_cast<uint8_t>((bits >> i) & 0xff));
@@ -195,6 +246,7 @@ void Stream::Write24(const std::uint32_t bits)
 
 void Stream::Write32(const std::uint32_t bits)
 {
+    PrepareWrite();
     for (int i=24;i>=0;)
     {
         m_storage.push_back(static_cast<uint8_t>((bits >> i) & 0xff));
@@ -204,6 +256,7 @@ void Stream::Write32(const std::uint32_t bits)
 
 void Stream::Write64(const std::uint64_t bits)
 {
+    PrepareWrite();
     for (int i=56;i>=0;)
     {
         m_storage.push_back(static_cast<uint8_t>((bits >> i) & 0xff));
@@ -218,6 +271,7 @@ void Stream::WriteArray(const std::vector<std::uint8_t>& bits,
     // if len was not given, add everything until end of the vector
     auto copyLen = len == UINT64_MAX ? (bits.size() - srcOffset) : len;
 
+    PrepareWrite();
     m_storage.insert(m_storage.end(), bits.begin() + static_cast<std::int64_t>(srcOffset),
                     bits.begin() + static_cast<std::int64_t>(srcOffset + copyLen));
 }
@@ -230,6 +284,7 @@ void Stream::Write1(std::uint64_t bits, std::uint32_t len)
     }
     else
     {
+        PrepareWrite();
         do
         {
             const unsigned int pLeftByte = 8 - m_bitOffset;
@@ -263,6 +318,7 @@ void Stream::WriteString(const std::string& srcString)
         ISO_LOG(LOG_WARNING, "Stream::WriteString called for zero-length string.\n");
     }
 
+    PrepareWrite();
     for (const auto character : srcString)
     {
         m_storage.push_back(static_cast<unsigned char>(character));
@@ -271,6 +327,7 @@ void Stream::WriteString(const std::string& srcString)
 
 void Stream::WriteZeroEndString(const std::string& srcString)
 {
+    PrepareWrite();
     for (const auto character : srcString)
     {
         m_storage.push_back(static_cast<unsigned char>(character));
@@ -306,61 +363,61 @@ float Stream::ReadFloat32()
 
 std::uint8_t Stream::Read8()
 {
-    const std::uint8_t ret = m_storage.at(m_byteOffset);
+    const std::uint8_t ret = GetDataByte(m_byteOffset);
     ++m_byteOffset;
     return ret;
 }
 
 std::uint16_t Stream::Read16()
 {
-    std::uint16_t ret = m_storage.at(m_byteOffset);
+    std::uint16_t ret = GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
     return ret;
 }
 
 std::uint32_t Stream::Read24()
 {
-    unsigned int ret = m_storage.at(m_byteOffset);
+    unsigned int ret = GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
     return ret;
 }
 
 std::uint32_t Stream::Read32()
 {
-    unsigned int ret = m_storage.at(m_byteOffset);
+    unsigned int ret = GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
     return ret;
 }
 
 std::uint64_t Stream::Read64()
 {
-    unsigned long long int ret = m_storage.at(m_byteOffset);
+    unsigned long long int ret = GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
-    ret = (ret << 8) | m_storage.at(m_byteOffset);
+    ret = (ret << 8) | GetDataByte(m_byteOffset);
     m_byteOffset++;
 
     return ret;
@@ -368,10 +425,9 @@ std::uint64_t Stream::Read64()
 
 void Stream::ReadArray(std::vector<std::uint8_t>& bits, const std::uint64_t len)
 {
-    if (static_cast<std::size_t>(m_byteOffset + len) <= m_storage.size())
+    if (static_cast<std::size_t>(m_byteOffset + len) <= GetDataSize())
     {
-        bits.insert(bits.end(), m_storage.begin() + static_cast<std::int64_t>(m_byteOffset),
-                    m_storage.begin() + static_cast<std::int64_t>(m_byteOffset + len));
+        bits.insert(bits.end(), GetData() + m_byteOffset, GetData() + m_byteOffset + len);
         m_byteOffset += len;
     }
     else
@@ -383,9 +439,9 @@ void Stream::ReadArray(std::vector<std::uint8_t>& bits, const std::uint64_t len)
 
 void Stream::ReadByteArrayToBuffer(char* buffer, const std::uint64_t len)
 {
-    if (static_cast<std::size_t>(m_byteOffset + len) <= m_storage.size())
+    if (static_cast<std::size_t>(m_byteOffset + len) <= GetDataSize())
     {
-        std::memcpy(buffer, m_storage.data() + m_byteOffset, len);
+        std::memcpy(buffer, GetData() + m_byteOffset, len);
         m_byteOffset += len;
     }
     else
@@ -407,28 +463,28 @@ std::uint32_t Stream::Read1(const std::uint32_t len)
 
     if (pLeftByte >= len)
     {
-        retBits = (unsigned int) ((m_storage).at(m_byteOffset) >> (pLeftByte - len)) &
+        retBits = (unsigned int) (GetDataByte(m_byteOffset) >> (pLeftByte - len)) &
                         (unsigned int) ((1 << len) - 1);
         m_bitOffset += (unsigned int) len;
     }
     else
     {
         std::uint32_t pBitsGo = len - pLeftByte;
-        retBits                = (m_storage).at(m_byteOffset) & (((unsigned int) 1 << pLeftByte) - 1);
+        retBits                = GetDataByte(m_byteOffset) & (((unsigned int) 1 << pLeftByte) - 1);
         m_byteOffset++;
         m_bitOffset = 0;
         while (pBitsGo > 0)
         {
             if (pBitsGo >= 8)
             {
-                retBits = (retBits << 8) | (m_storage).at(m_byteOffset);
+                retBits = (retBits << 8) | GetDataByte(m_byteOffset);
                 m_byteOffset++;
                 pBitsGo -= 8;
             }
             else
             {
                 retBits = (retBits << pBitsGo) |
-                                ((unsigned int) ((m_storage).at(m_byteOffset) >> (8 - pBitsGo)) &
+                                ((unsigned int) (GetDataByte(m_byteOffset) >> (8 - pBitsGo)) &
                                 (((unsigned int) 1 << pBitsGo) - 1));
                 m_bitOffset += (unsigned int) (pBitsGo);
                 pBitsGo = 0;
@@ -470,7 +526,7 @@ void Stream::ReadZeroEndString(std::string& pDst)
     std::uint8_t pCurr = 0xff;
     pDst.clear();
 
-    while (m_byteOffset < m_storage.size())
+    while (m_byteOffset < GetDataSize())
     {
         pCurr = Read8();
         if ((char) pCurr != '\0')
@@ -35,6 +35,7 @@
 #define BITSTREAM_H
 
 #include <cstdint>
+#include <stdexcept>
 #include "FormAllocator.h"
 #include "../include/Common.h"
 #include "FourCCInt.h"
@@ -102,6 +103,36 @@ public:
     //!
     const std::vector<std::uint8_t>& GetStorage() const;
 
+    //!
+    //! \brief    Borrow Data, let the stream read an external read-only
+    //!           memory without copy, the memory must stay valid while
+    //!           the stream or any sub stream extracted from it is used
+    //!
+    //! \param    [in] const std::uint8_t*
+    //!           data to borrow
+    //! \param    [in] std::uint64_t
+    //!           size of the data
+    //!
+    //! \return   void
+    //!
+    void BorrowData(const std::uint8_t* data, std::uint64_t size);
+
+    //!
+    //! \brief    Own Data, copy borrowed data into own storage so that
+    //!           the stream can outlive the borrowed memory
+    //!
+    //! \return   void
+    //!
+    void OwnData();
+
+    //!
+    //! \brief    Is Borrowed or not
+    //!
+    //! \return   bool
+    //!           whether the stream reads borrowed memory
+    //!
+    bool IsBorrowed() const;
+
     //!
     //! \brief Reset function
     //!
@@ -474,7 +505,36 @@ public:
     bool IsByteAligned() const;
 
 private:
-    std::vector<std::uint8_t> m_storage;    //!< storage
+    const std::uint8_t* GetData() const
+    {
+        return m_borrowedData ? m_borrowedData : m_storage.data();
+    }
+
+    std::uint64_t GetDataSize() const
+    {
+        return m_borrowedData ? m_borrowedSize : m_storage.size();
+    }
+
+    std::uint8_t GetDataByte(std::uint64_t offset) const
+    {
+        if (offset >= GetDataSize())
+        {
+            throw std::out_of_range("Stream read out of range");
+        }
+        return GetData()[offset];
+    }
+
+    void PrepareWrite()
+    {
+        if (m_borrowedData)
+        {
+            OwnData();
+        }
+    }
+
+    mutable std::vector<std::uint8_t> m_storage;    //!< storage, filled from borrowed data on GetStorage
+    mutable const std::uint8_t* m_borrowedData;     //!< borrowed read-only data, null if not borrowed
+    mutable std::uint64_t m_borrowedSize;           //!< size of borrowed data
     unsigned int m_currByte;                //!< current byte postion
     std::uint64_t m_byteOffset;             //!< byte offset
     unsigned int m_bitOffset;               //!< bit offset
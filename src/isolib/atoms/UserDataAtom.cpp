@@ -87,6 +87,8 @@ void UserDataAtom::FromStream(Stream& str)
     {
         FourCCInt AtomType;
         Stream subBitstr = str.ReadSubAtomStream(AtomType);
+        // kept after parsing, so it must not borrow the parsed buffer
+        subBitstr.OwnData();
 
         m_bitStreams[AtomType] = std::move(subBitstr);
     }
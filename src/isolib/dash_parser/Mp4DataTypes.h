@@ -740,6 +740,17 @@ struct SegmentProperties
 typedef std::map<SegmentId, SegmentProperties> SegPropMap;
 typedef std::map<Sequence, SegmentId> SeqToSegMap;
 
+struct SampleTable       ///< flat sample table of one track in one parsed segment
+{
+    SegmentId segmentId;
+    ItemId itemIdBase;
+    SegmentIO* io = nullptr;                   ///< owned by the segment properties
+    std::vector<uint64_t> dataOffsets;
+    std::vector<uint32_t> dataLengths;
+    std::vector<FourCCInt> codeTypes;          ///< 0 if decoder code type is unknown
+};
+typedef std::vector<SampleTable> SampleTableVector;  ///< ordered by itemIdBase
+
 struct InitSegmentProperties
 {
     FileProperty fileProperty;
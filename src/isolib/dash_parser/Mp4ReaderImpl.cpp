@@ -345,6 +345,135 @@ void Mp4Reader::RefreshCompTimes(InitSegmentId initSegId, SegmentId segIndex)
     }
 }
 
+void Mp4Reader::BuildSampTables(InitSegmentId initSegId, SegmentId segIndex)
+{
+    DropSampTables(initSegId, segIndex);
+
+    SegmentProperties& segProps = m_initSegProps.at(initSegId).segPropMap.at(segIndex);
+    for (auto& decInfo : segProps.trackDecInfos)
+    {
+        InitSegmentTrackId trackIdPair   = make_pair(initSegId, decInfo.first);
+        const TrackDecInfo& trackDecInfo = decInfo.second;
+        CtxType ctxType;
+        if (trackDecInfo.samples.empty() || GetCtxTypeError(trackIdPair, ctxType) ||
+            ctxType != CtxType::TRACK)
+        {
+            continue;
+        }
+
+        SampleTable sampTable;
+        sampTable.segmentId  = segIndex;
+        sampTable.itemIdBase = trackDecInfo.itemIdBase;
+        sampTable.io         = &segProps.io;
+
+        const size_t sampNum = trackDecInfo.samples.size();
+        sampTable.dataOffsets.reserve(sampNum);
+        sampTable.dataLengths.reserve(sampNum);
+        sampTable.codeTypes.reserve(sampNum);
+        for (size_t index = 0; index < sampNum; index++)
+        {
+            const SampleInfo& sampInfo = trackDecInfo.samples[index];
+            sampTable.dataOffsets.push_back(sampInfo.dataOffset);
+            sampTable.dataLengths.push_back(sampInfo.dataLength);
+
+            // same look up as GetDecoderCodeType, resolved once per sample here
+            FourCCInt codeType;
+            auto codeTypeIt = trackDecInfo.decoderCodeTypeMap.find(
+                ItemId(trackDecInfo.itemIdBase.GetIndex() + static_cast<uint32_t>(index)));
+            if (codeTypeIt != trackDecInfo.decoderCodeTypeMap.end())
+            {
+                codeType = codeTypeIt->second;
+            }
+            else
+            {
+                auto paramSetIt = segProps.itemToParameterSetMap.find(
+                    InitSegTrackIdPair(trackIdPair, ItemId(static_cast<uint32_t>(index))));
+                if (paramSetIt != segProps.itemToParameterSetMap.end())
+                {
+                    codeTypeIt = trackDecInfo.decoderCodeTypeMap.find(ItemId(paramSetIt->second.GetIndex()));
+                    if (codeTypeIt != trackDecInfo.decoderCodeTypeMap.end())
+                    {
+                        codeType = codeTypeIt->second;
+                    }
+                }
+            }
+            sampTable.codeTypes.push_back(codeType);
+        }
+
+        SampleTableVector& sampTables = m_sampTables[trackIdPair];
+        auto pos = sampTables.begin();
+        while (pos != sampTables.end() && !(sampTable.itemIdBase < pos->itemIdBase))
+        {
+            pos++;
+        }
+        sampTables.insert(pos, std::move(sampTable));
+    }
+}
+
+void Mp4Reader::DropSampTables(InitSegmentId initSegId, SegmentId segIndex)
+{
+    for (auto tablesIt = m_sampTables.begin(); tablesIt != m_sampTables.end();)
+    {
+        if (tablesIt->first.first != initSegId)
+        {
+            tablesIt++;
+            continue;
+        }
+
+        SampleTableVector& sampTables = tablesIt->second;
+        for (auto sampTable = sampTables.begin(); sampTable != sampTables.end();)
+        {
+            if (sampTable->segmentId == segIndex)
+            {
+                sampTable = sampTables.erase(sampTable);
+            }
+            else
+            {
+                sampTable++;
+            }
+        }
+
+        if (sampTables.empty())
+        {
+            tablesIt = m_sampTables.erase(tablesIt);
+        }
+        else
+        {
+            tablesIt++;
+        }
+    }
+}
+
+const SampleTable* Mp4Reader::FindSampTable(InitSegmentTrackId initSegTrackId,
+                                            ItemId itemId,
+                                            size_t& sampIndex) const
+{
+    auto tablesIt = m_sampTables.find(initSegTrackId);
+    if (tablesIt == m_sampTables.end())
+    {
+        return nullptr;
+    }
+
+    // segments are few and the newest ones are read most, so search from the back
+    const SampleTableVector& sampTables = tablesIt->second;
+    for (auto sampTable = sampTables.rbegin(); sampTable != sampTables.rend(); sampTable++)
+    {
+        if (sampTable->itemIdBase > itemId)
+        {
+            continue;
+        }
+
+        size_t index = (itemId - sampTable->itemIdBase).GetIndex();
+        if (index >= sampTable->dataOffsets.size())
+        {
+            return nullptr;
+        }
+        sampIndex = index;
+        return &(*sampTable);
+    }
+    return nullptr;
+}
+
 DashSegGroup Mp4Reader::CreateDashSegs(InitSegmentId initSegId)
 {
     return DashSegGroup(*this, initSegId);
@@ -512,6 +641,7 @@ int32_t Mp4Reader::ParseInitSeg(StreamIO* strIO, uint32_t initSegId)
         }
 
         RefreshCompTimes(initSegmentId, segIndex);
+        BuildSampTables(initSegmentId, segIndex);
 
         if ((!io.strIO->IsStreamGood()) && (!io.strIO->IsReachEOS()))
         {
@@ -540,6 +670,7 @@ int32_t Mp4Reader::DisableInitSeg(uint32_t initSegId)
         for (auto& basicTrackInfo : m_initSegProps.at(initSegId).basicTrackInfos)
         {
             m_ctxInfoMap.erase(InitSegmentTrackId(initSegId, basicTrackInfo.first));
+            m_sampTables.erase(InitSegmentTrackId(initSegId, basicTrackInfo.first));
         }
         m_initSegProps.erase(initSegId);
     }
@@ -731,6 +862,7 @@ int32_t Mp4Reader::ParseSeg(StreamIO* strIO,
         }
 
         RefreshCompTimes(initSegId, segIndex);
+        BuildSampTables(initSegId, segIndex);
 
         if ((!io.strIO->IsStreamGood()) && (!io.strIO->IsReachEOS()))
         {
@@ -769,6 +901,7 @@ int32_t Mp4Reader::DisableSeg(uint32_t initSegId, uint32_t segIndex)
             {
                 seqToSeg.erase(sequence);
             }
+            DropSampTables(initSegId, segIndex);
             SegmentProperties& segProps = m_initSegProps.at(initSegId).segPropMap[segIndex];
             SegmentIO& io = segProps.io;
             io.strIO.reset(NULL);
@@ -1200,6 +1333,7 @@ int32_t Mp4Reader::ReadStream(InitSegmentId initSegId, SegmentId segIndex)
     if (!error)
     {
         RefreshCompTimes(initSegId, segIndex);
+        BuildSampTables(initSegId, segIndex);
 
         if ((!io.strIO->IsStreamGood()) && (!io.strIO->IsReachEOS()))
         {
@@ -1326,14 +1460,23 @@ int32_t Mp4Reader::ReadAtom(SegmentIO& io, Stream& bitstream)
         return error;
     }
 
+    bitstream.Clear();
+    bitstream.Reset();
+
+    // parse the box in place when the stream holds it in contiguous memory
+    const char* boxData = io.strIO->ReadContiguous(boxSize);
+    if (boxData)
+    {
+        bitstream.BorrowData(reinterpret_cast<const uint8_t*>(boxData), uint64_t(boxSize));
+        return ERROR_NONE;
+    }
+
     std::vector<uint8_t> data((uint64_t) boxSize);
     io.strIO->ReadStream(reinterpret_cast<char*>(data.data()), boxSize);
     if (!io.strIO->IsStreamGood())
     {
         return OMAF_FILE_READ_ERROR;
     }
-    bitstream.Clear();
-    bitstream.Reset();
     bitstream.WriteArray(data, uint64_t(boxSize));
     return ERROR_NONE;
 }
@@ -3595,6 +3738,61 @@ int32_t Mp4Reader::GetSegIndex(InitSegTrackIdPair id, SegmentId& segIndex) const
     return GetSegIndex(id.first, id.second, segIndex);
 }
 
+int32_t Mp4Reader::GetSampLocation(InitSegmentTrackId trackIdPair,
+                                             uint32_t itemIndex,
+                                             SampLocation& location)
+{
+    size_t sampIndex = 0;
+    const SampleTable* sampTable = FindSampTable(trackIdPair, ItemId(itemIndex), sampIndex);
+    if (sampTable && sampTable->codeTypes[sampIndex] != FourCCInt())
+    {
+        location.segmentId  = sampTable->segmentId;
+        location.io         = sampTable->io;
+        location.dataOffset = sampTable->dataOffsets[sampIndex];
+        location.dataLength = sampTable->dataLengths[sampIndex];
+        location.codeType   = sampTable->codeTypes[sampIndex].GetUInt32();
+        return ERROR_NONE;
+    }
+
+    InitSegmentId initSegId = trackIdPair.first;
+    SegmentId segIndex;
+    int32_t result = GetSegIndex(trackIdPair, itemIndex, segIndex);
+    if (result != ERROR_NONE)
+    {
+        return result;
+    }
+    SegmentTrackId segTrackId = make_pair(segIndex, trackIdPair.second);
+    ItemId itemId             = ItemId(itemIndex) - GetTrackDecInfo(initSegId, segTrackId).itemIdBase;
+
+    CtxType ctxType;
+    int error = GetCtxTypeError(trackIdPair, ctxType);
+    if (error)
+    {
+        return error;
+    }
+    if (ctxType != CtxType::TRACK)
+    {
+        return OMAF_INVALID_MP4READER_CONTEXTID;
+    }
+    if (itemId.GetIndex() >= GetTrackDecInfo(initSegId, segTrackId).samples.size())
+    {
+        return OMAF_INVALID_ITEM_ID;
+    }
+
+    error = GetDecoderCodeType(GenTrackId(trackIdPair), itemIndex, location.codeType);
+    if (error)
+    {
+        return error;
+    }
+
+    const SampleInfo& sampInfo = GetTrackDecInfo(initSegId, segTrackId).samples.at(itemId.GetIndex());
+    location.segmentId  = segIndex;
+    location.io         = &m_initSegProps.at(initSegId).segPropMap.at(segIndex).io;
+    location.dataOffset = sampInfo.dataOffset;
+    location.dataLength = sampInfo.dataLength;
+    return ERROR_NONE;
+}
+
 int32_t Mp4Reader::GetSampDataInfo(uint32_t ctxId,
                                                uint32_t itemIndex,
                                                const InitSegmentId& initSegId,
@@ -3609,6 +3807,14 @@ int32_t Mp4Reader::GetSampDataInfo(uint32_t ctxId,
 
     InitSegmentTrackId neededInitSegTrackId = make_pair(initSegId, trackCtxId);
 
+    size_t sampIndex = 0;
+    if (const SampleTable* sampTable = FindSampTable(neededInitSegTrackId, ItemId(itemIndex), sampIndex))
+    {
+        refDataOffset = sampTable->dataOffsets[sampIndex];
+        refSampLength = sampTable->dataLengths[sampIndex];
+        return ERROR_NONE;
+    }
+
     SegmentId segIndex;
     int32_t result = GetSegIndex(neededInitSegTrackId, itemIndex, segIndex);
     if (result != ERROR_NONE)
@@ -3642,6 +3848,14 @@ int32_t Mp4Reader::GetDepedentSampInfo(uint32_t trackId,
 
     InitSegmentTrackId refInitSegTrackId = make_pair(initSegId, refTrackCtxId);
 
+    size_t sampIndex = 0;
+    if (const SampleTable* sampTable = FindSampTable(refInitSegTrackId, ItemId(itemIndex), sampIndex))
+    {
+        refDataOffset = sampTable->dataOffsets[sampIndex];
+        refSampLength = sampTable->dataLengths[sampIndex];
+        return ERROR_NONE;
+    }
+
     SegmentId refSegmentId;
     int32_t result = GetSegIndex(refInitSegTrackId, itemIndex, refSegmentId);
     if (result != ERROR_NONE)
@@ -3775,60 +3989,33 @@ int32_t Mp4Reader::GetExtractorTrackSampData(uint32_t trackId,
 
     InitSegmentTrackId trackIdPair = MakeIdPair(trackId);
     InitSegmentId initSegId       = trackIdPair.first;
-    SegmentId segIndex;
-    int32_t result = GetSegIndex(trackIdPair, itemIndex, segIndex);
+    SampLocation sampLocation;
+    int32_t result = GetSampLocation(trackIdPair, itemIndex, sampLocation);
     if (result != ERROR_NONE)
     {
         return result;
     }
-    SegmentTrackId segTrackId = make_pair(segIndex, trackIdPair.second);
-    ItemId itemId             = ItemId(itemIndex) - GetTrackDecInfo(initSegId, segTrackId).itemIdBase;
+    SegmentTrackId segTrackId = make_pair(sampLocation.segmentId, trackIdPair.second);
 
-    SegmentIO& io = m_initSegProps.at(initSegId).segPropMap.at(segIndex).io;
-    CtxType ctxType;
-    int error = GetCtxTypeError(trackIdPair, ctxType);
-    if (error)
+    const uint32_t sampLen = sampLocation.dataLength;
+    if (bufSize < sampLen)
     {
-        return error;
-    }
-    switch (ctxType)
-    {
-    case CtxType::TRACK:
-    {
-        if (itemId.GetIndex() >= GetTrackDecInfo(initSegId, segTrackId).samples.size())
-        {
-            return OMAF_INVALID_ITEM_ID;
-        }
-
-        const uint32_t sampLen = GetTrackDecInfo(initSegId, segTrackId).samples.at(itemId.GetIndex()).dataLength;
-        if (bufSize < sampLen)
-        {
-            bufSize = sampLen;
-            return OMAF_MEMORY_TOO_SMALL_BUFFER;
-        }
-
-        int64_t neededDataOffset = (int64_t) GetTrackDecInfo(initSegId, segTrackId).samples.at(itemId.GetIndex()).dataOffset;
-        LocateToOffset(io, neededDataOffset);
-        io.strIO->ReadStream(buf, sampLen);
         bufSize = sampLen;
-
-        if (!io.strIO->IsStreamGood())
-        {
-            return OMAF_FILE_READ_ERROR;
-        }
-        break;
-    }
-    default:
-        return OMAF_INVALID_MP4READER_CONTEXTID;
+        return OMAF_MEMORY_TOO_SMALL_BUFFER;
     }
 
-    FourCC codeType;
-    error = GetDecoderCodeType(GenTrackId(trackIdPair), itemIndex, codeType);
-    if (error)
+    SegmentIO& io = *sampLocation.io;
+    LocateToOffset(io, (int64_t) sampLocation.dataOffset);
+    io.strIO->ReadStream(buf, sampLen);
+    bufSize = sampLen;
+
+    if (!io.strIO->IsStreamGood())
     {
-        return error;
+        return OMAF_FILE_READ_ERROR;
     }
 
+    const FourCC& codeType = sampLocation.codeType;
+
     if (codeType == "avc1" || codeType == "avc3")
     {
         if (strHrd)
@@ -4056,59 +4243,33 @@ int32_t Mp4Reader::GetSampData(uint32_t trackId,
 
     InitSegmentTrackId trackIdPair = MakeIdPair(trackId);
     InitSegmentId initSegId       = trackIdPair.first;
-    SegmentId segIndex;
-    int32_t result = GetSegIndex(trackIdPair, itemIndex, segIndex);
+    SampLocation sampLocation;
+    int32_t result = GetSampLocation(trackIdPair, itemIndex, sampLocation);
     if (result != ERROR_NONE)
     {
         return result;
     }
-    SegmentTrackId segTrackId = make_pair(segIndex, trackIdPair.second);
-    ItemId itemId             = ItemId(itemIndex) - GetTrackDecInfo(initSegId, segTrackId).itemIdBase;
+    SegmentTrackId segTrackId = make_pair(sampLocation.segmentId, trackIdPair.second);
 
-    SegmentIO& io = m_initSegProps.at(initSegId).segPropMap.at(segIndex).io;
-    CtxType ctxType;
-    int error = GetCtxTypeError(trackIdPair, ctxType);
-    if (error)
+    const uint32_t sampLen = sampLocation.dataLength;
+    if (bufSize < sampLen)
     {
-        return error;
-    }
-    switch (ctxType)
-    {
-    case CtxType::TRACK:
-    {
-        if (itemId.GetIndex() >= GetTrackDecInfo(initSegId, segTrackId).samples.size())
-        {
-            return OMAF_INVALID_ITEM_ID;
-        }
-
-        const uint32_t sampLen = GetTrackDecInfo(initSegId, segTrackId).samples.at(itemId.GetIndex()).dataLength;
-        if (bufSize < sampLen)
-        {
-            bufSize = sampLen;
-            return OMAF_MEMORY_TOO_SMALL_BUFFER;
-        }
-
-        LocateToOffset(io, (int64_t) GetTrackDecInfo(initSegId, segTrackId).samples.at(itemId.GetIndex()).dataOffset);
-        io.strIO->ReadStream(buf, sampLen);
         bufSize = sampLen;
-
-        if (!io.strIO->IsStreamGood())
-        {
-            return OMAF_FILE_READ_ERROR;
-        }
-        break;
-    }
-    default:
-        return OMAF_INVALID_MP4READER_CONTEXTID;
+        return OMAF_MEMORY_TOO_SMALL_BUFFER;
     }
 
-    FourCC codeType;
-    error = GetDecoderCodeType(GenTrackId(trackIdPair), itemIndex, codeType);
-    if (error)
+    SegmentIO& io = *sampLocation.io;
+    LocateToOffset(io, (int64_t) sampLocation.dataOffset);
+    io.strIO->ReadStream(buf, sampLen);
+    bufSize = sampLen;
+
+    if (!io.strIO->IsStreamGood())
     {
-        return error;
+        return OMAF_FILE_READ_ERROR;
     }
 
+    const FourCC& codeType = sampLocation.codeType;
+
     if (codeType == "avc1" || codeType == "avc3")
     {
         if (strHrd)
@@ -4317,6 +4478,15 @@ int32_t Mp4Reader::GetSampOffset(uint32_t trackId,
 
     InitSegmentTrackId trackIdPair = MakeIdPair(trackId);
     InitSegmentId initSegId       = trackIdPair.first;
+
+    size_t sampIndex = 0;
+    if (const SampleTable* sampTable = FindSampTable(trackIdPair, ItemId(itemIndex), sampIndex))
+    {
+        sampLen    = sampTable->dataLengths[sampIndex];
+        sampOffset = sampTable->dataOffsets[sampIndex];
+        return ERROR_NONE;
+    }
+
     SegmentId segIndex;
     int32_t result = GetSegIndex(trackIdPair, itemIndex, segIndex);
     if (result != ERROR_NONE)
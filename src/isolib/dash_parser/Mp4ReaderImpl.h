@@ -921,6 +921,7 @@ private:
         bool enableLoopPlay              = false;
     };
     std::map<InitSegmentTrackId, CtxInfo> m_ctxInfoMap;
+    std::map<InitSegmentTrackId, SampleTableVector> m_sampTables;
 
     friend class DashSegGroup;
     friend class ConstDashSegGroup;
@@ -1015,6 +1016,15 @@ private:
     void RefreshCompTimes(InitSegmentId initSegId,
                                 SegmentId segIndex);
 
+    void BuildSampTables(InitSegmentId initSegId,
+                                SegmentId segIndex);
+
+    void DropSampTables(InitSegmentId initSegId,
+                                SegmentId segIndex);
+
+    const SampleTable* FindSampTable(InitSegmentTrackId initSegTrackId,
+                                ItemId itemId, size_t& sampIndex) const;  //< returns null if not built
+
     ItemInfoMap ExtractItemInfoMap(const MetaAtom& metaAtom) const;
 
     void ProcessDecoderConfigProperties(const InitSegmentTrackId segTrackId);
@@ -1116,6 +1126,19 @@ private:
                         ItemId itemId, SegmentId& segIndex) const;
     int32_t GetSegIndex(InitSegTrackIdPair id, SegmentId& segIndex) const;
 
+    struct SampLocation
+    {
+        SegmentId segmentId;
+        SegmentIO* io       = nullptr;
+        uint64_t dataOffset = 0;
+        uint32_t dataLength = 0;
+        FourCC codeType;
+    };
+
+    int32_t GetSampLocation(InitSegmentTrackId initSegTrackId,
+                              uint32_t itemIndex,
+                              SampLocation& location);
+
 
     int32_t GetSampDataInfo(uint32_t trackId,
                               uint32_t itemIndex,
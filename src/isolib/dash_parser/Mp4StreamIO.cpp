@@ -74,6 +74,19 @@ void StreamIOInternal::ReadStream(char* buffer, StreamIO::offset_t size_)
     }
 }
 
+const char* StreamIOInternal::ReadContiguous(StreamIO::offset_t size_)
+{
+    const StreamIO::offset_t offset = m_stream->TellOffset();
+    const char* data = m_stream->GetContiguousData(offset, size_);
+    if (data && !m_stream->SeekAbsoluteOffset(offset + size_))
+    {
+        m_eof   = true;
+        m_error = true;
+        return nullptr;
+    }
+    return data;
+}
+
 int StreamIOInternal::GetOneByte()
 {
     char ch;
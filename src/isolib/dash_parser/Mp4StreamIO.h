@@ -58,6 +58,16 @@ public:
     virtual offset_t TellOffset() = 0;
 
     virtual offset_t GetStreamSize() = 0;
+
+    /** Read-only contiguous memory of [offset, offset + size) without copy, or
+        nullptr if the source can't expose it. The memory stays valid as long as
+        the source holds the data */
+    virtual const char* GetContiguousData(offset_t offset, offset_t size)
+    {
+        (void)offset;
+        (void)size;
+        return nullptr;
+    };
 };
 
 class StreamIOInternal
@@ -71,6 +81,8 @@ public:
 
     void ReadStream(char* buffer, StreamIO::offset_t size);
 
+    const char* ReadContiguous(StreamIO::offset_t size);
+
     int GetOneByte();
 
 
@@ -188,7 +188,7 @@ RenderStatus VideoDecoder::SendPacket(DashPacket* packet)
 
     //send a packet to AVPACKET list
 
-    if (NULL != packet->buf && packet->size)
+    if ((NULL != packet->buf || NULL != packet->spans) && packet->size)
     {
         int size = packet->size;
         if (av_new_packet(mPkt, size) < 0)
@@ -198,7 +198,23 @@ RenderStatus VideoDecoder::SendPacket(DashPacket* packet)
             SAFE_DELETE(mRwpk);
             return RENDER_ERROR;
         }
-        memcpy_s(mPkt->data, size, packet->buf, size);
+        if (NULL != packet->buf)
+        {
+            memcpy_s(mPkt->data, size, packet->buf, size);
+        }
+        else
+        {
+            // the tile data are gathered into the decoder packet directly without any other copy
+            uint32_t assembledLen = 0;
+            if (I360SCVP_AssembleSpans(packet->spans, packet->spansNum, mPkt->data, size, &assembledLen) || assembledLen != (uint32_t)size)
+            {
+                LOG(ERROR) << "Failed to assemble packet spans at pts " << packet->pts << endl;
+                SAFE_DELETE(mPktInfo);
+                av_packet_free(&mPkt);
+                SAFE_DELETE(mRwpk);
+                return RENDER_ERROR;
+            }
+        }
         mPkt->size = size;
         if (packet->rwpk != nullptr) {
             *mRwpk = *(packet->rwpk);
@@ -223,7 +223,7 @@ RenderStatus VideoDecoder_hw::SendPacket(DashPacket* packet)
 
     //send a packet to AVPACKET list
 
-    if (NULL != packet->buf && packet->size)
+    if ((NULL != packet->buf || NULL != packet->spans) && packet->size)
     {
         // use mPkt to store buf and size
         mPkt->size = packet->size;
@@ -231,7 +231,19 @@ RenderStatus VideoDecoder_hw::SendPacket(DashPacket* packet)
         mPkt->width = packet->width;
         mPkt->height = packet->height;
         mPkt->pts = packet->pts;
-        memcpy_s(mPkt->buf, packet->size, packet->buf, packet->size);
+        if (NULL != packet->buf)
+        {
+            memcpy_s(mPkt->buf, packet->size, packet->buf, packet->size);
+        }
+        else
+        {
+            uint32_t assembledLen = 0;
+            if (I360SCVP_AssembleSpans(packet->spans, packet->spansNum, (uint8_t*)mPkt->buf, mPkt->size, &assembledLen) || assembledLen != mPkt->size)
+            {
+                ANDROID_LOGD("Failed to assemble packet spans at pts %ld", packet->pts);
+                memset(mPkt->buf, 0, mPkt->size);
+            }
+        }
 
         *mRwpk = *(packet->rwpk);
 
@@ -137,6 +137,8 @@ RenderStatus DashMediaSource::Initialize(struct RenderConfig renderConfig, Rende
   pCtxDashStreaming->omaf_params.synchronizer_params.segment_range_size = 20;  // 20
   pCtxDashStreaming->omaf_params.max_decode_width = renderConfig.maxVideoDecodeWidth;
   pCtxDashStreaming->omaf_params.max_decode_height = renderConfig.maxVideoDecodeHeight;
+  // the decoders gather the merged frame from the tile data directly
+  pCtxDashStreaming->omaf_params.enable_span_output = 1;
   pCtxDashStreaming->omaf_params.enable_in_time_viewport_update = renderConfig.enableInTimeViewportUpdate;
   pCtxDashStreaming->omaf_params.max_response_times_in_seg = renderConfig.maxResponseTimesInOneSeg;
   pCtxDashStreaming->omaf_params.max_catchup_width = renderConfig.maxCatchupWidth;
@@ -413,7 +415,15 @@ void DashMediaSource::ProcessVideoPacket() {
   if (m_needStreamDumped && !m_dumpedFile.empty()) {
     for (uint32_t i = 0; i < dashPktNum; i++)
     {
-        fwrite(dashPkt[i].buf, 1, dashPkt[i].size, m_dumpedFile[dashPkt[i].videoID]);
+        if (dashPkt[i].buf)
+        {
+            fwrite(dashPkt[i].buf, 1, dashPkt[i].size, m_dumpedFile[dashPkt[i].videoID]);
+            continue;
+        }
+        for (uint32_t j = 0; j < dashPkt[i].spansNum; j++)
+        {
+            fwrite(dashPkt[i].spans[j].pData, 1, dashPkt[i].spans[j].dataLen, m_dumpedFile[dashPkt[i].videoID]);
+        }
     }
   }
 #ifdef _ANDROID_OS_
@@ -445,6 +455,7 @@ void DashMediaSource::ProcessVideoPacket() {
 #endif
   for (int i = 0; i < dashPktNum; i++) {
     SAFE_FREE(dashPkt[i].buf);
+    OmafAccess_ReleasePacketSpans(&(dashPkt[i]));
     if (dashPkt[i].rwpk) SAFE_DELETE_ARRAY(dashPkt[i].rwpk->rectRegionPacking);
     SAFE_DELETE(dashPkt[i].rwpk);
     SAFE_DELETE(dashPkt[i].prft);
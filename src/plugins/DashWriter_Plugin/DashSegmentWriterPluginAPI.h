@@ -36,10 +36,41 @@
 
 #include "MediaData.h"
 
+#include <sys/uio.h>
+
 using namespace std;
 
 VCD_MP4_BEGIN
 
+//!
+//! \class SegmentSink
+//! \brief output of the segment writer, box headers and frame payloads
+//!        are passed as data spans in order, without being copied into
+//!        an intermediate stream
+//!
+class SegmentSink
+{
+public:
+    SegmentSink() {};
+
+    virtual ~SegmentSink() {};
+
+    //!
+    //! \brief  Begin to write one segment with the file name
+    //!
+    virtual bool BeginSegment(const char *segName) = 0;
+
+    //!
+    //! \brief  Append the data spans to the current segment
+    //!
+    virtual bool Write(const struct iovec *spans, int32_t spansNum) = 0;
+
+    //!
+    //! \brief  End the current segment
+    //!
+    virtual bool EndSegment() = 0;
+};
+
 class SegmentWriterBase
 {
 public:
@@ -89,6 +120,16 @@ public:
     virtual void WriteSegments(std::ostringstream &frameString,
         uint64_t *segNum, char segName[1024], char *baseName, uint64_t *segSize) = 0;
 
+    //!
+    //! \brief  Write the ready segments to the sink, each segment is
+    //!         written between BeginSegment and EndSegment of the sink
+    //!
+    //! \return bool
+    //!         false if the sink fails to write
+    //!
+    virtual bool WriteSegments(SegmentSink *sink,
+        uint64_t *segNum, char segName[1024], char *baseName, uint64_t *segSize) = 0;
+
 protected:
 };
 
@@ -58,6 +58,8 @@ MPDWriter::MPDWriter()
     m_vsNum = 0;
     m_cmafEnabled = false;
     m_currSegNum = 0;
+    m_mpdEle = NULL;
+    m_periodEle = NULL;
 }
 
 MPDWriter::MPDWriter(
@@ -84,6 +86,8 @@ MPDWriter::MPDWriter(
     m_vsNum = videoNum;
     m_cmafEnabled = cmafEnabled;
     m_currSegNum = 0;
+    m_mpdEle = NULL;
+    m_periodEle = NULL;
 }
 
 MPDWriter::MPDWriter(const MPDWriter& src)
@@ -104,6 +108,9 @@ MPDWriter::MPDWriter(const MPDWriter& src)
     m_vsNum         = src.m_vsNum;
     m_cmafEnabled   = src.m_cmafEnabled;
     m_currSegNum    = src.m_currSegNum;
+    m_mpdEle        = src.m_mpdEle;
+    m_periodEle     = src.m_periodEle;
+    m_startNumEles  = src.m_startNumEles;
 }
 
 MPDWriter& MPDWriter::operator=(MPDWriter&& other)
@@ -124,6 +131,9 @@ MPDWriter& MPDWriter::operator=(MPDWriter&& other)
     m_vsNum         = other.m_vsNum;
     m_cmafEnabled   = other.m_cmafEnabled;
     m_currSegNum    = other.m_currSegNum;
+    m_mpdEle        = other.m_mpdEle;
+    m_periodEle     = other.m_periodEle;
+    m_startNumEles  = std::move(other.m_startNumEles);
 
     return *this;
 }
@@ -311,6 +321,7 @@ int32_t MPDWriter::WriteTileTrackAS(XMLElement *periodEle, VCD::MP4::MPDAdaptati
         int32_t currSegNum = (int32_t)m_currSegNum;//(int32_t)(trackASCtx->dashSegmenter->GetSegmentsNum());
         //OMAF_LOG(LOG_INFO, "Write start number %d to MPD \n", currSegNum);
         sgtTpeEle->SetAttribute(STARTNUMBER, currSegNum);
+        m_startNumEles.push_back(sgtTpeEle);
     }
 
     sgtTpeEle->SetAttribute(TIMESCALE, m_timeScale);
@@ -479,6 +490,7 @@ int32_t MPDWriter::WriteExtractorTrackAS(XMLElement *periodEle, VCD::MP4::MPDAda
     else
     {
         sgtTpeEle->SetAttribute(STARTNUMBER, (int32_t)m_currSegNum);
+        m_startNumEles.push_back(sgtTpeEle);
     }
     sgtTpeEle->SetAttribute(TIMESCALE, m_timeScale);
 
@@ -540,41 +552,9 @@ int32_t MPDWriter::WriteAudioTrackAS(XMLElement *periodEle, VCD::MP4::MPDAdaptat
     return ERROR_NONE;
 }
 
-int32_t MPDWriter::WriteMpd(uint64_t totalFramesNum)
+int32_t MPDWriter::SetTimeAttributes(XMLElement *mpdEle, uint64_t totalFramesNum)
 {
-    const char *declaration = "xml version=\"1.0\" encoding=\"UTF-8\"";
-    XMLDeclaration *xmlDec = m_xmlDoc->NewDeclaration();
-    xmlDec->SetValue(declaration);
-
-    m_xmlDoc->InsertFirstChild(xmlDec);
-
-    XMLElement *mpdEle = m_xmlDoc->NewElement(DASH_MPD);
-    mpdEle->SetAttribute(OMAF_XMLNS, OMAF_XMLNS_VALUE);
-    mpdEle->SetAttribute(XSI_XMLNS, XSI_XMLNS_VALUE);
-    mpdEle->SetAttribute(XMLNS, XMLNS_VALUE);
-    mpdEle->SetAttribute(XLINK_XMLNS, XLINK_XMLNS_VALUE);
-    mpdEle->SetAttribute(XSI_SCHEMALOCATION, XSI_SCHEMALOCATION_VALUE);
-
     char string[1024];
-    memset_s(string, 1024, 0);
-    snprintf(string, 1024, "PT%fS", (double)m_segInfo->segDuration);
-    mpdEle->SetAttribute(MINBUFFERTIME, string);
-
-    memset_s(string, 1024, 0);
-    snprintf(string, 1024, "PT%fS", (double)m_segInfo->segDuration);
-    mpdEle->SetAttribute(MAXSEGMENTDURATION, string);
-
-    if (m_segInfo->isLive)
-    {
-        mpdEle->SetAttribute(PROFILES, PROFILE_LIVE);
-        mpdEle->SetAttribute(MPDTYPE, TYPE_LIVE);
-    }
-    else
-    {
-        mpdEle->SetAttribute(PROFILES, PROFILE_ONDEMOND);
-        mpdEle->SetAttribute(MPDTYPE, TYPE_STATIC);
-    }
-
     if (m_segInfo->isLive)
     {
         uint32_t sec;
@@ -659,6 +639,53 @@ int32_t MPDWriter::WriteMpd(uint64_t totalFramesNum)
         mpdEle->SetAttribute(MEDIAPRESENTATIONDURATION, m_presentationDur);
     }
 
+    return ERROR_NONE;
+}
+
+int32_t MPDWriter::WriteMpd(uint64_t totalFramesNum)
+{
+    m_xmlDoc->Clear();
+    m_mpdEle = NULL;
+    m_periodEle = NULL;
+    m_startNumEles.clear();
+
+    const char *declaration = "xml version=\"1.0\" encoding=\"UTF-8\"";
+    XMLDeclaration *xmlDec = m_xmlDoc->NewDeclaration();
+    xmlDec->SetValue(declaration);
+
+    m_xmlDoc->InsertFirstChild(xmlDec);
+
+    XMLElement *mpdEle = m_xmlDoc->NewElement(DASH_MPD);
+    mpdEle->SetAttribute(OMAF_XMLNS, OMAF_XMLNS_VALUE);
+    mpdEle->SetAttribute(XSI_XMLNS, XSI_XMLNS_VALUE);
+    mpdEle->SetAttribute(XMLNS, XMLNS_VALUE);
+    mpdEle->SetAttribute(XLINK_XMLNS, XLINK_XMLNS_VALUE);
+    mpdEle->SetAttribute(XSI_SCHEMALOCATION, XSI_SCHEMALOCATION_VALUE);
+
+    char string[1024];
+    memset_s(string, 1024, 0);
+    snprintf(string, 1024, "PT%fS", (double)m_segInfo->segDuration);
+    mpdEle->SetAttribute(MINBUFFERTIME, string);
+
+    memset_s(string, 1024, 0);
+    snprintf(string, 1024, "PT%fS", (double)m_segInfo->segDuration);
+    mpdEle->SetAttribute(MAXSEGMENTDURATION, string);
+
+    if (m_segInfo->isLive)
+    {
+        mpdEle->SetAttribute(PROFILES, PROFILE_LIVE);
+        mpdEle->SetAttribute(MPDTYPE, TYPE_LIVE);
+    }
+    else
+    {
+        mpdEle->SetAttribute(PROFILES, PROFILE_ONDEMOND);
+        mpdEle->SetAttribute(MPDTYPE, TYPE_STATIC);
+    }
+
+    int32_t ret = SetTimeAttributes(mpdEle, totalFramesNum);
+    if (ret)
+        return ret;
+
     m_xmlDoc->InsertEndChild(mpdEle);
 
     XMLElement *essentialEle = m_xmlDoc->NewElement(ESSENTIALPROPERTY);
@@ -886,7 +913,50 @@ int32_t MPDWriter::WriteMpd(uint64_t totalFramesNum)
         }
     }
 
-    m_xmlDoc->SaveFile(m_mpdFileName);
+    m_mpdEle = mpdEle;
+    m_periodEle = periodEle;
+
+    return PublishMpd();
+}
+
+int32_t MPDWriter::PatchMpd(uint64_t totalFramesNum)
+{
+    int32_t ret = SetTimeAttributes(m_mpdEle, totalFramesNum);
+    if (ret)
+        return ret;
+
+    if (!(m_segInfo->isLive))
+    {
+        m_periodEle->SetAttribute(DURATION, m_presentationDur);
+    }
+
+    std::vector<XMLElement*>::iterator it;
+    for (it = m_startNumEles.begin(); it != m_startNumEles.end(); it++)
+    {
+        (*it)->SetAttribute(STARTNUMBER, (int32_t)m_currSegNum);
+    }
+
+    return PublishMpd();
+}
+
+int32_t MPDWriter::PublishMpd()
+{
+    char tmpName[1024 + 8] = { 0 };
+    snprintf(tmpName, sizeof(tmpName), "%s.tmp", m_mpdFileName);
+
+    if (m_xmlDoc->SaveFile(tmpName) != XML_SUCCESS)
+    {
+        OMAF_LOG(LOG_ERROR, "Failed to write MPD file %s\n", tmpName);
+        remove(tmpName);
+        return OMAF_ERROR_FILE_WRITE;
+    }
+
+    if (rename(tmpName, m_mpdFileName) != 0)
+    {
+        OMAF_LOG(LOG_ERROR, "Failed to publish MPD file %s\n", m_mpdFileName);
+        remove(tmpName);
+        return OMAF_ERROR_FILE_WRITE;
+    }
 
     return ERROR_NONE;
 }
@@ -894,61 +964,26 @@ int32_t MPDWriter::WriteMpd(uint64_t totalFramesNum)
 int32_t MPDWriter::UpdateMpd(uint64_t segNumber, uint64_t framesNumber)
 {
     m_currSegNum = segNumber;
+
+    bool needUpdate = false;
     if (m_segInfo->windowSize)
     {
-        if (segNumber % m_segInfo->windowSize == 1)
-        {
-            char buf[PATH_MAX] = { 0 };
-            char *res = realpath(m_mpdFileName, buf);
-            if (res)
-            {
-                remove(buf);
-                DELETE_MEMORY(m_xmlDoc);
-
-                m_xmlDoc = new XMLDocument;
-                if (!m_xmlDoc)
-                    return OMAF_ERROR_CREATE_XMLFILE_FAILED;
-            }
-            else
-            {
-                if (segNumber > 1)
-                {
-                    perror("realpath");
-                    return OMAF_ERROR_REALPATH_FAILED;
-                }
-            }
-
-            int32_t ret = WriteMpd(framesNumber);
-            return ret;
-        }
+        needUpdate = (segNumber % m_segInfo->windowSize == 1);
     }
     else
     {
-        if (framesNumber % (m_segInfo->segDuration * (uint16_t)((double)(m_frameRate.num / m_frameRate.den) + 0.5)) == 0)
-        {
-            char buf[PATH_MAX] = { 0 };
-            char *res = realpath(m_mpdFileName, buf);
-            if (res)
-            {
-                remove(buf);
-                DELETE_MEMORY(m_xmlDoc);
+        needUpdate = (framesNumber % (m_segInfo->segDuration * (uint16_t)((double)(m_frameRate.num / m_frameRate.den) + 0.5)) == 0);
+    }
 
-                m_xmlDoc = new XMLDocument;
-                if (!m_xmlDoc)
-                    return OMAF_ERROR_CREATE_XMLFILE_FAILED;
-            }
-            else
-            {
-                perror("realpath");
-                return OMAF_ERROR_REALPATH_FAILED;
-            }
+    if (!needUpdate)
+        return ERROR_NONE;
 
-            int32_t ret = WriteMpd(framesNumber);
-            return ret;
-        }
-    }
+    // only time varying attributes change between updates, so patch
+    // them into the DOM which has been built instead of rebuilding it
+    if (m_mpdEle && m_periodEle)
+        return PatchMpd(framesNumber);
 
-    return ERROR_NONE;
+    return WriteMpd(framesNumber);
 }
 
 extern "C" MPDWriterBase* Create(
@@ -35,6 +35,7 @@
 #define _MPDWRITERPLUGIN_H_
 
 #include "../DashMPDWriterPluginAPI.h"
+#include <vector>
 #include "tinyxml2.h"
 #include "../../../utils/safe_mem.h"
 //extern "C"
@@ -129,6 +130,43 @@ public:
 
 private:
 
+    //!
+    //! \brief  Set time varying attributes of MPD element, that is
+    //!         availability start time and publish time for live
+    //!         streaming, or presentation duration for static one
+    //!
+    //! \param  [in] mpdEle
+    //!         pointer to MPD element
+    //! \param  [in] totalFramesNum
+    //!         total number of frames written into segments
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t SetTimeAttributes(XMLElement *mpdEle, uint64_t totalFramesNum);
+
+    //!
+    //! \brief  Update time varying attributes and start number in
+    //!         the MPD DOM which has been built, then publish it
+    //!
+    //! \param  [in] totalFramesNum
+    //!         total number of frames written into segments
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t PatchMpd(uint64_t totalFramesNum);
+
+    //!
+    //! \brief  Save the MPD DOM to temporary file, then rename it
+    //!         to the MPD file, so that clients never read a partly
+    //!         written MPD file
+    //!
+    //! \return int32_t
+    //!         ERROR_NONE if success, else failed reason
+    //!
+    int32_t PublishMpd();
+
     //!
     //! \brief  Write AdaptationSet for tile track in mpd file
     //!
@@ -188,6 +226,9 @@ private:
     uint8_t                                         m_vsNum;               //!< video streams number
     bool                                            m_cmafEnabled;         //!< flag for whether CMAF compliance is enabled
     uint64_t                                        m_currSegNum;          //!< current segment number
+    XMLElement                                      *m_mpdEle;             //!< MPD element in built DOM, NULL if DOM hasn't been built
+    XMLElement                                      *m_periodEle;          //!< Period element in built DOM
+    std::vector<XMLElement*>                        m_startNumEles;        //!< SegmentTemplate elements whose start number follows current segment number
 };
 
 extern "C" MPDWriterBase* Create(
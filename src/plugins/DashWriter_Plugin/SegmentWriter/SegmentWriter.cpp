@@ -78,7 +78,7 @@ struct Mp4MoofInfo
 
 typedef map<TrackId, Mp4MoofInfo> Mp4MoofInfos;
 
-void WriteMoof(ostream& outStr,
+void WriteMoof(Stream& outBS,
                const TrackIds& trackIndex,
                const Segment& oneSeg,
                const Mp4MoofInfos& moofInfos,
@@ -154,19 +154,46 @@ void WriteMoof(ostream& outStr,
         moof.AddTrackFragmentAtom(move(traf));
     }
 
-    Stream bs;
-    moof.ToStream(bs);
-    auto data = bs.GetStorage();
-    outStr.write(reinterpret_cast<const char*>(&data[0]), streamsize(data.size()));
+    moof.ToStream(outBS);
 }
 
-void FlushStream(Stream& inBS, ostream& outStr)
+bool FlushStream(Stream& inBS, SegmentSink* sink)
 {
-    auto data = inBS.GetStorage();
-    outStr.write(reinterpret_cast<const char*>(&data[0]), streamsize(data.size()));
+    const auto& data = inBS.GetStorage();
+    struct iovec span = {const_cast<uint8_t*>(data.data()), data.size()};
+    bool ret = sink->Write(&span, 1);
     inBS.Clear();
+    return ret;
 }
 
+//!
+//! \class OstreamSegmentSink
+//! \brief segment sink which appends all segments to one output stream
+//!
+class OstreamSegmentSink : public SegmentSink
+{
+public:
+    OstreamSegmentSink(ostream& outStr) : m_outStr(outStr) {};
+
+    ~OstreamSegmentSink() {};
+
+    bool BeginSegment(const char*) override { return true; };
+
+    bool Write(const struct iovec *spans, int32_t spansNum) override
+    {
+        for (int32_t i = 0; i < spansNum; i++)
+        {
+            m_outStr.write(static_cast<const char*>(spans[i].iov_base), streamsize(spans[i].iov_len));
+        }
+        return m_outStr.good();
+    };
+
+    bool EndSegment() override { return true; };
+
+private:
+    ostream& m_outStr;
+};
+
 void CopyAtom(const Atom& srcAtom, Atom& dstAtom)
 {
     Stream bs;
@@ -252,7 +279,7 @@ InitialSegment& InitialSegment::operator=(InitialSegment&& initSeg)
     return *this;
 }
 
-void WriteSegmentHeader(ostream& outStr)
+bool WriteSegmentHeader(SegmentSink* sink)
 {
     SegmentTypeAtom stypAtom;
     Stream tempBS;
@@ -262,10 +289,10 @@ void WriteSegmentHeader(ostream& outStr)
     stypAtom.AddCompatibleBrand("msix");
     stypAtom.ToStream(tempBS);
 
-    FlushStream(tempBS, outStr);
+    return FlushStream(tempBS, sink);
 }
 
-void WriteSampleData(ostream& outStr, const Segment& oneSeg)
+bool WriteSampleData(SegmentSink* sink, const Segment& oneSeg, uint64_t* writtenSize)
 {
     TrackIds trackIds = Keys(oneSeg.tracks);
     map<TrackId, Frames> frameMap;
@@ -276,7 +303,6 @@ void WriteSampleData(ostream& outStr, const Segment& oneSeg)
         frameMap.insert(make_pair(iter->first, iter->second.frames));
     }
 
-    auto moofOffset = outStr.tellp();
     Mp4MoofInfos segMoofInfos;
 
     vector<TrackId>::iterator iter1 = trackIds.begin();
@@ -286,26 +312,23 @@ void WriteSampleData(ostream& outStr, const Segment& oneSeg)
         segMoofInfos.insert(make_pair(*iter1, move(moofInfo)));
     }
 
-    WriteMoof(outStr, trackIds, oneSeg, segMoofInfos, frameMap);
-
-    vector<uint8_t> mdatHrd;
-    mdatHrd.push_back(0);
-    mdatHrd.push_back(0);
-    mdatHrd.push_back(0);
-    mdatHrd.push_back(0);
-    mdatHrd.push_back(uint8_t('m'));
-    mdatHrd.push_back(uint8_t('d'));
-    mdatHrd.push_back(uint8_t('a'));
-    mdatHrd.push_back(uint8_t('t'));
-    auto mdatOffset = outStr.tellp();
-    outStr.write(reinterpret_cast<const char*>(&mdatHrd[0]), streamsize(mdatHrd.size()));
-    uint64_t mdatSize = mdatHrd.size();
+    // moof size doesn't depend on the data offsets in it, so the offsets
+    // are known before writing and neither moof nor mdat need rewriting
+    Stream moofBS;
+    WriteMoof(moofBS, trackIds, oneSeg, segMoofInfos, frameMap);
+    uint64_t moofSize = moofBS.GetStorage().size();
+
+    uint8_t mdatHrd[8] = {0, 0, 0, 0, uint8_t('m'), uint8_t('d'), uint8_t('a'), uint8_t('t')};
+    uint64_t mdatSize = sizeof(mdatHrd);
+
+    // spans of moof, mdat header and then all frames payload
+    vector<struct iovec> spans(2);
+    // frame data which can't be referred without copy
+    list<FrameBuf> frameBufs;
     vector<TrackId>::iterator iter2 = trackIds.begin();
     for ( ; iter2 != trackIds.end(); iter2++)
     {
-        Mp4MoofInfo moofInfo  = {oneSeg.tracks.find(*iter2)->second.trackInfo,
-                                    int32_t(outStr.tellp() - streamoff(moofOffset))};
-        segMoofInfos[*iter2] = move(moofInfo);
+        segMoofInfos[*iter2].moofToDataOffset = int32_t(moofSize + mdatSize);
         if (frameMap.find(*iter2) == frameMap.end())
         {
             ISO_LOG(LOG_ERROR, "Failed to find frame with designated track Id !\n");
@@ -313,24 +336,42 @@ void WriteSampleData(ostream& outStr, const Segment& oneSeg)
         }
         for (const auto& frame : frameMap.find(*iter2)->second)
         {
-            const auto& frameData = *frame;
-            const auto& data      = frameData.frameBuf;
-            outStr.write(reinterpret_cast<const char*>(&data[0]), streamsize(data.size()));
-            mdatSize += data.size();
+            const uint8_t* data = frame.GetDataPtr();
+            size_t size = frame.GetSize();
+            if (!data)
+            {
+                frameBufs.push_back((*frame).frameBuf);
+                data = frameBufs.back().data();
+                size = frameBufs.back().size();
+            }
+            if (!size)
+                continue;
+            spans.push_back({const_cast<uint8_t*>(data), size});
+            mdatSize += size;
         }
     }
-    streampos afterMdat = outStr.tellp();
 
     mdatHrd[0] = uint8_t((mdatSize >> 24) & 0xff);
     mdatHrd[1] = uint8_t((mdatSize >> 16) & 0xff);
     mdatHrd[2] = uint8_t((mdatSize >> 8) & 0xff);
     mdatHrd[3] = uint8_t((mdatSize >> 0) & 0xff);
-    outStr.seekp(mdatOffset);
-    outStr.write(reinterpret_cast<const char*>(&mdatHrd[0]), streamsize(4));
 
-    outStr.seekp(moofOffset);
-    WriteMoof(outStr, trackIds, oneSeg, segMoofInfos, frameMap);
-    outStr.seekp(afterMdat);
+    moofBS.Clear();
+    WriteMoof(moofBS, trackIds, oneSeg, segMoofInfos, frameMap);
+    if (moofBS.GetStorage().size() != moofSize)
+    {
+        ISO_LOG(LOG_ERROR, "Moof size changes with data offsets !\n");
+        throw exception();
+    }
+
+    const auto& moofData = moofBS.GetStorage();
+    spans[0] = {const_cast<uint8_t*>(moofData.data()), moofData.size()};
+    spans[1] = {mdatHrd, sizeof(mdatHrd)};
+
+    if (writtenSize)
+        *writtenSize = moofSize + mdatSize;
+
+    return sink->Write(spans.data(), int32_t(spans.size()));
 }
 
 void WriteInitSegment(ostringstream& outStr, const InitialSegment& initSegment)
@@ -866,6 +907,11 @@ size_t AcquireVideoFrameData::GetDataSize() const
     return (size_t)(m_dataSize);
 }
 
+const uint8_t* AcquireVideoFrameData::GetDataPtr() const
+{
+    return m_data;
+}
+
 AcquireVideoFrameData* AcquireVideoFrameData::Clone() const
 {
     return new AcquireVideoFrameData(m_data, m_dataSize);
@@ -1772,29 +1818,32 @@ void SegmentWriter::WriteInitSegment(ostringstream& outStr, const bool isFraged)
     outStr.write(reinterpret_cast<const char*>(&data[0]), streamsize(data.size()));
 }
 
-void SegmentWriter::WriteSubSegments(ostream& outStr, const list<Segment> subSegList)
+bool SegmentWriter::WriteSubSegments(SegmentSink* sink, const list<Segment>& subSegList, uint64_t* segSize)
 {
     if (m_needWriteSegmentHeader)
     {
-        WriteSegmentHeader(outStr);
+        if (!WriteSegmentHeader(sink))
+            return false;
     }
     for (auto& subsegment : subSegList)
     {
         m_sidxWriter->AddSubSeg(subsegment);
     }
-    auto sidxInfo = m_sidxWriter->WriteSidx(outStr, {});
+    auto sidxInfo = m_sidxWriter->WriteSidx(sink, {});
     for (auto& subsegment : subSegList)
     {
-        auto before = outStr.tellp();
-        WriteSampleData(outStr, subsegment);
-        auto after = outStr.tellp();
-        m_sidxWriter->AddSubSegSize(after - before);
+        uint64_t subSegSize = 0;
+        if (!WriteSampleData(sink, subsegment, &subSegSize))
+            return false;
+        m_sidxWriter->AddSubSegSize(streampos(subSegSize));
+        if (segSize)
+            *segSize += subSegSize;
     }
     if (sidxInfo)
     {
-        m_sidxWriter->WriteSidx(outStr, sidxInfo->position);
+        m_sidxWriter->WriteSidx(sink, sidxInfo->position);
     }
-
+    return true;
 }
 
 void SegmentWriter::WriteSegments(std::ostringstream &frameString,
@@ -1803,17 +1852,39 @@ void SegmentWriter::WriteSegments(std::ostringstream &frameString,
     char *baseName,
     uint64_t *segSize)
 {
+    OstreamSegmentSink sink(frameString);
+    WriteSegments(&sink, segNum, segName, baseName, NULL);
+}
+
+bool SegmentWriter::WriteSegments(SegmentSink *sink,
+    uint64_t *segNum,
+    char segName[1024],
+    char *baseName,
+    uint64_t *segSize)
+{
+    if (!sink)
+        return false;
+
     std::list<SegmentList> segments = ExtractSubSegments();
-    if (segments.size())
+    for (auto& segment : segments)
     {
-        for (auto& segment : segments)
+        (*segNum)++;
+        snprintf(segName, 1024, "%s.%ld.mp4", baseName, *segNum);
+        if (segSize)
+            *segSize = 0;
+        if (!sink->BeginSegment(segName))
+        {
+            ISO_LOG(LOG_ERROR, "Failed to begin segment %s !\n", segName);
+            return false;
+        }
+        bool ret = WriteSubSegments(sink, segment, segSize);
+        if (!sink->EndSegment() || !ret)
         {
-            (*segNum)++;
-            snprintf(segName, 1024, "%s.%ld.mp4", baseName, *segNum);
-            WriteSubSegments(frameString, segment);
-            std::string segString(frameString.str());
+            ISO_LOG(LOG_ERROR, "Failed to write segment %s !\n", segName);
+            return false;
         }
     }
+    return true;
 }
 
 extern "C" SegmentWriterBase* Create(SegmentWriterCfg inCfg)
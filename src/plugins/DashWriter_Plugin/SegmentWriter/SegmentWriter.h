@@ -56,7 +56,7 @@ public:
     {
     }
 
-    DataItem<SidxInfo> WriteSidx(ostream&, DataItem<ostream::pos_type>)
+    DataItem<SidxInfo> WriteSidx(SegmentSink*, DataItem<ostream::pos_type>)
     {
         return {};
     }
@@ -113,6 +113,9 @@ public:
     void WriteSegments(std::ostringstream &frameString,
         uint64_t *segNum, char segName[1024], char *baseName, uint64_t *segSize);
 
+    bool WriteSegments(SegmentSink *sink,
+        uint64_t *segNum, char segName[1024], char *baseName, uint64_t *segSize);
+
 private:
     void AddTrack(TrackMeta inTrackMeta);
 
@@ -134,7 +137,7 @@ private:
 
     Action FeedOneFrame(TrackId trackIndex, FrameWrapper oneFrame);
 
-    void WriteSubSegments(ostream& outStr, const list<Segment> subSegList);
+    bool WriteSubSegments(SegmentSink* sink, const list<Segment>& subSegList, uint64_t* segSize);
 
     list<SegmentList> ExtractSubSegments();
 
@@ -261,6 +264,14 @@ public:
     //!
     size_t GetDataSize() const override;
 
+    //!
+    //! \brief  Get the pointer to the coded data without copy
+    //!
+    //! \return const uint8_t*
+    //!         the pointer to the coded data
+    //!
+    const uint8_t* GetDataPtr() const override;
+
     //!
     //! \brief  Clone one AcquireVideoFrameData object
     //!
@@ -93,6 +93,11 @@ size_t FrameWrapper::GetSize() const
     return m_acquire->GetDataSize();
 }
 
+const uint8_t* FrameWrapper::GetDataPtr() const
+{
+    return m_acquire->GetDataPtr();
+}
+
 FrameInfo FrameWrapper::GetFrameInfo() const
 {
     return m_frameInfo;
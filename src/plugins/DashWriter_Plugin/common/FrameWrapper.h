@@ -52,6 +52,13 @@ public:
     virtual size_t GetDataSize() const = 0;
     virtual FrameBuf Get() const  = 0;
 
+    //!
+    //! \brief  Get the pointer to the data without copy, which is
+    //!         valid as long as the data source, nullptr if the data
+    //!         is only available by Get()
+    //!
+    virtual const uint8_t* GetDataPtr() const { return nullptr; };
+
     virtual GetDataOfFrame* Clone() const = 0;
 };
 
@@ -69,6 +76,7 @@ public:
     FrameInfo GetFrameInfo() const;
     void SetFrameInfo(const FrameInfo& aFrameInfo);
     size_t GetSize() const;
+    const uint8_t* GetDataPtr() const;
 
 private:
     unique_ptr<GetDataOfFrame> m_acquire;
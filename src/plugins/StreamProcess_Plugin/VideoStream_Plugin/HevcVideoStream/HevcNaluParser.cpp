@@ -270,6 +270,30 @@ int16_t HevcNaluParser::ParseProjectionTypeSei()
     }
 }
 
+uint32_t HevcNaluParser::MatchParsedNalu(uint8_t *data, uint32_t dataSize, Nalu *parsedNalu)
+{
+    if (!data || !parsedNalu || !(parsedNalu->data) || (parsedNalu->dataSize <= 0))
+        return 0;
+
+    uint32_t naluSize = (uint32_t)(parsedNalu->dataSize);
+    if (naluSize > dataSize)
+        return 0;
+
+    if (memcmp(data, parsedNalu->data, naluSize))
+        return 0;
+
+    // the matched bytes must be followed by the start codes of next nalu,
+    // otherwise the nalu in frame is longer than the parsed one
+    if ((naluSize + 3 > dataSize) || data[naluSize] || data[naluSize + 1])
+        return 0;
+
+    if ((data[naluSize + 2] != 1) &&
+        ((naluSize + 4 > dataSize) || data[naluSize + 2] || (data[naluSize + 3] != 1)))
+        return 0;
+
+    return naluSize;
+}
+
 int32_t HevcNaluParser::ParseSliceNalu(
         uint8_t *frameData,
         int32_t frameDataSize,
@@ -283,27 +307,40 @@ int32_t HevcNaluParser::ParseSliceNalu(
     m_360scvpParam->inputBitstreamLen = frameDataSize;
     uint32_t restBSBytes = m_360scvpParam->inputBitstreamLen;
 
+    Nalu *parsedNalus[4] = { m_vpsNalu, m_spsNalu, m_ppsNalu, m_projNalu };
+    Nalu tempNalu;
     while (restBSBytes > 0)
     {
-        Nalu *tempNalu = new Nalu;
-        tempNalu->data = m_360scvpParam->pInputBitstream;
-        tempNalu->dataSize = restBSBytes;
-        I360SCVP_ParseNAL(tempNalu, m_360scvpHandle);
-        if (tempNalu->naluType == 32 || tempNalu->naluType == 33
-        || tempNalu->naluType == 34 || tempNalu->naluType == 39
-        || tempNalu->naluType == 40) // skip VPS/SPS/PPS/SEI
+        // VPS/SPS/PPS/SEI repeated in the frame are usually identical to
+        // the ones parsed in header data, then they are skipped without
+        // parsing them again
+        uint32_t skipSize = 0;
+        for (uint8_t idx = 0; idx < 4; idx++)
         {
-            m_360scvpParam->pInputBitstream = m_360scvpParam->pInputBitstream + tempNalu->dataSize;
-            restBSBytes -= tempNalu->dataSize;
-            delete tempNalu;
-            tempNalu = NULL;
+            skipSize = MatchParsedNalu(m_360scvpParam->pInputBitstream, restBSBytes, parsedNalus[idx]);
+            if (skipSize)
+                break;
         }
-        else
+
+        if (!skipSize)
         {
-            delete tempNalu;
-            tempNalu = NULL;
-            break;
+            memset_s(&tempNalu, sizeof(Nalu), 0);
+            tempNalu.data = m_360scvpParam->pInputBitstream;
+            tempNalu.dataSize = restBSBytes;
+            I360SCVP_ParseNAL(&tempNalu, m_360scvpHandle);
+            if (tempNalu.naluType == 32 || tempNalu.naluType == 33
+            || tempNalu.naluType == 34 || tempNalu.naluType == 39
+            || tempNalu.naluType == 40) // skip VPS/SPS/PPS/SEI
+            {
+                skipSize = tempNalu.dataSize;
+            }
         }
+
+        if (!skipSize || (skipSize > restBSBytes))
+            break;
+
+        m_360scvpParam->pInputBitstream = m_360scvpParam->pInputBitstream + skipSize;
+        restBSBytes -= skipSize;
     }
 
     uint32_t restBitstreamLen = restBSBytes;
@@ -170,6 +170,22 @@ private:
     //!
     virtual int16_t ParseProjectionTypeSei();
 
+    //!
+    //! \brief  Check whether the nalu at the beginning of data is
+    //!         identical to the nalu already parsed in header data
+    //!
+    //! \param  [in] data
+    //!         pointer to the bitstream data
+    //! \param  [in] dataSize
+    //!         size of the bitstream data
+    //! \param  [in] parsedNalu
+    //!         pointer to the nalu already parsed
+    //!
+    //! \return uint32_t
+    //!         size of the matched nalu, 0 if not matched
+    //!
+    uint32_t MatchParsedNalu(uint8_t *data, uint32_t dataSize, Nalu *parsedNalu);
+
 private:
 };
 
@@ -117,6 +117,47 @@ typedef struct DASHSTATISTICINFO {
   int32_t immediate_bandwidth;
 } DashStatisticInfo;
 
+/*
+ * the stages a segment goes through in OmafDashAccess, from downloading to
+ * the packet being got by the client
+ */
+typedef enum {
+  LatencyStage_Download = 0,
+  LatencyStage_Parse,
+  LatencyStage_Stitch,
+  LatencyStage_GetPacket,
+  LatencyStage_Num,
+} LatencyStage;
+
+typedef enum {
+  LatencyTrack_Video = 0,
+  LatencyTrack_Extractor,
+  LatencyTrack_Audio,
+  LatencyTrack_Num,
+} LatencyTrackType;
+
+/*
+ * count : the number of latency samples
+ * min_us / max_us / mean_us : the latency in microsecond
+ * p50_us / p90_us / p99_us : the percentiles of the latency in microsecond
+ */
+typedef struct LATENCYINFO {
+  uint64_t count;
+  uint64_t min_us;
+  uint64_t max_us;
+  uint64_t mean_us;
+  uint64_t p50_us;
+  uint64_t p90_us;
+  uint64_t p99_us;
+} LatencyInfo;
+
+/*
+ * latency : the latency of each stage for each track type
+ */
+typedef struct DASHSTAGESTATISTICINFO {
+  LatencyInfo latency[LatencyStage_Num][LatencyTrack_Num];
+} DashStageStatisticInfo;
+
 /*
  * stream_type : Video or Audio stream
  * height : the height of original video
@@ -189,6 +230,9 @@ typedef struct DASHPACKET {
   bool bCatchup;
   int32_t hViewID;                  //!< horizontal view id
   int32_t vViewID;                  //!< vertical view id
+  Output_Span* spans;               //!< spans of the merged frame when buf is NULL in span output mode
+  uint32_t spansNum;                //!< number of the spans
+  void* spansOwner;                 //!< keeps the data the spans point to alive until the spans are released
 } DashPacket;
 
 typedef enum {